@@ -0,0 +1,156 @@
+#include "bench.h"
+#include "atomic.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static TaskHandle_t xRunnerHandle = NULL;
+static UBaseType_t uxIdleTaskCount = 0;   // tasks alive while no scenario runs
+
+static void vBenchRunner(void* pvParam);
+static int compareSamples(const void* a, const void* b);
+static uint64_t percentile(const uint64_t* sorted, uint32_t count, uint32_t pct);
+
+uint64_t benchNowNs(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+void benchInit(Bench_t* bench, uint32_t sampleCapacity)
+{
+  // host memory, so the FreeRTOS heap only holds what the scenario allocates
+  bench->samplesNs = malloc(sizeof(uint64_t) * sampleCapacity);
+  configASSERT(bench->samplesNs != NULL);
+  bench->sampleCapacity = sampleCapacity;
+  bench->sampleCount = 0;
+  bench->elapsedNs = 0;
+  bench->switches = 0;
+}
+
+void benchFree(Bench_t* bench)
+{
+  free(bench->samplesNs);
+  bench->samplesNs = NULL;
+}
+
+void benchStart(Bench_t* bench)
+{
+  bench->sampleCount = 0;
+  bench->startSwitches = ulPortGetContextSwitchCount();
+  bench->startNs = benchNowNs();
+}
+
+void benchStop(Bench_t* bench)
+{
+  bench->elapsedNs = benchNowNs() - bench->startNs;
+  bench->switches = ulPortGetContextSwitchCount() - bench->startSwitches;
+}
+
+void benchSample(Bench_t* bench, uint64_t ns)
+{
+  // tasks on different cores can record samples at the same time
+  uint32_t index = Atomic_Increment_u32(&bench->sampleCount);
+  if (index < bench->sampleCapacity)
+  {
+    bench->samplesNs[index] = ns;
+  }
+}
+
+void benchPrintHeader(const char* title)
+{
+  printf("\n%s\n", title);
+  printf("%-44s %10s %11s %9s %9s %9s %9s %10s %7s\n",
+         "scenario", "ops", "ops/s", "ns/op", "p50", "p90", "p99", "max", "cs/op");
+}
+
+void benchReport(const char* scenario, Bench_t* bench, uint32_t ops)
+{
+  uint64_t p50 = 0, p90 = 0, p99 = 0, max = 0;
+
+  if (bench->sampleCount > bench->sampleCapacity)
+  {
+    bench->sampleCount = bench->sampleCapacity;
+  }
+
+  if (bench->sampleCount > 0)
+  {
+    qsort(bench->samplesNs, bench->sampleCount, sizeof(uint64_t), compareSamples);
+    p50 = percentile(bench->samplesNs, bench->sampleCount, 50);
+    p90 = percentile(bench->samplesNs, bench->sampleCount, 90);
+    p99 = percentile(bench->samplesNs, bench->sampleCount, 99);
+    max = bench->samplesNs[bench->sampleCount - 1];
+  }
+
+  printf("%-44s %10u %11.0f %9.0f %9llu %9llu %9llu %10llu %7.2f\n",
+         scenario, ops,
+         ops * 1e9 / (double)bench->elapsedNs,
+         (double)bench->elapsedNs / ops,
+         (unsigned long long)p50, (unsigned long long)p90,
+         (unsigned long long)p99, (unsigned long long)max,
+         (double)bench->switches / ops);
+}
+
+void benchMain(void (*body)(void))
+{
+  BaseType_t err = xTaskCreate(vBenchRunner, "bench", BENCH_STACK_SIZE, (void*)body,
+                               BENCH_RUNNER_PRIORITY, &xRunnerHandle);
+  configASSERT(err == pdPASS);
+
+  vTaskStartScheduler();
+}
+
+void benchWaitForTasks(uint32_t count)
+{
+  benchWaitForDone(count);
+
+  // let the idle task free the stacks of the deleted tasks before the next
+  // scenario creates its own
+  while (uxTaskGetNumberOfTasks() > uxIdleTaskCount)
+  {
+    vTaskDelay(1);
+  }
+}
+
+void benchWaitForDone(uint32_t count)
+{
+  for (uint32_t i = 0; i < count; i++)
+  {
+    ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+  }
+}
+
+void benchTaskDone(void)
+{
+  xTaskNotifyGive(xRunnerHandle);
+  vTaskDelete(NULL);
+}
+
+static void vBenchRunner(void* pvParam)
+{
+  void (*body)(void) = (void (*)(void))pvParam;
+
+  uxIdleTaskCount = uxTaskGetNumberOfTasks();
+  body();
+
+  printf("\n");
+  vTaskEndScheduler();
+}
+
+static int compareSamples(const void* a, const void* b)
+{
+  uint64_t x = *(const uint64_t*)a;
+  uint64_t y = *(const uint64_t*)b;
+  return (x > y) - (x < y);
+}
+
+static uint64_t percentile(const uint64_t* sorted, uint32_t count, uint32_t pct)
+{
+  uint32_t index = (uint32_t)(((uint64_t)count * pct) / 100);
+  if (index >= count)
+  {
+    index = count - 1;
+  }
+  return sorted[index];
+}
@@ -0,0 +1,69 @@
+/*
+Benchmark harness for the Posix/Linux simulator build.
+
+  Every benchmark program runs its scenarios from a single runner task and
+  reports one row per scenario:
+
+    ops/s         throughput
+    ns/op         mean cost of one operation (one handoff, one lock/unlock...)
+    p50/p90/p99   percentiles of the per-operation samples
+    max           worst sample
+    cs/op         context switches per operation
+
+  Wall clock time comes from CLOCK_MONOTONIC and context switches from the
+  port, so the numbers are for the host, not for the STM32F407. They are meant
+  to be compared against each other and against earlier runs.
+*/
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+
+// Priority of the runner task - above every task a scenario creates
+#define BENCH_RUNNER_PRIORITY (configMAX_PRIORITIES - 1)
+#define BENCH_STACK_SIZE      0x200
+
+typedef struct
+{
+  uint64_t* samplesNs;      // per-operation samples
+  uint32_t  sampleCount;
+  uint32_t  sampleCapacity;
+  uint64_t  startNs;
+  uint32_t  startSwitches;
+  uint64_t  elapsedNs;      // total time between benchStart and benchStop
+  uint32_t  switches;       // context switches between benchStart and benchStop
+} Bench_t;
+
+// Time since an arbitrary point in the past, in nanoseconds
+uint64_t benchNowNs(void);
+
+// Allocate room for sampleCapacity samples and reset the counters
+void benchInit(Bench_t* bench, uint32_t sampleCapacity);
+void benchFree(Bench_t* bench);
+
+void benchStart(Bench_t* bench);
+void benchStop(Bench_t* bench);
+
+// Record one sample, ignored once the bench is full
+void benchSample(Bench_t* bench, uint64_t ns);
+
+void benchPrintHeader(const char* title);
+
+// Print one row; ops is the number of operations the elapsed time covers
+void benchReport(const char* scenario, Bench_t* bench, uint32_t ops);
+
+// Run body() from the runner task, then stop the scheduler
+void benchMain(void (*body)(void));
+
+// Block the runner until count tasks have called benchTaskDone() and the idle
+// task has cleaned up after them
+void benchWaitForTasks(uint32_t count);
+
+// Block the runner until count tasks have called benchTaskDone(), without
+// waiting for the clean up - for when other tasks are still running
+void benchWaitForDone(uint32_t count);
+void benchTaskDone(void);
+
+#endif
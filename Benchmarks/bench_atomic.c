@@ -0,0 +1,161 @@
+/*
+Shared counter contention benchmark:
+
+  N tasks of equal priority increment one shared counter as fast as they can,
+  as in exc_1.5.2. The tasks time slice, so a task can be preempted by the
+  tick half way through an update. One op is one increment, and each sample
+  is the mean of a batch of BATCH_SIZE increments so the clock reads don't
+  swamp the numbers. The final count is checked after every scenario.
+
+  Atomic_Increment_u32:
+    atomic.h fetch-and-add. On this port it is a single locked instruction,
+    on the Cortex-M4 an LDREX/STREX loop. Neither masks interrupts.
+
+  Atomic_CompareAndSwap_u32 loop:
+    Read, add one and retry the compare-and-swap until nobody got in between,
+    the general pattern for read-modify-write updates atomic.h has no
+    function for.
+
+  taskENTER_CRITICAL:
+    Mask interrupts around the update, which is what atomic.h does on ports
+    without lock free primitives. On this port it masks the tick signal, so
+    it costs two system calls - on the target it is a few cycles.
+
+  Mutex:
+    xSemaphoreTake() / xSemaphoreGive() around the update.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "atomic.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY     1
+#define MAX_TASKS           16
+#define TOTAL_INCREMENTS    1600000   // split between the tasks of a scenario
+#define BATCH_SIZE          1000
+
+typedef enum
+{
+  COUNTER_ATOMIC,
+  COUNTER_CAS_LOOP,
+  COUNTER_CRITICAL,
+  COUNTER_MUTEX
+} Counter_t;
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static Counter_t eCounter;
+static uint32_t incrementsPerTask;
+static volatile uint32_t sharedCounter;
+static SemaphoreHandle_t xCounterMutex;
+
+static void runCounter(const char* scenario, Counter_t counter, uint32_t tasks);
+static void vCounterTask(void* pvParam);
+static void incrementCounter(void);
+
+static void benchmarks(void)
+{
+  static const uint32_t taskCounts[] = { 1, 4, MAX_TASKS };
+
+  benchInit(&xBench, TOTAL_INCREMENTS / BATCH_SIZE);
+
+  for (uint32_t i = 0; i < sizeof(taskCounts) / sizeof(taskCounts[0]); i++)
+  {
+    char title[64];
+
+    snprintf(title, sizeof(title), "Shared counter increment (%u tasks)", (unsigned)taskCounts[i]);
+    benchPrintHeader(title);
+    runCounter("Atomic_Increment_u32", COUNTER_ATOMIC, taskCounts[i]);
+    runCounter("Atomic_CompareAndSwap_u32 loop", COUNTER_CAS_LOOP, taskCounts[i]);
+    runCounter("taskENTER_CRITICAL", COUNTER_CRITICAL, taskCounts[i]);
+    runCounter("mutex", COUNTER_MUTEX, taskCounts[i]);
+  }
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runCounter(const char* scenario, Counter_t counter, uint32_t tasks)
+{
+  eCounter = counter;
+  incrementsPerTask = TOTAL_INCREMENTS / tasks;
+  sharedCounter = 0;
+  xCounterMutex = xSemaphoreCreateMutex();
+
+  for (uint32_t i = 0; i < tasks; i++)
+  {
+    BaseType_t err = xTaskCreate(vCounterTask, "count", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+    configASSERT(err == pdPASS);
+  }
+
+  benchStart(&xBench);
+  benchWaitForTasks(tasks);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, tasks * incrementsPerTask);
+
+  if (sharedCounter != tasks * incrementsPerTask)
+  {
+    printf("  lost updates: counter = %u, expected %u\n", (unsigned)sharedCounter, (unsigned)(tasks * incrementsPerTask));
+  }
+
+  vSemaphoreDelete(xCounterMutex);
+}
+
+// TASKS
+
+static void vCounterTask(void* pvParam)
+{
+  for (uint32_t done = 0; done < incrementsPerTask; done += BATCH_SIZE)
+  {
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    {
+      incrementCounter();
+    }
+    benchSample(&xBench, (benchNowNs() - start) / BATCH_SIZE);
+  }
+  benchTaskDone();
+}
+
+// COUNTERS
+
+static void incrementCounter(void)
+{
+  uint32_t current;
+
+  switch (eCounter)
+  {
+    case COUNTER_ATOMIC:
+      Atomic_Increment_u32(&sharedCounter);
+      break;
+
+    case COUNTER_CAS_LOOP:
+      do
+      {
+        current = sharedCounter;
+      } while (Atomic_CompareAndSwap_u32(&sharedCounter, current + 1, current) == ATOMIC_COMPARE_AND_SWAP_FAILURE);
+      break;
+
+    case COUNTER_CRITICAL:
+      taskENTER_CRITICAL();
+      sharedCounter++;
+      taskEXIT_CRITICAL();
+      break;
+
+    case COUNTER_MUTEX:
+      xSemaphoreTake(xCounterMutex, portMAX_DELAY);
+      sharedCounter++;
+      xSemaphoreGive(xCounterMutex);
+      break;
+  }
+}
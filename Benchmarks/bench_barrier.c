@@ -0,0 +1,205 @@
+/*
+Reusable barrier benchmark:
+
+  N tasks of equal priority meet at a barrier over and over, as in the
+  exc_3.7 exercises. One op is one barrier phase: every task arrives and
+  every task is released. For the turnstile barriers that means every task
+  passes the first turnstile, then every task passes the second one.
+
+  Turnstile (chained):
+    The book's reusable barrier used by exc_3.7_barrier.c. The last task to
+    arrive gives the turnstile once and every task takes and gives it back
+    on its way through, so N tasks cost a cascade of N wakeups.
+
+  Turnstile (give loop):
+    exc_3.7_barrier_2 before xSemaphoreGiveMultiple() existed. The last task
+    to arrive calls xSemaphoreGive() N times.
+
+  Turnstile (give multiple):
+    exc_3.7_barrier_2 as it is now. The last task to arrive releases all N
+    tokens with one xSemaphoreGiveMultiple() call.
+
+  Native barrier:
+    exc_3.7_barrier_3. One xBarrierWait() per task per phase, no mutex and
+    no semaphores.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "barrier.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY 1
+#define MAX_TASKS       100
+
+typedef enum
+{
+  BARRIER_CHAINED,
+  BARRIER_GIVE_LOOP,
+  BARRIER_GIVE_MULTIPLE,
+  BARRIER_NATIVE
+} Barrier_t;
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static Barrier_t eBarrier;
+static uint32_t taskCount;
+static uint32_t phaseCount;
+static uint32_t arrived;
+static SemaphoreHandle_t xCountLock;
+static SemaphoreHandle_t xTurnstile;
+static SemaphoreHandle_t xSecondTurnstile;
+static BarrierHandle_t xNativeBarrier;
+
+static void runBarrier(const char* scenario, Barrier_t barrier, uint32_t tasks, uint32_t phases);
+static void vBarrierTask(void* pvParam);
+static void barrierWait(void);
+static void openTurnstile(SemaphoreHandle_t xOpen, SemaphoreHandle_t xClose);
+static void passTurnstile(SemaphoreHandle_t xTurnstileToPass);
+
+static void benchmarks(void)
+{
+  static const uint32_t taskCounts[] = { 4, 20, MAX_TASKS };
+
+  benchInit(&xBench, 2000);
+
+  for (uint32_t i = 0; i < sizeof(taskCounts) / sizeof(taskCounts[0]); i++)
+  {
+    char title[64];
+    uint32_t phases = 40000 / taskCounts[i];
+
+    snprintf(title, sizeof(title), "Reusable barrier (%u tasks, one op = one phase)", (unsigned)taskCounts[i]);
+    benchPrintHeader(title);
+    runBarrier("turnstile (chained)", BARRIER_CHAINED, taskCounts[i], phases);
+    runBarrier("turnstile (give loop)", BARRIER_GIVE_LOOP, taskCounts[i], phases);
+    runBarrier("turnstile (give multiple)", BARRIER_GIVE_MULTIPLE, taskCounts[i], phases);
+    runBarrier("xBarrierWait", BARRIER_NATIVE, taskCounts[i], phases);
+  }
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runBarrier(const char* scenario, Barrier_t barrier, uint32_t tasks, uint32_t phases)
+{
+  eBarrier = barrier;
+  taskCount = tasks;
+  phaseCount = phases;
+  arrived = 0;
+  xCountLock = xSemaphoreCreateMutex();
+  xTurnstile = xSemaphoreCreateCounting(tasks, 0);        // closed
+  xSecondTurnstile = xSemaphoreCreateCounting(tasks, 0);
+  if (barrier == BARRIER_CHAINED)
+  {
+    xSemaphoreGive(xSecondTurnstile);                     // chained turnstile 2 starts open
+  }
+  xNativeBarrier = xBarrierCreate(tasks);
+
+  for (uint32_t i = 0; i < tasks; i++)
+  {
+    BaseType_t err = xTaskCreate(vBarrierTask, "bar", BENCH_STACK_SIZE, (void*)(uintptr_t)i, WORKER_PRIORITY, NULL);
+    configASSERT(err == pdPASS);
+  }
+
+  benchStart(&xBench);
+  benchWaitForTasks(tasks);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, phases);
+
+  vSemaphoreDelete(xCountLock);
+  vSemaphoreDelete(xTurnstile);
+  vSemaphoreDelete(xSecondTurnstile);
+  vBarrierDelete(xNativeBarrier);
+}
+
+// TASKS
+
+static void vBarrierTask(void* pvParam)
+{
+  uint32_t index = (uint32_t)(uintptr_t)pvParam;
+
+  for (uint32_t i = 0; i < phaseCount; i++)
+  {
+    uint64_t start = benchNowNs();
+    barrierWait();
+    if (index == 0)
+    {
+      benchSample(&xBench, benchNowNs() - start);
+    }
+  }
+  benchTaskDone();
+}
+
+// BARRIERS
+
+static void barrierWait(void)
+{
+  if (eBarrier == BARRIER_NATIVE)
+  {
+    xBarrierWait(xNativeBarrier, portMAX_DELAY);
+    return;
+  }
+
+  xSemaphoreTake(xCountLock, portMAX_DELAY);
+  if (++arrived == taskCount)
+  {
+    openTurnstile(xTurnstile, xSecondTurnstile);
+  }
+  xSemaphoreGive(xCountLock);
+
+  passTurnstile(xTurnstile);
+
+  xSemaphoreTake(xCountLock, portMAX_DELAY);
+  if (--arrived == 0)
+  {
+    openTurnstile(xSecondTurnstile, xTurnstile);
+  }
+  xSemaphoreGive(xCountLock);
+
+  passTurnstile(xSecondTurnstile);
+}
+
+static void openTurnstile(SemaphoreHandle_t xOpen, SemaphoreHandle_t xClose)
+{
+  switch (eBarrier)
+  {
+    case BARRIER_CHAINED:
+      // lock the other turnstile, then let the first task through this one
+      xSemaphoreTake(xClose, portMAX_DELAY);
+      xSemaphoreGive(xOpen);
+      break;
+
+    case BARRIER_GIVE_LOOP:
+      for (uint32_t i = 0; i < taskCount; i++)
+      {
+        xSemaphoreGive(xOpen);
+      }
+      break;
+
+    case BARRIER_GIVE_MULTIPLE:
+      xSemaphoreGiveMultiple(xOpen, taskCount);
+      break;
+
+    case BARRIER_NATIVE:
+      break;
+  }
+}
+
+static void passTurnstile(SemaphoreHandle_t xTurnstileToPass)
+{
+  xSemaphoreTake(xTurnstileToPass, portMAX_DELAY);
+  if (eBarrier == BARRIER_CHAINED)
+  {
+    // let the next task through
+    xSemaphoreGive(xTurnstileToPass);
+  }
+}
@@ -0,0 +1,217 @@
+/*
+Contention statistics benchmark:
+
+  What counting takes, waits and holds adds to semaphore and mutex
+  operations, and what the report says about each scenario. The same program
+  is built with and without the counters - the title says which:
+
+    stats off   default
+    stats on    cmake -DSIMULATOR_CONTENTION_STATS=ON
+
+  mutex take and give:
+    One task takes and gives a mutex nobody else wants. Each sample is the
+    mean over BATCH_SIZE of them.
+
+  semaphore ping-pong:
+    Two tasks of equal priority hand a binary semaphore token back and
+    forth. One op is one handoff - every take but the first waits.
+
+  contended mutex:
+    WORKER_COUNT tasks of equal priority take a mutex, yield while holding
+    it and give it back, so every other worker that gets to run blocks on
+    it. One op is one take and give.
+
+  mutex held across ticks:
+    The same workers hold the mutex for a tick each time, so the waits that
+    do happen run to many ticks and land in the upper histogram buckets.
+
+  With the counters on, the contention report of the registered semaphores
+  and mutexes follows the rows - note how few of the shared mutex's takes
+  wait: the giver takes it straight back before the waiter it woke runs.
+
+  Compare each row against the same row of the other build.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define WORKER_COUNT      4
+#define BATCH_SIZE        64
+#define MUTEX_COUNT       262144
+#define PING_PONG_ROUNDS  20000
+#define CONTENDED_ROUNDS  5000
+#define HELD_ROUNDS       50
+
+#if (configUSE_QUEUE_CONTENTION_STATS == 1)
+#define STATS "stats on"
+#else
+#define STATS "stats off"
+#endif
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static SemaphoreHandle_t xPingSem, xPongSem, xSharedMutex;
+static uint32_t ulRounds;
+static TickType_t xHoldTicks;
+
+static void runMutex(const char* scenario);
+static void runPingPong(const char* scenario);
+static void runContended(const char* scenario, uint32_t rounds, TickType_t holdTicks);
+static void printReport(void);
+
+static void vPing(void* pvParam);
+static void vPong(void* pvParam);
+static void vWorker(void* pvParam);
+
+static void benchmarks(void)
+{
+  benchInit(&xBench, MUTEX_COUNT / BATCH_SIZE);
+
+  xPingSem = xSemaphoreCreateBinary();
+  xPongSem = xSemaphoreCreateBinary();
+  xSharedMutex = xSemaphoreCreateMutex();
+  configASSERT(xPingSem != NULL && xPongSem != NULL && xSharedMutex != NULL);
+  vQueueAddToRegistry(xPingSem, "ping");
+  vQueueAddToRegistry(xPongSem, "pong");
+  vQueueAddToRegistry(xSharedMutex, "shared mutex");
+
+  benchPrintHeader("semaphore and mutex contention (" STATS ")");
+  runMutex("mutex take and give");
+  runPingPong("semaphore ping-pong");
+  runContended("contended mutex", CONTENDED_ROUNDS, 0);
+  printReport();
+
+  // the report of the held mutex on its own
+#if (configUSE_QUEUE_CONTENTION_STATS == 1)
+  vQueueResetContentionStats(xSharedMutex);
+#endif
+  runContended("mutex held across ticks", HELD_ROUNDS, 1);
+  printReport();
+
+  vSemaphoreDelete(xPingSem);
+  vSemaphoreDelete(xPongSem);
+  vSemaphoreDelete(xSharedMutex);
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runMutex(const char* scenario)
+{
+  SemaphoreHandle_t xMutex = xSemaphoreCreateMutex();
+  configASSERT(xMutex != NULL);
+  vQueueAddToRegistry(xMutex, "uncontended");
+
+  benchStart(&xBench);
+  for (uint32_t done = 0; done < MUTEX_COUNT; done += BATCH_SIZE)
+  {
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    {
+      xSemaphoreTake(xMutex, portMAX_DELAY);
+      xSemaphoreGive(xMutex);
+    }
+    benchSample(&xBench, (benchNowNs() - start) / BATCH_SIZE);
+  }
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, MUTEX_COUNT);
+  printReport();
+
+  vQueueUnregisterQueue(xMutex);
+  vSemaphoreDelete(xMutex);
+}
+
+static void runPingPong(const char* scenario)
+{
+  BaseType_t err = xTaskCreate(vPong, "pong", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  configASSERT(err == pdPASS);
+  err = xTaskCreate(vPing, "ping", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  configASSERT(err == pdPASS);
+
+  benchStart(&xBench);
+  benchWaitForTasks(2);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, PING_PONG_ROUNDS * 2);
+}
+
+static void runContended(const char* scenario, uint32_t rounds, TickType_t holdTicks)
+{
+  ulRounds = rounds;
+  xHoldTicks = holdTicks;
+
+  for (uint32_t i = 0; i < WORKER_COUNT; i++)
+  {
+    BaseType_t err = xTaskCreate(vWorker, "worker", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+    configASSERT(err == pdPASS);
+  }
+
+  benchStart(&xBench);
+  benchWaitForTasks(WORKER_COUNT);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, rounds * WORKER_COUNT);
+}
+
+// The contention report of the registered objects, with the counters on
+static void printReport(void)
+{
+#if (configUSE_QUEUE_CONTENTION_STATS == 1)
+  static char report[1024];
+
+  vQueueListContention(report, sizeof(report));
+  printf("%s", report);
+#endif
+}
+
+// TASKS
+
+static void vPing(void* pvParam)
+{
+  for (uint32_t i = 0; i < PING_PONG_ROUNDS; i++)
+  {
+    uint64_t start = benchNowNs();
+    xSemaphoreGive(xPingSem);
+    xSemaphoreTake(xPongSem, portMAX_DELAY);
+    benchSample(&xBench, (benchNowNs() - start) / 2);
+  }
+  benchTaskDone();
+}
+
+static void vPong(void* pvParam)
+{
+  for (uint32_t i = 0; i < PING_PONG_ROUNDS; i++)
+  {
+    xSemaphoreTake(xPingSem, portMAX_DELAY);
+    xSemaphoreGive(xPongSem);
+  }
+  benchTaskDone();
+}
+
+static void vWorker(void* pvParam)
+{
+  for (uint32_t i = 0; i < ulRounds; i++)
+  {
+    uint64_t start = benchNowNs();
+    xSemaphoreTake(xSharedMutex, portMAX_DELAY);
+    if (xHoldTicks > 0)
+    {
+      vTaskDelay(xHoldTicks);
+    }
+    else
+    {
+      taskYIELD();  // let the other workers find it taken
+    }
+    xSemaphoreGive(xSharedMutex);
+    benchSample(&xBench, benchNowNs() - start);
+  }
+  benchTaskDone();
+}
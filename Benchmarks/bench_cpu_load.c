@@ -0,0 +1,223 @@
+/*
+Run time statistics benchmark:
+
+  What adding up run time and counting switch-ins adds to a context switch,
+  and what it costs to read the counters back. The same program is built
+  with and without the statistics - the title says which:
+
+    stats on    default
+    stats off   cmake -DSIMULATOR_RUN_TIME_STATS=OFF
+
+  semaphore ping-pong:
+    Two tasks of equal priority hand a binary semaphore token back and
+    forth. One op is one handoff, one context switch, which reads the clock
+    and updates the counters with the statistics on.
+
+  run time snapshot:
+    uxTaskGetRunTimeSnapshot() with BLOCKED_TASKS tasks blocked besides the
+    runner and the idle and timer tasks. Each sample is the mean over
+    BATCH_SIZE of them.
+
+  cpu load sample:
+    cpuLoadSample() on the same tasks, the snapshot plus the figures.
+
+  system state:
+    uxTaskGetSystemState() on the same tasks for comparison, which suspends
+    the scheduler and scans every stack - only with the trace facility,
+    cmake -DSIMULATOR_TRACE=ON.
+
+  With the statistics on, the CPU load over the ping-pong follows its row.
+  The two tasks are deleted by then, so they only count towards the totals.
+
+  Compare each row against the same row of the other build.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "cpu_load.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define BLOCKED_TASKS     16
+#define BATCH_SIZE        64
+#define SNAPSHOT_COUNT    16384
+#define PING_PONG_ROUNDS  20000
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+#define STATS "stats on"
+#else
+#define STATS "stats off"
+#endif
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static SemaphoreHandle_t xPingSem, xPongSem, xReleaseSem;
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+static CpuLoad_t xLoad;
+static TaskRunTime_t xRunTimes[BLOCKED_TASKS + 8];
+#endif
+#if (configUSE_TRACE_FACILITY == 1)
+static TaskStatus_t xStatuses[BLOCKED_TASKS + 8];
+#endif
+
+static void runPingPong(const char* scenario);
+static void runReadBack(void);
+static void runBatched(const char* scenario, void (*read)(void));
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+static void readSnapshot(void);
+static void readCpuLoad(void);
+#endif
+#if (configUSE_TRACE_FACILITY == 1)
+static void readSystemState(void);
+#endif
+
+static void vPing(void* pvParam);
+static void vPong(void* pvParam);
+static void vBlocked(void* pvParam);
+
+static void benchmarks(void)
+{
+  benchInit(&xBench, SNAPSHOT_COUNT / BATCH_SIZE + PING_PONG_ROUNDS);
+
+  benchPrintHeader("run time statistics (" STATS ")");
+  runPingPong("semaphore ping-pong");
+  runReadBack();
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runPingPong(const char* scenario)
+{
+  xPingSem = xSemaphoreCreateBinary();
+  xPongSem = xSemaphoreCreateBinary();
+  configASSERT(xPingSem != NULL && xPongSem != NULL);
+#if (configGENERATE_RUN_TIME_STATS == 1)
+  cpuLoadSample(&xLoad);  // the CPU load from here
+#endif
+
+  BaseType_t err = xTaskCreate(vPong, "pong", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  configASSERT(err == pdPASS);
+  err = xTaskCreate(vPing, "ping", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  configASSERT(err == pdPASS);
+
+  benchStart(&xBench);
+  benchWaitForTasks(2);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, PING_PONG_ROUNDS * 2);
+#if (configGENERATE_RUN_TIME_STATS == 1)
+  cpuLoadSample(&xLoad);
+  cpuLoadPrint(&xLoad);
+#endif
+
+  vSemaphoreDelete(xPingSem);
+  vSemaphoreDelete(xPongSem);
+}
+
+// The ways of reading the counters back, with BLOCKED_TASKS tasks to read
+static void runReadBack(void)
+{
+  xReleaseSem = xSemaphoreCreateCounting(BLOCKED_TASKS, 0);
+  configASSERT(xReleaseSem != NULL);
+
+  for (uint32_t i = 0; i < BLOCKED_TASKS; i++)
+  {
+    BaseType_t err = xTaskCreate(vBlocked, "blocked", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+    configASSERT(err == pdPASS);
+  }
+  vTaskDelay(1);  // let them all block
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+  runBatched("run time snapshot", readSnapshot);
+  runBatched("cpu load sample", readCpuLoad);
+#endif
+#if (configUSE_TRACE_FACILITY == 1)
+  runBatched("system state", readSystemState);
+#endif
+
+  for (uint32_t i = 0; i < BLOCKED_TASKS; i++)
+  {
+    xSemaphoreGive(xReleaseSem);
+  }
+  benchWaitForTasks(BLOCKED_TASKS);
+  vSemaphoreDelete(xReleaseSem);
+}
+
+static void runBatched(const char* scenario, void (*read)(void))
+{
+  benchStart(&xBench);
+  for (uint32_t done = 0; done < SNAPSHOT_COUNT; done += BATCH_SIZE)
+  {
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    {
+      read();
+    }
+    benchSample(&xBench, (benchNowNs() - start) / BATCH_SIZE);
+  }
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, SNAPSHOT_COUNT);
+}
+
+// READS
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+static void readSnapshot(void)
+{
+  RunTimeSnapshot_t snapshot;
+  uxTaskGetRunTimeSnapshot(xRunTimes, BLOCKED_TASKS + 8, &snapshot);
+}
+
+static void readCpuLoad(void)
+{
+  cpuLoadSample(&xLoad);
+}
+#endif
+
+#if (configUSE_TRACE_FACILITY == 1)
+static void readSystemState(void)
+{
+  uxTaskGetSystemState(xStatuses, BLOCKED_TASKS + 8, NULL);
+}
+#endif
+
+// TASKS
+
+static void vPing(void* pvParam)
+{
+  for (uint32_t i = 0; i < PING_PONG_ROUNDS; i++)
+  {
+    uint64_t start = benchNowNs();
+    xSemaphoreGive(xPingSem);
+    xSemaphoreTake(xPongSem, portMAX_DELAY);
+    benchSample(&xBench, (benchNowNs() - start) / 2);
+  }
+  benchTaskDone();
+}
+
+static void vPong(void* pvParam)
+{
+  for (uint32_t i = 0; i < PING_PONG_ROUNDS; i++)
+  {
+    xSemaphoreTake(xPingSem, portMAX_DELAY);
+    xSemaphoreGive(xPongSem);
+  }
+  benchTaskDone();
+}
+
+static void vBlocked(void* pvParam)
+{
+  xSemaphoreTake(xReleaseSem, portMAX_DELAY);
+  benchTaskDone();
+}
@@ -0,0 +1,192 @@
+/*
+Delayed task benchmark:
+
+  N background tasks are blocked with a timeout while the kernel's delayed
+  task bookkeeping is measured. The same program is built against either
+  implementation - the title says which:
+
+    sorted list    default, the delayed list kept in wake time order
+    timing wheel   cmake -DSIMULATOR_TIMING_WHEEL=ON
+
+  block + wake:
+    The N tasks wait with timeouts of several seconds. Two tasks of their own
+    priority hand a notification back and forth, each waiting for it with a
+    random timeout in the same range, so every op blocks two tasks with a
+    timeout and unblocks two before it expires. The sorted list walks past
+    the tasks that wake earlier on every block.
+
+  tick:
+    The N tasks wait on random timeouts of 1 to 2N ticks, so a few expire on
+    every tick and block again. One op is one xTaskIncrementTick() call,
+    made directly from a task of the same priority in a critical section.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "task_random.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define PING_PRIORITY     2
+#define MAX_SLEEPERS      500
+#define PING_COUNT        20000
+#define TICK_COUNT        20000
+#define LONG_TIMEOUT_MIN  pdMS_TO_TICKS(20000)
+#define LONG_TIMEOUT_SPAN pdMS_TO_TICKS(40000)
+
+#if (configUSE_TIMING_WHEEL == 1)
+#define DELAYED_LISTS "timing wheel"
+#else
+#define DELAYED_LISTS "sorted list"
+#endif
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static TaskHandle_t xSleepers[MAX_SLEEPERS];
+static TaskHandle_t xPing;
+static TaskHandle_t xPong;
+static volatile BaseType_t xStop;
+static TickType_t xTimeoutSpan;
+
+static void runBlock(uint32_t sleepers);
+static void runTick(uint32_t sleepers);
+static void startSleepers(uint32_t sleepers, TickType_t minTimeout, TickType_t timeoutSpan);
+static void stopSleepers(uint32_t sleepers);
+static void vSleeperTask(void* pvParam);
+static void vPingTask(void* pvParam);
+static void vPongTask(void* pvParam);
+static void vTickTask(void* pvParam);
+
+static void benchmarks(void)
+{
+  static const uint32_t sleeperCounts[] = { 10, 100, MAX_SLEEPERS };
+
+  benchInit(&xBench, PING_COUNT > TICK_COUNT ? PING_COUNT : TICK_COUNT);
+
+  for (uint32_t i = 0; i < sizeof(sleeperCounts) / sizeof(sleeperCounts[0]); i++)
+  {
+    char title[64];
+
+    snprintf(title, sizeof(title), "%u delayed tasks (" DELAYED_LISTS ")", (unsigned)sleeperCounts[i]);
+    benchPrintHeader(title);
+    runBlock(sleeperCounts[i]);
+    runTick(sleeperCounts[i]);
+  }
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runBlock(uint32_t sleepers)
+{
+  startSleepers(sleepers, LONG_TIMEOUT_MIN, LONG_TIMEOUT_SPAN);
+
+  benchStart(&xBench);
+  xTaskCreate(vPongTask, "pong", BENCH_STACK_SIZE, NULL, PING_PRIORITY, &xPong);
+  xTaskCreate(vPingTask, "ping", BENCH_STACK_SIZE, NULL, PING_PRIORITY, &xPing);
+  benchWaitForDone(2);
+  benchStop(&xBench);
+
+  stopSleepers(sleepers);
+  benchReport("block + wake (timeout)", &xBench, PING_COUNT);
+}
+
+static void runTick(uint32_t sleepers)
+{
+  startSleepers(sleepers, 1, 2 * sleepers);
+
+  benchStart(&xBench);
+  xTaskCreate(vTickTask, "tick", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  benchWaitForDone(1);
+  benchStop(&xBench);
+
+  stopSleepers(sleepers);
+  benchReport("tick", &xBench, TICK_COUNT);
+}
+
+static void startSleepers(uint32_t sleepers, TickType_t minTimeout, TickType_t timeoutSpan)
+{
+  xStop = pdFALSE;
+  xTimeoutSpan = timeoutSpan;
+
+  for (uint32_t i = 0; i < sleepers; i++)
+  {
+    BaseType_t err = xTaskCreate(vSleeperTask, "sleeper", configMINIMAL_STACK_SIZE, (void*)(uintptr_t)minTimeout,
+                                 WORKER_PRIORITY, &xSleepers[i]);
+    configASSERT(err == pdPASS);
+  }
+
+  // let every sleeper block before measuring
+  vTaskDelay(pdMS_TO_TICKS(10));
+}
+
+static void stopSleepers(uint32_t sleepers)
+{
+  xStop = pdTRUE;
+  for (uint32_t i = 0; i < sleepers; i++)
+  {
+    xTaskNotifyGive(xSleepers[i]);
+  }
+  benchWaitForTasks(sleepers);
+}
+
+// TASKS
+
+static void vSleeperTask(void* pvParam)
+{
+  TickType_t minTimeout = (TickType_t)(uintptr_t)pvParam;
+
+  while (!xStop)
+  {
+    ulTaskNotifyTake(pdTRUE, minTimeout + randomRange(xTimeoutSpan));
+  }
+  benchTaskDone();
+}
+
+static void vPingTask(void* pvParam)
+{
+  for (uint32_t i = 0; i < PING_COUNT; i++)
+  {
+    uint64_t start = benchNowNs();
+    xTaskNotifyGive(xPong);
+    ulTaskNotifyTake(pdTRUE, LONG_TIMEOUT_MIN + randomRange(LONG_TIMEOUT_SPAN));
+    benchSample(&xBench, benchNowNs() - start);
+  }
+  benchTaskDone();
+}
+
+static void vPongTask(void* pvParam)
+{
+  for (uint32_t i = 0; i < PING_COUNT; i++)
+  {
+    ulTaskNotifyTake(pdTRUE, LONG_TIMEOUT_MIN + randomRange(LONG_TIMEOUT_SPAN));
+    xTaskNotifyGive(xPing);
+  }
+  benchTaskDone();
+}
+
+static void vTickTask(void* pvParam)
+{
+  for (uint32_t i = 0; i < TICK_COUNT; i++)
+  {
+    taskENTER_CRITICAL();
+    uint64_t start = benchNowNs();
+    xTaskIncrementTick();
+    uint64_t elapsed = benchNowNs() - start;
+    taskEXIT_CRITICAL();
+
+    benchSample(&xBench, elapsed);
+
+    // let the sleepers that woke block again
+    taskYIELD();
+  }
+  benchTaskDone();
+}
@@ -0,0 +1,161 @@
+/*
+Event group benchmark:
+
+  N background tasks are blocked on one event group, spread evenly across its
+  24 bits, while a task of their own priority sets bits one at a time. One op
+  is one xEventGroupSetBits() call, and each sample is the time that call
+  takes - it unblocks the tasks the bit releases, and the setter yields after
+  it so they can block again. The same program is built against either
+  implementation - the title says which:
+
+    bit index   default, blocked tasks kept on one list per bit
+    one list    cmake -DSIMULATOR_EVENT_GROUP_LIST=ON
+
+  any bit:
+    Each task waits for one bit, clearing it on exit, and the setter sets the
+    bits in turn, so every set unblocks the N / 24 tasks waiting for it. The
+    single list tests every blocked task on every set.
+
+  all bits:
+    Each task waits for both bits of one of 12 pairs, clearing them on exit,
+    and the setter sets the first bit of a pair then the second. The first set
+    unblocks nothing, the second the N / 12 tasks waiting for the pair. With
+    the index, the tasks the first set does not release move to the list of
+    the other bit.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+#include "atomic.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define EVENT_BITS        24
+#define MAX_WAITERS       200
+#define SET_COUNT         24000
+#define ALL_EVENT_BITS    ((EventBits_t)((1UL << EVENT_BITS) - 1))
+
+#if (configUSE_EVENT_GROUP_WAITER_INDEX == 1)
+#define WAITER_LISTS "bit index"
+#else
+#define WAITER_LISTS "one list"
+#endif
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static EventGroupHandle_t xEventGroup;
+static BaseType_t xWaitForPairs;
+static volatile BaseType_t xStop;
+static uint32_t waitersLeft;
+
+static void runSet(const char* scenario, uint32_t waiters, BaseType_t pairs);
+static void vWaiterTask(void* pvParam);
+static void vSetterTask(void* pvParam);
+
+static void benchmarks(void)
+{
+  static const uint32_t waiterCounts[] = { 8, 24, 64, MAX_WAITERS };
+
+  benchInit(&xBench, SET_COUNT);
+
+  for (uint32_t i = 0; i < sizeof(waiterCounts) / sizeof(waiterCounts[0]); i++)
+  {
+    char title[64];
+
+    snprintf(title, sizeof(title), "%u waiting tasks (" WAITER_LISTS ")", (unsigned)waiterCounts[i]);
+    benchPrintHeader(title);
+    runSet("any bit", waiterCounts[i], pdFALSE);
+    runSet("all bits", waiterCounts[i], pdTRUE);
+  }
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runSet(const char* scenario, uint32_t waiters, BaseType_t pairs)
+{
+  xEventGroup = xEventGroupCreate();
+  configASSERT(xEventGroup != NULL);
+  xWaitForPairs = pairs;
+  xStop = pdFALSE;
+  waitersLeft = waiters;
+
+  for (uint32_t i = 0; i < waiters; i++)
+  {
+    BaseType_t err = xTaskCreate(vWaiterTask, "waiter", configMINIMAL_STACK_SIZE, (void*)(uintptr_t)i,
+                                 WORKER_PRIORITY, NULL);
+    configASSERT(err == pdPASS);
+  }
+
+  // let every waiter block before measuring
+  vTaskDelay(pdMS_TO_TICKS(10));
+
+  benchStart(&xBench);
+  xTaskCreate(vSetterTask, "setter", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  benchWaitForDone(1);
+  benchStop(&xBench);
+
+  // setting every bit releases every waiter, but one that has not blocked
+  // again yet needs another go
+  xStop = pdTRUE;
+  while (waitersLeft > 0)
+  {
+    xEventGroupSetBits(xEventGroup, ALL_EVENT_BITS);
+    vTaskDelay(1);
+  }
+  benchWaitForTasks(waiters);
+  benchReport(scenario, &xBench, SET_COUNT);
+
+  vEventGroupDelete(xEventGroup);
+}
+
+// TASKS
+
+static void vWaiterTask(void* pvParam)
+{
+  uint32_t waiter = (uint32_t)(uintptr_t)pvParam;
+  EventBits_t bits;
+
+  if (xWaitForPairs)
+  {
+    bits = (EventBits_t)3 << (2 * (waiter % (EVENT_BITS / 2)));
+  }
+  else
+  {
+    bits = (EventBits_t)1 << (waiter % EVENT_BITS);
+  }
+
+  while (!xStop)
+  {
+    xEventGroupWaitBits(xEventGroup, bits, pdTRUE, xWaitForPairs, portMAX_DELAY);
+  }
+  Atomic_Decrement_u32(&waitersLeft);
+  benchTaskDone();
+}
+
+static void vSetterTask(void* pvParam)
+{
+  for (uint32_t i = 0; i < SET_COUNT; i++)
+  {
+    // the bits in turn, which with pairs is the first bit of each pair then
+    // the second
+    EventBits_t bit = (EventBits_t)1 << (i % EVENT_BITS);
+
+    uint64_t start = benchNowNs();
+    xEventGroupSetBits(xEventGroup, bit);
+    benchSample(&xBench, benchNowNs() - start);
+
+    // let the waiters that were released block again
+    taskYIELD();
+  }
+  benchTaskDone();
+}
@@ -0,0 +1,226 @@
+/*
+Leader/follower pairing benchmark:
+
+  LEADER_COUNT leaders and as many followers pair up over and over, dance,
+  and rendezvous after the dance, as in exc_3.8_semaphore-queue. One op is
+  one pair formed, danced and finished.
+
+  Dance floor mutex:
+    The exercise's scheme. A counting semaphore guards the dance floor and
+    the queue counters, a binary semaphore per class is the queue, and two
+    more binary semaphores make the post-dance rendezvous. Only one pair is
+    on the floor at a time.
+
+  Exchanger:
+    xExchangerPair() pairs the longest waiting leader and follower and swaps
+    their task handles, the post-dance rendezvous is a task notification each
+    way, and the leader calls vExchangerPairDone(). The exchanger is created
+    for 1 pair and for LEADER_COUNT pairs on the floor at once.
+
+  With an instant dance the rows show the cost of pairing. With a dance of
+  one tick they show what letting more than one pair on the floor buys.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "exchanger.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define LEADER_COUNT      4
+#define FOLLOWER_COUNT    LEADER_COUNT
+#define INSTANT_PAIRS     5000    // pairs per leader, instant dance
+#define TICK_PAIRS        100     // pairs per leader, one tick dance
+
+#define STR(x)  #x
+#define XSTR(x) STR(x)
+
+typedef enum
+{
+  SCHEME_MUTEX,
+  SCHEME_EXCHANGER
+} Scheme_t;
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static Scheme_t eScheme;
+static uint32_t pairsPerTask;
+static TickType_t xDanceTicks;
+
+// Dance floor mutex scheme
+static SemaphoreHandle_t xDanceFloorMutex;
+static SemaphoreHandle_t xALeaderIsAvailable;
+static SemaphoreHandle_t xAFollowerIsAvailable;
+static SemaphoreHandle_t xRandezvousFromLeader;
+static SemaphoreHandle_t xRandezvousFromFollower;
+static UBaseType_t leaderCount;
+static UBaseType_t followerCount;
+
+// Exchanger scheme
+static ExchangerHandle_t xExchanger;
+
+static void runPairing(const char* scenario, Scheme_t scheme, UBaseType_t maxPairs, uint32_t pairs, TickType_t danceTicks);
+static void vLeader(void* pvParam);
+static void vFollower(void* pvParam);
+static void pairWithMutex(BaseType_t isLeader);
+static void pairWithExchanger(BaseType_t isLeader);
+static void dance(void);
+
+static void benchmarks(void)
+{
+  benchInit(&xBench, LEADER_COUNT * INSTANT_PAIRS);
+
+  benchPrintHeader("Leader/follower pairing (" XSTR(LEADER_COUNT) " + " XSTR(FOLLOWER_COUNT) " tasks, instant dance)");
+  runPairing("dance floor mutex", SCHEME_MUTEX, 1, INSTANT_PAIRS, 0);
+  runPairing("exchanger, 1 pair", SCHEME_EXCHANGER, 1, INSTANT_PAIRS, 0);
+  runPairing("exchanger, " XSTR(LEADER_COUNT) " pairs", SCHEME_EXCHANGER, LEADER_COUNT, INSTANT_PAIRS, 0);
+
+  benchPrintHeader("Leader/follower pairing (" XSTR(LEADER_COUNT) " + " XSTR(FOLLOWER_COUNT) " tasks, one tick dance)");
+  runPairing("dance floor mutex", SCHEME_MUTEX, 1, TICK_PAIRS, 1);
+  runPairing("exchanger, 1 pair", SCHEME_EXCHANGER, 1, TICK_PAIRS, 1);
+  runPairing("exchanger, " XSTR(LEADER_COUNT) " pairs", SCHEME_EXCHANGER, LEADER_COUNT, TICK_PAIRS, 1);
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runPairing(const char* scenario, Scheme_t scheme, UBaseType_t maxPairs, uint32_t pairs, TickType_t danceTicks)
+{
+  eScheme = scheme;
+  pairsPerTask = pairs;
+  xDanceTicks = danceTicks;
+  leaderCount = 0;
+  followerCount = 0;
+
+  xDanceFloorMutex = xSemaphoreCreateCounting(1, 1);
+  xALeaderIsAvailable = xSemaphoreCreateBinary();
+  xAFollowerIsAvailable = xSemaphoreCreateBinary();
+  xRandezvousFromLeader = xSemaphoreCreateBinary();
+  xRandezvousFromFollower = xSemaphoreCreateBinary();
+  xExchanger = xExchangerCreate(maxPairs);
+
+  for (uint32_t i = 0; i < LEADER_COUNT; i++)
+  {
+    xTaskCreate(vLeader, "lead", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+    xTaskCreate(vFollower, "follow", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  }
+
+  benchStart(&xBench);
+  benchWaitForTasks(LEADER_COUNT + FOLLOWER_COUNT);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, LEADER_COUNT * pairs);
+
+  vSemaphoreDelete(xDanceFloorMutex);
+  vSemaphoreDelete(xALeaderIsAvailable);
+  vSemaphoreDelete(xAFollowerIsAvailable);
+  vSemaphoreDelete(xRandezvousFromLeader);
+  vSemaphoreDelete(xRandezvousFromFollower);
+  vExchangerDelete(xExchanger);
+}
+
+// TASKS
+
+static void vLeader(void* pvParam)
+{
+  for (uint32_t i = 0; i < pairsPerTask; i++)
+  {
+    uint64_t start = benchNowNs();
+    if (eScheme == SCHEME_MUTEX)
+    {
+      pairWithMutex(pdTRUE);
+    }
+    else
+    {
+      pairWithExchanger(pdTRUE);
+    }
+    benchSample(&xBench, benchNowNs() - start);
+  }
+  benchTaskDone();
+}
+
+static void vFollower(void* pvParam)
+{
+  for (uint32_t i = 0; i < pairsPerTask; i++)
+  {
+    if (eScheme == SCHEME_MUTEX)
+    {
+      pairWithMutex(pdFALSE);
+    }
+    else
+    {
+      pairWithExchanger(pdFALSE);
+    }
+  }
+  benchTaskDone();
+}
+
+// SCHEMES
+
+static void pairWithMutex(BaseType_t isLeader)
+{
+  UBaseType_t* myCount = isLeader ? &leaderCount : &followerCount;
+  UBaseType_t* otherCount = isLeader ? &followerCount : &leaderCount;
+  SemaphoreHandle_t xMyQueue = isLeader ? xALeaderIsAvailable : xAFollowerIsAvailable;
+  SemaphoreHandle_t xOtherQueue = isLeader ? xAFollowerIsAvailable : xALeaderIsAvailable;
+
+  xSemaphoreTake(xDanceFloorMutex, portMAX_DELAY);
+  if (*otherCount > 0)
+  {
+    (*otherCount)--;
+    xSemaphoreGive(xMyQueue);
+  }
+  else
+  {
+    (*myCount)++;
+    xSemaphoreGive(xDanceFloorMutex);
+    xSemaphoreTake(xOtherQueue, portMAX_DELAY);
+  }
+
+  dance();
+
+  if (isLeader)
+  {
+    xSemaphoreGive(xRandezvousFromLeader);
+    xSemaphoreTake(xRandezvousFromFollower, portMAX_DELAY);
+    xSemaphoreGive(xDanceFloorMutex);
+  }
+  else
+  {
+    xSemaphoreGive(xRandezvousFromFollower);
+    xSemaphoreTake(xRandezvousFromLeader, portMAX_DELAY);
+  }
+}
+
+static void pairWithExchanger(BaseType_t isLeader)
+{
+  void* partner;
+
+  xExchangerPair(xExchanger, isLeader ? exchangerLEADER : exchangerFOLLOWER,
+                 xTaskGetCurrentTaskHandle(), &partner, portMAX_DELAY);
+
+  dance();
+
+  xTaskNotifyGive((TaskHandle_t)partner);
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  if (isLeader)
+  {
+    vExchangerPairDone(xExchanger);
+  }
+}
+
+static void dance(void)
+{
+  if (xDanceTicks > 0)
+  {
+    vTaskDelay(xDanceTicks);
+  }
+}
@@ -0,0 +1,371 @@
+/*
+Kernel IPC latency/throughput benchmark:
+
+  The exercises hand control between tasks with queues, binary and counting
+  semaphores, mutexes and task notifications. This measures what each
+  handoff costs so the cheapest primitive can be picked for the job.
+
+  Ping-pong:
+    Two tasks of equal priority bounce a token back and forth. One op is one
+    handoff (half a round trip), so every op is a context switch.
+
+  Fan-in:
+    PRODUCER_COUNT producers feed a single consumer. One op is one item
+    received. Queue samples are the latency from send to receive, semaphore
+    and notification samples are the interval between consecutive takes.
+
+  Fan-out:
+    A single producer feeds CONSUMER_COUNT consumers. One op is one item
+    received, samples are the latency from send to receive.
+
+  Event group sync:
+    SYNC_TASK_COUNT tasks meet at xEventGroupSync(). One op is one round.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define PING_PONG_ROUNDS  20000
+#define PRODUCER_COUNT    4
+#define CONSUMER_COUNT    4
+#define ITEMS_PER_TASK    5000
+#define FAN_QUEUE_LENGTH  8
+#define SYNC_TASK_COUNT   4
+#define SYNC_ROUNDS       10000
+
+#define STR(x)  #x
+#define XSTR(x) STR(x)
+
+typedef enum
+{
+  PRIMITIVE_QUEUE,
+  PRIMITIVE_SEMAPHORE,
+  PRIMITIVE_NOTIFICATION,
+  PRIMITIVE_STREAM_BUFFER,
+  PRIMITIVE_EVENT_GROUP
+} Primitive_t;
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static Primitive_t ePrimitive;
+static QueueHandle_t xPing, xPong;
+static SemaphoreHandle_t xPingSem, xPongSem;
+static StreamBufferHandle_t xPingStream, xPongStream;
+static EventGroupHandle_t xSyncGroup;
+static TaskHandle_t xPingTask, xPongTask, xConsumerTask;
+static uint64_t lastTakeNs;
+
+static void runPingPong(const char* scenario, Primitive_t primitive);
+static void runFanIn(const char* scenario, Primitive_t primitive);
+static void runFanOut(const char* scenario);
+static void runSync(const char* scenario, uint32_t taskCount);
+
+static void vPing(void* pvParam);
+static void vPong(void* pvParam);
+static void vProducer(void* pvParam);
+static void vConsumer(void* pvParam);
+static void vFanOutProducer(void* pvParam);
+static void vFanOutConsumer(void* pvParam);
+static void vSyncTask(void* pvParam);
+
+static void sendToken(Primitive_t primitive, uint32_t direction);
+static void receiveToken(Primitive_t primitive, uint32_t direction);
+static void safeSample(uint64_t ns);
+
+static void benchmarks(void)
+{
+  benchInit(&xBench, PING_PONG_ROUNDS * 2);
+
+  benchPrintHeader("IPC ping-pong (2 tasks, equal priority)");
+  runPingPong("queue send/receive", PRIMITIVE_QUEUE);
+  runPingPong("binary semaphore give/take", PRIMITIVE_SEMAPHORE);
+  runPingPong("task notify give/take", PRIMITIVE_NOTIFICATION);
+  runPingPong("stream buffer send/receive (4 bytes)", PRIMITIVE_STREAM_BUFFER);
+  runSync("event group sync (2 tasks, per round)", 2);
+
+  benchPrintHeader("IPC fan-in (" XSTR(PRODUCER_COUNT) " producers, 1 consumer)");
+  runFanIn("queue send/receive", PRIMITIVE_QUEUE);
+  runFanIn("counting semaphore give/take", PRIMITIVE_SEMAPHORE);
+  runFanIn("task notify give/take", PRIMITIVE_NOTIFICATION);
+
+  benchPrintHeader("IPC fan-out (1 producer, " XSTR(CONSUMER_COUNT) " consumers)");
+  runFanOut("queue send/receive");
+  runSync("event group sync (" XSTR(SYNC_TASK_COUNT) " tasks, per round)", SYNC_TASK_COUNT);
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runPingPong(const char* scenario, Primitive_t primitive)
+{
+  ePrimitive = primitive;
+  xPing = xQueueCreate(1, sizeof(uint32_t));
+  xPong = xQueueCreate(1, sizeof(uint32_t));
+  xPingSem = xSemaphoreCreateBinary();
+  xPongSem = xSemaphoreCreateBinary();
+  xPingStream = xStreamBufferCreate(sizeof(uint32_t) * 4, 1);
+  xPongStream = xStreamBufferCreate(sizeof(uint32_t) * 4, 1);
+
+  xTaskCreate(vPong, "pong", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, &xPongTask);
+  xTaskCreate(vPing, "ping", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, &xPingTask);
+
+  benchStart(&xBench);
+  benchWaitForTasks(2);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, PING_PONG_ROUNDS * 2);
+
+  vQueueDelete(xPing);
+  vQueueDelete(xPong);
+  vSemaphoreDelete(xPingSem);
+  vSemaphoreDelete(xPongSem);
+  vStreamBufferDelete(xPingStream);
+  vStreamBufferDelete(xPongStream);
+}
+
+static void runFanIn(const char* scenario, Primitive_t primitive)
+{
+  ePrimitive = primitive;
+  xPing = xQueueCreate(FAN_QUEUE_LENGTH, sizeof(uint64_t));
+  xPingSem = xSemaphoreCreateCounting(PRODUCER_COUNT * ITEMS_PER_TASK, 0);
+  lastTakeNs = 0;
+
+  xTaskCreate(vConsumer, "cons", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, &xConsumerTask);
+  for (uint32_t i = 0; i < PRODUCER_COUNT; i++)
+  {
+    xTaskCreate(vProducer, "prod", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  }
+
+  benchStart(&xBench);
+  benchWaitForTasks(PRODUCER_COUNT + 1);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, PRODUCER_COUNT * ITEMS_PER_TASK);
+
+  vQueueDelete(xPing);
+  vSemaphoreDelete(xPingSem);
+}
+
+static void runFanOut(const char* scenario)
+{
+  xPing = xQueueCreate(FAN_QUEUE_LENGTH, sizeof(uint64_t));
+
+  for (uint32_t i = 0; i < CONSUMER_COUNT; i++)
+  {
+    xTaskCreate(vFanOutConsumer, "cons", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  }
+  xTaskCreate(vFanOutProducer, "prod", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+
+  benchStart(&xBench);
+  benchWaitForTasks(CONSUMER_COUNT + 1);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, CONSUMER_COUNT * ITEMS_PER_TASK);
+
+  vQueueDelete(xPing);
+}
+
+static void runSync(const char* scenario, uint32_t taskCount)
+{
+  xSyncGroup = xEventGroupCreate();
+
+  for (uint32_t i = 0; i < taskCount; i++)
+  {
+    // parameter packs the task's own bit and the bits of everyone
+    uint32_t bits = (1UL << i) | (((1UL << taskCount) - 1) << 8);
+    xTaskCreate(vSyncTask, "sync", BENCH_STACK_SIZE, (void*)(uintptr_t)bits, WORKER_PRIORITY, NULL);
+  }
+
+  benchStart(&xBench);
+  benchWaitForTasks(taskCount);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, SYNC_ROUNDS);
+
+  vEventGroupDelete(xSyncGroup);
+}
+
+// TASKS
+
+static void vPing(void* pvParam)
+{
+  for (uint32_t i = 0; i < PING_PONG_ROUNDS; i++)
+  {
+    uint64_t start = benchNowNs();
+    sendToken(ePrimitive, 0);
+    receiveToken(ePrimitive, 1);
+    // a round trip is two handoffs
+    uint64_t half = (benchNowNs() - start) / 2;
+    benchSample(&xBench, half);
+    benchSample(&xBench, half);
+  }
+  benchTaskDone();
+}
+
+static void vPong(void* pvParam)
+{
+  for (uint32_t i = 0; i < PING_PONG_ROUNDS; i++)
+  {
+    receiveToken(ePrimitive, 0);
+    sendToken(ePrimitive, 1);
+  }
+  benchTaskDone();
+}
+
+static void vProducer(void* pvParam)
+{
+  for (uint32_t i = 0; i < ITEMS_PER_TASK; i++)
+  {
+    if (ePrimitive == PRIMITIVE_QUEUE)
+    {
+      uint64_t sentAt = benchNowNs();
+      xQueueSend(xPing, &sentAt, portMAX_DELAY);
+    }
+    else if (ePrimitive == PRIMITIVE_SEMAPHORE)
+    {
+      xSemaphoreGive(xPingSem);
+    }
+    else
+    {
+      xTaskNotifyGive(xConsumerTask);
+    }
+  }
+  benchTaskDone();
+}
+
+static void vConsumer(void* pvParam)
+{
+  for (uint32_t i = 0; i < PRODUCER_COUNT * ITEMS_PER_TASK; i++)
+  {
+    if (ePrimitive == PRIMITIVE_QUEUE)
+    {
+      uint64_t sentAt;
+      xQueueReceive(xPing, &sentAt, portMAX_DELAY);
+      benchSample(&xBench, benchNowNs() - sentAt);
+    }
+    else
+    {
+      if (ePrimitive == PRIMITIVE_SEMAPHORE)
+      {
+        xSemaphoreTake(xPingSem, portMAX_DELAY);
+      }
+      else
+      {
+        ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+      }
+      uint64_t now = benchNowNs();
+      if (lastTakeNs != 0)
+      {
+        benchSample(&xBench, now - lastTakeNs);
+      }
+      lastTakeNs = now;
+    }
+  }
+  benchTaskDone();
+}
+
+static void vFanOutProducer(void* pvParam)
+{
+  for (uint32_t i = 0; i < CONSUMER_COUNT * ITEMS_PER_TASK; i++)
+  {
+    uint64_t sentAt = benchNowNs();
+    xQueueSend(xPing, &sentAt, portMAX_DELAY);
+  }
+  benchTaskDone();
+}
+
+static void vFanOutConsumer(void* pvParam)
+{
+  for (uint32_t i = 0; i < ITEMS_PER_TASK; i++)
+  {
+    uint64_t sentAt;
+    xQueueReceive(xPing, &sentAt, portMAX_DELAY);
+    safeSample(benchNowNs() - sentAt);
+  }
+  benchTaskDone();
+}
+
+static void vSyncTask(void* pvParam)
+{
+  uint32_t bits = (uint32_t)(uintptr_t)pvParam;
+  EventBits_t myBit = bits & 0xFF;
+  EventBits_t allBits = bits >> 8;
+
+  for (uint32_t i = 0; i < SYNC_ROUNDS; i++)
+  {
+    uint64_t start = benchNowNs();
+    xEventGroupSync(xSyncGroup, myBit, allBits, portMAX_DELAY);
+    if (myBit == 1)
+    {
+      // one task speaks for the round
+      benchSample(&xBench, benchNowNs() - start);
+    }
+  }
+  benchTaskDone();
+}
+
+// HELPER FUNCTIONS
+
+static void sendToken(Primitive_t primitive, uint32_t direction)
+{
+  uint32_t token = direction;
+
+  switch (primitive)
+  {
+    case PRIMITIVE_QUEUE:
+      xQueueSend(direction ? xPong : xPing, &token, portMAX_DELAY);
+      break;
+    case PRIMITIVE_SEMAPHORE:
+      xSemaphoreGive(direction ? xPongSem : xPingSem);
+      break;
+    case PRIMITIVE_NOTIFICATION:
+      xTaskNotifyGive(direction ? xPingTask : xPongTask);
+      break;
+    case PRIMITIVE_STREAM_BUFFER:
+      xStreamBufferSend(direction ? xPongStream : xPingStream, &token, sizeof(token), portMAX_DELAY);
+      break;
+    default:
+      configASSERT(0);
+  }
+}
+
+static void receiveToken(Primitive_t primitive, uint32_t direction)
+{
+  uint32_t token;
+
+  switch (primitive)
+  {
+    case PRIMITIVE_QUEUE:
+      xQueueReceive(direction ? xPong : xPing, &token, portMAX_DELAY);
+      break;
+    case PRIMITIVE_SEMAPHORE:
+      xSemaphoreTake(direction ? xPongSem : xPingSem, portMAX_DELAY);
+      break;
+    case PRIMITIVE_NOTIFICATION:
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      break;
+    case PRIMITIVE_STREAM_BUFFER:
+      xStreamBufferReceive(direction ? xPongStream : xPingStream, &token, sizeof(token), portMAX_DELAY);
+      break;
+    default:
+      configASSERT(0);
+  }
+}
+
+static void safeSample(uint64_t ns)
+{
+  // several tasks sample into the same bench
+  taskENTER_CRITICAL();
+  benchSample(&xBench, ns);
+  taskEXIT_CRITICAL();
+}
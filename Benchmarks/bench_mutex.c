@@ -0,0 +1,136 @@
+/*
+Mutex benchmark:
+
+  Tasks of equal priority take a mutex, add one to a shared counter and give
+  it back. One op is one take and give, and each sample is the mean over
+  BATCH_SIZE of them on one task's side. The same program is built against
+  either implementation - the title says which:
+
+    fast path   default, an uncontended take or give is one compare-and-swap
+    slow path   cmake -DSIMULATOR_MUTEX_SLOW_PATH=ON, every take and give
+                runs in a critical section
+
+  uncontended:
+    One task takes and gives the mutex, as the exercises do with a lock that
+    guards a counter or a debug log.
+
+  uncontended, recursive:
+    As above with a recursive mutex, taken twice and given twice.
+
+  contended:
+    TASK_COUNT tasks share the mutex and each yields while holding it, so the
+    others block on it and every give has a task to unblock - the fast path
+    only costs its failed compare-and-swap here.
+
+  A critical section on the simulator costs two system calls, so the
+  uncontended rows mostly show those being saved.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define TASK_COUNT        4
+#define BATCH_SIZE        16
+#define OP_COUNT          256000
+#define CONTENDED_OPS     32000
+
+#if (configUSE_MUTEX_FAST_PATH == 1)
+#define MUTEX_PATH "fast path"
+#else
+#define MUTEX_PATH "slow path"
+#endif
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static SemaphoreHandle_t xMutex;
+static BaseType_t xRecursive;
+static BaseType_t xYieldWhileHeld;
+static uint32_t opsPerTask;
+static uint32_t counter;
+
+static void runLock(const char* scenario, uint32_t tasks, BaseType_t recursive, BaseType_t yield, uint32_t ops);
+static void vWorkerTask(void* pvParam);
+
+static void benchmarks(void)
+{
+  benchInit(&xBench, OP_COUNT / BATCH_SIZE);
+
+  benchPrintHeader("take and give (" MUTEX_PATH ")");
+  runLock("uncontended", 1, pdFALSE, pdFALSE, OP_COUNT);
+  runLock("uncontended, recursive", 1, pdTRUE, pdFALSE, OP_COUNT);
+  runLock("contended", TASK_COUNT, pdFALSE, pdTRUE, CONTENDED_OPS);
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runLock(const char* scenario, uint32_t tasks, BaseType_t recursive, BaseType_t yield, uint32_t ops)
+{
+  xRecursive = recursive;
+  xYieldWhileHeld = yield;
+  xMutex = recursive ? xSemaphoreCreateRecursiveMutex() : xSemaphoreCreateMutex();
+  configASSERT(xMutex != NULL);
+  opsPerTask = ops / tasks;
+  counter = 0;
+
+  benchStart(&xBench);
+  for (uint32_t i = 0; i < tasks; i++)
+  {
+    BaseType_t err = xTaskCreate(vWorkerTask, "worker", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+    configASSERT(err == pdPASS);
+  }
+  benchWaitForTasks(tasks);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, ops);
+
+  // every op added one while holding the mutex
+  configASSERT(counter == opsPerTask * tasks);
+  configASSERT(uxSemaphoreGetCount(xMutex) == 1);
+  printf("  %u increments\n", (unsigned)counter);
+
+  vSemaphoreDelete(xMutex);
+}
+
+// TASKS
+
+static void vWorkerTask(void* pvParam)
+{
+  for (uint32_t done = 0; done < opsPerTask; done += BATCH_SIZE)
+  {
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    {
+      if (xRecursive)
+      {
+        xSemaphoreTakeRecursive(xMutex, portMAX_DELAY);
+        xSemaphoreTakeRecursive(xMutex, portMAX_DELAY);
+        counter++;
+        xSemaphoreGiveRecursive(xMutex);
+        xSemaphoreGiveRecursive(xMutex);
+      }
+      else
+      {
+        xSemaphoreTake(xMutex, portMAX_DELAY);
+        counter++;
+        if (xYieldWhileHeld)
+        {
+          taskYIELD();
+        }
+        xSemaphoreGive(xMutex);
+      }
+    }
+    benchSample(&xBench, (benchNowNs() - start) / BATCH_SIZE);
+  }
+  benchTaskDone();
+}
@@ -0,0 +1,159 @@
+/*
+Queue batch transfer benchmark:
+
+  A producer and a consumer of equal priority move ITEM_COUNT items of a
+  given size through a queue of QUEUE_LENGTH items, as a sensor task feeding
+  a processing task would. One op is one item moved, and each sample is the
+  mean over one batch of BATCH_SIZE items on the producer's side. The line
+  under each row gives the payload throughput.
+
+  one at a time:
+    xQueueSend() and xQueueReceive() per item - one critical section, one
+    memcpy and one wake up decision per item at each end.
+
+  batches:
+    xQueueSendMultiple() and xQueueReceiveMultiple() with BATCH_SIZE items -
+    one critical section and at most two memcpy calls per batch at each end.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "bench.h"
+#include <stdio.h>
+#include <string.h>
+
+#define WORKER_PRIORITY   1
+#define QUEUE_LENGTH      64
+#define BATCH_SIZE        16
+#define ITEM_COUNT        64000
+#define MAX_ITEM_SIZE     256
+
+#define STR(x)  #x
+#define XSTR(x) STR(x)
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static QueueHandle_t xQueue;
+static BaseType_t xBatched;
+static uint32_t itemSize;
+static uint32_t checksum;
+
+static void runTransfer(const char* scenario, uint32_t size, BaseType_t batched);
+static void vProducerTask(void* pvParam);
+static void vConsumerTask(void* pvParam);
+
+static void benchmarks(void)
+{
+  static const uint32_t itemSizes[] = { 4, 16, 64, MAX_ITEM_SIZE };
+
+  benchInit(&xBench, ITEM_COUNT / BATCH_SIZE);
+
+  for (uint32_t i = 0; i < sizeof(itemSizes) / sizeof(itemSizes[0]); i++)
+  {
+    char title[64];
+
+    snprintf(title, sizeof(title), "%u byte items", (unsigned)itemSizes[i]);
+    benchPrintHeader(title);
+    runTransfer("one at a time", itemSizes[i], pdFALSE);
+    runTransfer("batches of " XSTR(BATCH_SIZE), itemSizes[i], pdTRUE);
+  }
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runTransfer(const char* scenario, uint32_t size, BaseType_t batched)
+{
+  itemSize = size;
+  xBatched = batched;
+  checksum = 0;
+
+  xQueue = xQueueCreate(QUEUE_LENGTH, size);
+  configASSERT(xQueue != NULL);
+
+  benchStart(&xBench);
+  xTaskCreate(vConsumerTask, "consumer", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  xTaskCreate(vProducerTask, "producer", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  benchWaitForTasks(2);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, ITEM_COUNT);
+
+  // every item carries its sequence number in its first word
+  configASSERT(checksum == (uint32_t)ITEM_COUNT * (ITEM_COUNT - 1) / 2);
+  printf("  %.1f MB/s\n", (double)ITEM_COUNT * size * 1000.0 / xBench.elapsedNs);
+
+  vQueueDelete(xQueue);
+}
+
+// TASKS
+
+static void vProducerTask(void* pvParam)
+{
+  static uint8_t items[BATCH_SIZE][MAX_ITEM_SIZE];
+
+  for (uint32_t sent = 0; sent < ITEM_COUNT; sent += BATCH_SIZE)
+  {
+    // pack the batch at the queue's item size, as xQueueSendMultiple expects
+    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    {
+      uint32_t sequence = sent + i;
+      memcpy(&items[0][0] + i * itemSize, &sequence, sizeof(sequence));
+    }
+
+    uint64_t start = benchNowNs();
+    if (xBatched)
+    {
+      for (UBaseType_t done = 0; done < BATCH_SIZE;)
+      {
+        done += xQueueSendMultiple(xQueue, &items[0][0] + done * itemSize, BATCH_SIZE - done, portMAX_DELAY);
+      }
+    }
+    else
+    {
+      for (uint32_t i = 0; i < BATCH_SIZE; i++)
+      {
+        xQueueSend(xQueue, &items[0][0] + i * itemSize, portMAX_DELAY);
+      }
+    }
+    benchSample(&xBench, (benchNowNs() - start) / BATCH_SIZE);
+  }
+  benchTaskDone();
+}
+
+static void vConsumerTask(void* pvParam)
+{
+  static uint8_t items[BATCH_SIZE][MAX_ITEM_SIZE];
+  uint32_t sum = 0;
+
+  for (uint32_t received = 0; received < ITEM_COUNT;)
+  {
+    UBaseType_t count = 1;
+
+    if (xBatched)
+    {
+      count = xQueueReceiveMultiple(xQueue, &items[0][0], BATCH_SIZE, portMAX_DELAY);
+    }
+    else
+    {
+      xQueueReceive(xQueue, &items[0][0], portMAX_DELAY);
+    }
+
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+      uint32_t sequence;
+      memcpy(&sequence, &items[0][0] + i * itemSize, sizeof(sequence));
+      sum += sequence;
+    }
+    received += count;
+  }
+  checksum = sum;
+  benchTaskDone();
+}
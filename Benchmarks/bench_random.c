@@ -0,0 +1,104 @@
+/*
+Random number benchmark:
+
+  N tasks of equal priority draw random delays as fast as they can, as the
+  exercises' vRandomDelay() and somePretendAction() do. One op is one
+  number in [0, 2000), and each sample is the mean of a batch of BATCH_SIZE
+  draws.
+
+  rand() % 2000:
+    The C library generator. One hidden state shared by every task, taken
+    under the library's lock.
+
+  randomRange(2000):
+    task_random.h. Each task's xorshift32 state sits in its own thread local
+    storage slot, so nothing is shared and nothing is locked.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "task_random.h"
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define WORKER_PRIORITY   1
+#define MAX_TASKS         16
+#define TOTAL_DRAWS       1600000   // split between the tasks of a scenario
+#define BATCH_SIZE        1000
+#define DELAY_RANGE_MS    2000
+
+typedef enum
+{
+  GENERATOR_RAND,
+  GENERATOR_TASK_RANDOM
+} Generator_t;
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static Generator_t eGenerator;
+static uint32_t drawsPerTask;
+static volatile uint32_t sink;
+
+static void runGenerator(const char* scenario, Generator_t generator, uint32_t tasks);
+static void vDrawTask(void* pvParam);
+
+static void benchmarks(void)
+{
+  static const uint32_t taskCounts[] = { 1, MAX_TASKS };
+
+  benchInit(&xBench, TOTAL_DRAWS / BATCH_SIZE);
+
+  for (uint32_t i = 0; i < sizeof(taskCounts) / sizeof(taskCounts[0]); i++)
+  {
+    char title[64];
+
+    snprintf(title, sizeof(title), "Random delay draw (%u tasks)", (unsigned)taskCounts[i]);
+    benchPrintHeader(title);
+    runGenerator("rand() % 2000", GENERATOR_RAND, taskCounts[i]);
+    runGenerator("randomRange(2000)", GENERATOR_TASK_RANDOM, taskCounts[i]);
+  }
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runGenerator(const char* scenario, Generator_t generator, uint32_t tasks)
+{
+  eGenerator = generator;
+  drawsPerTask = TOTAL_DRAWS / tasks;
+
+  for (uint32_t i = 0; i < tasks; i++)
+  {
+    BaseType_t err = xTaskCreate(vDrawTask, "draw", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+    configASSERT(err == pdPASS);
+  }
+
+  benchStart(&xBench);
+  benchWaitForTasks(tasks);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, tasks * drawsPerTask);
+}
+
+// TASKS
+
+static void vDrawTask(void* pvParam)
+{
+  for (uint32_t done = 0; done < drawsPerTask; done += BATCH_SIZE)
+  {
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    {
+      sink = (eGenerator == GENERATOR_RAND) ? (uint32_t)(rand() % DELAY_RANGE_MS) : randomRange(DELAY_RANGE_MS);
+    }
+    benchSample(&xBench, (benchNowNs() - start) / BATCH_SIZE);
+  }
+  benchTaskDone();
+}
@@ -0,0 +1,138 @@
+/*
+Two task rendezvous benchmark:
+
+  Two tasks of equal priority meet over and over, as in exc_3.3 and the
+  post-dance rendezvous of exc_3.8. One op is one rendezvous: both tasks
+  arrive and both are released.
+
+  Two semaphores:
+    The book's solution. Each task gives its own semaphore and takes the
+    other task's, so one rendezvous is four queue calls and the semaphores
+    are two queue objects from the heap. They count up to 2 rather than 1:
+    in a tight loop the task released first can get round to its next give
+    before the other task has taken the last one, and a binary semaphore
+    would drop that give.
+
+  Rendezvous_t:
+    xRendezvousArrive() from both tasks. The first task to arrive waits for
+    a task notification and the second one gives it - two kernel calls and
+    no heap.
+
+  The heap taken by the objects of each scheme is printed after its row.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "rendezvous.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define RENDEZVOUS_COUNT  100000
+
+typedef enum
+{
+  SCHEME_SEMAPHORES,
+  SCHEME_RENDEZVOUS
+} Scheme_t;
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static Scheme_t eScheme;
+static SemaphoreHandle_t xDoneA;
+static SemaphoreHandle_t xDoneB;
+static Rendezvous_t xRendezvous;
+
+static void runRendezvous(const char* scenario, Scheme_t scheme);
+static void vTaskA(void* pvParam);
+static void vTaskB(void* pvParam);
+
+static void benchmarks(void)
+{
+  benchInit(&xBench, RENDEZVOUS_COUNT);
+
+  benchPrintHeader("Two task rendezvous");
+  runRendezvous("two semaphores", SCHEME_SEMAPHORES);
+  runRendezvous("Rendezvous_t", SCHEME_RENDEZVOUS);
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runRendezvous(const char* scenario, Scheme_t scheme)
+{
+  size_t freeHeap = xPortGetFreeHeapSize();
+
+  eScheme = scheme;
+  if (scheme == SCHEME_SEMAPHORES)
+  {
+    xDoneA = xSemaphoreCreateCounting(2, 0);
+    xDoneB = xSemaphoreCreateCounting(2, 0);
+  }
+  else
+  {
+    vRendezvousInitialise(&xRendezvous);
+  }
+  size_t objectHeap = freeHeap - xPortGetFreeHeapSize();
+
+  xTaskCreate(vTaskA, "A", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  xTaskCreate(vTaskB, "B", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+
+  benchStart(&xBench);
+  benchWaitForTasks(2);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, RENDEZVOUS_COUNT);
+  printf("  heap used by the rendezvous: %u bytes\n", (unsigned)objectHeap);
+
+  if (scheme == SCHEME_SEMAPHORES)
+  {
+    vSemaphoreDelete(xDoneA);
+    vSemaphoreDelete(xDoneB);
+  }
+}
+
+// TASKS
+
+static void vTaskA(void* pvParam)
+{
+  for (uint32_t i = 0; i < RENDEZVOUS_COUNT; i++)
+  {
+    uint64_t start = benchNowNs();
+    if (eScheme == SCHEME_SEMAPHORES)
+    {
+      xSemaphoreGive(xDoneA);
+      xSemaphoreTake(xDoneB, portMAX_DELAY);
+    }
+    else
+    {
+      xRendezvousArrive(&xRendezvous, portMAX_DELAY);
+    }
+    benchSample(&xBench, benchNowNs() - start);
+  }
+  benchTaskDone();
+}
+
+static void vTaskB(void* pvParam)
+{
+  for (uint32_t i = 0; i < RENDEZVOUS_COUNT; i++)
+  {
+    if (eScheme == SCHEME_SEMAPHORES)
+    {
+      xSemaphoreGive(xDoneB);
+      xSemaphoreTake(xDoneA, portMAX_DELAY);
+    }
+    else
+    {
+      xRendezvousArrive(&xRendezvous, portMAX_DELAY);
+    }
+  }
+  benchTaskDone();
+}
@@ -0,0 +1,187 @@
+/*
+Reader-writer lock benchmark:
+
+  TASK_COUNT tasks of equal priority share a table of TABLE_WORDS words. Each
+  op is a read of the whole table, or one time in WRITE_EVERY a write of every
+  word, made under a lock - a read-mostly table such as a routing or config
+  table. Readers check no write is half done. One op is one lock, read or
+  write and unlock, and each sample is the time one task takes for it.
+
+  mutex:
+    xSemaphoreCreateMutex(), so readers wait for each other as well as for
+    the writers.
+
+  rwlock, prefer readers / prefer writers / fair:
+    xRWLockCreate() with each policy, so readers share the lock.
+
+  short sections:
+    The table is read or written and the lock given straight away. On a
+    single core a task is rarely preempted while it holds the lock, so the
+    rows mostly compare the cost of taking and giving each lock.
+
+  sections that block:
+    The task holding the lock also waits for a tick, as a read of a slow
+    peripheral would. With the mutex every op waits its turn for a tick of its
+    own, while readers holding the rwlock wait out their ticks together.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "rwlock.h"
+#include "task_random.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define TASK_COUNT        8
+#define TABLE_WORDS       64
+#define WRITE_EVERY       16
+#define SHORT_OP_COUNT    64000
+#define BLOCKING_OP_COUNT 2000
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static SemaphoreHandle_t xMutex;
+static RWLockHandle_t xRWLock;
+static BaseType_t xBlocking;
+static uint32_t opsPerTask;
+static uint32_t table[TABLE_WORDS];
+static uint32_t writes;
+
+static void runLock(const char* scenario, BaseType_t rwlock, BaseType_t policy, uint32_t ops);
+static void vWorkerTask(void* pvParam);
+
+static void benchmarks(void)
+{
+  benchInit(&xBench, SHORT_OP_COUNT);
+
+  for (xBlocking = pdFALSE; xBlocking <= pdTRUE; xBlocking++)
+  {
+    uint32_t ops = xBlocking ? BLOCKING_OP_COUNT : SHORT_OP_COUNT;
+    char title[64];
+
+    snprintf(title, sizeof(title), "%u tasks, 1 in %u writes, %s", TASK_COUNT, WRITE_EVERY,
+             xBlocking ? "sections that block" : "short sections");
+    benchPrintHeader(title);
+    runLock("mutex", pdFALSE, 0, ops);
+    runLock("rwlock, prefer readers", pdTRUE, rwlockPREFER_READERS, ops);
+    runLock("rwlock, prefer writers", pdTRUE, rwlockPREFER_WRITERS, ops);
+    runLock("rwlock, fair", pdTRUE, rwlockFAIR, ops);
+  }
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runLock(const char* scenario, BaseType_t rwlock, BaseType_t policy, uint32_t ops)
+{
+  xMutex = NULL;
+  xRWLock = NULL;
+  if (rwlock)
+  {
+    xRWLock = xRWLockCreate(policy);
+    configASSERT(xRWLock != NULL);
+  }
+  else
+  {
+    xMutex = xSemaphoreCreateMutex();
+    configASSERT(xMutex != NULL);
+  }
+
+  opsPerTask = ops / TASK_COUNT;
+  writes = 0;
+  for (uint32_t i = 0; i < TABLE_WORDS; i++)
+  {
+    table[i] = 0;
+  }
+
+  benchStart(&xBench);
+  for (uint32_t i = 0; i < TASK_COUNT; i++)
+  {
+    xTaskCreate(vWorkerTask, "worker", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  }
+  benchWaitForTasks(TASK_COUNT);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, ops);
+
+  // every write moved the whole table on by one
+  configASSERT(table[0] == writes && table[TABLE_WORDS - 1] == writes);
+  printf("  %u writes\n", (unsigned)writes);
+
+  if (rwlock)
+  {
+    vRWLockDelete(xRWLock);
+  }
+  else
+  {
+    vSemaphoreDelete(xMutex);
+  }
+}
+
+// TASKS
+
+static void vWorkerTask(void* pvParam)
+{
+  for (uint32_t i = 0; i < opsPerTask; i++)
+  {
+    BaseType_t write = randomRange(WRITE_EVERY) == 0;
+
+    uint64_t start = benchNowNs();
+    if (xRWLock == NULL)
+    {
+      xSemaphoreTake(xMutex, portMAX_DELAY);
+    }
+    else if (write)
+    {
+      xRWLockTakeWrite(xRWLock, portMAX_DELAY);
+    }
+    else
+    {
+      xRWLockTakeRead(xRWLock, portMAX_DELAY);
+    }
+
+    if (write)
+    {
+      writes++;
+      for (uint32_t k = 0; k < TABLE_WORDS; k++)
+      {
+        table[k] = writes;
+      }
+    }
+    else
+    {
+      for (uint32_t k = 1; k < TABLE_WORDS; k++)
+      {
+        configASSERT(table[k] == table[0]);
+      }
+    }
+
+    if (xBlocking)
+    {
+      vTaskDelay(1);
+    }
+
+    if (xRWLock == NULL)
+    {
+      xSemaphoreGive(xMutex);
+    }
+    else if (write)
+    {
+      xRWLockGiveWrite(xRWLock);
+    }
+    else
+    {
+      xRWLockGiveRead(xRWLock);
+    }
+    benchSample(&xBench, benchNowNs() - start);
+  }
+  benchTaskDone();
+}
@@ -0,0 +1,387 @@
+/*
+SMP scaling benchmark:
+
+  TASK_COUNT tasks of equal priority run the synchronisation patterns of the
+  exercises, each doing WORK_ITERATIONS of arithmetic wherever the exercise
+  does its work, so the cores have something to do in parallel. The core
+  count is fixed when the kernel is built - build and run the program once
+  for each count and compare the tables, the title says which:
+
+    cmake -DSIMULATOR_CORES=1    (default)
+    cmake -DSIMULATOR_CORES=2, 4 or 8
+
+  multiplex:
+    exc_3.5. A counting semaphore lets MULTIPLEX_SIZE tasks into a section at
+    a time and each does its work inside. One op is one take, work and give.
+    Up to MULTIPLEX_SIZE cores can be busy at once.
+
+  barrier, turnstiles:
+    exc_3.7. Each task does its work, then waits at the book's reusable
+    barrier - a count under a mutex and two turnstiles. One op is one phase,
+    every task working and passing the barrier, so all the cores are busy
+    until the slowest task arrives.
+
+  barrier, native:
+    exc_3.7_barrier_3. As above with xBarrierWait().
+
+  dance floor:
+    exc_3.8. TASK_COUNT / 2 leaders and as many followers pair up through two
+    queues, and each pair dances - both do their work - on a floor that only
+    holds one pair at a time. One op is one dance. At most two cores are
+    busy, the rest wait for the floor.
+
+  The simulated cores are threads that share the processors of the host, so
+  on a host with fewer processors than cores the rows show what the
+  synchronisation costs rather than any speed up - ns/op and cs/op going up
+  with the core count is the kernel lock and the interrupts between cores.
+  The line under each row checks the pattern held.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "barrier.h"
+#include "rendezvous.h"
+#include "atomic.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define TASK_COUNT        8
+#define WORK_ITERATIONS   2000
+#define MULTIPLEX_SIZE    4
+#define MULTIPLEX_OPS     16000
+#define BARRIER_PHASES    2000
+#define DANCE_COUNT       4000
+#define PAIR_COUNT        (TASK_COUNT / 2)
+
+typedef enum
+{
+  PATTERN_MULTIPLEX,
+  PATTERN_TURNSTILES,
+  PATTERN_NATIVE_BARRIER,
+  PATTERN_DANCE_LEADER,
+  PATTERN_DANCE_FOLLOWER
+} Pattern_t;
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static uint32_t opsPerTask;
+static uint32_t sink;
+
+// multiplex
+static SemaphoreHandle_t xMultiplex;
+static uint32_t inSection;
+static uint32_t mostInSection;
+
+// barriers
+static SemaphoreHandle_t xCountLock;
+static SemaphoreHandle_t xTurnstile;
+static SemaphoreHandle_t xSecondTurnstile;
+static BarrierHandle_t xNativeBarrier;
+static uint32_t arrived;
+static volatile uint32_t arrivedPhase[TASK_COUNT];
+
+// dance floor
+static SemaphoreHandle_t xDanceFloor;
+static SemaphoreHandle_t xFollowerHand;
+static SemaphoreHandle_t xLeaderHand;
+static Rendezvous_t xAfterDance;
+static uint32_t leadersQueued;
+static uint32_t followersQueued;
+static uint32_t onFloor;
+static uint32_t dances;
+
+static void runMultiplex(void);
+static void runBarrier(const char* scenario, Pattern_t pattern);
+static void runDance(void);
+static void createTasks(Pattern_t pattern, uint32_t count, uint32_t firstIndex);
+static void vWorkerTask(void* pvParam);
+static void multiplexOp(void);
+static void barrierOp(Pattern_t pattern, uint32_t index, uint32_t phase);
+static void turnstileWait(void);
+static void danceOp(BaseType_t leader);
+static void dance(void);
+static void work(void);
+
+static void benchmarks(void)
+{
+  char title[64];
+
+  benchInit(&xBench, BARRIER_PHASES * TASK_COUNT);
+
+  snprintf(title, sizeof(title), "%u tasks on %u core%s", TASK_COUNT, (unsigned)configNUMBER_OF_CORES,
+           configNUMBER_OF_CORES > 1 ? "s" : "");
+  benchPrintHeader(title);
+  runMultiplex();
+  runBarrier("barrier, turnstiles", PATTERN_TURNSTILES);
+  runBarrier("barrier, native", PATTERN_NATIVE_BARRIER);
+  runDance();
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runMultiplex(void)
+{
+  xMultiplex = xSemaphoreCreateCounting(MULTIPLEX_SIZE, MULTIPLEX_SIZE);
+  configASSERT(xMultiplex != NULL);
+  opsPerTask = MULTIPLEX_OPS / TASK_COUNT;
+  inSection = 0;
+  mostInSection = 0;
+
+  benchStart(&xBench);
+  createTasks(PATTERN_MULTIPLEX, TASK_COUNT, 0);
+  benchWaitForTasks(TASK_COUNT);
+  benchStop(&xBench);
+  benchReport("multiplex", &xBench, MULTIPLEX_OPS);
+
+  configASSERT(mostInSection <= MULTIPLEX_SIZE);
+  configASSERT(uxSemaphoreGetCount(xMultiplex) == MULTIPLEX_SIZE);
+  printf("  at most %u of %u tasks in the section\n", (unsigned)mostInSection, MULTIPLEX_SIZE);
+
+  vSemaphoreDelete(xMultiplex);
+}
+
+static void runBarrier(const char* scenario, Pattern_t pattern)
+{
+  if (pattern == PATTERN_NATIVE_BARRIER)
+  {
+    xNativeBarrier = xBarrierCreate(TASK_COUNT);
+    configASSERT(xNativeBarrier != NULL);
+  }
+  else
+  {
+    xCountLock = xSemaphoreCreateMutex();
+    xTurnstile = xSemaphoreCreateCounting(TASK_COUNT, 0);
+    xSecondTurnstile = xSemaphoreCreateCounting(TASK_COUNT, 0);
+    configASSERT(xCountLock != NULL && xTurnstile != NULL && xSecondTurnstile != NULL);
+  }
+  opsPerTask = BARRIER_PHASES;
+  arrived = 0;
+  for (uint32_t i = 0; i < TASK_COUNT; i++)
+  {
+    arrivedPhase[i] = 0;
+  }
+
+  benchStart(&xBench);
+  createTasks(pattern, TASK_COUNT, 0);
+  benchWaitForTasks(TASK_COUNT);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, BARRIER_PHASES);
+
+  // every task arrived at every phase, and none was let through early
+  for (uint32_t i = 0; i < TASK_COUNT; i++)
+  {
+    configASSERT(arrivedPhase[i] == BARRIER_PHASES);
+  }
+  printf("  %u phases of %u tasks\n", BARRIER_PHASES, TASK_COUNT);
+
+  if (pattern == PATTERN_NATIVE_BARRIER)
+  {
+    vBarrierDelete(xNativeBarrier);
+  }
+  else
+  {
+    vSemaphoreDelete(xCountLock);
+    vSemaphoreDelete(xTurnstile);
+    vSemaphoreDelete(xSecondTurnstile);
+  }
+}
+
+static void runDance(void)
+{
+  xDanceFloor = xSemaphoreCreateCounting(1, 1);
+  xFollowerHand = xSemaphoreCreateBinary();
+  xLeaderHand = xSemaphoreCreateBinary();
+  configASSERT(xDanceFloor != NULL && xFollowerHand != NULL && xLeaderHand != NULL);
+  vRendezvousInitialise(&xAfterDance);
+  opsPerTask = DANCE_COUNT / PAIR_COUNT;
+  leadersQueued = 0;
+  followersQueued = 0;
+  onFloor = 0;
+  dances = 0;
+
+  benchStart(&xBench);
+  createTasks(PATTERN_DANCE_LEADER, PAIR_COUNT, 0);
+  createTasks(PATTERN_DANCE_FOLLOWER, PAIR_COUNT, PAIR_COUNT);
+  benchWaitForTasks(TASK_COUNT);
+  benchStop(&xBench);
+  benchReport("dance floor", &xBench, DANCE_COUNT);
+
+  // every leader danced with a follower, one pair at a time
+  configASSERT(dances == DANCE_COUNT);
+  configASSERT(leadersQueued == 0 && followersQueued == 0);
+  printf("  %u dances, one pair on the floor at a time\n", (unsigned)dances);
+
+  vSemaphoreDelete(xDanceFloor);
+  vSemaphoreDelete(xFollowerHand);
+  vSemaphoreDelete(xLeaderHand);
+}
+
+static void createTasks(Pattern_t pattern, uint32_t count, uint32_t firstIndex)
+{
+  for (uint32_t i = firstIndex; i < firstIndex + count; i++)
+  {
+    // the pattern in the low byte, the task's index above it
+    uintptr_t param = (uintptr_t)pattern | ((uintptr_t)i << 8);
+    BaseType_t err = xTaskCreate(vWorkerTask, "worker", BENCH_STACK_SIZE, (void*)param, WORKER_PRIORITY, NULL);
+    configASSERT(err == pdPASS);
+  }
+}
+
+// TASKS
+
+static void vWorkerTask(void* pvParam)
+{
+  Pattern_t pattern = (Pattern_t)((uintptr_t)pvParam & 0xff);
+  uint32_t index = (uint32_t)((uintptr_t)pvParam >> 8);
+
+  for (uint32_t i = 0; i < opsPerTask; i++)
+  {
+    uint64_t start = benchNowNs();
+    switch (pattern)
+    {
+      case PATTERN_MULTIPLEX:
+        multiplexOp();
+        break;
+
+      case PATTERN_TURNSTILES:
+      case PATTERN_NATIVE_BARRIER:
+        barrierOp(pattern, index, i + 1);
+        break;
+
+      case PATTERN_DANCE_LEADER:
+      case PATTERN_DANCE_FOLLOWER:
+        danceOp(pattern == PATTERN_DANCE_LEADER);
+        break;
+    }
+    benchSample(&xBench, benchNowNs() - start);
+  }
+  benchTaskDone();
+}
+
+static void multiplexOp(void)
+{
+  xSemaphoreTake(xMultiplex, portMAX_DELAY);
+
+  uint32_t count = Atomic_Increment_u32(&inSection) + 1;
+  uint32_t most = mostInSection;
+  while (count > most && Atomic_CompareAndSwap_u32(&mostInSection, count, most) != ATOMIC_COMPARE_AND_SWAP_SUCCESS)
+  {
+    most = mostInSection;
+  }
+
+  work();
+  Atomic_Decrement_u32(&inSection);
+
+  xSemaphoreGive(xMultiplex);
+}
+
+static void barrierOp(Pattern_t pattern, uint32_t index, uint32_t phase)
+{
+  work();
+  arrivedPhase[index] = phase;
+
+  if (pattern == PATTERN_NATIVE_BARRIER)
+  {
+    xBarrierWait(xNativeBarrier, portMAX_DELAY);
+  }
+  else
+  {
+    turnstileWait();
+  }
+
+  // nobody gets through before everybody has arrived, and nobody can be
+  // more than one phase ahead
+  for (uint32_t k = 0; k < TASK_COUNT; k++)
+  {
+    configASSERT(arrivedPhase[k] == phase || arrivedPhase[k] == phase + 1);
+  }
+}
+
+static void turnstileWait(void)
+{
+  // the book's reusable barrier - the last task in opens the first
+  // turnstile for everyone, the last task out opens the second
+  xSemaphoreTake(xCountLock, portMAX_DELAY);
+  if (++arrived == TASK_COUNT)
+  {
+    for (uint32_t i = 0; i < TASK_COUNT; i++)
+    {
+      xSemaphoreGive(xTurnstile);
+    }
+  }
+  xSemaphoreGive(xCountLock);
+  xSemaphoreTake(xTurnstile, portMAX_DELAY);
+
+  xSemaphoreTake(xCountLock, portMAX_DELAY);
+  if (--arrived == 0)
+  {
+    for (uint32_t i = 0; i < TASK_COUNT; i++)
+    {
+      xSemaphoreGive(xSecondTurnstile);
+    }
+  }
+  xSemaphoreGive(xCountLock);
+  xSemaphoreTake(xSecondTurnstile, portMAX_DELAY);
+}
+
+static void danceOp(BaseType_t leader)
+{
+  uint32_t* mine = leader ? &leadersQueued : &followersQueued;
+  uint32_t* theirs = leader ? &followersQueued : &leadersQueued;
+  SemaphoreHandle_t xMyHand = leader ? xLeaderHand : xFollowerHand;
+  SemaphoreHandle_t xTheirHand = leader ? xFollowerHand : xLeaderHand;
+
+  // as in exc_3.8 - whoever arrives second keeps the floor for the pair,
+  // and the leader hands it on after the dance
+  xSemaphoreTake(xDanceFloor, portMAX_DELAY);
+  if (*theirs > 0)
+  {
+    (*theirs)--;
+    xSemaphoreGive(xMyHand);
+  }
+  else
+  {
+    (*mine)++;
+    xSemaphoreGive(xDanceFloor);
+    xSemaphoreTake(xTheirHand, portMAX_DELAY);
+  }
+
+  dance();
+  xRendezvousArrive(&xAfterDance, portMAX_DELAY);
+
+  if (leader)
+  {
+    dances++;
+    xSemaphoreGive(xDanceFloor);
+  }
+}
+
+static void dance(void)
+{
+  configASSERT(Atomic_Increment_u32(&onFloor) < 2);
+  work();
+  Atomic_Decrement_u32(&onFloor);
+}
+
+static void work(void)
+{
+  // stands in for the work the exercises do between synchronisations
+  uint32_t x = (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandle() | 1;
+  for (uint32_t i = 0; i < WORK_ITERATIONS; i++)
+  {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+  }
+  Atomic_Add_u32(&sink, x);
+}
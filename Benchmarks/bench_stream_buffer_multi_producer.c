@@ -0,0 +1,183 @@
+/*
+Multi-producer message buffer benchmark:
+
+  Some number of producers and one consumer, all of equal priority, move
+  MESSAGE_COUNT messages of a given size between them through a message
+  buffer of BUFFER_SIZE bytes, split evenly between the producers, as
+  several sensor tasks logging to one writer task would. Every word of a
+  message holds its sequence number, which the consumer checks. One op is one
+  message moved, and each sample is the mean over BATCH_SIZE messages on one
+  producer's side. The line under each row gives the aggregate payload
+  throughput.
+
+  mutex:
+    A plain message buffer, with every xMessageBufferSend() inside a mutex as
+    the single writer rule asks. A producer that is preempted while copying a
+    message in, or that finds the buffer full, holds up all the others.
+
+  multi-producer:
+    xMessageBufferCreateMultiProducer(), and no mutex. Each producer reserves
+    room for its message with one compare-and-swap, copies the message in
+    while others reserve and copy theirs, and commits it in a short critical
+    section. The consumer only sees a message once every message reserved
+    before it has been committed.
+
+  A critical section on the simulator costs two system calls. Sending inside
+  the mutex takes three - the take, the send and the give - where the
+  multi-producer send takes one, so with a single producer the rows mostly
+  show that difference.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "message_buffer.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define BUFFER_SIZE       16384
+#define BATCH_SIZE        16
+#define MESSAGE_COUNT     64000
+#define MAX_PRODUCERS     16
+#define MAX_MESSAGE_SIZE  1024
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static MessageBufferHandle_t xBuffer;
+static SemaphoreHandle_t xMutex;
+static BaseType_t xMultiProducer;
+static uint32_t producerCount;
+static uint32_t messageWords;
+static uint32_t checksum;
+
+static void runTransfer(const char* scenario, uint32_t producers, uint32_t size, BaseType_t multiProducer);
+static void vProducerTask(void* pvParam);
+static void vConsumerTask(void* pvParam);
+
+static void benchmarks(void)
+{
+  static const uint32_t producerCounts[] = { 1, 4, MAX_PRODUCERS };
+  static const uint32_t messageSizes[] = { 64, MAX_MESSAGE_SIZE };
+
+  benchInit(&xBench, MESSAGE_COUNT / BATCH_SIZE);
+  xMutex = xSemaphoreCreateMutex();
+  configASSERT(xMutex != NULL);
+
+  for (uint32_t i = 0; i < sizeof(producerCounts) / sizeof(producerCounts[0]); i++)
+  {
+    for (uint32_t j = 0; j < sizeof(messageSizes) / sizeof(messageSizes[0]); j++)
+    {
+      char title[64];
+
+      snprintf(title, sizeof(title), "%u producers, %u byte messages", (unsigned)producerCounts[i],
+               (unsigned)messageSizes[j]);
+      benchPrintHeader(title);
+      runTransfer("mutex", producerCounts[i], messageSizes[j], pdFALSE);
+      runTransfer("multi-producer", producerCounts[i], messageSizes[j], pdTRUE);
+    }
+  }
+
+  vSemaphoreDelete(xMutex);
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runTransfer(const char* scenario, uint32_t producers, uint32_t size, BaseType_t multiProducer)
+{
+  producerCount = producers;
+  xMultiProducer = multiProducer;
+  messageWords = size / sizeof(uint32_t);
+  checksum = 0;
+
+  if (multiProducer)
+  {
+    xBuffer = xMessageBufferCreateMultiProducer(BUFFER_SIZE);
+  }
+  else
+  {
+    xBuffer = xMessageBufferCreate(BUFFER_SIZE);
+  }
+  configASSERT(xBuffer != NULL);
+
+  benchStart(&xBench);
+  xTaskCreate(vConsumerTask, "consumer", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  for (uint32_t i = 0; i < producers; i++)
+  {
+    BaseType_t err = xTaskCreate(vProducerTask, "producer", BENCH_STACK_SIZE, (void*)(uintptr_t)i, WORKER_PRIORITY, NULL);
+    configASSERT(err == pdPASS);
+  }
+  benchWaitForTasks(producers + 1);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, MESSAGE_COUNT);
+
+  // every message carries its sequence number in every word
+  configASSERT(checksum == (uint32_t)MESSAGE_COUNT * (MESSAGE_COUNT - 1) / 2);
+  printf("  %.1f MB/s\n", (double)MESSAGE_COUNT * size * 1000.0 / xBench.elapsedNs);
+
+  vMessageBufferDelete(xBuffer);
+}
+
+// TASKS
+
+static void vProducerTask(void* pvParam)
+{
+  static uint32_t messages[MAX_PRODUCERS][MAX_MESSAGE_SIZE / sizeof(uint32_t)];
+  uint32_t producer = (uint32_t)(uintptr_t)pvParam;
+  uint32_t* message = messages[producer];
+  uint32_t share = MESSAGE_COUNT / producerCount;
+
+  for (uint32_t sent = 0; sent < share; sent += BATCH_SIZE)
+  {
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    {
+      uint32_t sequence = producer * share + sent + i;
+      for (uint32_t k = 0; k < messageWords; k++)
+      {
+        message[k] = sequence;
+      }
+
+      if (xMultiProducer)
+      {
+        xMessageBufferSend(xBuffer, message, messageWords * sizeof(uint32_t), portMAX_DELAY);
+      }
+      else
+      {
+        xSemaphoreTake(xMutex, portMAX_DELAY);
+        xMessageBufferSend(xBuffer, message, messageWords * sizeof(uint32_t), portMAX_DELAY);
+        xSemaphoreGive(xMutex);
+      }
+    }
+    benchSample(&xBench, (benchNowNs() - start) / BATCH_SIZE);
+  }
+  benchTaskDone();
+}
+
+static void vConsumerTask(void* pvParam)
+{
+  static uint32_t message[MAX_MESSAGE_SIZE / sizeof(uint32_t)];
+  uint32_t sum = 0;
+
+  for (uint32_t received = 0; received < MESSAGE_COUNT; received++)
+  {
+    size_t bytes = xMessageBufferReceive(xBuffer, message, sizeof(message), portMAX_DELAY);
+    configASSERT(bytes == messageWords * sizeof(uint32_t));
+
+    // the consumer looks at the whole message, and checks it is intact
+    for (uint32_t k = 1; k < messageWords; k++)
+    {
+      configASSERT(message[k] == message[0]);
+    }
+    sum += message[0];
+  }
+  checksum = sum;
+  benchTaskDone();
+}
@@ -0,0 +1,234 @@
+/*
+Stream buffer region benchmark:
+
+  A producer and a consumer of equal priority move CHUNK_COUNT chunks of a
+  given size through a stream buffer, or a message buffer, of BUFFER_SIZE
+  bytes. The producer fills in every word of each chunk and the consumer reads
+  every word, as a task assembling packets for another to send would. One op
+  is one chunk moved, and each sample is the mean over BATCH_SIZE chunks on the
+  producer's side. The line under each row gives the payload throughput.
+
+  stream copy / message copy:
+    The producer fills in a local chunk that xStreamBufferSend() (or
+    xMessageBufferSend()) copies in, xStreamBufferReceive() copies it out into
+    a local chunk and the consumer reads it there.
+
+  stream in place:
+    The producer fills in the regions from xStreamBufferAcquireWrite() and
+    commits them, the consumer reads the regions from
+    xStreamBufferAcquireRead() and consumes them. A chunk that wraps at the
+    end of the storage area takes two regions at each end.
+
+  stream in place, mirrored:
+    As above with xStreamBufferCreateMirrored(), so a chunk is always one
+    region.
+
+  message in place:
+    xMessageBufferAcquireWrite() and xMessageBufferAcquireRead() - a message
+    is never split, so it is always one region.
+
+  The stream buffer's trigger level is one chunk, so the consumer wakes once
+  per chunk either way. As in bench_queue_zero_copy, acquiring a region for
+  writing takes a critical section that a send does not need, which on the
+  simulator costs two system calls - the copies saved only win from chunks of
+  a few KB.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define BUFFER_SIZE       65536
+#define BATCH_SIZE        16
+#define CHUNK_COUNT       32000
+#define MAX_CHUNK_SIZE    16384
+
+typedef enum
+{
+  COPY,
+  IN_PLACE,
+  IN_PLACE_MIRRORED
+} Method_t;
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static StreamBufferHandle_t xBuffer;
+static Method_t xMethod;
+static uint32_t chunkSize;
+static uint32_t checksum;
+
+static void runTransfer(const char* scenario, uint32_t size, BaseType_t messages, Method_t method);
+static void writeChunk(uint32_t sequence);
+static uint32_t readChunk(void);
+static void vProducerTask(void* pvParam);
+static void vConsumerTask(void* pvParam);
+
+static void benchmarks(void)
+{
+  static const uint32_t chunkSizes[] = { 64, 1024, 4096, MAX_CHUNK_SIZE };
+
+  benchInit(&xBench, CHUNK_COUNT / BATCH_SIZE);
+
+  for (uint32_t i = 0; i < sizeof(chunkSizes) / sizeof(chunkSizes[0]); i++)
+  {
+    char title[64];
+
+    snprintf(title, sizeof(title), "%u byte chunks", (unsigned)chunkSizes[i]);
+    benchPrintHeader(title);
+    runTransfer("stream copy", chunkSizes[i], pdFALSE, COPY);
+    runTransfer("stream in place", chunkSizes[i], pdFALSE, IN_PLACE);
+    runTransfer("stream in place, mirrored", chunkSizes[i], pdFALSE, IN_PLACE_MIRRORED);
+    runTransfer("message copy", chunkSizes[i], pdTRUE, COPY);
+    runTransfer("message in place", chunkSizes[i], pdTRUE, IN_PLACE);
+  }
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runTransfer(const char* scenario, uint32_t size, BaseType_t messages, Method_t method)
+{
+  chunkSize = size;
+  xMethod = method;
+  checksum = 0;
+
+  if (messages)
+  {
+    xBuffer = xMessageBufferCreate(BUFFER_SIZE);
+  }
+  else if (method == IN_PLACE_MIRRORED)
+  {
+    xBuffer = xStreamBufferCreateMirrored(BUFFER_SIZE, size);
+  }
+  else
+  {
+    xBuffer = xStreamBufferCreate(BUFFER_SIZE, size);
+  }
+  configASSERT(xBuffer != NULL);
+
+  benchStart(&xBench);
+  xTaskCreate(vConsumerTask, "consumer", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  xTaskCreate(vProducerTask, "producer", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  benchWaitForTasks(2);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, CHUNK_COUNT);
+
+  // every chunk carries its sequence number in every word
+  configASSERT(checksum == (uint32_t)CHUNK_COUNT * (CHUNK_COUNT - 1) / 2);
+  printf("  %.1f MB/s\n", (double)CHUNK_COUNT * size * 1000.0 / xBench.elapsedNs);
+
+  vStreamBufferDelete(xBuffer);
+}
+
+static void writeChunk(uint32_t sequence)
+{
+  static uint32_t chunk[MAX_CHUNK_SIZE / sizeof(uint32_t)];
+
+  if (xMethod == COPY)
+  {
+    for (uint32_t i = 0; i < chunkSize / sizeof(uint32_t); i++)
+    {
+      chunk[i] = sequence;
+    }
+    for (size_t sent = 0; sent < chunkSize;)
+    {
+      sent += xStreamBufferSend(xBuffer, (uint8_t*)chunk + sent, chunkSize - sent, portMAX_DELAY);
+    }
+    return;
+  }
+
+  // a stream buffer region can stop short at the end of the storage area,
+  // but always on a word boundary as every chunk is a whole number of words
+  for (size_t written = 0; written < chunkSize;)
+  {
+    uint32_t* region;
+    size_t bytes = xStreamBufferAcquireWrite(xBuffer, (void**)&region, chunkSize - written, portMAX_DELAY);
+
+    for (uint32_t i = 0; i < bytes / sizeof(uint32_t); i++)
+    {
+      region[i] = sequence;
+    }
+    vStreamBufferCommitWrite(xBuffer, bytes);
+    written += bytes;
+  }
+}
+
+static uint32_t readChunk(void)
+{
+  static uint32_t chunk[MAX_CHUNK_SIZE / sizeof(uint32_t)];
+  uint32_t sequence = 0;
+  BaseType_t first = pdTRUE;
+
+  // the consumer looks at the whole chunk, and checks it is intact
+  for (size_t read = 0; read < chunkSize;)
+  {
+    const uint32_t* words = chunk;
+    size_t bytes;
+
+    if (xMethod == COPY)
+    {
+      bytes = xStreamBufferReceive(xBuffer, chunk, chunkSize - read, portMAX_DELAY);
+    }
+    else
+    {
+      bytes = xStreamBufferAcquireRead(xBuffer, (void**)&words, portMAX_DELAY);
+      bytes = bytes < chunkSize - read ? bytes : chunkSize - read;
+    }
+
+    for (uint32_t i = 0; i < bytes / sizeof(uint32_t); i++)
+    {
+      if (first)
+      {
+        sequence = words[i];
+        first = pdFALSE;
+      }
+      configASSERT(words[i] == sequence);
+    }
+
+    if (xMethod != COPY)
+    {
+      vStreamBufferConsume(xBuffer, bytes);
+    }
+    read += bytes;
+  }
+  return sequence;
+}
+
+// TASKS
+
+static void vProducerTask(void* pvParam)
+{
+  for (uint32_t sent = 0; sent < CHUNK_COUNT; sent += BATCH_SIZE)
+  {
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    {
+      writeChunk(sent + i);
+    }
+    benchSample(&xBench, (benchNowNs() - start) / BATCH_SIZE);
+  }
+  benchTaskDone();
+}
+
+static void vConsumerTask(void* pvParam)
+{
+  uint32_t sum = 0;
+
+  for (uint32_t received = 0; received < CHUNK_COUNT; received++)
+  {
+    sum += readChunk();
+  }
+  checksum = sum;
+  benchTaskDone();
+}
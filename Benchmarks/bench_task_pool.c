@@ -0,0 +1,398 @@
+/*
+Task pool benchmark:
+
+  A driver task hands work to a pool of one worker per core, or does it
+  itself, the way the exercises hand-partition theirs between long-lived
+  tasks. The core count is fixed when the kernel is built - build and run the
+  program once for each count and compare the tables, the title says which:
+
+    cmake -DSIMULATOR_CORES=1    (default)
+    cmake -DSIMULATOR_CORES=2, 4 or 8
+
+  short jobs:
+    JOB_BATCH jobs of JOB_WORK iterations of arithmetic are started, then
+    waited for. One op is one job, and each sample the mean over a batch.
+
+    task per job   xTaskCreate() for each job, which gives a semaphore and
+                   deletes itself. The idle task only frees the deleted
+                   tasks once nothing else is ready, so the driver sleeps
+                   until it has between batches - left out of the samples but
+                   not out of ops/s
+    pool           xTaskPoolSubmit() then xTaskPoolWait() for each job
+
+  block workloads:
+    One op is one block, processed by the driver alone (serial) or split with
+    vTaskPoolParallelFor() / vTaskPoolParallelReduce() (pool).
+
+    fir            FIR_TAPS tap Q15 filter over BLOCK_SAMPLES samples, split
+                   by output sample
+    dense layer    int8 matrix-vector product of LAYER_ROWS x LAYER_COLUMNS,
+                   split by row, as in one layer of a small network
+    energy         sum of the squares of the block, a parallel reduce
+
+  The simulated cores are threads that share the processors of the host, so
+  the block rows only speed up with the core count on a host with at least as
+  many processors. The line under each row checks the result against the
+  serial one.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "task_pool.h"
+#include "bench.h"
+#include <stdio.h>
+#include <string.h>
+
+#define WORKER_PRIORITY   1
+#define POOL_QUEUE_LENGTH 32
+#define JOB_BATCH         16
+#define JOB_WORK          500
+#define JOB_COUNT         8000
+#define BLOCK_SAMPLES     2048
+#define FIR_TAPS          32
+#define FIR_GRAIN         128
+#define LAYER_ROWS        256
+#define LAYER_COLUMNS     256
+#define LAYER_GRAIN       16
+#define ENERGY_GRAIN      256
+#define BLOCK_COUNT       400
+
+typedef enum
+{
+  WORKLOAD_JOBS,
+  WORKLOAD_FIR,
+  WORKLOAD_DENSE_LAYER,
+  WORKLOAD_ENERGY
+} Workload_t;
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static TaskPoolHandle_t xPool;     // NULL for the serial scenarios
+static Workload_t xWorkload;
+static uint32_t opCount;
+
+// short jobs
+static SemaphoreHandle_t xJobsDone;
+static TaskPoolJob_t xJobs[JOB_BATCH];
+static uint32_t jobResults[JOB_BATCH];
+static uint32_t jobChecksum;
+
+// block workloads, and the serial results the pool's are checked against
+static int16_t samples[BLOCK_SAMPLES + FIR_TAPS - 1];
+static int16_t taps[FIR_TAPS];
+static int32_t filtered[BLOCK_SAMPLES];
+static int32_t filteredSerial[BLOCK_SAMPLES];
+static int8_t weights[LAYER_ROWS][LAYER_COLUMNS];
+static int8_t activations[LAYER_COLUMNS];
+static int32_t layerOut[LAYER_ROWS];
+static int32_t layerOutSerial[LAYER_ROWS];
+static int64_t energySerial;
+static uint32_t energyMismatches;
+
+static void runWorkload(const char* scenario, Workload_t workload, BaseType_t pooled, uint32_t ops);
+static void makeBlock(void);
+static uint32_t work(uint32_t seed);
+static void fir(uint32_t first, uint32_t end, void* pvParam);
+static void denseLayer(uint32_t first, uint32_t end, void* pvParam);
+static void energy(uint32_t first, uint32_t end, void* pvParam, void* pvResult);
+static void addEnergy(void* pvResult, const void* pvPartial, void* pvParam);
+static void vDriverTask(void* pvParam);
+static void vJobTask(void* pvParam);
+static void vPoolJob(void* pvParam);
+
+static void benchmarks(void)
+{
+  char title[64];
+
+  benchInit(&xBench, JOB_COUNT / JOB_BATCH + BLOCK_COUNT);
+  makeBlock();
+
+  xJobsDone = xSemaphoreCreateCounting(JOB_BATCH, 0);
+  configASSERT(xJobsDone != NULL);
+
+  snprintf(title, sizeof(title), "short jobs, %u workers on %u core%s", (unsigned)configNUMBER_OF_CORES,
+           (unsigned)configNUMBER_OF_CORES, configNUMBER_OF_CORES > 1 ? "s" : "");
+  benchPrintHeader(title);
+  runWorkload("task per job", WORKLOAD_JOBS, pdFALSE, JOB_COUNT);
+  runWorkload("pool", WORKLOAD_JOBS, pdTRUE, JOB_COUNT);
+
+  snprintf(title, sizeof(title), "block workloads, %u workers on %u core%s", (unsigned)configNUMBER_OF_CORES,
+           (unsigned)configNUMBER_OF_CORES, configNUMBER_OF_CORES > 1 ? "s" : "");
+  benchPrintHeader(title);
+  runWorkload("fir, serial", WORKLOAD_FIR, pdFALSE, BLOCK_COUNT);
+  runWorkload("fir, pool", WORKLOAD_FIR, pdTRUE, BLOCK_COUNT);
+  runWorkload("dense layer, serial", WORKLOAD_DENSE_LAYER, pdFALSE, BLOCK_COUNT);
+  runWorkload("dense layer, pool", WORKLOAD_DENSE_LAYER, pdTRUE, BLOCK_COUNT);
+  runWorkload("energy, serial", WORKLOAD_ENERGY, pdFALSE, BLOCK_COUNT);
+  runWorkload("energy, pool", WORKLOAD_ENERGY, pdTRUE, BLOCK_COUNT);
+
+  vSemaphoreDelete(xJobsDone);
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runWorkload(const char* scenario, Workload_t workload, BaseType_t pooled, uint32_t ops)
+{
+  xPool = NULL;
+  if (pooled)
+  {
+    xPool = xTaskPoolCreate("worker", configNUMBER_OF_CORES, BENCH_STACK_SIZE, WORKER_PRIORITY, POOL_QUEUE_LENGTH);
+    configASSERT(xPool != NULL);
+    configASSERT(uxTaskPoolGetWorkers(xPool) == configNUMBER_OF_CORES);
+  }
+  xWorkload = workload;
+  opCount = ops;
+  jobChecksum = 0;
+  energyMismatches = 0;
+  memset(filtered, 0, sizeof(filtered));
+  memset(layerOut, 0, sizeof(layerOut));
+
+  benchStart(&xBench);
+  xTaskCreate(vDriverTask, "driver", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  benchWaitForDone(1);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, ops);
+
+  switch (workload)
+  {
+    case WORKLOAD_JOBS:
+      printf("  checksum %08x\n", (unsigned)jobChecksum);
+      break;
+
+    case WORKLOAD_FIR:
+      configASSERT(memcmp(filtered, filteredSerial, sizeof(filtered)) == 0);
+      printf("  output matches serial\n");
+      break;
+
+    case WORKLOAD_DENSE_LAYER:
+      configASSERT(memcmp(layerOut, layerOutSerial, sizeof(layerOut)) == 0);
+      printf("  output matches serial\n");
+      break;
+
+    case WORKLOAD_ENERGY:
+      configASSERT(energyMismatches == 0);
+      printf("  energy %lld on every block\n", (long long)energySerial);
+      break;
+  }
+
+  // stop the workers, and let the idle task free them, the driver and the job
+  // tasks
+  if (pooled)
+  {
+    vTaskPoolDelete(xPool);
+  }
+  benchWaitForTasks(0);
+}
+
+static void makeBlock(void)
+{
+  uint32_t x = 2463534242u;
+
+  for (uint32_t i = 0; i < BLOCK_SAMPLES + FIR_TAPS - 1; i++)
+  {
+    x = work(x + i);
+    samples[i] = (int16_t)x;
+  }
+  for (uint32_t i = 0; i < FIR_TAPS; i++)
+  {
+    taps[i] = (int16_t)(4096 - 256 * (int32_t)i);
+  }
+  for (uint32_t r = 0; r < LAYER_ROWS; r++)
+  {
+    for (uint32_t c = 0; c < LAYER_COLUMNS; c++)
+    {
+      weights[r][c] = (int8_t)(r * 31 + c * 17);
+    }
+  }
+  for (uint32_t c = 0; c < LAYER_COLUMNS; c++)
+  {
+    activations[c] = (int8_t)(c * 7);
+  }
+
+  fir(0, BLOCK_SAMPLES, filteredSerial);
+  denseLayer(0, LAYER_ROWS, layerOutSerial);
+  energySerial = 0;
+  energy(0, BLOCK_SAMPLES, NULL, &energySerial);
+}
+
+// A few xorshift steps, so the compiler cannot fold the work away
+static uint32_t work(uint32_t seed)
+{
+  uint32_t x = seed | 1;
+
+  for (uint32_t i = 0; i < 4; i++)
+  {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+  }
+  return x;
+}
+
+static void fir(uint32_t first, uint32_t end, void* pvParam)
+{
+  int32_t* out = pvParam;
+
+  for (uint32_t n = first; n < end; n++)
+  {
+    int32_t acc = 0;
+    for (uint32_t k = 0; k < FIR_TAPS; k++)
+    {
+      acc += (int32_t)samples[n + k] * taps[k];
+    }
+    out[n] = acc >> 15;
+  }
+}
+
+static void denseLayer(uint32_t first, uint32_t end, void* pvParam)
+{
+  int32_t* out = pvParam;
+
+  for (uint32_t r = first; r < end; r++)
+  {
+    int32_t acc = 0;
+    for (uint32_t c = 0; c < LAYER_COLUMNS; c++)
+    {
+      acc += (int32_t)weights[r][c] * activations[c];
+    }
+    out[r] = acc;
+  }
+}
+
+static void energy(uint32_t first, uint32_t end, void* pvParam, void* pvResult)
+{
+  int64_t sum = *(int64_t*)pvResult;
+
+  for (uint32_t n = first; n < end; n++)
+  {
+    sum += (int32_t)samples[n] * samples[n];
+  }
+  *(int64_t*)pvResult = sum;
+}
+
+static void addEnergy(void* pvResult, const void* pvPartial, void* pvParam)
+{
+  *(int64_t*)pvResult += *(const int64_t*)pvPartial;
+}
+
+// TASKS
+
+static void vDriverTask(void* pvParam)
+{
+  TaskPoolHandle_t pool = xPool;
+  uint32_t perSample = (xWorkload == WORKLOAD_JOBS) ? JOB_BATCH : 1;
+  UBaseType_t tasksBefore = uxTaskGetNumberOfTasks();
+
+  for (uint32_t done = 0; done < opCount; done += perSample)
+  {
+    uint64_t start = benchNowNs();
+    switch (xWorkload)
+    {
+      case WORKLOAD_JOBS:
+        for (uint32_t i = 0; i < JOB_BATCH; i++)
+        {
+          jobResults[i] = done + i;
+          if (pool == NULL)
+          {
+            BaseType_t err = xTaskCreate(vJobTask, "job", BENCH_STACK_SIZE, &jobResults[i], WORKER_PRIORITY, NULL);
+            configASSERT(err == pdPASS);
+          }
+          else
+          {
+            BaseType_t err = xTaskPoolSubmit(pool, &xJobs[i], vPoolJob, &jobResults[i], portMAX_DELAY);
+            configASSERT(err == pdPASS);
+          }
+        }
+        for (uint32_t i = 0; i < JOB_BATCH; i++)
+        {
+          if (pool == NULL)
+          {
+            xSemaphoreTake(xJobsDone, portMAX_DELAY);
+          }
+          else
+          {
+            xTaskPoolWait(pool, &xJobs[i], portMAX_DELAY);
+          }
+        }
+        for (uint32_t i = 0; i < JOB_BATCH; i++)
+        {
+          jobChecksum += jobResults[i];
+        }
+        break;
+
+      case WORKLOAD_FIR:
+        if (pool == NULL)
+        {
+          fir(0, BLOCK_SAMPLES, filtered);
+        }
+        else
+        {
+          vTaskPoolParallelFor(pool, 0, BLOCK_SAMPLES, FIR_GRAIN, fir, filtered);
+        }
+        break;
+
+      case WORKLOAD_DENSE_LAYER:
+        if (pool == NULL)
+        {
+          denseLayer(0, LAYER_ROWS, layerOut);
+        }
+        else
+        {
+          vTaskPoolParallelFor(pool, 0, LAYER_ROWS, LAYER_GRAIN, denseLayer, layerOut);
+        }
+        break;
+
+      case WORKLOAD_ENERGY:
+      {
+        int64_t sum = 0;
+        if (pool == NULL)
+        {
+          energy(0, BLOCK_SAMPLES, NULL, &sum);
+        }
+        else
+        {
+          vTaskPoolParallelReduce(pool, 0, BLOCK_SAMPLES, ENERGY_GRAIN, energy, addEnergy, NULL, &sum, sizeof(sum));
+        }
+        energyMismatches += (sum != energySerial);
+        break;
+      }
+    }
+    benchSample(&xBench, (benchNowNs() - start) / perSample);
+
+    if (xWorkload == WORKLOAD_JOBS && pool == NULL)
+    {
+      while (uxTaskGetNumberOfTasks() > tasksBefore)
+      {
+        vTaskDelay(1);
+      }
+    }
+  }
+  benchTaskDone();
+}
+
+static void vJobTask(void* pvParam)
+{
+  vPoolJob(pvParam);
+  xSemaphoreGive(xJobsDone);
+  vTaskDelete(NULL);
+}
+
+static void vPoolJob(void* pvParam)
+{
+  uint32_t* result = pvParam;
+  uint32_t x = *result;
+
+  for (uint32_t i = 0; i < JOB_WORK / 4; i++)
+  {
+    x = work(x);
+  }
+  *result = x;
+}
@@ -0,0 +1,161 @@
+/*
+Timer command benchmark:
+
+  Tasks send bursts of timer commands to the timer service task. The same
+  program is built against either command channel - the title says which:
+
+    command ring   default, a ring of slots the timer service task drains
+                   configTIMER_COMMAND_BATCH commands at a time
+    kernel queue   cmake -DSIMULATOR_TIMER_COMMAND_QUEUE=ON
+
+  Both are configTIMER_QUEUE_LENGTH commands long. One op is one
+  xTimerReset() and each sample is the mean over one burst of BURST_LENGTH,
+  so a burst that had to wait for room shows up in the max column.
+
+  burst above:
+    The senders run above the timer service task, which only gets to take
+    the commands once every sender has finished its burst and slept for a
+    tick - the case batching is for.
+
+  burst below:
+    The senders run below the timer service task, which runs as soon as each
+    command is sent. Every command costs a context switch either way.
+
+  Each scenario resets either one timer per sender per command (distinct),
+  or the same few timers from every sender (shared), where a reset that a
+  later reset in the same batch undoes can be skipped. The command ring's
+  counters are printed after each scenario.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define LOW_PRIORITY      1
+#define HIGH_PRIORITY     (configTIMER_TASK_PRIORITY + 1)
+#define MAX_SENDERS       4
+#define BURST_LENGTH      16
+#define BURST_COUNT       500
+#define SHARED_TIMERS     4
+#define TIMER_PERIOD      pdMS_TO_TICKS(60000)
+
+#if (configUSE_TIMER_COMMAND_RING == 1)
+#define COMMAND_CHANNEL "command ring"
+#else
+#define COMMAND_CHANNEL "kernel queue"
+#endif
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static TimerHandle_t xTimers[MAX_SENDERS * BURST_LENGTH];
+static BaseType_t xShared;
+
+static void runBurst(const char* scenario, uint32_t senders, UBaseType_t priority, BaseType_t shared);
+static void printCommandStats(void);
+static void vTimerCallback(TimerHandle_t xTimer);
+static void vSenderTask(void* pvParam);
+
+static void benchmarks(void)
+{
+  static const uint32_t senderCounts[] = { 1, MAX_SENDERS };
+
+  benchInit(&xBench, MAX_SENDERS * BURST_COUNT);
+
+  for (uint32_t i = 0; i < MAX_SENDERS * BURST_LENGTH; i++)
+  {
+    xTimers[i] = xTimerCreate("timer", TIMER_PERIOD, pdFALSE, NULL, vTimerCallback);
+    configASSERT(xTimers[i] != NULL);
+  }
+
+  for (uint32_t i = 0; i < sizeof(senderCounts) / sizeof(senderCounts[0]); i++)
+  {
+    char title[64];
+
+    snprintf(title, sizeof(title), "%u senders (" COMMAND_CHANNEL ")", (unsigned)senderCounts[i]);
+    benchPrintHeader(title);
+    runBurst("burst above, distinct", senderCounts[i], HIGH_PRIORITY, pdFALSE);
+    runBurst("burst above, shared", senderCounts[i], HIGH_PRIORITY, pdTRUE);
+    runBurst("burst below, distinct", senderCounts[i], LOW_PRIORITY, pdFALSE);
+    runBurst("burst below, shared", senderCounts[i], LOW_PRIORITY, pdTRUE);
+  }
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runBurst(const char* scenario, uint32_t senders, UBaseType_t priority, BaseType_t shared)
+{
+  xShared = shared;
+
+  benchStart(&xBench);
+  for (uint32_t i = 0; i < senders; i++)
+  {
+    BaseType_t err = xTaskCreate(vSenderTask, "sender", BENCH_STACK_SIZE, (void*)(uintptr_t)i, priority, NULL);
+    configASSERT(err == pdPASS);
+  }
+  benchWaitForTasks(senders);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, senders * BURST_COUNT * BURST_LENGTH);
+  printCommandStats();
+
+  // leave the timers stopped for the next scenario
+  for (uint32_t i = 0; i < MAX_SENDERS * BURST_LENGTH; i++)
+  {
+    xTimerStop(xTimers[i], portMAX_DELAY);
+  }
+  vTaskDelay(pdMS_TO_TICKS(10));
+}
+
+static void printCommandStats(void)
+{
+#if (configUSE_TIMER_COMMAND_RING == 1)
+  static TimerCommandStats_t last;
+  TimerCommandStats_t stats;
+
+  vTimerGetCommandStats(&stats);
+  uint32_t received = stats.ulReceived - last.ulReceived;
+  uint32_t batches = stats.ulBatches - last.ulBatches;
+
+  printf("  %u commands in %u batches (%.1f each), %u coalesced, %u dropped, deepest yet %u\n", (unsigned)received,
+         (unsigned)batches, batches ? (double)received / batches : 0.0, (unsigned)(stats.ulCoalesced - last.ulCoalesced),
+         (unsigned)(stats.ulDropped - last.ulDropped), (unsigned)stats.uxMaxDepth);
+  last = stats;
+#endif
+}
+
+// CALLBACKS
+
+static void vTimerCallback(TimerHandle_t xTimer)
+{
+}
+
+// TASKS
+
+static void vSenderTask(void* pvParam)
+{
+  uint32_t sender = (uint32_t)(uintptr_t)pvParam;
+
+  for (uint32_t burst = 0; burst < BURST_COUNT; burst++)
+  {
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < BURST_LENGTH; i++)
+    {
+      uint32_t timer = xShared ? i % SHARED_TIMERS : sender * BURST_LENGTH + i;
+      xTimerReset(xTimers[timer], portMAX_DELAY);
+    }
+    benchSample(&xBench, (benchNowNs() - start) / BURST_LENGTH);
+
+    // let the timer service task catch up
+    vTaskDelay(1);
+  }
+  benchTaskDone();
+}
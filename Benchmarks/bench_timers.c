@@ -0,0 +1,182 @@
+/*
+Software timer benchmark:
+
+  N auto-reload timers are active while the timer service task is measured.
+  The same program is built against either implementation of the active
+  timer list - the title says which:
+
+    sorted list    default, active timers kept in expiry time order
+    timer wheel    cmake -DSIMULATOR_TIMER_WHEEL=ON
+
+  start + stop:
+    The N timers have periods of one to two minutes, so none expire. A task
+    below the timer service task starts and stops spare timers of random
+    periods in the same range. One op is one xTimerStart() and one
+    xTimerStop(), each processed by the timer service task straight away.
+
+  expire:
+    The N timers have random periods of 1 to 2 seconds. A task below the
+    timer service task winds the tick count on by CATCH_UP_TICKS at a time
+    with xTaskCatchUpTicks(), and the timer service task catches up on every
+    timer that expired. One op is one expiry - the timer reloaded and its
+    callback called - and each sample is the mean over one catch up.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "task_random.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define MAX_TIMERS        10000
+#define SPARE_TIMERS      64
+#define START_STOP_COUNT  20000
+#define EXPIRE_COUNT      100000
+#define CATCH_UP_TICKS    100
+#define IDLE_PERIOD_MIN   pdMS_TO_TICKS(60000)
+#define BUSY_PERIOD_MIN   pdMS_TO_TICKS(1000)
+
+#if (configUSE_TIMER_WHEEL == 1)
+#define ACTIVE_TIMERS "timer wheel"
+#else
+#define ACTIVE_TIMERS "sorted list"
+#endif
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static TimerHandle_t xTimers[MAX_TIMERS];
+static TimerHandle_t xSpares[SPARE_TIMERS];
+static volatile uint32_t expiries;
+
+static void runStartStop(uint32_t timers);
+static void runExpire(uint32_t timers);
+static void startTimers(uint32_t timers, TickType_t minPeriod);
+static void deleteTimers(TimerHandle_t* timers, uint32_t count);
+static void vTimerCallback(TimerHandle_t xTimer);
+static void vStartStopTask(void* pvParam);
+static void vCatchUpTask(void* pvParam);
+
+static void benchmarks(void)
+{
+  static const uint32_t timerCounts[] = { 10, 1000, MAX_TIMERS };
+
+  benchInit(&xBench, EXPIRE_COUNT);
+
+  for (uint32_t i = 0; i < sizeof(timerCounts) / sizeof(timerCounts[0]); i++)
+  {
+    char title[64];
+
+    snprintf(title, sizeof(title), "%u active timers (" ACTIVE_TIMERS ")", (unsigned)timerCounts[i]);
+    benchPrintHeader(title);
+    runStartStop(timerCounts[i]);
+    runExpire(timerCounts[i]);
+  }
+
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runStartStop(uint32_t timers)
+{
+  startTimers(timers, IDLE_PERIOD_MIN);
+  for (uint32_t i = 0; i < SPARE_TIMERS; i++)
+  {
+    xSpares[i] = xTimerCreate("spare", IDLE_PERIOD_MIN + randomRange(IDLE_PERIOD_MIN), pdFALSE, NULL, vTimerCallback);
+    configASSERT(xSpares[i] != NULL);
+  }
+
+  benchStart(&xBench);
+  xTaskCreate(vStartStopTask, "startstop", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  benchWaitForTasks(1);
+  benchStop(&xBench);
+  benchReport("start + stop", &xBench, START_STOP_COUNT);
+
+  deleteTimers(xSpares, SPARE_TIMERS);
+  deleteTimers(xTimers, timers);
+}
+
+static void runExpire(uint32_t timers)
+{
+  startTimers(timers, BUSY_PERIOD_MIN);
+
+  benchStart(&xBench);
+  xTaskCreate(vCatchUpTask, "catchup", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  benchWaitForTasks(1);
+  benchStop(&xBench);
+  benchReport("expire", &xBench, expiries);
+
+  deleteTimers(xTimers, timers);
+}
+
+static void startTimers(uint32_t timers, TickType_t minPeriod)
+{
+  for (uint32_t i = 0; i < timers; i++)
+  {
+    xTimers[i] = xTimerCreate("timer", minPeriod + randomRange(minPeriod), pdTRUE, NULL, vTimerCallback);
+    configASSERT(xTimers[i] != NULL);
+    xTimerStart(xTimers[i], portMAX_DELAY);
+  }
+}
+
+static void deleteTimers(TimerHandle_t* timers, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; i++)
+  {
+    xTimerDelete(timers[i], portMAX_DELAY);
+  }
+
+  // let the timer service task free them before the next scenario
+  vTaskDelay(pdMS_TO_TICKS(10));
+}
+
+// CALLBACKS
+
+static void vTimerCallback(TimerHandle_t xTimer)
+{
+  expiries++;
+}
+
+// TASKS
+
+static void vStartStopTask(void* pvParam)
+{
+  for (uint32_t i = 0; i < START_STOP_COUNT; i++)
+  {
+    TimerHandle_t xSpare = xSpares[i % SPARE_TIMERS];
+
+    uint64_t start = benchNowNs();
+    xTimerStart(xSpare, portMAX_DELAY);
+    xTimerStop(xSpare, portMAX_DELAY);
+    benchSample(&xBench, benchNowNs() - start);
+  }
+  benchTaskDone();
+}
+
+static void vCatchUpTask(void* pvParam)
+{
+  expiries = 0;
+
+  while (expiries < EXPIRE_COUNT)
+  {
+    uint32_t before = expiries;
+    uint64_t start = benchNowNs();
+    xTaskCatchUpTicks(CATCH_UP_TICKS);
+    uint64_t elapsed = benchNowNs() - start;
+    uint32_t fired = expiries - before;
+
+    if (fired > 0)
+    {
+      benchSample(&xBench, elapsed / fired);
+    }
+  }
+  benchTaskDone();
+}
@@ -0,0 +1,172 @@
+/*
+Trace recorder benchmark:
+
+  What the trace hooks add to the operations they record. The same program
+  is built with and without the recorder - the title says which:
+
+    recorder off   default, the trace macros are empty
+    recorder on    cmake -DSIMULATOR_TRACE=ON
+
+  record an event:
+    One traceMark() per op, the cost of a single event. Each sample is the
+    mean over BATCH_SIZE of them. With the recorder off this is an empty
+    loop.
+
+  mutex take and give:
+    One task takes and gives a mutex nobody else wants, two events per op.
+
+  semaphore ping-pong:
+    Two tasks of equal priority hand a binary semaphore token back and
+    forth. One op is one handoff - a give, the other task made ready and
+    switched in, and its take, plus the blocking of the giver.
+
+  Compare each row against the same row of the other build.
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "trace_recorder.h"
+#include "bench.h"
+#include <stdio.h>
+
+#define WORKER_PRIORITY   1
+#define BATCH_SIZE        64
+#define MARK_COUNT        1048576
+#define MUTEX_COUNT       262144
+#define PING_PONG_ROUNDS  20000
+
+#if (configUSE_TRACE_RECORDER == 1)
+#define RECORDER "recorder on"
+#else
+#define RECORDER "recorder off"
+#endif
+
+// State shared by the tasks of the scenario that is running
+static Bench_t xBench;
+static SemaphoreHandle_t xPingSem, xPongSem;
+
+static void runMark(const char* scenario);
+static void runMutex(const char* scenario);
+static void runPingPong(const char* scenario);
+static void printEventsRecorded(void);
+
+static void vPing(void* pvParam);
+static void vPong(void* pvParam);
+
+static void benchmarks(void)
+{
+  benchInit(&xBench, MARK_COUNT / BATCH_SIZE);
+  traceStart();
+
+  benchPrintHeader("trace hooks (" RECORDER ")");
+  runMark("record an event");
+  runMutex("mutex take and give");
+  runPingPong("semaphore ping-pong");
+
+  traceStop();
+  benchFree(&xBench);
+}
+
+int main(void)
+{
+  benchMain(benchmarks);
+  return 0;
+}
+
+// SCENARIOS
+
+static void runMark(const char* scenario)
+{
+  benchStart(&xBench);
+  for (uint32_t done = 0; done < MARK_COUNT; done += BATCH_SIZE)
+  {
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    {
+      traceMark(done + i);
+    }
+    benchSample(&xBench, (benchNowNs() - start) / BATCH_SIZE);
+  }
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, MARK_COUNT);
+  printEventsRecorded();
+}
+
+static void runMutex(const char* scenario)
+{
+  SemaphoreHandle_t xMutex = xSemaphoreCreateMutex();
+  configASSERT(xMutex != NULL);
+
+  benchStart(&xBench);
+  for (uint32_t done = 0; done < MUTEX_COUNT; done += BATCH_SIZE)
+  {
+    uint64_t start = benchNowNs();
+    for (uint32_t i = 0; i < BATCH_SIZE; i++)
+    {
+      xSemaphoreTake(xMutex, portMAX_DELAY);
+      xSemaphoreGive(xMutex);
+    }
+    benchSample(&xBench, (benchNowNs() - start) / BATCH_SIZE);
+  }
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, MUTEX_COUNT);
+  printEventsRecorded();
+
+  vSemaphoreDelete(xMutex);
+}
+
+static void runPingPong(const char* scenario)
+{
+  xPingSem = xSemaphoreCreateBinary();
+  xPongSem = xSemaphoreCreateBinary();
+  configASSERT(xPingSem != NULL && xPongSem != NULL);
+
+  BaseType_t err = xTaskCreate(vPong, "pong", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  configASSERT(err == pdPASS);
+  err = xTaskCreate(vPing, "ping", BENCH_STACK_SIZE, NULL, WORKER_PRIORITY, NULL);
+  configASSERT(err == pdPASS);
+
+  benchStart(&xBench);
+  benchWaitForTasks(2);
+  benchStop(&xBench);
+  benchReport(scenario, &xBench, PING_PONG_ROUNDS * 2);
+  printEventsRecorded();
+
+  vSemaphoreDelete(xPingSem);
+  vSemaphoreDelete(xPongSem);
+}
+
+// Total number of events recorded so far, with the recorder on
+static void printEventsRecorded(void)
+{
+#if (configUSE_TRACE_RECORDER == 1)
+  uint32_t size;
+  const TraceHeader_t* header = traceGetRecording(&size);
+  printf("  %u events recorded\n", (unsigned)header->eventsWritten);
+#endif
+}
+
+// TASKS
+
+static void vPing(void* pvParam)
+{
+  for (uint32_t i = 0; i < PING_PONG_ROUNDS; i++)
+  {
+    uint64_t start = benchNowNs();
+    xSemaphoreGive(xPingSem);
+    xSemaphoreTake(xPongSem, portMAX_DELAY);
+    benchSample(&xBench, (benchNowNs() - start) / 2);
+  }
+  benchTaskDone();
+}
+
+static void vPong(void* pvParam)
+{
+  for (uint32_t i = 0; i < PING_PONG_ROUNDS; i++)
+  {
+    xSemaphoreTake(xPingSem, portMAX_DELAY);
+    xSemaphoreGive(xPongSem);
+  }
+  benchTaskDone();
+}
@@ -136,6 +136,28 @@ standard names. */
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
 #define configUSE_QUEUE_SETS 1
+// set configUSE_QUEUE_ZERO_COPY to 1 to fill in and read large queue items in
+// place instead of copying them
+#define configUSE_QUEUE_ZERO_COPY 0
+// set configUSE_STREAM_BUFFER_REGIONS to 1 to write and read stream and
+// message buffers in place instead of copying
+#define configUSE_STREAM_BUFFER_REGIONS 0
+// set configUSE_MULTI_PRODUCER_STREAM_BUFFERS to 1 to let several tasks and
+// interrupts write to one stream or message buffer without a mutex
+#define configUSE_MULTI_PRODUCER_STREAM_BUFFERS 0
+// set configUSE_EVENT_GROUP_WAITER_INDEX to 1 to keep xEventGroupSetBits() fast
+// when many tasks wait on different bits of one event group
+#define configUSE_EVENT_GROUP_WAITER_INDEX 0
+// set configUSE_MUTEX_FAST_PATH to 1 to take and give uncontended mutexes
+// with LDREX/STREX instead of a critical section
+#define configUSE_MUTEX_FAST_PATH 0
+// set configUSE_QUEUE_CONTENTION_STATS to 1 to count takes, waits, timeouts
+// and hold times per semaphore and mutex, reported by registry name with
+// vQueueListContention()
+#define configUSE_QUEUE_CONTENTION_STATS 0
+// the STM32F407 has one core - configNUMBER_OF_CORES above 1 needs a port
+// with a kernel lock, which only the Posix simulator port has
+#define configNUMBER_OF_CORES 1
 #define configUSE_COUNTING_SEMAPHORES 1
 #define INCLUDE_xTimerPendFunctionCall 1
 #define configUSE_RECURSIVE_MUTEXES 1
@@ -143,8 +165,44 @@ standard names. */
 // Timers
 #define configUSE_TIMERS 1
 #define configTIMER_TASK_PRIORITY 2
-#define configTIMER_QUEUE_LENGTH 2
+#define configTIMER_QUEUE_LENGTH 16
 #define configTIMER_TASK_STACK_DEPTH 0x100
+// timer commands go through a ring of slots that the timer service task
+// drains in batches - configTIMER_QUEUE_LENGTH must be a power of 2
+#define configUSE_TIMER_COMMAND_RING 1
+#define configTIMER_COMMAND_BATCH 8
+// set configUSE_TIMER_WHEEL to 1 to hash active timers into a timer wheel
+// instead of a sorted list when there are many of them
+#define configUSE_TIMER_WHEEL 0
+#define configTIMER_WHEEL_SLOTS 64
+// Thread local storage - slot 0 holds the task's random number generator
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 1
+// Delayed tasks - set configUSE_TIMING_WHEEL to 1 to hash them into a timing
+// wheel instead of a sorted list when many tasks block with timeouts
+#define configUSE_TIMING_WHEEL 0
+#define configTIMING_WHEEL_SLOTS 64
+// set configUSE_TRACE_RECORDER to 1 to record context switches, blocking and
+// queue and semaphore operations into a ring buffer in RAM for
+// Trace/trace2chrome - the recorder needs configUSE_TRACE_FACILITY
+#define configUSE_TRACE_RECORDER 0
+#define configUSE_TRACE_FACILITY configUSE_TRACE_RECORDER
+#if (configUSE_TRACE_RECORDER == 1) && (defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__))
+  #include "trace_hooks.h"
+#endif
+// set configGENERATE_RUN_TIME_STATS to 0 to stop adding up each task's run
+// time and counting its context switches for CpuLoad/cpu_load.h - the clock
+// is the DWT cycle counter (MDK-ARM/cpu_load_port.c), 64 bits wide so it
+// does not wrap
+#define configGENERATE_RUN_TIME_STATS 1
+#define configRUN_TIME_COUNTER_TYPE uint64_t
+#if (configGENERATE_RUN_TIME_STATS == 1)
+  #if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+    extern void cpuLoadPortInit(void);
+    extern uint64_t cpuLoadPortGetCounter(void);
+  #endif
+  #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() cpuLoadPortInit()
+  #define portGET_RUN_TIME_COUNTER_VALUE() cpuLoadPortGetCounter()
+#endif
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
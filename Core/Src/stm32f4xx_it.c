@@ -22,6 +22,7 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "cpu_load.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -170,7 +171,11 @@ void TIM1_UP_TIM10_IRQHandler(void)
   /* USER CODE END TIM1_UP_TIM10_IRQn 0 */
   HAL_TIM_IRQHandler(&htim1);
   /* USER CODE BEGIN TIM1_UP_TIM10_IRQn 1 */
-
+#if (configGENERATE_RUN_TIME_STATS == 1)
+  // the run time clock counts the DWT counter's wraps when it is read, read
+  // it every millisecond in case no task switches for longer than a wrap
+  cpuLoadPortGetCounter();
+#endif
   /* USER CODE END TIM1_UP_TIM10_IRQn 1 */
 }
 
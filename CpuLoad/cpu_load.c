@@ -0,0 +1,151 @@
+/*
+CPU load - see cpu_load.h.
+
+  The kernel's counters only ever go up, so a sample is the difference
+  between two snapshots. A task is matched with its row of the previous
+  snapshot by handle. When there is none, or its counters went down because
+  a new task was given the handle of a deleted one, the task was created
+  since and everything it has counted falls in this period.
+
+  The run time clock counts from 0 when the scheduler starts, so the
+  zeroed previous snapshot makes the first sample cover everything since.
+*/
+#include "cpu_load.h"
+#include <stdio.h>
+#include <string.h>
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+
+static TaskRunTime_t currentTasks[CPU_LOAD_MAX_TASKS];
+static TaskRunTime_t previousTasks[CPU_LOAD_MAX_TASKS];
+static UBaseType_t previousCount;
+static RunTimeSnapshot_t previous;
+
+static const TaskRunTime_t* findPrevious(TaskHandle_t handle);
+static uint32_t permille(uint64_t part, uint64_t whole);
+static uint32_t perSecond(uint32_t count, uint64_t elapsed);
+static void sortBusiestFirst(CpuLoad_t* load);
+static void vCpuLoadTask(void* pvParam);
+
+void cpuLoadSample(CpuLoad_t* load)
+{
+  RunTimeSnapshot_t now;
+  UBaseType_t count = uxTaskGetRunTimeSnapshot(currentTasks, CPU_LOAD_MAX_TASKS, &now);
+  uint32_t hz = cpuLoadPortGetHz();
+
+  uint64_t elapsed = now.ulTimeNow - previous.ulTimeNow;
+  uint64_t capacity = elapsed * configNUMBER_OF_CORES;   // the time all the cores had
+
+  // split up so a long period in nanoseconds does not overflow
+  load->periodUs = (elapsed / hz) * 1000000u + (elapsed % hz) * 1000000u / hz;
+  load->idlePermille = permille(now.ulIdleRunTime - previous.ulIdleRunTime, capacity);
+  load->switchesPerSecond = perSecond(now.ulSwitchCount - previous.ulSwitchCount, elapsed);
+  load->taskCount = (uint32_t)count;
+
+  for (UBaseType_t i = 0; i < count; i++)
+  {
+    const TaskRunTime_t* task = &currentTasks[i];
+    const TaskRunTime_t* before = findPrevious(task->xHandle);
+    uint64_t runTime = task->ulRunTimeCounter;
+    uint32_t switches = task->ulSwitchInCount;
+
+    if (before != NULL && before->ulRunTimeCounter <= runTime && before->ulSwitchInCount <= switches)
+    {
+      runTime -= before->ulRunTimeCounter;
+      switches -= before->ulSwitchInCount;
+    }
+
+    load->tasks[i].handle = task->xHandle;
+    memcpy(load->tasks[i].name, task->pcTaskName, sizeof(load->tasks[i].name));
+    load->tasks[i].cpuPermille = permille(runTime, capacity);
+    load->tasks[i].switchesPerSecond = perSecond(switches, elapsed);
+  }
+  sortBusiestFirst(load);
+
+  for (UBaseType_t i = 0; i < count; i++)
+  {
+    previousTasks[i] = currentTasks[i];
+  }
+  previousCount = count;
+  previous = now;
+}
+
+void cpuLoadPrint(const CpuLoad_t* load)
+{
+  printf("CPU load over %lu ms: %lu.%lu%% idle, %lu context switches/s\n",
+         (unsigned long)(load->periodUs / 1000u),
+         (unsigned long)(load->idlePermille / 10u), (unsigned long)(load->idlePermille % 10u),
+         (unsigned long)load->switchesPerSecond);
+  printf("%-16s %6s %11s\n", "task", "cpu %", "switches/s");
+
+  for (uint32_t i = 0; i < load->taskCount; i++)
+  {
+    const CpuLoadTask_t* task = &load->tasks[i];
+    printf("%-16s %4lu.%lu %11lu\n", task->name,
+           (unsigned long)(task->cpuPermille / 10u), (unsigned long)(task->cpuPermille % 10u),
+           (unsigned long)task->switchesPerSecond);
+  }
+}
+
+void cpuLoadInit(uint32_t periodMs, UBaseType_t priority)
+{
+  BaseType_t err = xTaskCreate(vCpuLoadTask, "cpu load", CPU_LOAD_STACK_SIZE, (void*)(uintptr_t)periodMs, priority, NULL);
+  configASSERT(err == pdPASS);
+}
+
+static void vCpuLoadTask(void* pvParam)
+{
+  static CpuLoad_t load;   // too big for the stack
+  TickType_t period = pdMS_TO_TICKS((uint32_t)(uintptr_t)pvParam);
+  TickType_t lastWake = xTaskGetTickCount();
+
+  for (;;)
+  {
+    vTaskDelayUntil(&lastWake, period);
+    cpuLoadSample(&load);
+    cpuLoadPrint(&load);
+  }
+}
+
+// HELPERS
+
+static const TaskRunTime_t* findPrevious(TaskHandle_t handle)
+{
+  for (UBaseType_t i = 0; i < previousCount; i++)
+  {
+    if (previousTasks[i].xHandle == handle)
+    {
+      return &previousTasks[i];
+    }
+  }
+  return NULL;
+}
+
+static uint32_t permille(uint64_t part, uint64_t whole)
+{
+  return (whole > 0) ? (uint32_t)(part * 1000u / whole) : 0;
+}
+
+static uint32_t perSecond(uint32_t count, uint64_t elapsed)
+{
+  return (elapsed > 0) ? (uint32_t)((uint64_t)count * cpuLoadPortGetHz() / elapsed) : 0;
+}
+
+// Insertion sort, there are only a few dozen tasks
+static void sortBusiestFirst(CpuLoad_t* load)
+{
+  for (uint32_t i = 1; i < load->taskCount; i++)
+  {
+    CpuLoadTask_t task = load->tasks[i];
+    uint32_t j = i;
+
+    while (j > 0 && load->tasks[j - 1].cpuPermille < task.cpuPermille)
+    {
+      load->tasks[j] = load->tasks[j - 1];
+      j--;
+    }
+    load->tasks[j] = task;
+  }
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+CPU load.
+
+  With configGENERATE_RUN_TIME_STATS set to 1 the kernel adds up the time
+  each task spends running, counts how often each task is switched in and
+  how many context switches there are in all, and the idle tasks' run time
+  is the integral of idle time. The clock is the DWT cycle counter on the
+  target and CLOCK_MONOTONIC nanoseconds in the simulator (cpuLoadPort*
+  below), and the counters are 64 bits wide (configRUN_TIME_COUNTER_TYPE),
+  so they do not wrap.
+
+  cpuLoadSample() takes a snapshot of the counters with
+  uxTaskGetRunTimeSnapshot() and works out, from the difference with the
+  snapshot it took the time before:
+    - each task's share of the CPU
+    - the idle percentage
+    - each task's context switches per second, and the total
+  A share is of the time of all cores, so with one core or several the
+  tasks and idle add up to 100%.
+
+  The snapshot holds a critical section while it copies the counters and
+  name of each task - it neither suspends the scheduler nor scans the stacks
+  the way uxTaskGetSystemState() and vTaskGetRunTimeStats() do - so sampling
+  every second or so from a running system costs next to nothing.
+  Interrupts are masked for longer the more tasks there are, up to
+  CPU_LOAD_MAX_TASKS of them. cpuLoadInit() starts a task that samples and
+  prints the figures.
+
+  Sample from one task only, the previous snapshot is kept here.
+*/
+#ifndef CPU_LOAD_H
+#define CPU_LOAD_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+
+// Number of tasks a sample covers, the rest only count towards the totals
+#ifndef CPU_LOAD_MAX_TASKS
+#define CPU_LOAD_MAX_TASKS  32
+#endif
+
+#define CPU_LOAD_STACK_SIZE 0x200
+
+typedef struct
+{
+  TaskHandle_t handle;
+  char name[configMAX_TASK_NAME_LEN];
+  uint32_t cpuPermille;         // share of the CPU, in tenths of a percent
+  uint32_t switchesPerSecond;   // times the task was switched in
+} CpuLoadTask_t;
+
+typedef struct
+{
+  uint64_t periodUs;            // time since the previous sample
+  uint32_t idlePermille;
+  uint32_t switchesPerSecond;   // context switches on all cores
+  uint32_t taskCount;
+  CpuLoadTask_t tasks[CPU_LOAD_MAX_TASKS];
+} CpuLoad_t;
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+
+// Fill load with the figures since the previous call, or since the
+// scheduler started on the first call. The tasks come busiest first.
+void cpuLoadSample(CpuLoad_t* load);
+
+// Print a sample as a table
+void cpuLoadPrint(const CpuLoad_t* load);
+
+// Create a task that samples and prints every periodMs. Call before
+// vTaskStartScheduler().
+void cpuLoadInit(uint32_t periodMs, UBaseType_t priority);
+
+// Platform run time clock: Posix/cpu_load_port.c on the host,
+// MDK-ARM/cpu_load_port.c on the target. The kernel calls
+// cpuLoadPortInit() through portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() when
+// the scheduler starts and cpuLoadPortGetCounter() through
+// portGET_RUN_TIME_COUNTER_VALUE(), which FreeRTOSConfig.h maps to them.
+void cpuLoadPortInit(void);
+uint64_t cpuLoadPortGetCounter(void);
+uint32_t cpuLoadPortGetHz(void);
+
+#endif
+
+#endif
@@ -0,0 +1,142 @@
+/*
+Deferred console logging - see deferred_log.h.
+
+  The ring buffer is a bounded queue with many producers and one consumer.
+  Every slot carries a sequence number that says whose turn it is:
+
+    sequence == position          free, a producer at this position may fill it
+    sequence == position + 1      filled, the drain task may print it
+    sequence == position + size   printed, free again for the next lap
+
+  A producer claims a position by moving the write position on with a
+  compare-and-swap, fills the slot it now owns, then publishes it by bumping
+  the slot's sequence number. A producer that is interrupted half way only
+  holds up the drain task at that slot, never another producer, and no
+  producer ever disables interrupts or waits. The updates go through
+  atomic.h, which is lock free on both ports.
+*/
+#include "deferred_log.h"
+#include "atomic.h"
+#include <stdio.h>
+
+#if (LOG_BUFFER_RECORDS & (LOG_BUFFER_RECORDS - 1)) != 0
+#error LOG_BUFFER_RECORDS must be a power of two
+#endif
+
+typedef struct
+{
+  volatile uint32_t sequence;
+  const char* format;
+  uintptr_t args[LOG_MAX_ARGS];
+  uint32_t timestamp;
+  TaskHandle_t task;        // NULL when logged from an interrupt
+} LogRecord_t;
+
+static LogRecord_t records[LOG_BUFFER_RECORDS];
+static volatile uint32_t writePosition;
+static uint32_t readPosition;       // only touched by the task draining
+static volatile uint32_t dropped;
+static uint32_t droppedReported;
+
+static void vLogDrainTask(void* pvParam);
+static BaseType_t printNextRecord(void);
+
+void logInit(UBaseType_t drainPriority)
+{
+  for (uint32_t i = 0; i < LOG_BUFFER_RECORDS; i++)
+  {
+    records[i].sequence = i;
+  }
+  writePosition = 0;
+  readPosition = 0;
+
+  BaseType_t err = xTaskCreate(vLogDrainTask, "log", LOG_STACK_SIZE, NULL, drainPriority, NULL);
+  configASSERT(err == pdPASS);
+}
+
+BaseType_t logWrite(const char* format, uintptr_t a0, uintptr_t a1, uintptr_t a2, uintptr_t a3)
+{
+  uint32_t position = writePosition;
+  LogRecord_t* record;
+
+  // claim a slot
+  for (;;)
+  {
+    record = &records[position & (LOG_BUFFER_RECORDS - 1)];
+    int32_t lap = (int32_t)(record->sequence - position);
+
+    if (lap == 0)
+    {
+      if (Atomic_CompareAndSwap_u32(&writePosition, position + 1, position) == ATOMIC_COMPARE_AND_SWAP_SUCCESS)
+      {
+        break;
+      }
+      position = writePosition;   // another producer got it first
+    }
+    else if (lap < 0)
+    {
+      // the drain task has not printed this slot's last record yet
+      Atomic_Increment_u32(&dropped);
+      return pdFALSE;
+    }
+    else
+    {
+      position = writePosition;   // stale position, another producer moved on
+    }
+  }
+
+  record->format = format;
+  record->args[0] = a0;
+  record->args[1] = a1;
+  record->args[2] = a2;
+  record->args[3] = a3;
+  record->timestamp = logGET_TIMESTAMP();
+  record->task = xPortIsInsideInterrupt() ? NULL : xTaskGetCurrentTaskHandle();
+
+  // publish: sequence goes from position to position + 1
+  Atomic_Increment_u32(&record->sequence);
+  return pdTRUE;
+}
+
+uint32_t logGetDropped(void)
+{
+  return dropped;
+}
+
+static void vLogDrainTask(void* pvParam)
+{
+  for (;;)
+  {
+    while (printNextRecord() == pdTRUE)
+    {
+    }
+
+    uint32_t droppedNow = dropped;
+    if (droppedNow != droppedReported)
+    {
+      printf("(%u log records dropped)\n", (unsigned)(droppedNow - droppedReported));
+      droppedReported = droppedNow;
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_PERIOD_MS));
+  }
+}
+
+static BaseType_t printNextRecord(void)
+{
+  LogRecord_t* record = &records[readPosition & (LOG_BUFFER_RECORDS - 1)];
+
+  if (record->sequence != readPosition + 1)
+  {
+    return pdFALSE;   // empty, or the producer has not finished writing it
+  }
+
+  printf("[%6u] %s: ", (unsigned)record->timestamp,
+         (record->task != NULL) ? pcTaskGetName(record->task) : "ISR");
+  printf(record->format, record->args[0], record->args[1], record->args[2], record->args[3]);
+
+  // hand the slot back for the next lap: position + 1 -> position + size
+  Atomic_Add_u32(&record->sequence, LOG_BUFFER_RECORDS - 1);
+  readPosition++;
+  return pdTRUE;
+}
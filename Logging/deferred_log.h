@@ -0,0 +1,80 @@
+/*
+Deferred console logging.
+
+  printf() formats and pushes every character out before it returns - through
+  ITM_SendChar on the target - so calling it inside a critical section or
+  while holding a mutex keeps interrupts off, or the mutex held, for as long
+  as the whole line takes to go out.
+
+  logPrintf() takes the same arguments but only stores the format string,
+  up to LOG_MAX_ARGS arguments, a timestamp and the calling task in a ring
+  buffer, which costs a few dozen instructions and never blocks. A drain
+  task started by logInit() formats and prints the records later, from a
+  low priority, with interrupts enabled. Each line is prefixed with the tick
+  it was logged at and the name of the task that logged it.
+
+  The ring buffer is lock free, so logPrintf() can be called from any task,
+  inside a critical section, with the scheduler suspended or from an
+  interrupt. When the buffer is full the record is dropped and counted, and
+  the drain task reports how many were lost.
+
+  Restrictions, because the record is formatted later:
+    - Arguments must be integers, characters or pointers - no doubles. They
+      reach printf() as uintptr_t, so print integers with PRIuPTR, PRIdPTR
+      or PRIxPTR from <inttypes.h> (e.g. "count = %" PRIuPTR "\n").
+    - More than LOG_MAX_ARGS arguments is a compile error.
+    - A %s argument must still be valid when the drain task gets to it -
+      string literals and static strings are fine, stack buffers are not.
+    - A task whose records are still queued must not be deleted, its name is
+      looked up when the record is printed.
+*/
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+#include <inttypes.h>
+
+// Number of records the ring buffer holds, must be a power of two
+#ifndef LOG_BUFFER_RECORDS
+#define LOG_BUFFER_RECORDS  64
+#endif
+
+// How often the drain task empties the buffer
+#ifndef LOG_DRAIN_PERIOD_MS
+#define LOG_DRAIN_PERIOD_MS 10
+#endif
+
+#define LOG_MAX_ARGS        4
+#define LOG_STACK_SIZE      0x200
+
+// Timestamp stored with each record. Ticks by default - a port with a cycle
+// counter can define it to something finer before including this header.
+#ifndef logGET_TIMESTAMP
+#define logGET_TIMESTAMP()  ((uint32_t)xTaskGetTickCountFromISR())
+#endif
+
+// Create the drain task. Call before vTaskStartScheduler().
+void logInit(UBaseType_t drainPriority);
+
+// Queue a printf style message with up to LOG_MAX_ARGS integer or pointer
+// arguments. Returns pdFALSE if the buffer was full and the record dropped.
+#define logPrintf(...) \
+  (logCHECK_ARGS_(logCOUNT_ARGS_(__VA_ARGS__)), logPrintf_(__VA_ARGS__, 0, 0, 0, 0, 0))
+#define logPrintf_(format, a0, a1, a2, a3, ...) \
+  logWrite((format), (uintptr_t)(a0), (uintptr_t)(a1), (uintptr_t)(a2), (uintptr_t)(a3))
+
+// The number of arguments after the format, up to 9, and a compile error -
+// an array of negative size - when it is more than LOG_MAX_ARGS. Plain C99,
+// which the target compiler has no _Static_assert in.
+#define logCOUNT_ARGS_(...) logCOUNT_ARGS__(__VA_ARGS__, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define logCOUNT_ARGS__(format, a1, a2, a3, a4, a5, a6, a7, a8, a9, count, ...) count
+#define logCHECK_ARGS_(count) ((void)sizeof(char[((count) <= LOG_MAX_ARGS) ? 1 : -1]))
+
+BaseType_t logWrite(const char* format, uintptr_t a0, uintptr_t a1, uintptr_t a2, uintptr_t a3);
+
+// Records dropped because the buffer was full
+uint32_t logGetDropped(void);
+
+#endif
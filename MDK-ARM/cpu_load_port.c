@@ -0,0 +1,50 @@
+#include "cpu_load.h"
+#include "main.h"
+
+// Run time clock for CpuLoad/cpu_load.c on the target, the DWT cycle counter.
+// It is 32 bits wide and wraps every 25s at 168MHz, so the wraps are counted
+// here on each read. That only works when it is read at least that often -
+// the kernel reads it on each context switch, and the timebase interrupt
+// (stm32f4xx_it.c) reads it every millisecond in case there are none.
+// The counter is not cleared, the trace recorder uses it too.
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+
+static uint32_t startCount;
+static uint32_t lastCount;
+static uint32_t wraps;
+
+void cpuLoadPortInit(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  startCount = DWT->CYCCNT;
+  lastCount = 0;
+  wraps = 0;
+}
+
+uint64_t cpuLoadPortGetCounter(void)
+{
+  // called from tasks and interrupts, the count and the wraps go together
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  uint32_t count = DWT->CYCCNT - startCount;
+  if (count < lastCount)
+  {
+    wraps++;
+  }
+  lastCount = count;
+  uint64_t counter = ((uint64_t)wraps << 32) | count;
+
+  __set_PRIMASK(primask);
+  return counter;
+}
+
+uint32_t cpuLoadPortGetHz(void)
+{
+  return SystemCoreClock;
+}
+
+#endif
@@ -1,10 +1,12 @@
 #include <stdio.h>
 #include "FreeRTOS.h"
 #include "task.h"
+#include "trace_recorder.h"
 
 void vAssertFailed(char* file, uint32_t line)
 {
   taskDISABLE_INTERRUPTS(); 
   printf("Assertion failed, file: %s, line %u\n", file, line);
+  traceStop();  // keep the events that led up to it for the debugger
   for( ;; );
 };
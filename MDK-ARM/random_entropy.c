@@ -0,0 +1,29 @@
+#include "task_random.h"
+#include "main.h"
+
+// Seed source for Random/task_random.c, read from the STM32F4 hardware RNG.
+// The RNG runs from the 48MHz PLLQ clock the USB host already needs.
+
+static RNG_HandleTypeDef hrng;
+
+uint32_t randomGetEntropy(void)
+{
+  uint32_t value = 0;
+
+  // the HAL handle is not thread safe, keep other tasks off the peripheral
+  vTaskSuspendAll();
+  if (hrng.Instance == NULL)
+  {
+    __HAL_RCC_RNG_CLK_ENABLE();
+    hrng.Instance = RNG;
+    HAL_RNG_Init(&hrng);
+  }
+  if (HAL_RNG_GenerateRandomNumber(&hrng, &value) != HAL_OK)
+  {
+    // seed or clock error - fall back on the SysTick count
+    value = SysTick->VAL ^ HAL_GetTick();
+  }
+  xTaskResumeAll();
+
+  return (value != 0) ? value : 1;
+}
@@ -0,0 +1,23 @@
+#include "trace_recorder.h"
+#include "main.h"
+
+// Timestamps for Trace/trace_recorder.c on the target, from the DWT cycle
+// counter, which counts CPU cycles and wraps every 25s at 168MHz. The counter
+// is not cleared, the run time clock (cpu_load_port.c) counts on it too.
+
+#if (configUSE_TRACE_RECORDER == 1)
+
+uint32_t tracePortInit(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  return SystemCoreClock;
+}
+
+uint32_t tracePortGetTimestamp(void)
+{
+  return DWT->CYCCNT;
+}
+
+#endif
@@ -0,0 +1,209 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "barrier.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Stored in the event list item value of the tasks released by a trip, so a
+task can tell whether it was released or timed out.  It is important it does
+not clash with the taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
+#if configUSE_16_BIT_TICKS == 1
+	#define barrierUNBLOCKED_BY_TRIP	0x0200U
+#else
+	#define barrierUNBLOCKED_BY_TRIP	0x02000000UL
+#endif
+
+typedef struct BarrierDef_t
+{
+	UBaseType_t uxParties;				/*< The number of tasks that must arrive before the barrier trips. */
+	UBaseType_t uxArrived;				/*< The number of tasks that have arrived in the current phase. */
+	UBaseType_t uxGeneration;			/*< Incremented each time the barrier trips. */
+	List_t xTasksWaitingForBarrier;		/*< List of tasks waiting for the barrier to trip. */
+} Barrier_t;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	BarrierHandle_t xBarrierCreate( const UBaseType_t uxParties )
+	{
+	Barrier_t *pxBarrier;
+
+		configASSERT( uxParties > ( UBaseType_t ) 0 );
+
+		pxBarrier = ( Barrier_t * ) pvPortMalloc( sizeof( Barrier_t ) ); /*lint !e9087 !e9079 pvPortMalloc() meets the alignment requirements of the structure. */
+
+		if( pxBarrier != NULL )
+		{
+			pxBarrier->uxParties = uxParties;
+			pxBarrier->uxArrived = 0;
+			pxBarrier->uxGeneration = 0;
+			vListInitialise( &( pxBarrier->xTasksWaitingForBarrier ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxBarrier;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+BaseType_t xBarrierWait( BarrierHandle_t xBarrier, TickType_t xTicksToWait )
+{
+Barrier_t *pxBarrier = xBarrier;
+List_t * const pxWaitingList = &( pxBarrier->xTasksWaitingForBarrier );
+BaseType_t xReturn, xAlreadyYielded;
+UBaseType_t uxGeneration;
+
+	configASSERT( pxBarrier );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	vTaskSuspendAll();
+	{
+		uxGeneration = pxBarrier->uxGeneration;
+		( pxBarrier->uxArrived )++;
+
+		if( pxBarrier->uxArrived == pxBarrier->uxParties )
+		{
+			/* The last party has arrived.  Start the next phase, then release
+			every waiting task.  The tasks are only moved to the ready lists
+			here - none of them can run until the scheduler is resumed. */
+			pxBarrier->uxArrived = 0;
+			( pxBarrier->uxGeneration )++;
+
+			while( listLIST_IS_EMPTY( pxWaitingList ) == pdFALSE )
+			{
+				vTaskRemoveFromUnorderedEventList( listGET_HEAD_ENTRY( pxWaitingList ), barrierUNBLOCKED_BY_TRIP );
+			}
+
+			xReturn = barrierSERIAL_TASK;
+			xTicksToWait = 0;
+		}
+		else if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			vTaskPlaceOnUnorderedEventList( pxWaitingList, ( TickType_t ) 0, xTicksToWait );
+
+			/* Set after the task unblocks. */
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			/* The barrier has not tripped and no block time was specified,
+			so leave again. */
+			( pxBarrier->uxArrived )--;
+			xReturn = pdFAIL;
+		}
+	}
+	xAlreadyYielded = xTaskResumeAll();
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Either the barrier tripped, in which case the flag is set in the
+		task's event list item, or the block time expired. */
+		if( ( uxTaskResetEventItemValue() & barrierUNBLOCKED_BY_TRIP ) != ( TickType_t ) 0 )
+		{
+			xReturn = pdPASS;
+		}
+		else
+		{
+			taskENTER_CRITICAL();
+			{
+				/* The barrier may have tripped after the task timed out but
+				before it ran again, in which case it was counted as one of
+				the parties and has passed. */
+				if( pxBarrier->uxGeneration == uxGeneration )
+				{
+					( pxBarrier->uxArrived )--;
+					xReturn = pdFAIL;
+				}
+				else
+				{
+					xReturn = pdPASS;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxBarrierGetWaiting( BarrierHandle_t xBarrier )
+{
+const Barrier_t *pxBarrier = xBarrier;
+
+	configASSERT( pxBarrier );
+	return pxBarrier->uxArrived;
+}
+/*-----------------------------------------------------------*/
+
+void vBarrierDelete( BarrierHandle_t xBarrier )
+{
+Barrier_t *pxBarrier = xBarrier;
+
+	configASSERT( pxBarrier );
+
+	/* A waiting task would be left blocked on freed memory. */
+	configASSERT( listLIST_IS_EMPTY( &( pxBarrier->xTasksWaitingForBarrier ) ) != pdFALSE );
+
+	vPortFree( pxBarrier );
+}
+/*-----------------------------------------------------------*/
+
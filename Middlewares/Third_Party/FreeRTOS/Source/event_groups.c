@@ -53,11 +53,13 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x0200U
 	#define eventWAIT_FOR_ALL_BITS			0x0400U
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff00U
+	#define eventEVENT_BITS_COUNT			8U
 #else
 	#define eventCLEAR_EVENTS_ON_EXIT_BIT	0x01000000UL
 	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x02000000UL
 	#define eventWAIT_FOR_ALL_BITS			0x04000000UL
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
+	#define eventEVENT_BITS_COUNT			24U
 #endif
 
 typedef struct EventGroupDef_t
@@ -65,6 +67,11 @@ typedef struct EventGroupDef_t
 	EventBits_t uxEventBits;
 	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
 
+	#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+		List_t xTasksWaitingForBit[ eventEVENT_BITS_COUNT ];	/*< Tasks that cannot be unblocked until the bit of the same number is set.  xTasksWaitingForBits then only holds tasks waiting for any one of several bits. */
+		EventBits_t uxAnyBitsWaitedFor;	/*< The bits waited for by the tasks in xTasksWaitingForBits.  Can include bits of tasks that have since timed out. */
+	#endif
+
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxEventGroupNumber;
 	#endif
@@ -86,6 +93,44 @@ typedef struct EventGroupDef_t
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Unblock the tasks on pxList whose wait condition is met by the current event
+ * bits, and return the bits to clear because the unblocked tasks asked for
+ * them to be cleared on exit.  Called with the scheduler suspended.
+ */
+static EventBits_t prvUnblockWaiters( EventGroup_t *pxEventBits, List_t const * pxList ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+
+	/*
+	 * Initialise the lists that index the tasks blocked on an event group by
+	 * the bits they wait for.
+	 */
+	static void prvInitialiseWaiterIndex( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the list a task waiting for uxBitsToWaitFor should block on, given
+	 * its wait condition is not met by the current event bits.  A task that
+	 * waits for all of its bits, or for a single bit, goes on the list of one of
+	 * its bits that is clear - it cannot be unblocked until that bit is set.  A
+	 * task that waits for any one of several bits could be unblocked by any of
+	 * them, so goes on xTasksWaitingForBits, which is only searched when one of
+	 * the bits its tasks wait for is set.
+	 */
+	static List_t *prvGetWaiterList( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return the number of the lowest bit set in uxBits, which must not be 0.
+	 */
+	static UBaseType_t prvLowestBit( EventBits_t uxBits ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/* All the tasks blocked on the event group share one list. */
+	#define prvGetWaiterList( pxEventBits, uxBitsToWaitFor, xWaitForAllBits ) ( &( ( pxEventBits )->xTasksWaitingForBits ) )
+
+#endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -115,6 +160,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 			pxEventBits->uxEventBits = 0;
 			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+			#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+			{
+				prvInitialiseWaiterIndex( pxEventBits );
+			}
+			#endif
+
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
 				/* Both static and dynamic allocation can be used, so note that
@@ -166,6 +217,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 			pxEventBits->uxEventBits = 0;
 			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+			#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+			{
+				prvInitialiseWaiterIndex( pxEventBits );
+			}
+			#endif
+
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
 				/* Both static and dynamic allocation can be used, so note this
@@ -229,7 +286,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				vTaskPlaceOnUnorderedEventList( prvGetWaiterList( pxEventBits, uxBitsToWaitFor, pdTRUE ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -384,7 +441,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			vTaskPlaceOnUnorderedEventList( prvGetWaiterList( pxEventBits, uxBitsToWaitFor, xWaitForAllBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -518,87 +575,64 @@ EventBits_t uxReturn;
 
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
 {
-ListItem_t *pxListItem, *pxNext;
-ListItem_t const *pxListEnd;
-List_t const * pxList;
-EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+EventBits_t uxBitsToClear = 0;
 EventGroup_t *pxEventBits = xEventGroup;
-BaseType_t xMatchFound = pdFALSE;
 
 	/* Check the user is not attempting to set the bits used by the kernel
 	itself. */
 	configASSERT( xEventGroup );
 	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-	pxList = &( pxEventBits->xTasksWaitingForBits );
-	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-		pxListItem = listGET_HEAD_ENTRY( pxList );
-
-		/* Set the bits. */
-		pxEventBits->uxEventBits |= uxBitsToSet;
-
-		/* See if the new bit value should unblock any tasks. */
-		while( pxListItem != pxListEnd )
+		#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
 		{
-			pxNext = listGET_NEXT( pxListItem );
-			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-			xMatchFound = pdFALSE;
+		EventBits_t uxBitsChanged;
+		UBaseType_t uxBit;
+
+			/* A blocked task's wait condition was not met by the bits that
+			were already set, so only the bits that change from clear to set
+			can unblock it. */
+			uxBitsChanged = uxBitsToSet & ~( pxEventBits->uxEventBits );
 
-			/* Split the bits waited for from the control bits. */
-			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+			/* Set the bits. */
+			pxEventBits->uxEventBits |= uxBitsToSet;
 
-			if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+			/* Tasks still waiting after the lists of the changed bits have
+			been searched are moved to the list of a bit that is still clear,
+			so are not seen twice. */
+			for( uxBit = 0; uxBit < eventEVENT_BITS_COUNT; uxBit++ )
 			{
-				/* Just looking for single bit being set. */
-				if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+				if( ( uxBitsChanged & ( ( EventBits_t ) 1 << uxBit ) ) != ( EventBits_t ) 0 )
 				{
-					xMatchFound = pdTRUE;
+					uxBitsToClear |= prvUnblockWaiters( pxEventBits, &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
-			else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+
+			if( ( uxBitsChanged & pxEventBits->uxAnyBitsWaitedFor ) != ( EventBits_t ) 0 )
 			{
-				/* All bits are set. */
-				xMatchFound = pdTRUE;
+				uxBitsToClear |= prvUnblockWaiters( pxEventBits, &( pxEventBits->xTasksWaitingForBits ) );
 			}
 			else
 			{
-				/* Need all bits to be set, but not all the bits were set. */
-			}
-
-			if( xMatchFound != pdFALSE )
-			{
-				/* The bits match.  Should the bits be cleared on exit? */
-				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-				{
-					uxBitsToClear |= uxBitsWaitedFor;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-
-				/* Store the actual event flag value in the task's event list
-				item before removing the task from the event list.  The
-				eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-				that is was unblocked due to its required bits matching, rather
-				than because it timed out. */
-				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+				mtCOVERAGE_TEST_MARKER();
 			}
+		}
+		#else
+		{
+			/* Set the bits. */
+			pxEventBits->uxEventBits |= uxBitsToSet;
 
-			/* Move onto the next list item.  Note pxListItem->pxNext is not
-			used here as the list item may have been removed from the event list
-			and inserted into the ready/pending reading list. */
-			pxListItem = pxNext;
+			/* See if the new bit value should unblock any tasks. */
+			uxBitsToClear = prvUnblockWaiters( pxEventBits, &( pxEventBits->xTasksWaitingForBits ) );
 		}
+		#endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
 
 		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
 		bit was set in the control word. */
@@ -610,6 +644,107 @@ BaseType_t xMatchFound = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
+static EventBits_t prvUnblockWaiters( EventGroup_t *pxEventBits, List_t const * pxList )
+{
+ListItem_t *pxListItem, *pxNext;
+ListItem_t const *pxListEnd;
+EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+BaseType_t xMatchFound;
+
+	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+	pxListItem = listGET_HEAD_ENTRY( pxList );
+
+	#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+	{
+		/* The bits waited for by the tasks left on xTasksWaitingForBits are
+		worked out again as the list is searched. */
+		if( pxList == &( pxEventBits->xTasksWaitingForBits ) )
+		{
+			pxEventBits->uxAnyBitsWaitedFor = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	while( pxListItem != pxListEnd )
+	{
+		pxNext = listGET_NEXT( pxListItem );
+		uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+		xMatchFound = pdFALSE;
+
+		/* Split the bits waited for from the control bits. */
+		uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+		uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+		if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+		{
+			/* Just looking for single bit being set. */
+			if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+			{
+				xMatchFound = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+		{
+			/* All bits are set. */
+			xMatchFound = pdTRUE;
+		}
+		else
+		{
+			/* Need all bits to be set, but not all the bits were set. */
+		}
+
+		if( xMatchFound != pdFALSE )
+		{
+			/* The bits match.  Should the bits be cleared on exit? */
+			if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+			{
+				uxBitsToClear |= uxBitsWaitedFor;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Store the actual event flag value in the task's event list
+			item before removing the task from the event list.  The
+			eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+			that is was unblocked due to its required bits matching, rather
+			than because it timed out. */
+			vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+		}
+		#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+		else if( pxList == &( pxEventBits->xTasksWaitingForBits ) )
+		{
+			pxEventBits->uxAnyBitsWaitedFor |= uxBitsWaitedFor;
+		}
+		else
+		{
+			/* The task waits for all of its bits, and the bit whose list it
+			is on has been set, so move it to the list of one of its bits that
+			is still clear. */
+			( void ) uxListRemove( pxListItem );
+			vListInsertEnd( prvGetWaiterList( pxEventBits, uxBitsWaitedFor, pdTRUE ), pxListItem );
+		}
+		#endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+
+		/* Move onto the next list item.  Note pxListItem->pxNext is not
+		used here as the list item may have been removed from the event list
+		and inserted into the ready/pending reading list. */
+		pxListItem = pxNext;
+	}
+
+	return uxBitsToClear;
+}
+/*-----------------------------------------------------------*/
+
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
 EventGroup_t *pxEventBits = xEventGroup;
@@ -627,6 +762,23 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
 		}
 
+		#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+		{
+		UBaseType_t uxBit;
+		const List_t *pxTasksWaitingForBit;
+
+			for( uxBit = 0; uxBit < eventEVENT_BITS_COUNT; uxBit++ )
+			{
+				pxTasksWaitingForBit = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+
+				while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBit ) > ( UBaseType_t ) 0 )
+				{
+					vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBit->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+				}
+			}
+		}
+		#endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
 			/* The event group can only have been allocated dynamically - free
@@ -703,6 +855,69 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+
+	static void prvInitialiseWaiterIndex( EventGroup_t *pxEventBits )
+	{
+	UBaseType_t uxBit;
+
+		for( uxBit = 0; uxBit < eventEVENT_BITS_COUNT; uxBit++ )
+		{
+			vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+		}
+
+		pxEventBits->uxAnyBitsWaitedFor = 0;
+	}
+
+#endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+
+	static List_t *prvGetWaiterList( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits )
+	{
+	List_t *pxList;
+	EventBits_t uxBitsClear;
+
+		/* Only the bits that are clear can still unblock the task.  If it
+		waits for any bit they all are. */
+		uxBitsClear = uxBitsToWaitFor & ~( pxEventBits->uxEventBits );
+		configASSERT( uxBitsClear != ( EventBits_t ) 0 );
+
+		if( ( xWaitForAllBits != pdFALSE ) || ( ( uxBitsClear & ( uxBitsClear - ( EventBits_t ) 1 ) ) == ( EventBits_t ) 0 ) )
+		{
+			pxList = &( pxEventBits->xTasksWaitingForBit[ prvLowestBit( uxBitsClear ) ] );
+		}
+		else
+		{
+			pxEventBits->uxAnyBitsWaitedFor |= uxBitsToWaitFor;
+			pxList = &( pxEventBits->xTasksWaitingForBits );
+		}
+
+		return pxList;
+	}
+
+#endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+
+	static UBaseType_t prvLowestBit( EventBits_t uxBits )
+	{
+	UBaseType_t uxBit = 0;
+
+		while( ( uxBits & ( EventBits_t ) 1 ) == ( EventBits_t ) 0 )
+		{
+			uxBits >>= 1;
+			uxBit++;
+		}
+
+		return uxBit;
+	}
+
+#endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
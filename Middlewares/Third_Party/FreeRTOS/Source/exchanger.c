@@ -0,0 +1,366 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "exchanger.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* A task waiting for a partner.  The record lives on the waiting task's
+stack for as long as the task is in xExchangerPair(). */
+typedef struct ExchangerWaiter
+{
+	struct ExchangerWaiter *pxNext;		/*< The next task of the same class to have arrived. */
+	TaskHandle_t xTask;
+	void *pvItem;						/*< Passed to the partner. */
+	void *pvPartnerItem;				/*< Written by the task that forms the pair. */
+	volatile BaseType_t xPaired;		/*< Set, under a critical section, when the pair is formed. */
+} ExchangerWaiter_t;
+
+typedef struct ExchangerDef_t
+{
+	ExchangerWaiter_t *pxHead[ 2 ];		/*< Longest waiting task of each class. */
+	ExchangerWaiter_t *pxTail[ 2 ];		/*< Most recent task of each class to start waiting. */
+	UBaseType_t uxMaxPairs;				/*< The number of pairs that can be working at the same time. */
+	UBaseType_t uxActivePairs;			/*< Pairs formed for which vExchangerPairDone() has not been called. */
+} Exchanger_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Add a waiting task to the back of its class's queue, remove the task at the
+ * front of a class's queue, or remove a task that timed out from wherever it
+ * is in its queue.  Must be called from a critical section.
+ */
+static void prvAppend( Exchanger_t *pxExchanger, BaseType_t xClass, ExchangerWaiter_t *pxWaiter ) PRIVILEGED_FUNCTION;
+static ExchangerWaiter_t *prvRemoveHead( Exchanger_t *pxExchanger, BaseType_t xClass ) PRIVILEGED_FUNCTION;
+static void prvRemove( Exchanger_t *pxExchanger, BaseType_t xClass, const ExchangerWaiter_t *pxWaiter ) PRIVILEGED_FUNCTION;
+
+/*
+ * Pair the longest waiting leader with the longest waiting follower, for as
+ * long as both queues hold a task and a pair slot is free.  Must be called
+ * from a critical section.
+ */
+static void prvPairWaitingTasks( Exchanger_t *pxExchanger ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	ExchangerHandle_t xExchangerCreate( const UBaseType_t uxMaxPairs )
+	{
+	Exchanger_t *pxExchanger;
+
+		configASSERT( uxMaxPairs > ( UBaseType_t ) 0 );
+
+		pxExchanger = ( Exchanger_t * ) pvPortMalloc( sizeof( Exchanger_t ) ); /*lint !e9087 !e9079 pvPortMalloc() meets the alignment requirements of the structure. */
+
+		if( pxExchanger != NULL )
+		{
+			pxExchanger->pxHead[ exchangerLEADER ] = NULL;
+			pxExchanger->pxTail[ exchangerLEADER ] = NULL;
+			pxExchanger->pxHead[ exchangerFOLLOWER ] = NULL;
+			pxExchanger->pxTail[ exchangerFOLLOWER ] = NULL;
+			pxExchanger->uxMaxPairs = uxMaxPairs;
+			pxExchanger->uxActivePairs = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxExchanger;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+BaseType_t xExchangerPair( ExchangerHandle_t xExchanger, BaseType_t xClass, void *pvItem, void **ppvPartnerItem, TickType_t xTicksToWait )
+{
+Exchanger_t *pxExchanger = xExchanger;
+ExchangerWaiter_t xSelf, *pxPartner;
+const BaseType_t xOtherClass = ( xClass == exchangerLEADER ) ? exchangerFOLLOWER : exchangerLEADER;
+TimeOut_t xTimeOut;
+BaseType_t xReturn, xNotified = pdFALSE;
+UBaseType_t uxOtherNotifications = 0;
+
+	configASSERT( pxExchanger );
+	configASSERT( ( xClass == exchangerLEADER ) || ( xClass == exchangerFOLLOWER ) );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	xSelf.pxNext = NULL;
+	xSelf.xTask = xTaskGetCurrentTaskHandle();
+	xSelf.pvItem = pvItem;
+	xSelf.pvPartnerItem = NULL;
+	xSelf.xPaired = pdFALSE;
+
+	taskENTER_CRITICAL();
+	{
+		if( ( pxExchanger->pxHead[ xOtherClass ] != NULL ) && ( pxExchanger->uxActivePairs < pxExchanger->uxMaxPairs ) )
+		{
+			/* A partner is waiting and there is room for another pair - pair
+			with the partner that has waited the longest and wake it. */
+			pxPartner = prvRemoveHead( pxExchanger, xOtherClass );
+			( pxExchanger->uxActivePairs )++;
+
+			pxPartner->pvPartnerItem = pvItem;
+			pxPartner->xPaired = pdTRUE;
+			xSelf.pvPartnerItem = pxPartner->pvItem;
+			xSelf.xPaired = pdTRUE;
+
+			( void ) xTaskNotifyGive( pxPartner->xTask );
+		}
+		else if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			prvAppend( pxExchanger, xClass, &xSelf );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( ( xSelf.xPaired == pdFALSE ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+	{
+		/* Wait to be paired.  The pairing task sets xPaired then gives
+		exactly one notification, so counts are taken one at a time, and a
+		count taken before xPaired is set belongs to the application and is
+		given back below. */
+		vTaskSetTimeOutState( &xTimeOut );
+
+		while( xNotified == pdFALSE )
+		{
+			if( ulTaskNotifyTake( pdFALSE, xTicksToWait ) != 0UL )
+			{
+				if( xSelf.xPaired != pdFALSE )
+				{
+					xNotified = pdTRUE;
+				}
+				else
+				{
+					uxOtherNotifications++;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( xNotified == pdFALSE ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE ) )
+			{
+				break;
+			}
+		}
+
+		if( xNotified == pdFALSE )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( xSelf.xPaired == pdFALSE )
+				{
+					/* Timed out - leave the queue before the record goes out
+					of scope. */
+					prvRemove( pxExchanger, xClass, &xSelf );
+				}
+				else
+				{
+					/* Paired after timing out but before getting here, so the
+					notification is still pending. */
+					( void ) ulTaskNotifyTake( pdFALSE, 0 );
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		while( uxOtherNotifications > ( UBaseType_t ) 0 )
+		{
+			( void ) xTaskNotifyGive( xSelf.xTask );
+			uxOtherNotifications--;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xSelf.xPaired != pdFALSE )
+	{
+		if( ppvPartnerItem != NULL )
+		{
+			*ppvPartnerItem = xSelf.pvPartnerItem;
+		}
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vExchangerPairDone( ExchangerHandle_t xExchanger )
+{
+Exchanger_t *pxExchanger = xExchanger;
+
+	configASSERT( pxExchanger );
+
+	taskENTER_CRITICAL();
+	{
+		configASSERT( pxExchanger->uxActivePairs > ( UBaseType_t ) 0 );
+		( pxExchanger->uxActivePairs )--;
+
+		/* Tasks may have queued up behind the slot that was just freed. */
+		prvPairWaitingTasks( pxExchanger );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vExchangerDelete( ExchangerHandle_t xExchanger )
+{
+Exchanger_t *pxExchanger = xExchanger;
+
+	configASSERT( pxExchanger );
+
+	/* A waiting task would be left with a partner that can never come. */
+	configASSERT( pxExchanger->pxHead[ exchangerLEADER ] == NULL );
+	configASSERT( pxExchanger->pxHead[ exchangerFOLLOWER ] == NULL );
+
+	vPortFree( pxExchanger );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPairWaitingTasks( Exchanger_t *pxExchanger )
+{
+ExchangerWaiter_t *pxLeader, *pxFollower;
+
+	while( ( pxExchanger->pxHead[ exchangerLEADER ] != NULL ) &&
+		   ( pxExchanger->pxHead[ exchangerFOLLOWER ] != NULL ) &&
+		   ( pxExchanger->uxActivePairs < pxExchanger->uxMaxPairs ) )
+	{
+		pxLeader = prvRemoveHead( pxExchanger, exchangerLEADER );
+		pxFollower = prvRemoveHead( pxExchanger, exchangerFOLLOWER );
+		( pxExchanger->uxActivePairs )++;
+
+		pxLeader->pvPartnerItem = pxFollower->pvItem;
+		pxFollower->pvPartnerItem = pxLeader->pvItem;
+		pxLeader->xPaired = pdTRUE;
+		pxFollower->xPaired = pdTRUE;
+
+		( void ) xTaskNotifyGive( pxLeader->xTask );
+		( void ) xTaskNotifyGive( pxFollower->xTask );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvAppend( Exchanger_t *pxExchanger, BaseType_t xClass, ExchangerWaiter_t *pxWaiter )
+{
+	if( pxExchanger->pxTail[ xClass ] == NULL )
+	{
+		pxExchanger->pxHead[ xClass ] = pxWaiter;
+	}
+	else
+	{
+		pxExchanger->pxTail[ xClass ]->pxNext = pxWaiter;
+	}
+
+	pxExchanger->pxTail[ xClass ] = pxWaiter;
+}
+/*-----------------------------------------------------------*/
+
+static ExchangerWaiter_t *prvRemoveHead( Exchanger_t *pxExchanger, BaseType_t xClass )
+{
+ExchangerWaiter_t *pxWaiter = pxExchanger->pxHead[ xClass ];
+
+	pxExchanger->pxHead[ xClass ] = pxWaiter->pxNext;
+
+	if( pxExchanger->pxHead[ xClass ] == NULL )
+	{
+		pxExchanger->pxTail[ xClass ] = NULL;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxWaiter;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemove( Exchanger_t *pxExchanger, BaseType_t xClass, const ExchangerWaiter_t *pxWaiter )
+{
+ExchangerWaiter_t *pxPrevious = NULL, *pxCurrent = pxExchanger->pxHead[ xClass ];
+
+	while( ( pxCurrent != NULL ) && ( pxCurrent != pxWaiter ) )
+	{
+		pxPrevious = pxCurrent;
+		pxCurrent = pxCurrent->pxNext;
+	}
+
+	configASSERT( pxCurrent != NULL );
+
+	if( pxPrevious == NULL )
+	{
+		pxExchanger->pxHead[ xClass ] = pxCurrent->pxNext;
+	}
+	else
+	{
+		pxPrevious->pxNext = pxCurrent->pxNext;
+	}
+
+	if( pxExchanger->pxTail[ xClass ] == pxCurrent )
+	{
+		pxExchanger->pxTail[ xClass ] = pxPrevious;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
@@ -716,6 +716,13 @@ hold explicit before calling the code. */
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
 
+#ifndef configRUN_TIME_COUNTER_TYPE
+	/* The type of the run time counters.  A 32 bit counter of a clock fast
+	enough to time context switches wraps within seconds, so set it to
+	uint64_t in FreeRTOSConfig.h for such a clock. */
+	#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
@@ -762,6 +769,30 @@ hold explicit before calling the code. */
 	#define configUSE_TICKLESS_IDLE 0
 #endif
 
+#ifndef configUSE_TIMING_WHEEL
+	#define configUSE_TIMING_WHEEL 0
+#endif
+
+#ifndef configTIMING_WHEEL_SLOTS
+	#define configTIMING_WHEEL_SLOTS 256
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOTS
+	#define configTIMER_WHEEL_SLOTS 256
+#endif
+
+#ifndef configUSE_TIMER_COMMAND_RING
+	#define configUSE_TIMER_COMMAND_RING 0
+#endif
+
+#ifndef configTIMER_COMMAND_BATCH
+	#define configTIMER_COMMAND_BATCH 8
+#endif
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
 	#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -778,6 +809,80 @@ hold explicit before calling the code. */
 	#define configUSE_QUEUE_SETS 0
 #endif
 
+#ifndef configUSE_QUEUE_ZERO_COPY
+	#define configUSE_QUEUE_ZERO_COPY 0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_REGIONS
+	#define configUSE_STREAM_BUFFER_REGIONS 0
+#endif
+
+#ifndef configUSE_MIRRORED_STREAM_BUFFERS
+	#define configUSE_MIRRORED_STREAM_BUFFERS 0
+#endif
+
+#ifndef configUSE_MULTI_PRODUCER_STREAM_BUFFERS
+	#define configUSE_MULTI_PRODUCER_STREAM_BUFFERS 0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_WAITER_INDEX
+	#define configUSE_EVENT_GROUP_WAITER_INDEX 0
+#endif
+
+#ifndef configUSE_MUTEX_FAST_PATH
+	#define configUSE_MUTEX_FAST_PATH 0
+#endif
+
+#ifndef configUSE_QUEUE_CONTENTION_STATS
+	#define configUSE_QUEUE_CONTENTION_STATS 0
+#endif
+
+#ifndef configNUMBER_OF_CORES
+	#define configNUMBER_OF_CORES 1
+#endif
+
+#ifndef configUSE_CORE_AFFINITY
+	#define configUSE_CORE_AFFINITY 0
+#endif
+
+#ifndef portGET_CORE_ID
+	#define portGET_CORE_ID() ( ( BaseType_t ) 0 )
+#endif
+
+#ifndef portWAIT_FOR_INTERRUPT
+	#define portWAIT_FOR_INTERRUPT()
+#endif
+
+#if( configNUMBER_OF_CORES > 1 )
+	/* A port that runs the scheduler on more than one core must provide the
+	following.  portYIELD_CORE() interrupts another core so it reselects its
+	task, portSET_INTERRUPT_MASK() and portCLEAR_INTERRUPT_MASK() mask and
+	restore interrupts on the calling core only, and portGET_KERNEL_LOCK() and
+	portRELEASE_KERNEL_LOCK() take and give the recursive lock that serialises
+	the kernel between cores.  The kernel lock is always taken with interrupts
+	masked, and is taken by portENTER_CRITICAL() as well.
+	portGET_CRITICAL_NESTING_COUNT() returns the calling core's critical
+	nesting depth. */
+	#ifndef portYIELD_CORE
+		#error portYIELD_CORE() must be defined when configNUMBER_OF_CORES is greater than 1
+	#endif
+	#ifndef portSET_INTERRUPT_MASK
+		#error portSET_INTERRUPT_MASK() must be defined when configNUMBER_OF_CORES is greater than 1
+	#endif
+	#ifndef portCLEAR_INTERRUPT_MASK
+		#error portCLEAR_INTERRUPT_MASK() must be defined when configNUMBER_OF_CORES is greater than 1
+	#endif
+	#ifndef portGET_KERNEL_LOCK
+		#error portGET_KERNEL_LOCK() must be defined when configNUMBER_OF_CORES is greater than 1
+	#endif
+	#ifndef portRELEASE_KERNEL_LOCK
+		#error portRELEASE_KERNEL_LOCK() must be defined when configNUMBER_OF_CORES is greater than 1
+	#endif
+	#ifndef portGET_CRITICAL_NESTING_COUNT
+		#error portGET_CRITICAL_NESTING_COUNT() must be defined when configNUMBER_OF_CORES is greater than 1
+	#endif
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
 	#define portTASK_USES_FLOATING_POINT()
 #endif
@@ -872,6 +977,31 @@ hold explicit before calling the code. */
 	#endif /* INCLUDE_vTaskSuspend */
 #endif /* configUSE_TICKLESS_IDLE */
 
+#if( configUSE_TIMING_WHEEL == 1 )
+	#if( ( configTIMING_WHEEL_SLOTS < 32 ) || ( ( configTIMING_WHEEL_SLOTS & ( configTIMING_WHEEL_SLOTS - 1 ) ) != 0 ) )
+		#error configTIMING_WHEEL_SLOTS must be a power of 2 and at least 32
+	#endif
+#endif /* configUSE_TIMING_WHEEL */
+
+#if( configUSE_TIMER_WHEEL == 1 )
+	#if( ( configTIMER_WHEEL_SLOTS < 32 ) || ( ( configTIMER_WHEEL_SLOTS & ( configTIMER_WHEEL_SLOTS - 1 ) ) != 0 ) )
+		#error configTIMER_WHEEL_SLOTS must be a power of 2 and at least 32
+	#endif
+#endif /* configUSE_TIMER_WHEEL */
+
+#if( configUSE_TIMER_COMMAND_RING == 1 )
+	#if( ( configTIMER_QUEUE_LENGTH < 2 ) || ( ( configTIMER_QUEUE_LENGTH & ( configTIMER_QUEUE_LENGTH - 1 ) ) != 0 ) )
+		#error configTIMER_QUEUE_LENGTH must be a power of 2 when configUSE_TIMER_COMMAND_RING is 1
+	#endif
+	#if( configTIMER_COMMAND_BATCH < 1 )
+		#error configTIMER_COMMAND_BATCH must be at least 1
+	#endif
+#endif /* configUSE_TIMER_COMMAND_RING */
+
+#if( ( configUSE_MIRRORED_STREAM_BUFFERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use mirrored stream buffers
+#endif
+
 #if( ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
 	#error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
@@ -880,6 +1010,26 @@ hold explicit before calling the code. */
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( ( configUSE_MUTEX_FAST_PATH == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use the mutex fast path
+#endif
+
+#if( configNUMBER_OF_CORES > 1 )
+	#if( configUSE_TICKLESS_IDLE != 0 )
+		#error configUSE_TICKLESS_IDLE cannot be used when configNUMBER_OF_CORES is greater than 1
+	#endif
+	#if( portCRITICAL_NESTING_IN_TCB == 1 )
+		#error portCRITICAL_NESTING_IN_TCB cannot be used when configNUMBER_OF_CORES is greater than 1
+	#endif
+	#if( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+		#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to create an idle task per core
+	#endif
+#endif
+
+#if( ( configUSE_CORE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
+	#error configNUMBER_OF_CORES must be greater than 1 to use core affinity
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
 	#define configINITIAL_TICK_COUNT 0
 #endif
@@ -1138,7 +1288,9 @@ typedef struct xSTATIC_TCB
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulDummy16;
+		configRUN_TIME_COUNTER_TYPE	ulDummy16;
+		uint32_t		ulDummy25;
+		void			*pxDummy26[ 2 ];
 	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
@@ -1157,6 +1309,12 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_POSIX_ERRNO == 1 )
 		int				iDummy22;
 	#endif
+	#if ( configNUMBER_OF_CORES > 1 )
+		BaseType_t		xDummy23;
+		#if ( configUSE_CORE_AFFINITY == 1 )
+			UBaseType_t	uxDummy24;
+		#endif
+	#endif
 } StaticTask_t;
 
 /*
@@ -1187,6 +1345,10 @@ typedef struct xSTATIC_QUEUE
 	UBaseType_t uxDummy4[ 3 ];
 	uint8_t ucDummy5[ 2 ];
 
+	#if( configUSE_QUEUE_ZERO_COPY == 1 )
+		void *pvDummy10[ 2 ];
+	#endif
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucDummy6;
 	#endif
@@ -1200,6 +1362,12 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+		uint32_t ulDummy11[ 25 ];	/* QueueContentionStats_t, with its 16 histogram buckets. */
+		TickType_t xDummy12;
+		BaseType_t xDummy13;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1222,6 +1390,15 @@ typedef struct xSTATIC_EVENT_GROUP
 	TickType_t xDummy1;
 	StaticList_t xDummy2;
 
+	#if( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+		#if( configUSE_16_BIT_TICKS == 1 )
+			StaticList_t xDummy5[ 8 ];
+		#else
+			StaticList_t xDummy5[ 24 ];
+		#endif
+		TickType_t xDummy6;
+	#endif
+
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy3;
 	#endif
@@ -1277,6 +1454,13 @@ typedef struct xSTATIC_TIMER
 typedef struct xSTATIC_STREAM_BUFFER
 {
 	size_t uxDummy1[ 4 ];
+	#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+		size_t xDummy5[ 2 ];
+	#endif
+	#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		uint32_t ulDummy6;
+		StaticList_t xDummy7;
+	#endif
 	void * pvDummy2[ 3 ];
 	uint8_t ucDummy3;
 	#if ( configUSE_TRACE_FACILITY == 1 )
@@ -29,9 +29,9 @@
  * @file atomic.h
  * @brief FreeRTOS atomic operation support.
  *
- * This file implements atomic functions by disabling interrupts globally.
- * Implementations with architecture specific atomic instructions can be
- * provided under each compiler directory.
+ * This file implements atomic functions by disabling interrupts globally,
+ * unless the port provides lock free primitives built from architecture
+ * specific atomic instructions (see portHAS_ATOMIC_INSTRUCTIONS below).
  */
 
 #ifndef ATOMIC_H
@@ -84,6 +84,24 @@ extern "C" {
 	#define portFORCE_INLINE
 #endif
 
+/*
+ * Port specific definition -- lock free primitives.
+ * A port that can update memory atomically without masking interrupts defines
+ * portHAS_ATOMIC_INSTRUCTIONS to 1 and provides:
+ *
+ *   uint32_t ulPortAtomicCompareAndSwap_u32( uint32_t volatile *, uint32_t ulExchange, uint32_t ulComparand );
+ *   uint32_t ulPortAtomicCompareAndSwapPointers( void * volatile *, void *pvExchange, void *pvComparand );
+ *   uint32_t ulPortAtomicFetchAndAdd_u32( uint32_t volatile *, uint32_t ulCount );
+ *
+ * The compare-and-swap functions return 1 if the value was swapped and 0 if
+ * not, the fetch-and-add returns the value before the add.  Every function in
+ * this file is then built from those three, and none of them touch the
+ * interrupt mask.  Otherwise the critical section implementations are used.
+ */
+#ifndef portHAS_ATOMIC_INSTRUCTIONS
+	#define portHAS_ATOMIC_INSTRUCTIONS 0
+#endif
+
 #define ATOMIC_COMPARE_AND_SWAP_SUCCESS	 0x1U		/**< Compare and swap succeeded, swapped. */
 #define ATOMIC_COMPARE_AND_SWAP_FAILURE	 0x0U		/**< Compare and swap failed, did not swap. */
 
@@ -108,6 +126,9 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u32( uint32_t volatile *
 															uint32_t ulExchange,
 															uint32_t ulComparand )
 {
+#if( portHAS_ATOMIC_INSTRUCTIONS == 1 )
+	return ulPortAtomicCompareAndSwap_u32( pulDestination, ulExchange, ulComparand );
+#else
 uint32_t ulReturnValue;
 
 	ATOMIC_ENTER_CRITICAL();
@@ -125,6 +146,7 @@ uint32_t ulReturnValue;
 	ATOMIC_EXIT_CRITICAL();
 
 	return ulReturnValue;
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -143,6 +165,16 @@ uint32_t ulReturnValue;
 static portFORCE_INLINE void * Atomic_SwapPointers_p32( void * volatile * ppvDestination,
 														void * pvExchange )
 {
+#if( portHAS_ATOMIC_INSTRUCTIONS == 1 )
+void * pReturnValue;
+
+	do
+	{
+		pReturnValue = *ppvDestination;
+	} while( ulPortAtomicCompareAndSwapPointers( ppvDestination, pvExchange, pReturnValue ) == ATOMIC_COMPARE_AND_SWAP_FAILURE );
+
+	return pReturnValue;
+#else
 void * pReturnValue;
 
 	ATOMIC_ENTER_CRITICAL();
@@ -153,6 +185,7 @@ void * pReturnValue;
 	ATOMIC_EXIT_CRITICAL();
 
 	return pReturnValue;
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -176,6 +209,9 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwapPointers_p32( void * volat
 																	void * pvExchange,
 																	void * pvComparand )
 {
+#if( portHAS_ATOMIC_INSTRUCTIONS == 1 )
+	return ulPortAtomicCompareAndSwapPointers( ppvDestination, pvExchange, pvComparand );
+#else
 uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
 
 	ATOMIC_ENTER_CRITICAL();
@@ -189,6 +225,7 @@ uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
 	ATOMIC_EXIT_CRITICAL();
 
 	return ulReturnValue;
+#endif
 }
 
 
@@ -208,6 +245,9 @@ uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
 static portFORCE_INLINE uint32_t Atomic_Add_u32( uint32_t volatile * pulAddend,
 												 uint32_t ulCount )
 {
+#if( portHAS_ATOMIC_INSTRUCTIONS == 1 )
+	return ulPortAtomicFetchAndAdd_u32( pulAddend, ulCount );
+#else
 	uint32_t ulCurrent;
 
 	ATOMIC_ENTER_CRITICAL();
@@ -218,6 +258,7 @@ static portFORCE_INLINE uint32_t Atomic_Add_u32( uint32_t volatile * pulAddend,
 	ATOMIC_EXIT_CRITICAL();
 
 	return ulCurrent;
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -236,6 +277,9 @@ static portFORCE_INLINE uint32_t Atomic_Add_u32( uint32_t volatile * pulAddend,
 static portFORCE_INLINE uint32_t Atomic_Subtract_u32( uint32_t volatile * pulAddend,
 													  uint32_t ulCount )
 {
+#if( portHAS_ATOMIC_INSTRUCTIONS == 1 )
+	return ulPortAtomicFetchAndAdd_u32( pulAddend, ( uint32_t ) 0U - ulCount );
+#else
 	uint32_t ulCurrent;
 
 	ATOMIC_ENTER_CRITICAL();
@@ -246,6 +290,7 @@ static portFORCE_INLINE uint32_t Atomic_Subtract_u32( uint32_t volatile * pulAdd
 	ATOMIC_EXIT_CRITICAL();
 
 	return ulCurrent;
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -261,6 +306,9 @@ static portFORCE_INLINE uint32_t Atomic_Subtract_u32( uint32_t volatile * pulAdd
  */
 static portFORCE_INLINE uint32_t Atomic_Increment_u32( uint32_t volatile * pulAddend )
 {
+#if( portHAS_ATOMIC_INSTRUCTIONS == 1 )
+	return ulPortAtomicFetchAndAdd_u32( pulAddend, 1U );
+#else
 uint32_t ulCurrent;
 
 	ATOMIC_ENTER_CRITICAL();
@@ -271,6 +319,7 @@ uint32_t ulCurrent;
 	ATOMIC_EXIT_CRITICAL();
 
 	return ulCurrent;
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -286,6 +335,9 @@ uint32_t ulCurrent;
  */
 static portFORCE_INLINE uint32_t Atomic_Decrement_u32( uint32_t volatile * pulAddend )
 {
+#if( portHAS_ATOMIC_INSTRUCTIONS == 1 )
+	return ulPortAtomicFetchAndAdd_u32( pulAddend, ( uint32_t ) 0U - 1U );
+#else
 uint32_t ulCurrent;
 
 	ATOMIC_ENTER_CRITICAL();
@@ -296,6 +348,7 @@ uint32_t ulCurrent;
 	ATOMIC_EXIT_CRITICAL();
 
 	return ulCurrent;
+#endif
 }
 
 /*----------------------------- Bitwise Logical ------------------------------*/
@@ -314,6 +367,16 @@ uint32_t ulCurrent;
 static portFORCE_INLINE uint32_t Atomic_OR_u32( uint32_t volatile * pulDestination,
 												uint32_t ulValue )
 {
+#if( portHAS_ATOMIC_INSTRUCTIONS == 1 )
+uint32_t ulCurrent;
+
+	do
+	{
+		ulCurrent = *pulDestination;
+	} while( ulPortAtomicCompareAndSwap_u32( pulDestination, ulCurrent | ulValue, ulCurrent ) == ATOMIC_COMPARE_AND_SWAP_FAILURE );
+
+	return ulCurrent;
+#else
 uint32_t ulCurrent;
 
 	ATOMIC_ENTER_CRITICAL();
@@ -324,6 +387,7 @@ uint32_t ulCurrent;
 	ATOMIC_EXIT_CRITICAL();
 
 	return ulCurrent;
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -341,6 +405,16 @@ uint32_t ulCurrent;
 static portFORCE_INLINE uint32_t Atomic_AND_u32( uint32_t volatile * pulDestination,
 												 uint32_t ulValue )
 {
+#if( portHAS_ATOMIC_INSTRUCTIONS == 1 )
+uint32_t ulCurrent;
+
+	do
+	{
+		ulCurrent = *pulDestination;
+	} while( ulPortAtomicCompareAndSwap_u32( pulDestination, ulCurrent & ulValue, ulCurrent ) == ATOMIC_COMPARE_AND_SWAP_FAILURE );
+
+	return ulCurrent;
+#else
 uint32_t ulCurrent;
 
 	ATOMIC_ENTER_CRITICAL();
@@ -351,6 +425,7 @@ uint32_t ulCurrent;
 	ATOMIC_EXIT_CRITICAL();
 
 	return ulCurrent;
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -368,6 +443,16 @@ uint32_t ulCurrent;
 static portFORCE_INLINE uint32_t Atomic_NAND_u32( uint32_t volatile * pulDestination,
 												  uint32_t ulValue )
 {
+#if( portHAS_ATOMIC_INSTRUCTIONS == 1 )
+uint32_t ulCurrent;
+
+	do
+	{
+		ulCurrent = *pulDestination;
+	} while( ulPortAtomicCompareAndSwap_u32( pulDestination, ~( ulCurrent & ulValue ), ulCurrent ) == ATOMIC_COMPARE_AND_SWAP_FAILURE );
+
+	return ulCurrent;
+#else
 uint32_t ulCurrent;
 
 	ATOMIC_ENTER_CRITICAL();
@@ -378,6 +463,7 @@ uint32_t ulCurrent;
 	ATOMIC_EXIT_CRITICAL();
 
 	return ulCurrent;
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -395,6 +481,16 @@ uint32_t ulCurrent;
 static portFORCE_INLINE uint32_t Atomic_XOR_u32( uint32_t volatile * pulDestination,
 												 uint32_t ulValue )
 {
+#if( portHAS_ATOMIC_INSTRUCTIONS == 1 )
+uint32_t ulCurrent;
+
+	do
+	{
+		ulCurrent = *pulDestination;
+	} while( ulPortAtomicCompareAndSwap_u32( pulDestination, ulCurrent ^ ulValue, ulCurrent ) == ATOMIC_COMPARE_AND_SWAP_FAILURE );
+
+	return ulCurrent;
+#else
 uint32_t ulCurrent;
 
 	ATOMIC_ENTER_CRITICAL();
@@ -405,6 +501,7 @@ uint32_t ulCurrent;
 	ATOMIC_EXIT_CRITICAL();
 
 	return ulCurrent;
+#endif
 }
 
 #ifdef __cplusplus
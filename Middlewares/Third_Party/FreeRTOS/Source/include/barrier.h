@@ -0,0 +1,174 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef BARRIER_H
+#define BARRIER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include barrier.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A barrier is a synchronisation point for a fixed number of tasks (the
+ * parties).  Each task calls xBarrierWait() and blocks until the last of the
+ * parties arrives, at which point all of them are released together and the
+ * barrier resets itself, ready to be used again.
+ *
+ * A barrier does the job of the two turnstile "reusable barrier" from the
+ * Little Book of Semaphores with a single kernel object.  Each time the
+ * barrier trips its generation count is incremented (sense reversal), so a
+ * task that races around to wait again cannot be confused with the tasks
+ * still leaving the previous phase, and every waiting task is released in one
+ * sweep of a single event list.
+ *
+ * Barriers can only be created dynamically, and must not be used from an
+ * interrupt.
+ *
+ * \defgroup Barrier
+ */
+
+/**
+ * barrier.h
+ *
+ * Type by which barriers are referenced.
+ *
+ * \defgroup BarrierHandle_t BarrierHandle_t
+ * \ingroup Barrier
+ */
+struct BarrierDef_t;
+typedef struct BarrierDef_t * BarrierHandle_t;
+
+/* Returned by xBarrierWait() to exactly one of the parties - the last one to
+arrive - each time the barrier trips. */
+#define barrierSERIAL_TASK		( ( BaseType_t ) 2 )
+
+/**
+ * barrier.h
+ *<pre>
+ BarrierHandle_t xBarrierCreate( UBaseType_t uxParties );
+ </pre>
+ *
+ * Create a new barrier for uxParties tasks.
+ *
+ * @param uxParties The number of tasks that must call xBarrierWait() before
+ * any of them is released.  Must be at least 1.
+ *
+ * @return If the barrier was created then a handle to the barrier is
+ * returned.  If there was insufficient FreeRTOS heap available to create the
+ * barrier then NULL is returned.
+ *
+ * \defgroup xBarrierCreate xBarrierCreate
+ * \ingroup Barrier
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	BarrierHandle_t xBarrierCreate( const UBaseType_t uxParties ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * barrier.h
+ *<pre>
+ BaseType_t xBarrierWait( BarrierHandle_t xBarrier, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Arrive at the barrier and wait for the rest of the parties.
+ *
+ * @param xBarrier The barrier to wait at.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for the rest of the parties to arrive.  A task that times out leaves
+ * the barrier, so the barrier then waits for another task to take its place.
+ *
+ * @return barrierSERIAL_TASK to the task whose arrival tripped the barrier,
+ * pdPASS to every other task released by the same trip, or pdFAIL if the
+ * call timed out before the barrier tripped.
+ *
+ * Example usage:
+   <pre>
+ #define WORKERS 4
+
+ BarrierHandle_t xPhase;    // Created with xBarrierCreate( WORKERS ).
+
+ void vWorker( void *pvParameters )
+ {
+    for( ;; )
+    {
+        vComputeMyShareOfThePhase();
+
+        if( xBarrierWait( xPhase, portMAX_DELAY ) == barrierSERIAL_TASK )
+        {
+            // Exactly one worker gets here each phase.
+            vPublishThePhaseResult();
+        }
+    }
+ }
+   </pre>
+ * \defgroup xBarrierWait xBarrierWait
+ * \ingroup Barrier
+ */
+BaseType_t xBarrierWait( BarrierHandle_t xBarrier, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * barrier.h
+ *<pre>
+ UBaseType_t uxBarrierGetWaiting( BarrierHandle_t xBarrier );
+ </pre>
+ *
+ * @return The number of tasks that have arrived at the barrier in the current
+ * phase and are waiting for the rest.
+ *
+ * \defgroup uxBarrierGetWaiting uxBarrierGetWaiting
+ * \ingroup Barrier
+ */
+UBaseType_t uxBarrierGetWaiting( BarrierHandle_t xBarrier ) PRIVILEGED_FUNCTION;
+
+/**
+ * barrier.h
+ *<pre>
+ void vBarrierDelete( BarrierHandle_t xBarrier );
+ </pre>
+ *
+ * Delete a barrier that was previously created by a call to
+ * xBarrierCreate().  No task may be waiting at the barrier.
+ *
+ * @param xBarrier The barrier being deleted.
+ *
+ * \defgroup vBarrierDelete vBarrierDelete
+ * \ingroup Barrier
+ */
+void vBarrierDelete( BarrierHandle_t xBarrier ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BARRIER_H */
+
+
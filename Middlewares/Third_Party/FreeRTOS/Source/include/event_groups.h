@@ -423,6 +423,12 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
  * Setting bits in an event group will automatically unblock tasks that are
  * blocked waiting for the bits.
  *
+ * Every task blocked on the event group is tested each time bits are set, with
+ * the scheduler suspended.  When configUSE_EVENT_GROUP_WAITER_INDEX is set to 1
+ * in FreeRTOSConfig.h blocked tasks are instead indexed by the bits they wait
+ * for, so only tasks waiting for a bit that was clear before the call are
+ * tested.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -0,0 +1,185 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef EXCHANGER_H
+#define EXCHANGER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include exchanger.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * An exchanger pairs tasks of two classes - leaders and followers, producers
+ * and consumers - in the order they arrive.  A task that arrives when a task
+ * of the other class is waiting is paired with the one that has waited the
+ * longest, and the two swap a pointer.  Otherwise it waits in its own class's
+ * queue for a partner.
+ *
+ * The number of pairs that may be working at the same time is set when the
+ * exchanger is created.  A pair counts as working from the moment it is
+ * formed until one of the two tasks calls vExchangerPairDone().  While every
+ * pair slot is taken, arriving tasks queue up even if a partner is waiting,
+ * and they are paired in arrival order as slots are freed.
+ *
+ * A waiting task is described by a record on its own stack and is woken with
+ * a direct to task notification, so an exchanger uses no heap beyond the
+ * exchanger itself and pairing costs one short critical section.  As with
+ * stream buffers, a task must not rely on its notification value while it is
+ * blocked in xExchangerPair().
+ *
+ * Exchangers can only be created dynamically, and must not be used from an
+ * interrupt.
+ *
+ * \defgroup Exchanger
+ */
+
+/**
+ * exchanger.h
+ *
+ * Type by which exchangers are referenced.
+ *
+ * \defgroup ExchangerHandle_t ExchangerHandle_t
+ * \ingroup Exchanger
+ */
+struct ExchangerDef_t;
+typedef struct ExchangerDef_t * ExchangerHandle_t;
+
+/* The two classes of task that are paired with each other. */
+#define exchangerLEADER		( ( BaseType_t ) 0 )
+#define exchangerFOLLOWER	( ( BaseType_t ) 1 )
+
+/**
+ * exchanger.h
+ *<pre>
+ ExchangerHandle_t xExchangerCreate( UBaseType_t uxMaxPairs );
+ </pre>
+ *
+ * Create a new exchanger.
+ *
+ * @param uxMaxPairs The number of pairs that can be working at the same time.
+ * Must be at least 1.
+ *
+ * @return If the exchanger was created then a handle to the exchanger is
+ * returned.  If there was insufficient FreeRTOS heap available to create the
+ * exchanger then NULL is returned.
+ *
+ * \defgroup xExchangerCreate xExchangerCreate
+ * \ingroup Exchanger
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	ExchangerHandle_t xExchangerCreate( const UBaseType_t uxMaxPairs ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * exchanger.h
+ *<pre>
+ BaseType_t xExchangerPair( ExchangerHandle_t xExchanger, BaseType_t xClass, void *pvItem, void **ppvPartnerItem, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Wait for a task of the other class and pair up with it.
+ *
+ * @param xExchanger The exchanger to pair through.
+ *
+ * @param xClass The class of the calling task, exchangerLEADER or
+ * exchangerFOLLOWER.
+ *
+ * @param pvItem Passed to the partner.
+ *
+ * @param ppvPartnerItem Receives the pvItem of the partner.  Can be NULL.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for a partner and a free pair slot.
+ *
+ * @return pdPASS if the task was paired, or pdFAIL if it timed out.
+ *
+ * Example usage:
+   <pre>
+ ExchangerHandle_t xDanceFloor;  // Created with xExchangerCreate( 2 ).
+
+ void vLeader( void *pvParameters )
+ {
+ void *pvPartner;
+
+    for( ;; )
+    {
+        xExchangerPair( xDanceFloor, exchangerLEADER, pvParameters, &pvPartner, portMAX_DELAY );
+        vDanceWith( pvPartner );
+
+        // The leader gives the pair slot back, the follower does not.
+        vExchangerPairDone( xDanceFloor );
+    }
+ }
+   </pre>
+ * \defgroup xExchangerPair xExchangerPair
+ * \ingroup Exchanger
+ */
+BaseType_t xExchangerPair( ExchangerHandle_t xExchanger, BaseType_t xClass, void *pvItem, void **ppvPartnerItem, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * exchanger.h
+ *<pre>
+ void vExchangerPairDone( ExchangerHandle_t xExchanger );
+ </pre>
+ *
+ * Free the pair slot taken when a pair was formed, letting the next waiting
+ * leader and follower pair up.  Must be called exactly once per pair, by
+ * either of its tasks.
+ *
+ * @param xExchanger The exchanger the pair was formed through.
+ *
+ * \defgroup vExchangerPairDone vExchangerPairDone
+ * \ingroup Exchanger
+ */
+void vExchangerPairDone( ExchangerHandle_t xExchanger ) PRIVILEGED_FUNCTION;
+
+/**
+ * exchanger.h
+ *<pre>
+ void vExchangerDelete( ExchangerHandle_t xExchanger );
+ </pre>
+ *
+ * Delete an exchanger that was previously created by a call to
+ * xExchangerCreate().  No task may be waiting in the exchanger.
+ *
+ * @param xExchanger The exchanger being deleted.
+ *
+ * \defgroup vExchangerDelete vExchangerDelete
+ * \ingroup Exchanger
+ */
+void vExchangerDelete( ExchangerHandle_t xExchanger ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EXCHANGER_H */
+
+
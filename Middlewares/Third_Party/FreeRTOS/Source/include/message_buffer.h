@@ -207,6 +207,64 @@ MessageBufferHandle_t xMessageBuffer;
  */
 #define xMessageBufferCreateStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, pdTRUE, pucMessageBufferStorageArea, pxStaticMessageBuffer )
 
+/**
+ * message_buffer.h
+ *
+<pre>
+MessageBufferHandle_t xMessageBufferCreateMirrored( size_t xBufferSizeBytes );
+</pre>
+ *
+ * Creates a new message buffer, as xMessageBufferCreate() does, whose storage
+ * area is mapped twice, back to back - see xStreamBufferCreateMirrored().
+ * configUSE_MIRRORED_STREAM_BUFFERS must be set to 1 in FreeRTOSConfig.h for
+ * xMessageBufferCreateMirrored() to be available.
+ *
+ * \defgroup xMessageBufferCreateMirrored xMessageBufferCreateMirrored
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCreateMirrored( xBufferSizeBytes ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateMirrored( xBufferSizeBytes, ( size_t ) 0, pdTRUE )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+MessageBufferHandle_t xMessageBufferCreateMultiProducer( size_t xBufferSizeBytes );
+</pre>
+ *
+ * Creates a new message buffer, as xMessageBufferCreate() does, that any
+ * number of tasks and interrupts can send to at once without a critical
+ * section or a mutex - see xStreamBufferCreateMultiProducer().  Each message
+ * is reserved and written whole, so messages from different writers are never
+ * interleaved, and the reader only receives messages that have been written in
+ * full.  configUSE_MULTI_PRODUCER_STREAM_BUFFERS must be set to 1 in
+ * FreeRTOSConfig.h for xMessageBufferCreateMultiProducer() to be available.
+ *
+ * A message in a multi-producer message buffer can be split at the end of the
+ * storage area, so neither xMessageBufferAcquireWrite() nor
+ * xMessageBufferAcquireRead() can be used on one.
+ *
+ * \defgroup xMessageBufferCreateMultiProducer xMessageBufferCreateMultiProducer
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCreateMultiProducer( xBufferSizeBytes ) ( MessageBufferHandle_t ) xStreamBufferGenericCreate( xBufferSizeBytes, ( size_t ) 0, ( pdTRUE | sbCREATE_MULTI_PRODUCER ) )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+MessageBufferHandle_t xMessageBufferCreateMultiProducerStatic( size_t xBufferSizeBytes,
+                                                               uint8_t *pucMessageBufferStorageArea,
+                                                               StaticMessageBuffer_t *pxStaticMessageBuffer );
+</pre>
+ *
+ * A version of xMessageBufferCreateMultiProducer() that uses statically
+ * allocated memory, as xMessageBufferCreateStatic() does.
+ *
+ * \defgroup xMessageBufferCreateMultiProducerStatic xMessageBufferCreateMultiProducerStatic
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCreateMultiProducerStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, ( pdTRUE | sbCREATE_MULTI_PRODUCER ), pucMessageBufferStorageArea, pxStaticMessageBuffer )
+
 /**
  * message_buffer.h
  *
@@ -796,6 +854,110 @@ BaseType_t xMessageBufferReceiveCompletedFromISR( MessageBufferHandle_t xStreamB
  */
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) xStreamBufferReceiveCompletedFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxHigherPriorityTaskWoken )
 
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferAcquireWrite( MessageBufferHandle_t xMessageBuffer,
+                                   void **ppvRegion,
+                                   size_t xBytesWanted,
+                                   TickType_t xTicksToWait );
+</pre>
+ *
+ * Gets a contiguous region of xBytesWanted bytes in the message buffer's
+ * storage area for the next message, so the writer can build the message in
+ * place rather than have xMessageBufferSend() copy it.
+ * vMessageBufferCommitWrite() then adds the message.  See
+ * xStreamBufferAcquireWrite(), which this maps onto.
+ *
+ * With configUSE_STREAM_BUFFER_REGIONS set to 1 a message is never split at the
+ * end of the storage area, so any message can be read in place too.  A message
+ * that would be split is written from the start of the storage area instead,
+ * and the bytes it skips count as used until it is read - so a message can
+ * wait for, or be refused for want of, a little more space than it takes up.
+ *
+ * @param xMessageBuffer The handle of the message buffer to write to.
+ *
+ * @param ppvRegion Set to the start of the region, or NULL if none was
+ * acquired.
+ *
+ * @param xBytesWanted The largest message the writer might write.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for room for the message, as for xMessageBufferSend().
+ *
+ * @return xBytesWanted, or 0 if the calling task timed out before there was
+ * room for the message.
+ *
+ * \defgroup xMessageBufferAcquireWrite xMessageBufferAcquireWrite
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferAcquireWrite( xMessageBuffer, ppvRegion, xBytesWanted, xTicksToWait ) xStreamBufferAcquireWrite( ( StreamBufferHandle_t ) xMessageBuffer, ppvRegion, xBytesWanted, xTicksToWait )
+#define xMessageBufferAcquireWriteFromISR( xMessageBuffer, ppvRegion, xBytesWanted ) xStreamBufferAcquireWriteFromISR( ( StreamBufferHandle_t ) xMessageBuffer, ppvRegion, xBytesWanted )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+void vMessageBufferCommitWrite( MessageBufferHandle_t xMessageBuffer, size_t xBytesWritten );
+</pre>
+ *
+ * Adds the first xBytesWritten bytes of the region last acquired by
+ * xMessageBufferAcquireWrite() to the message buffer as one message, which can
+ * be shorter than the region.  0 releases the region without adding a message.
+ * See vStreamBufferCommitWrite(), which this maps onto.
+ *
+ * \defgroup vMessageBufferCommitWrite vMessageBufferCommitWrite
+ * \ingroup MessageBufferManagement
+ */
+#define vMessageBufferCommitWrite( xMessageBuffer, xBytesWritten ) vStreamBufferCommitWrite( ( StreamBufferHandle_t ) xMessageBuffer, xBytesWritten )
+#define vMessageBufferCommitWriteFromISR( xMessageBuffer, xBytesWritten, pxHigherPriorityTaskWoken ) vStreamBufferCommitWriteFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xBytesWritten, pxHigherPriorityTaskWoken )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferAcquireRead( MessageBufferHandle_t xMessageBuffer,
+                                  void **ppvRegion,
+                                  TickType_t xTicksToWait );
+</pre>
+ *
+ * Gets the next message in place, rather than have xMessageBufferReceive()
+ * copy it out.  vMessageBufferConsume() then removes it.  See
+ * xStreamBufferAcquireRead(), which this maps onto.
+ *
+ * @param xMessageBuffer The handle of the message buffer to read from.
+ *
+ * @param ppvRegion Set to the start of the message, or NULL if there is none.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for a message, as for xMessageBufferReceive().
+ *
+ * @return The length of the message, or 0 if the calling task timed out before
+ * a message arrived.
+ *
+ * \defgroup xMessageBufferAcquireRead xMessageBufferAcquireRead
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferAcquireRead( xMessageBuffer, ppvRegion, xTicksToWait ) xStreamBufferAcquireRead( ( StreamBufferHandle_t ) xMessageBuffer, ppvRegion, xTicksToWait )
+#define xMessageBufferAcquireReadFromISR( xMessageBuffer, ppvRegion ) xStreamBufferAcquireReadFromISR( ( StreamBufferHandle_t ) xMessageBuffer, ppvRegion )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+void vMessageBufferConsume( MessageBufferHandle_t xMessageBuffer );
+</pre>
+ *
+ * Removes the message last acquired by xMessageBufferAcquireRead() from the
+ * message buffer.  See vStreamBufferConsume(), which this maps onto.
+ *
+ * \defgroup vMessageBufferConsume vMessageBufferConsume
+ * \ingroup MessageBufferManagement
+ */
+#define vMessageBufferConsume( xMessageBuffer ) vStreamBufferConsume( ( StreamBufferHandle_t ) xMessageBuffer, ( size_t ) 0 )
+#define vMessageBufferConsumeFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) vStreamBufferConsumeFromISR( ( StreamBufferHandle_t ) xMessageBuffer, ( size_t ) 0, pxHigherPriorityTaskWoken )
+
 #if defined( __cplusplus )
 } /* extern "C" */
 #endif
@@ -166,6 +166,17 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Map *pxSize bytes twice, back to back, so the byte after the last one is the
+ * first one again, for the storage area of a mirrored stream buffer.  *pxSize
+ * is rounded up to what the port can map.  Only ports that can remap memory
+ * provide these.
+ */
+#if( configUSE_MIRRORED_STREAM_BUFFERS == 1 )
+	void *pvPortMallocMirrored( size_t *pxSize ) PRIVILEGED_FUNCTION;
+	void vPortFreeMirrored( void *pv, size_t xSize ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
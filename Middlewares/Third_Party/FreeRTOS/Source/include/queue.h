@@ -66,6 +66,9 @@ typedef struct QueueDefinition * QueueSetMemberHandle_t;
 #define	queueSEND_TO_FRONT		( ( BaseType_t ) 1 )
 #define queueOVERWRITE			( ( BaseType_t ) 2 )
 
+/* Passed to xQueueGiveMultiple() to give one count per blocked task. */
+#define queueGIVE_ALL_WAITERS	( ~( UBaseType_t ) 0 )
+
 /* For internal use only.  These definitions *must* match those in queue.c. */
 #define queueQUEUE_TYPE_BASE				( ( uint8_t ) 0U )
 #define queueQUEUE_TYPE_SET					( ( uint8_t ) 0U )
@@ -1295,6 +1298,111 @@ uint32_t ulVarToSend, ulValReceived;
 BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Use xSemaphoreGiveMultiple() or xSemaphoreGiveAll()
+ * instead of calling this function directly.
+ */
+BaseType_t xQueueGiveMultiple( QueueHandle_t xQueue, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueSendMultiple(
+									QueueHandle_t xQueue,
+									const void * pvItems,
+									UBaseType_t uxCount,
+									TickType_t xTicksToWait
+								);
+ * </pre>
+ *
+ * Post up to uxCount items to the back of a queue in one operation.  The
+ * items are copied into the queue, and up to one task per item that is
+ * blocked waiting to receive from the queue is unblocked, inside a single
+ * critical section, and the calling task yields at most once - instead of
+ * once per item as when xQueueSend() is called in a loop.
+ *
+ * As many of the items as there is room for are sent, in order.  If there is
+ * no room at all the calling task blocks, as it would in xQueueSend(), until
+ * there is room for at least one item or xTicksToWait expires.  A caller that
+ * must send every item calls the function again with the items that are left.
+ *
+ * This function must not be called from an interrupt service routine.  See
+ * xQueueSendMultipleFromISR() for an alternative which may be used in an ISR.
+ * It cannot be used with a semaphore or mutex - see xSemaphoreGiveMultiple().
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to uxCount items stored one after the other, each
+ * the size the queue was created to hold.
+ *
+ * @param uxCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it be full.
+ *
+ * @return The number of items posted - zero if the queue stayed full for the
+ * whole of xTicksToWait.
+ *
+ * Example usage:
+   <pre>
+ #define SAMPLES 16
+
+ void vADCTask( void *pvParameters )
+ {
+ uint16_t usSamples[ SAMPLES ];
+ UBaseType_t uxSent;
+
+	for( ;; )
+	{
+		vReadSamples( usSamples, SAMPLES );
+
+		// The queue was created with xQueueCreate( 64, sizeof( uint16_t ) ).
+		for( uxSent = 0; uxSent < SAMPLES; )
+		{
+			uxSent += xQueueSendMultiple( xSampleQueue, &( usSamples[ uxSent ] ), SAMPLES - uxSent, portMAX_DELAY );
+		}
+	}
+ }
+   </pre>
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueSendMultipleFromISR(
+										QueueHandle_t xQueue,
+										const void *pvItems,
+										UBaseType_t uxCount,
+										BaseType_t *pxHigherPriorityTaskWoken
+									);
+ * </pre>
+ *
+ * A version of xQueueSendMultiple() that can be used in an interrupt service
+ * routine.  It sends as many of the items as there is room for without
+ * blocking, and unblocks up to one waiting task per item sent.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to uxCount items stored one after the other.
+ *
+ * @param uxCount The number of items to post.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueSendMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if sending the items caused a task to
+ * unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If xQueueSendMultipleFromISR() sets this value to pdTRUE
+ * then a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * <pre>
@@ -1384,6 +1492,263 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherP
  */
 BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueReceiveMultiple(
+									QueueHandle_t xQueue,
+									void *pvBuffer,
+									UBaseType_t uxMaxCount,
+									TickType_t xTicksToWait
+								);
+ * </pre>
+ *
+ * Receive up to uxMaxCount items from a queue in one operation.  The items
+ * are copied out of the queue, and up to one task per item that is blocked
+ * waiting to send to the queue is unblocked, inside a single critical
+ * section, and the calling task yields at most once.
+ *
+ * Every item waiting is received, up to uxMaxCount.  If the queue is empty
+ * the calling task blocks, as it would in xQueueReceive(), until at least one
+ * item arrives or xTicksToWait expires.
+ *
+ * Items should not be received from a queue that is a member of a queue set
+ * with this function, as the queue set holds an entry per item.
+ *
+ * This function must not be called from an interrupt service routine.  See
+ * xQueueReceiveMultipleFromISR() for an alternative that can.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer with room for uxMaxCount items.
+ *
+ * @param uxMaxCount The most items to receive.  Must be at least one.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of the
+ * call.
+ *
+ * @return The number of items received - zero if the queue stayed empty for
+ * the whole of xTicksToWait.
+ *
+ * Example usage:
+   <pre>
+ void vLogWriterTask( void *pvParameters )
+ {
+ LogRecord_t xRecords[ 8 ];
+ UBaseType_t uxReceived, ux;
+
+	for( ;; )
+	{
+		uxReceived = xQueueReceiveMultiple( xLogQueue, xRecords, 8, portMAX_DELAY );
+
+		for( ux = 0; ux < uxReceived; ux++ )
+		{
+			vWriteRecord( &( xRecords[ ux ] ) );
+		}
+	}
+ }
+   </pre>
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ UBaseType_t xQueueReceiveMultipleFromISR(
+										QueueHandle_t xQueue,
+										void *pvBuffer,
+										UBaseType_t uxMaxCount,
+										BaseType_t *pxHigherPriorityTaskWoken
+									);
+ * </pre>
+ *
+ * A version of xQueueReceiveMultiple() that can be used in an interrupt
+ * service routine.  It receives the items that are waiting, up to
+ * uxMaxCount, without blocking.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer with room for uxMaxCount items.
+ *
+ * @param uxMaxCount The most items to receive.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueReceiveMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if making space in the queue caused a
+ * task to unblock, and the unblocked task has a priority higher than the
+ * currently running task.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueReserveSlot(
+							QueueHandle_t xQueue,
+							TickType_t xTicksToWait
+						);
+ * </pre>
+ *
+ * Reserve the slot at the back of a queue so the next item can be written
+ * straight into the queue storage instead of being copied in.  Fill the item
+ * in place through the returned pointer, then call vQueueCommitSlot() to send
+ * it.  Only available when configUSE_QUEUE_ZERO_COPY is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * The calling task blocks, as it would in xQueueSend(), while the queue is
+ * full.  A queue has only one reserved slot at a time, and nothing else can be
+ * sent to the queue until it is committed - other senders, and other callers
+ * of pvQueueReserveSlot(), block as though the queue were full - so the slot
+ * should be filled in and committed promptly.  xQueueOverwrite() and
+ * xQueueSendToFront() must not be used on a queue with a reserved slot.
+ *
+ * The pointer is only valid until vQueueCommitSlot() is called.  It lies a
+ * whole number of items into the queue storage area, so it is aligned for the
+ * item type whenever the storage area is.
+ *
+ * This function must not be called from an interrupt service routine, or on
+ * a semaphore.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already be
+ * full.
+ *
+ * @return A pointer to the reserved slot, which holds one item of the queue's
+ * item size, or NULL if there was no space for the whole of xTicksToWait.
+ *
+ * Example usage:
+   <pre>
+ void vSensorTask( void *pvParameters )
+ {
+ Frame_t *pxFrame;
+
+	for( ;; )
+	{
+		pxFrame = ( Frame_t * ) pvQueueReserveSlot( xFrameQueue, portMAX_DELAY );
+
+		// Fill the frame in place.
+		vReadFrame( pxFrame );
+
+		vQueueCommitSlot( xFrameQueue );
+	}
+ }
+   </pre>
+ * \defgroup pvQueueReserveSlot pvQueueReserveSlot
+ * \ingroup QueueManagement
+ */
+void *pvQueueReserveSlot( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ void vQueueCommitSlot( QueueHandle_t xQueue );
+ * </pre>
+ *
+ * Send the item written into the slot returned by pvQueueReserveSlot().  The
+ * item is sent to the back of the queue, exactly as if it had been copied in
+ * with xQueueSend(), and a task blocked waiting to receive it is unblocked.
+ * Only available when configUSE_QUEUE_ZERO_COPY is set to 1 in
+ * FreeRTOSConfig.h.
+ *
+ * Must only be called by the task that reserved the slot.
+ *
+ * @param xQueue The handle to the queue the slot was reserved on.
+ *
+ * \defgroup vQueueCommitSlot vQueueCommitSlot
+ * \ingroup QueueManagement
+ */
+void vQueueCommitSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueuePeekSlot(
+						QueueHandle_t xQueue,
+						TickType_t xTicksToWait
+					);
+ * </pre>
+ *
+ * Borrow the item at the front of a queue so it can be read where it is
+ * instead of being copied out.  Use the item through the returned pointer,
+ * then call vQueueReleaseSlot() to remove it from the queue.  Only available
+ * when configUSE_QUEUE_ZERO_COPY is set to 1 in FreeRTOSConfig.h.
+ *
+ * The calling task blocks, as it would in xQueueReceive(), while the queue is
+ * empty.  A queue has only one peeked slot at a time, and nothing else can be
+ * received from the queue until it is released - other receivers, and other
+ * callers of pvQueuePeekSlot(), block as though the queue were empty - so the
+ * item should be used and released promptly.  xQueuePeek() still copies the
+ * borrowed item.  xQueueOverwrite() and xQueueSendToFront() must not be used
+ * on a queue with a peeked slot.
+ *
+ * The pointer is only valid until vQueueReleaseSlot() is called.
+ *
+ * This function must not be called from an interrupt service routine, or on
+ * a semaphore.
+ *
+ * @param xQueue The handle to the queue from which the item is to be
+ * received.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of the
+ * call.
+ *
+ * @return A pointer to the item at the front of the queue, or NULL if the
+ * queue stayed empty for the whole of xTicksToWait.
+ *
+ * Example usage:
+   <pre>
+ void vProcessingTask( void *pvParameters )
+ {
+ const Frame_t *pxFrame;
+
+	for( ;; )
+	{
+		pxFrame = ( const Frame_t * ) pvQueuePeekSlot( xFrameQueue, portMAX_DELAY );
+
+		// Use the frame where it is.
+		vProcessFrame( pxFrame );
+
+		vQueueReleaseSlot( xFrameQueue );
+	}
+ }
+   </pre>
+ * \defgroup pvQueuePeekSlot pvQueuePeekSlot
+ * \ingroup QueueManagement
+ */
+void *pvQueuePeekSlot( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ void vQueueReleaseSlot( QueueHandle_t xQueue );
+ * </pre>
+ *
+ * Remove the item borrowed with pvQueuePeekSlot() from the queue, exactly as
+ * if it had been copied out with xQueueReceive(), and unblock a task waiting
+ * for the space it leaves.  Only available when configUSE_QUEUE_ZERO_COPY is
+ * set to 1 in FreeRTOSConfig.h.
+ *
+ * Must only be called by the task that peeked the slot.
+ *
+ * @param xQueue The handle to the queue the slot was peeked on.
+ *
+ * \defgroup vQueueReleaseSlot vQueueReleaseSlot
+ * \ingroup QueueManagement
+ */
+void vQueueReleaseSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -1487,6 +1852,78 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
 	const char *pcQueueGetName( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 #endif
 
+#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+
+/* Bucket 0 of the wait histogram counts waits of less than a tick, bucket n
+waits of 2^(n-1) to 2^n - 1 ticks, and the last bucket everything longer. */
+#define queueCONTENTION_HISTOGRAM_BUCKETS	16
+
+/*
+ * Contention counters kept for every queue, semaphore and mutex when
+ * configUSE_QUEUE_CONTENTION_STATS is set to 1 in FreeRTOSConfig.h.  A take
+ * is a successful xSemaphoreTake() (xQueueSemaphoreTake()), and it is
+ * contended if it found the semaphore or mutex unavailable and had to wait.
+ * An object is held from the take that leaves no token available until the
+ * give, by a task, that makes one available again - for a mutex, the time the
+ * holder keeps it.  All times are in ticks.
+ */
+typedef struct xQUEUE_CONTENTION_STATS
+{
+	uint32_t ulTakes;				/*< Successful takes. */
+	uint32_t ulContendedTakes;		/*< Takes that had to wait. */
+	uint32_t ulTimeouts;			/*< Takes that waited and gave up. */
+	uint32_t ulTotalWaitTicks;		/*< Time spent waiting by contended takes and timeouts. */
+	uint32_t ulMaxWaitTicks;		/*< The longest of those waits. */
+	uint32_t ulTotalHoldTicks;		/*< Time the object was held. */
+	uint32_t ulMaxHoldTicks;		/*< The longest hold. */
+	uint32_t ulBlockedSends;		/*< Sends that had to wait for space on a full queue. */
+	uint32_t ulBlockedSendTicks;	/*< Time spent waiting by those sends. */
+	uint32_t ulWaitHistogram[ queueCONTENTION_HISTOGRAM_BUCKETS ];	/*< Waits of takes and timeouts by log2 of their length. */
+} QueueContentionStats_t;
+
+/* One row of uxQueueGetContentionReport(). */
+typedef struct xQUEUE_CONTENTION_STATUS
+{
+	const char *pcQueueName;		/*< The name the queue was registered with. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	QueueHandle_t xHandle;
+	QueueContentionStats_t xStats;
+} QueueContentionStatus_t;
+
+/*
+ * Copy the contention counters of a queue, semaphore or mutex into
+ * *pxStats, or reset them to zero.
+ */
+void vQueueGetContentionStats( QueueHandle_t xQueue, QueueContentionStats_t *pxStats ) PRIVILEGED_FUNCTION;
+void vQueueResetContentionStats( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fill pxStatusArray with the name and contention counters of up to
+ * uxArraySize objects in the queue registry, the one whose tasks spent the
+ * longest waiting first.  Only objects added with vQueueAddToRegistry() are
+ * reported.  Returns the number of rows filled in.
+ */
+#if( configQUEUE_REGISTRY_SIZE > 0 )
+	UBaseType_t uxQueueGetContentionReport( QueueContentionStatus_t * const pxStatusArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Write the report of uxQueueGetContentionReport() as a table, one line per
+ * registered object, into pcWriteBuffer, which takes up to xBufferLength
+ * characters including the terminating null:
+ *
+ * name  takes  contended  %  timeouts  wait  max  hold  max  histogram
+ *
+ * The histogram lists the wait histogram buckets up to the last one that is
+ * not empty.  Like vTaskList(), this is a utility for debugging that
+ * depends on snprintf() and allocates the report with pvPortMalloc(), not
+ * part of the kernel proper.
+ */
+#if( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	void vQueueListContention( char *pcWriteBuffer, size_t xBufferLength ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+#endif
+
+#endif /* configUSE_QUEUE_CONTENTION_STATS */
+
 /*
  * Generic version of the function used to creaet a queue using dynamic memory
  * allocation.  This is called by other functions and macros that create other
@@ -0,0 +1,135 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef RENDEZVOUS_H
+#define RENDEZVOUS_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include rendezvous.h"
+#endif
+
+/* Rendezvous_t holds a task handle. */
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A rendezvous makes two tasks wait for each other.  Whichever task arrives
+ * first blocks until the other one arrives, then both carry on.  It replaces
+ * the pair of binary semaphores the same handoff is usually built from, where
+ * each task gives one semaphore and takes the other.
+ *
+ * A rendezvous is a single pointer to the waiting task, held in a Rendezvous_t
+ * the application declares, so it never uses the heap.  The task that arrives
+ * second releases the waiting task with a direct to task notification, so one
+ * rendezvous costs one kernel call from each task instead of two.  As with
+ * stream buffers, a task must not rely on its notification value while it is
+ * blocked in xRendezvousArrive().
+ *
+ * When more than two tasks use the same rendezvous they meet in pairs, in the
+ * order they arrive.  A rendezvous must not be used from an interrupt.
+ *
+ * \defgroup Rendezvous
+ */
+
+/**
+ * rendezvous.h
+ *
+ * The rendezvous itself.  The application declares one, calls
+ * vRendezvousInitialise() on it and passes its address to the other
+ * functions.  The member must not be accessed directly.
+ *
+ * \defgroup Rendezvous_t Rendezvous_t
+ * \ingroup Rendezvous
+ */
+typedef struct xRENDEZVOUS
+{
+	volatile TaskHandle_t xWaitingTask;		/*< The task that arrived first and is waiting, or NULL. */
+} Rendezvous_t;
+
+/**
+ * rendezvous.h
+ *<pre>
+ void vRendezvousInitialise( Rendezvous_t *pxRendezvous );
+ </pre>
+ *
+ * Prepare a rendezvous for use, with no task waiting.
+ *
+ * @param pxRendezvous The rendezvous to initialise.
+ *
+ * \defgroup vRendezvousInitialise vRendezvousInitialise
+ * \ingroup Rendezvous
+ */
+void vRendezvousInitialise( Rendezvous_t * const pxRendezvous ) PRIVILEGED_FUNCTION;
+
+/**
+ * rendezvous.h
+ *<pre>
+ BaseType_t xRendezvousArrive( Rendezvous_t *pxRendezvous, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Arrive at a rendezvous.  If another task is already waiting there it is
+ * released and the function returns straight away.  Otherwise the calling task
+ * waits for another task to arrive.
+ *
+ * @param pxRendezvous The rendezvous to arrive at.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for the other task.
+ *
+ * @return pdPASS if the other task arrived, or pdFAIL if the call timed out.
+ *
+ * Example usage:
+   <pre>
+ Rendezvous_t xRendezvous;  // Initialised with vRendezvousInitialise().
+
+ void vTaskA( void *pvParameters )
+ {
+    for( ;; )
+    {
+        vStepA1();
+        xRendezvousArrive( &xRendezvous, portMAX_DELAY );
+
+        // Task B has finished vStepB1() too.
+        vStepA2();
+    }
+ }
+   </pre>
+ * \defgroup xRendezvousArrive xRendezvousArrive
+ * \ingroup Rendezvous
+ */
+BaseType_t xRendezvousArrive( Rendezvous_t * const pxRendezvous, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RENDEZVOUS_H */
+
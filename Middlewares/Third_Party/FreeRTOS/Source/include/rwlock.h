@@ -0,0 +1,215 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include rwlock.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A reader-writer lock lets any number of tasks hold it for reading at the
+ * same time, or one task hold it for writing, so tasks that only read some
+ * shared state do not have to wait for each other as they would for a mutex.
+ *
+ * It does the job of the lightswitch and roomEmpty semaphore solution to the
+ * readers-writers problem in the Little Book of Semaphores, with the choice of
+ * who goes first made by the policy the lock is created with:
+ *
+ * rwlockPREFER_READERS - a reader takes the lock whenever no writer holds it.
+ * Writers wait for the readers to stop, so a steady stream of readers can
+ * starve them.
+ *
+ * rwlockPREFER_WRITERS - a reader waits while any writer is waiting.  Writers
+ * take the lock in turn for as long as there are any, so they can starve the
+ * readers.
+ *
+ * rwlockFAIR - as rwlockPREFER_WRITERS, except that when a writer gives the
+ * lock it goes to all the readers that are waiting, if there are any, before
+ * the next writer.  Readers and writers take turns, so neither starves (the
+ * book's no-starve solution).
+ *
+ * The lock is handed straight to the tasks it is given to, so a task that
+ * arrives later cannot take it first.  Waiting readers and waiting writers are
+ * each queued highest priority first.  A task that waits while a writer holds
+ * the lock raises the writer's priority to its own, as a mutex does.  A writer
+ * waiting for readers does not raise theirs.
+ *
+ * Reader-writer locks can only be created dynamically, and must not be used
+ * from an interrupt.  A task must not take a lock it already holds.
+ *
+ * \defgroup RWLock
+ */
+
+/**
+ * rwlock.h
+ *
+ * Type by which reader-writer locks are referenced.
+ *
+ * \defgroup RWLockHandle_t RWLockHandle_t
+ * \ingroup RWLock
+ */
+struct RWLockDef_t;
+typedef struct RWLockDef_t * RWLockHandle_t;
+
+/* The policies a reader-writer lock can be created with. */
+#define rwlockPREFER_READERS	( ( BaseType_t ) 0 )
+#define rwlockPREFER_WRITERS	( ( BaseType_t ) 1 )
+#define rwlockFAIR				( ( BaseType_t ) 2 )
+
+/**
+ * rwlock.h
+ *<pre>
+ RWLockHandle_t xRWLockCreate( BaseType_t xPolicy );
+ </pre>
+ *
+ * Create a new reader-writer lock.
+ *
+ * @param xPolicy rwlockPREFER_READERS, rwlockPREFER_WRITERS or rwlockFAIR.
+ *
+ * @return If the lock was created then a handle to the lock is returned.  If
+ * there was insufficient FreeRTOS heap available to create the lock then NULL
+ * is returned.
+ *
+ * \defgroup xRWLockCreate xRWLockCreate
+ * \ingroup RWLock
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	RWLockHandle_t xRWLockCreate( const BaseType_t xPolicy ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rwlock.h
+ *<pre>
+ BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+ BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Take the lock for reading, alongside any other readers, or for writing, on
+ * its own.
+ *
+ * @param xRWLock The lock to take.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for the lock.
+ *
+ * @return pdPASS if the lock was taken, or pdFAIL if the call timed out.
+ *
+ * Example usage:
+   <pre>
+ RWLockHandle_t xRouteLock;    // Created with xRWLockCreate( rwlockFAIR ).
+
+ void vForwardPacket( Packet_t *pxPacket )
+ {
+    xRWLockTakeRead( xRouteLock, portMAX_DELAY );
+    {
+        // Any number of tasks can look routes up at the same time.
+        vSend( pxPacket, pxLookUpRoute( pxPacket ) );
+    }
+    xRWLockGiveRead( xRouteLock );
+ }
+
+ void vUpdateRoute( const Route_t *pxRoute )
+ {
+    xRWLockTakeWrite( xRouteLock, portMAX_DELAY );
+    {
+        // No other task looks a route up while the table changes.
+        vReplaceRoute( pxRoute );
+    }
+    xRWLockGiveWrite( xRouteLock );
+ }
+   </pre>
+ * \defgroup xRWLockTakeRead xRWLockTakeRead
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *<pre>
+ BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock );
+ BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock );
+ </pre>
+ *
+ * Give back a lock taken with xRWLockTakeRead() or xRWLockTakeWrite().  A
+ * writer returns to its own priority if it had taken on that of a waiting
+ * task.
+ *
+ * @param xRWLock The lock to give.
+ *
+ * @return pdPASS if the lock was given, or pdFAIL if it was not held by a
+ * reader, or by the calling task for writing, respectively.
+ *
+ * \defgroup xRWLockGiveRead xRWLockGiveRead
+ * \ingroup RWLock
+ */
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *<pre>
+ UBaseType_t uxRWLockGetReaders( RWLockHandle_t xRWLock );
+ TaskHandle_t xRWLockGetWriter( RWLockHandle_t xRWLock );
+ </pre>
+ *
+ * @return The number of tasks holding the lock for reading, or the task
+ * holding it for writing (NULL if none).
+ *
+ * \defgroup uxRWLockGetReaders uxRWLockGetReaders
+ * \ingroup RWLock
+ */
+UBaseType_t uxRWLockGetReaders( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+TaskHandle_t xRWLockGetWriter( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rwlock.h
+ *<pre>
+ void vRWLockDelete( RWLockHandle_t xRWLock );
+ </pre>
+ *
+ * Delete a lock that was previously created by a call to xRWLockCreate().
+ * The lock must not be held, and no task may be waiting for it.
+ *
+ * @param xRWLock The lock being deleted.
+ *
+ * \defgroup vRWLockDelete vRWLockDelete
+ * \ingroup RWLock
+ */
+void vRWLockDelete( RWLockHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RWLOCK_H */
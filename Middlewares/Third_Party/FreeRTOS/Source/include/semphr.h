@@ -446,6 +446,69 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreGive( xSemaphore )		xQueueGenericSend( ( QueueHandle_t ) ( xSemaphore ), NULL, semGIVE_BLOCK_TIME, queueSEND_TO_BACK )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreGiveMultiple( SemaphoreHandle_t xSemaphore, UBaseType_t uxCount )</pre>
+ *
+ * <i>Macro</i> to release a counting semaphore uxCount times in one
+ * operation.  The count is raised and up to uxCount tasks that are blocked on
+ * the semaphore are unblocked inside a single critical section, and the
+ * calling task yields at most once, instead of once per call as when
+ * xSemaphoreGive() is called in a loop.
+ *
+ * The count is never raised above the maximum count the semaphore was created
+ * with.  Tasks are unblocked in priority order, and an unblocked task still
+ * has to take the semaphore when it runs, so a task that was not blocked can
+ * take a count first - exactly as if xSemaphoreGive() had been called uxCount
+ * times.
+ *
+ * This macro must not be used from an ISR, or on a mutex.
+ *
+ * @param xSemaphore A handle to the semaphore being released.
+ *
+ * @param uxCount The number of times to give the semaphore.
+ *
+ * @return pdPASS if the count was raised by uxCount.  errQUEUE_FULL if the
+ * semaphore reached its maximum count first, in which case it was given as
+ * many times as there was room for.
+ *
+ * Example usage:
+ <pre>
+ #define TASKS 5
+
+ // Created with xSemaphoreCreateCounting( TASKS, 0 ).
+ SemaphoreHandle_t xTurnstile;
+
+ void vLastTaskToArrive( void )
+ {
+    // Let every task through the turnstile, including this one.
+    xSemaphoreGiveMultiple( xTurnstile, TASKS );
+ }
+ </pre>
+ * \defgroup xSemaphoreGiveMultiple xSemaphoreGiveMultiple
+ * \ingroup Semaphores
+ */
+#define xSemaphoreGiveMultiple( xSemaphore, uxCount )	xQueueGiveMultiple( ( QueueHandle_t ) ( xSemaphore ), ( uxCount ) )
+
+/**
+ * semphr. h
+ * <pre>xSemaphoreGiveAll( SemaphoreHandle_t xSemaphore )</pre>
+ *
+ * <i>Macro</i> to broadcast on a counting semaphore: give it once for every
+ * task that is currently blocked on it, and unblock all of those tasks in a
+ * single operation.  Tasks that are not blocked on the semaphore when the
+ * macro is called are not accounted for.  See xSemaphoreGiveMultiple().
+ *
+ * @param xSemaphore A handle to the semaphore being released.
+ *
+ * @return pdPASS if every blocked task was given a count, errQUEUE_FULL if the
+ * semaphore reached its maximum count first.
+ *
+ * \defgroup xSemaphoreGiveAll xSemaphoreGiveAll
+ * \ingroup Semaphores
+ */
+#define xSemaphoreGiveAll( xSemaphore )	xQueueGiveMultiple( ( QueueHandle_t ) ( xSemaphore ), queueGIVE_ALL_WAITERS )
+
 /**
  * semphr. h
  * <pre>xSemaphoreGiveRecursive( SemaphoreHandle_t xMutex )</pre>
@@ -44,7 +44,9 @@
  * block time to 0.  Likewise, if there are to be multiple different readers
  * then the application writer must place each call to a reading API function
  * (such as xStreamBufferReceive()) inside a critical section section and set the
- * receive block time to 0.
+ * receive block time to 0.  The one exception is a buffer created by
+ * xStreamBufferCreateMultiProducer() or xMessageBufferCreateMultiProducer(),
+ * which any number of writers can write to without a critical section.
  *
  */
 
@@ -217,6 +219,101 @@ const size_t xTriggerLevel = 1;
  */
 #define xStreamBufferCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pdFALSE, pucStreamBufferStorageArea, pxStaticStreamBuffer )
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+StreamBufferHandle_t xStreamBufferCreateMirrored( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+</pre>
+ *
+ * Creates a new stream buffer, as xStreamBufferCreate() does, whose storage
+ * area is mapped twice, back to back, so the byte after the last byte of the
+ * storage area is the first byte again.  A region returned by
+ * xStreamBufferAcquireWrite() or xStreamBufferAcquireRead() is then never cut
+ * short by the end of the storage area.
+ *
+ * The storage area comes from pvPortMallocMirrored() rather than
+ * pvPortMalloc(), and its size is rounded up to what the port can map (a page
+ * on the Posix simulator), so the buffer can hold more than xBufferSizeBytes.
+ * configUSE_MIRRORED_STREAM_BUFFERS must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferCreateMirrored() to be available, and only ports that can remap
+ * memory provide pvPortMallocMirrored().
+ *
+ * @param xBufferSizeBytes The least number of bytes the stream buffer will be
+ * able to hold at any one time.
+ *
+ * @param xTriggerLevelBytes As for xStreamBufferCreate().
+ *
+ * @return As for xStreamBufferCreate().
+ *
+ * \defgroup xStreamBufferCreateMirrored xStreamBufferCreateMirrored
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferCreateMirrored( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreateMirrored( xBufferSizeBytes, xTriggerLevelBytes, pdFALSE )
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+StreamBufferHandle_t xStreamBufferCreateMultiProducer( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+</pre>
+ *
+ * Creates a new stream buffer, as xStreamBufferCreate() does, that any number
+ * of tasks and interrupts can write to at once, without wrapping each call to
+ * xStreamBufferSend() or xStreamBufferSendFromISR() in a critical section or
+ * a mutex.  There is still only one reader.
+ *
+ * Each writer reserves the space it needs by moving the buffer's reserve head
+ * with a single compare-and-swap, and copies its data in without holding
+ * anything that stops other writers.  It then commits, which locks out the
+ * other writers and the reader for a few instructions only.  Writers can
+ * commit in any order.  The reader sees the data up to the reserve head each
+ * time the last writer part way through a write commits, so it never sees
+ * space that has been reserved but not yet filled in - the data from a write
+ * that commits early becomes visible when the writes reserved before it commit
+ * too.  Writers that find the buffer full block, if they have a block time,
+ * until the reader frees space.
+ *
+ * The bytes from one call to xStreamBufferSend() are contiguous in the stream,
+ * but as a full buffer can accept fewer bytes than asked for, a write that
+ * must not be interleaved with other writers' data should use a message
+ * buffer instead - see xMessageBufferCreateMultiProducer().
+ *
+ * configUSE_MULTI_PRODUCER_STREAM_BUFFERS must be set to 1 in
+ * FreeRTOSConfig.h for xStreamBufferCreateMultiProducer() to be available.
+ * The buffer can be no larger than 16MB, and no more than 255 writers can be
+ * part way through a write at once.  xStreamBufferAcquireWrite() cannot be used
+ * on a multi-producer buffer.
+ *
+ * @param xBufferSizeBytes As for xStreamBufferCreate().
+ *
+ * @param xTriggerLevelBytes As for xStreamBufferCreate().
+ *
+ * @return As for xStreamBufferCreate().
+ *
+ * \defgroup xStreamBufferCreateMultiProducer xStreamBufferCreateMultiProducer
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferCreateMultiProducer( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( xBufferSizeBytes, xTriggerLevelBytes, sbCREATE_MULTI_PRODUCER )
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+StreamBufferHandle_t xStreamBufferCreateMultiProducerStatic( size_t xBufferSizeBytes,
+                                                             size_t xTriggerLevelBytes,
+                                                             uint8_t *pucStreamBufferStorageArea,
+                                                             StaticStreamBuffer_t *pxStaticStreamBuffer );
+</pre>
+ *
+ * A version of xStreamBufferCreateMultiProducer() that uses statically
+ * allocated memory, as xStreamBufferCreateStatic() does.
+ *
+ * \defgroup xStreamBufferCreateMultiProducerStatic xStreamBufferCreateMultiProducerStatic
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferCreateMultiProducerStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, sbCREATE_MULTI_PRODUCER, pucStreamBufferStorageArea, pxStaticStreamBuffer )
+
 /**
  * stream_buffer.h
  *
@@ -833,7 +930,258 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+                                  void **ppvRegion,
+                                  size_t xBytesWanted,
+                                  TickType_t xTicksToWait );
+</pre>
+ *
+ * Gets a region of the stream buffer's storage area that the writer can fill
+ * in place, rather than filling a buffer of its own that xStreamBufferSend()
+ * then copies.  vStreamBufferCommitWrite() adds what was written to the
+ * stream buffer.  configUSE_STREAM_BUFFER_REGIONS must be set to 1 in
+ * FreeRTOSConfig.h for the region functions to be available.
+ *
+ * The region is contiguous, so it is as much of xBytesWanted as there is room
+ * for before the end of the storage area - it can be smaller than the space
+ * available when the free space wraps.  Write the rest after committing, or
+ * create the stream buffer with xStreamBufferCreateMirrored(), where a region
+ * is never cut short.  A message buffer region is exactly xBytesWanted bytes
+ * or none at all - see xMessageBufferAcquireWrite().
+ *
+ * Only one region can be acquired at a time, and nothing else may be written
+ * to the stream buffer until it is committed.  Uniquely among FreeRTOS
+ * objects, the stream buffer implementation (so also the message buffer
+ * implementation, as message buffers are built on top of stream buffers)
+ * assumes there is only one task or interrupt that will write to the buffer
+ * (the writer), and only one task or interrupt that will read from the buffer
+ * (the reader) - see xStreamBufferSend().
+ *
+ * Use xStreamBufferAcquireWriteFromISR() to acquire a region from an interrupt
+ * service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param ppvRegion Set to the start of the region, or NULL if none was
+ * acquired.
+ *
+ * @param xBytesWanted The number of bytes the writer would like to write.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for xBytesWanted bytes of space to become available,
+ * as for xStreamBufferSend().
+ *
+ * @return The number of bytes in the region, which is 0 if the calling task
+ * timed out before there was space.
+ *
+ * Example use:
+<pre>
+void vAFunction( StreamBufferHandle_t xStreamBuffer )
+{
+uint8_t *pucRegion;
+size_t xBytes;
+
+    // Get up to 100 bytes of the buffer to fill in.
+    xBytes = xStreamBufferAcquireWrite( xStreamBuffer, ( void ** ) &pucRegion, 100, pdMS_TO_TICKS( 100 ) );
+
+    if( xBytes > 0 )
+    {
+        // Fill in xBytes bytes at pucRegion, then make them visible to the
+        // reader.
+        vStreamBufferCommitWrite( xStreamBuffer, xBytes );
+    }
+}
+</pre>
+ * \defgroup xStreamBufferAcquireWrite xStreamBufferAcquireWrite
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+								  void **ppvRegion,
+								  size_t xBytesWanted,
+								  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         void **ppvRegion,
+                                         size_t xBytesWanted );
+</pre>
+ *
+ * A version of xStreamBufferAcquireWrite() that can be called from an
+ * interrupt service routine (ISR).  It never blocks.
+ *
+ * \defgroup xStreamBufferAcquireWriteFromISR xStreamBufferAcquireWriteFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+										 void **ppvRegion,
+										 size_t xBytesWanted ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten );
+</pre>
+ *
+ * Adds the first xBytesWritten bytes of the region last acquired by
+ * xStreamBufferAcquireWrite() to the stream buffer, and releases the region.
+ * A task waiting to read is unblocked once the stream buffer holds its trigger
+ * level, exactly as for xStreamBufferSend().
+ *
+ * Use vStreamBufferCommitWriteFromISR() to commit a region from an interrupt
+ * service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer the region was acquired
+ * from.
+ *
+ * @param xBytesWritten The number of bytes written at the start of the region,
+ * which must not be more than the size of the region.  0 releases the region
+ * without adding anything.
+ *
+ * \defgroup vStreamBufferCommitWrite vStreamBufferCommitWrite
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xBytesWritten,
+                                      BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of vStreamBufferCommitWrite() that can be called from an
+ * interrupt service routine (ISR).  *pxHigherPriorityTaskWoken is set as by
+ * xStreamBufferSendFromISR().
+ *
+ * \defgroup vStreamBufferCommitWriteFromISR vStreamBufferCommitWriteFromISR
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+									  size_t xBytesWritten,
+									  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+                                 void **ppvRegion,
+                                 TickType_t xTicksToWait );
+</pre>
+ *
+ * Gets the region of the stream buffer's storage area that holds the oldest
+ * bytes in the buffer, so the reader can use them in place rather than have
+ * xStreamBufferReceive() copy them out.  vStreamBufferConsume() removes what
+ * was used from the stream buffer.
+ *
+ * The region is contiguous, so it ends at the end of the storage area when
+ * the data wraps - the rest is in the next region.  A mirrored stream buffer
+ * (see xStreamBufferCreateMirrored()) returns everything in the buffer.  A
+ * message buffer region is always one whole message - see
+ * xMessageBufferAcquireRead().
+ *
+ * Only one region can be acquired at a time, and nothing else may be read from
+ * the stream buffer until it is consumed.
+ *
+ * Use xStreamBufferAcquireReadFromISR() to acquire a region from an interrupt
+ * service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param ppvRegion Set to the start of the region, or NULL if none was
+ * acquired.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data, as for xStreamBufferReceive().
+ *
+ * @return The number of bytes in the region, which is 0 if the calling task
+ * timed out before there was data.
+ *
+ * \defgroup xStreamBufferAcquireRead xStreamBufferAcquireRead
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+								 void **ppvRegion,
+								 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireReadFromISR( StreamBufferHandle_t xStreamBuffer, void **ppvRegion );
+</pre>
+ *
+ * A version of xStreamBufferAcquireRead() that can be called from an interrupt
+ * service routine (ISR).  It never blocks.
+ *
+ * \defgroup xStreamBufferAcquireReadFromISR xStreamBufferAcquireReadFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireReadFromISR( StreamBufferHandle_t xStreamBuffer, void **ppvRegion ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytesRead );
+</pre>
+ *
+ * Removes the first xBytesRead bytes of the region last acquired by
+ * xStreamBufferAcquireRead() from the stream buffer, and releases the region.
+ * A task waiting to write is unblocked, as for xStreamBufferReceive().
+ *
+ * Use vStreamBufferConsumeFromISR() to consume a region from an interrupt
+ * service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer the region was acquired
+ * from.
+ *
+ * @param xBytesRead The number of bytes to remove, which must not be more than
+ * the size of the region.  0 releases the region and leaves the bytes in the
+ * buffer.  A message buffer always removes the whole message.
+ *
+ * \defgroup vStreamBufferConsume vStreamBufferConsume
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                  size_t xBytesRead,
+                                  BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of vStreamBufferConsume() that can be called from an interrupt
+ * service routine (ISR).  *pxHigherPriorityTaskWoken is set as by
+ * xStreamBufferReceiveFromISR().
+ *
+ * \defgroup vStreamBufferConsumeFromISR vStreamBufferConsumeFromISR
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+								  size_t xBytesRead,
+								  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /* Functions below here are not part of the public API. */
+#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	/* Or'ed into the xIsMessageBuffer parameter of the create functions below
+	to create a multi-producer buffer. */
+	#define sbCREATE_MULTI_PRODUCER ( ( BaseType_t ) 2 )
+#endif
+
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
 												 BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
@@ -844,6 +1192,10 @@ StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
 													   uint8_t * const pucStreamBufferStorageArea,
 													   StaticStreamBuffer_t * const pxStaticStreamBuffer ) PRIVILEGED_FUNCTION;
 
+StreamBufferHandle_t xStreamBufferGenericCreateMirrored( size_t xBufferSizeBytes,
+														 size_t xTriggerLevelBytes,
+														 BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+
 size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 
 #if( configUSE_TRACE_FACILITY == 1 )
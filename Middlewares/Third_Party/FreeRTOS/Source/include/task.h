@@ -142,11 +142,31 @@ typedef struct xTASK_STATUS
 	eTaskState eCurrentState;		/* The state in which the task existed when the structure was populated. */
 	UBaseType_t uxCurrentPriority;	/* The priority at which the task was running (may be inherited) when the structure was populated. */
 	UBaseType_t uxBasePriority;		/* The priority to which the task will return if the task's current priority has been inherited to avoid unbounded priority inversion when obtaining a mutex.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
-	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	configSTACK_DEPTH_TYPE usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with the uxTaskGetRunTimeSnapshot() function to return the run time
+counters of each task in the system. */
+typedef struct xTASK_RUN_TIME
+{
+	TaskHandle_t xHandle;			/* The handle of the task to which the rest of the information in the structure relates.  A task created after an earlier one was deleted can be given the same handle, but its counters then start again from 0. */
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/* The total run time allocated to the task so far, including the time it has been running for if it is running now. */
+	uint32_t ulSwitchInCount;		/* The number of times the task has been switched in. */
+	char pcTaskName[ configMAX_TASK_NAME_LEN ];	/* A copy of the task's name, which stays valid after the task is deleted. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+} TaskRunTime_t;
+
+/* Totals returned by uxTaskGetRunTimeSnapshot(), read at the same time as the
+counters of each task. */
+typedef struct xRUN_TIME_SNAPSHOT
+{
+	configRUN_TIME_COUNTER_TYPE ulTimeNow;		/* The run time stats clock when the snapshot was taken. */
+	configRUN_TIME_COUNTER_TYPE ulIdleRunTime;	/* The total run time of the idle tasks of all cores. */
+	uint32_t ulSwitchCount;						/* The number of context switches on all cores since the scheduler started. */
+	UBaseType_t uxNumberOfTasks;				/* The number of tasks in the system, which can be more than the number of rows returned. */
+} RunTimeSnapshot_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -184,7 +204,11 @@ typedef enum
  * \defgroup taskENTER_CRITICAL taskENTER_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskENTER_CRITICAL()		portENTER_CRITICAL()
+#if( configNUMBER_OF_CORES == 1 )
+	#define taskENTER_CRITICAL()		portENTER_CRITICAL()
+#else
+	#define taskENTER_CRITICAL()		vTaskEnterCritical()
+#endif
 #define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
 
 /**
@@ -1017,6 +1041,59 @@ void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xG
  */
 void vTaskPrioritySet( TaskHandle_t xTask, UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );</pre>
+ *
+ * configUSE_CORE_AFFINITY must be defined as 1, and configNUMBER_OF_CORES as
+ * more than 1, for this function to be available.
+ *
+ * Set the cores a task can run on.  Tasks can run on every core until this is
+ * called.  If the task is running on a core that is no longer in the mask it
+ * is moved off that core before the function returns.
+ *
+ * @param xTask Handle to the task for which the affinity is being set.
+ * Passing a NULL handle results in the affinity of the calling task being set.
+ *
+ * @param uxCoreAffinityMask Bit n is set if the task can run on core n.  At
+ * least one of the cores that exist must be set.
+ *
+ * Example usage:
+   <pre>
+ void vAFunction( void )
+ {
+ TaskHandle_t xHandle;
+
+	 // Create a task, storing the handle.
+	 xTaskCreate( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle );
+
+	 // Only let the task run on cores 0 and 2.
+	 vTaskCoreAffinitySet( xHandle, ( 1 << 0 ) | ( 1 << 2 ) );
+ }
+   </pre>
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup TaskCtrl
+ */
+void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask );</pre>
+ *
+ * configUSE_CORE_AFFINITY must be defined as 1, and configNUMBER_OF_CORES as
+ * more than 1, for this function to be available.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL handle
+ * results in the affinity of the calling task being returned.
+ *
+ * @return The mask of the cores the task can run on, as set by
+ * vTaskCoreAffinitySet().
+ *
+ * \defgroup uxTaskCoreAffinityGet uxTaskCoreAffinityGet
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>void vTaskSuspend( TaskHandle_t xTaskToSuspend );</pre>
@@ -1638,7 +1715,41 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 	}
 	</pre>
  */
-UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTime_t * const pxTaskArray, const UBaseType_t uxArraySize, RunTimeSnapshot_t * const pxSnapshot );</PRE>
+ *
+ * configGENERATE_RUN_TIME_STATS must be defined as 1 in FreeRTOSConfig.h for
+ * uxTaskGetRunTimeSnapshot() to be available.
+ *
+ * uxTaskGetRunTimeSnapshot() copies the run time, the number of times it has
+ * been switched in and the name of each task, and the total idle time and
+ * context switch count, all as at the same moment.  Two snapshots taken a period
+ * apart give each task's share of the CPU, the idle percentage and the
+ * context switch rate over that period.
+ *
+ * Unlike uxTaskGetSystemState() it does not suspend the scheduler or scan the
+ * stack of each task, so it can be called periodically while the application
+ * runs.  It does copy every row inside one critical section though, so
+ * interrupts are masked for a time that grows with the number of rows -
+ * uxArraySize bounds it.
+ *
+ * @param pxTaskArray A pointer to an array of TaskRunTime_t structures.
+ *
+ * @param uxArraySize The number of structures in pxTaskArray.  If there are
+ * more tasks than that, only the first uxArraySize are returned.
+ *
+ * @param pxSnapshot Set to the totals, which cover every task whether or not it
+ * fitted in pxTaskArray.
+ *
+ * @return The number of TaskRunTime_t structures that were populated.
+ *
+ * \defgroup uxTaskGetRunTimeSnapshot uxTaskGetRunTimeSnapshot
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTime_t * const pxTaskArray, const UBaseType_t uxArraySize, RunTimeSnapshot_t * const pxSnapshot ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
@@ -1743,7 +1854,7 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 
 /**
 * task. h
-* <PRE>uint32_t ulTaskGetIdleRunTimeCounter( void );</PRE>
+* <PRE>configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void );</PRE>
 *
 * configGENERATE_RUN_TIME_STATS and configUSE_STATS_FORMATTING_FUNCTIONS
 * must both be defined as 1 for this function to be available.  The application
@@ -1769,7 +1880,7 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
 * \defgroup ulTaskGetIdleRunTimeCounter ulTaskGetIdleRunTimeCounter
 * \ingroup TaskUtils
 */
-uint32_t ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
+configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
@@ -2437,6 +2548,19 @@ TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Return the handle of the task running on core xCoreID.  Only available when
+ * configNUMBER_OF_CORES is greater than 1, for use by the port.
+ */
+TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when configNUMBER_OF_CORES is greater than 1, where
+ * taskENTER_CRITICAL() calls it.  Enters a critical section, first letting the
+ * calling task be switched out if another core has asked for that.
+ */
+void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+
 /*
  * Shortcut used by the queue implementation to prevent unnecessary call to
  * taskYIELD();
@@ -2527,6 +2651,22 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Increment the mutex held count of a task that a lock
+ * is handed to while it is blocked, before it runs again, or of the calling
+ * task when it takes a mutex without a critical section.
+ */
+void vTaskIncrementMutexHeldCountOf( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Decrement the mutex held count of the calling task,
+ * pxMutexHolder, when it gives a mutex without a critical section.  Returns
+ * pdFALSE, leaving the count alone, if the mutex is the last one the task holds
+ * and its priority is still raised, as only a give made in a critical section
+ * can disinherit the priority.
+ */
+BaseType_t xTaskDecrementMutexHeldCount( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critial
  * section.
@@ -0,0 +1,325 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include task_pool.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A task pool runs short jobs on a fixed set of worker tasks that are created
+ * once, with the pool, so a job costs a push onto a deque rather than the
+ * creation of a task and its clean up by the idle task.
+ *
+ * Each worker has a deque of jobs.  A job submitted by a worker goes on the
+ * bottom of its own deque, and the worker takes jobs back off the bottom, so
+ * the jobs a job spawns are run while their data is still fresh.  A worker
+ * that runs out of jobs steals from the top of another worker's deque.  Jobs
+ * submitted by any other task go on a queue shared by the workers.  Workers
+ * with nothing to do block until a job is submitted.
+ *
+ * A job is a TaskPoolJob_t owned by the task that submits it, which doubles
+ * as the future of the job - xTaskPoolWait() blocks until it has run.  A task
+ * waiting for a job runs queued jobs itself while there are any, so a job may
+ * wait for the jobs it spawns without tying up a worker.
+ *
+ * vTaskPoolParallelFor() and vTaskPoolParallelReduce() split a range of
+ * indexes into chunks that the workers and the calling task share out
+ * between them, for block workloads such as filtering a buffer of samples or
+ * the rows of a matrix product.
+ *
+ * Pools can only be created dynamically.  None of the functions may be called
+ * from an interrupt.  Waiting for a job uses the notification value of the
+ * waiting task as a count.  Notifications given to the task for other reasons
+ * are kept, but a task must not wait on its notification value from inside a
+ * job it runs while it is in xTaskPoolWait(), vTaskPoolParallelFor() or
+ * vTaskPoolParallelReduce().
+ *
+ * \defgroup TaskPool
+ */
+
+/**
+ * task_pool.h
+ *
+ * Type by which task pools are referenced.
+ *
+ * \defgroup TaskPoolHandle_t TaskPoolHandle_t
+ * \ingroup TaskPool
+ */
+struct TaskPoolDef_t;
+typedef struct TaskPoolDef_t * TaskPoolHandle_t;
+
+/*
+ * The function a job runs, and the functions the parallel loops run on each
+ * chunk [ ulFirst, ulEnd ) of the range.  A reduce function accumulates the
+ * chunk into pvResult, and a combine function accumulates one partial result
+ * into another.
+ */
+typedef void ( *TaskPoolFunction_t )( void *pvParameters );
+typedef void ( *TaskPoolRangeFunction_t )( uint32_t ulFirst, uint32_t ulEnd, void *pvParameters );
+typedef void ( *TaskPoolReduceFunction_t )( uint32_t ulFirst, uint32_t ulEnd, void *pvParameters, void *pvResult );
+typedef void ( *TaskPoolCombineFunction_t )( void *pvResult, const void *pvPartial, void *pvParameters );
+
+/*
+ * A job and its future.  The memory is provided by the submitting task and
+ * must stay valid until the job has completed.  The members are private to
+ * task_pool.c.
+ */
+typedef struct xTASK_POOL_JOB
+{
+	TaskPoolFunction_t pxFunction;
+	void *pvParameters;
+	volatile uint32_t ulRunsLeft;
+	void * volatile pvWaiter;
+} TaskPoolJob_t;
+
+/* The largest result vTaskPoolParallelReduce() can accumulate, in bytes. */
+#define taskpoolMAX_RESULT_SIZE		( ( size_t ) 32 )
+
+/**
+ * task_pool.h
+ *<pre>
+ TaskPoolHandle_t xTaskPoolCreate( const char *pcName, UBaseType_t uxWorkers, configSTACK_DEPTH_TYPE usStackDepth, UBaseType_t uxPriority, UBaseType_t uxQueueLength );
+ </pre>
+ *
+ * Create a pool and its worker tasks.
+ *
+ * @param pcName The name given to each worker task.
+ *
+ * @param uxWorkers The number of worker tasks - usually one per core.
+ *
+ * @param usStackDepth The stack depth of each worker task, which must be
+ * enough for the deepest job.
+ *
+ * @param uxPriority The priority of the worker tasks.
+ *
+ * @param uxQueueLength The number of jobs each worker's deque, and the queue
+ * shared by the workers, can hold.  Must be a power of two.
+ *
+ * @return If the pool was created then a handle to the pool is returned.  If
+ * there was insufficient FreeRTOS heap available to create the pool and its
+ * workers then NULL is returned.
+ *
+ * \defgroup xTaskPoolCreate xTaskPoolCreate
+ * \ingroup TaskPool
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	TaskPoolHandle_t xTaskPoolCreate( const char * const pcName, const UBaseType_t uxWorkers, const configSTACK_DEPTH_TYPE usStackDepth, const UBaseType_t uxPriority, const UBaseType_t uxQueueLength ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task_pool.h
+ *<pre>
+ BaseType_t xTaskPoolSubmit( TaskPoolHandle_t xPool, TaskPoolJob_t *pxJob, TaskPoolFunction_t pxFunction, void *pvParameters, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Submit a job that calls pxFunction( pvParameters ) on one of the workers.
+ *
+ * @param xPool The pool to run the job on.
+ *
+ * @param pxJob The job, which must not already be submitted and not
+ * completed.  It is used again by xTaskPoolWait() and xTaskPoolIsDone().
+ *
+ * @param pxFunction The function the job runs.
+ *
+ * @param pvParameters Passed to pxFunction.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for room for the job if the pool is full.  A worker of the pool never
+ * waits - if its deque and the shared queue are full it runs the job itself
+ * before returning.
+ *
+ * @return pdPASS if the job was submitted (or run), or pdFAIL if there was no
+ * room for it within xTicksToWait.
+ *
+ * Example usage:
+   <pre>
+ void vFilterChannels( TaskPoolHandle_t xPool, Channel_t *pxChannels )
+ {
+ TaskPoolJob_t xJobs[ CHANNEL_COUNT ];
+
+    for( int i = 0; i < CHANNEL_COUNT; i++ )
+    {
+        xTaskPoolSubmit( xPool, &xJobs[ i ], vFilterChannel, &pxChannels[ i ], portMAX_DELAY );
+    }
+
+    for( int i = 0; i < CHANNEL_COUNT; i++ )
+    {
+        // Runs other queued jobs while the filter has not finished.
+        xTaskPoolWait( xPool, &xJobs[ i ], portMAX_DELAY );
+    }
+ }
+   </pre>
+ * \defgroup xTaskPoolSubmit xTaskPoolSubmit
+ * \ingroup TaskPool
+ */
+BaseType_t xTaskPoolSubmit( TaskPoolHandle_t xPool, TaskPoolJob_t * const pxJob, TaskPoolFunction_t pxFunction, void * const pvParameters, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task_pool.h
+ *<pre>
+ BaseType_t xTaskPoolWait( TaskPoolHandle_t xPool, TaskPoolJob_t *pxJob, TickType_t xTicksToWait );
+ BaseType_t xTaskPoolIsDone( const TaskPoolJob_t *pxJob );
+ </pre>
+ *
+ * Wait for a submitted job to complete, running jobs queued on the pool in
+ * the meantime, or test whether it has completed without waiting.  Only one
+ * task may wait for a given job.
+ *
+ * @param xPool The pool the job was submitted to.
+ *
+ * @param pxJob The job.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for the job once there are no queued jobs left to run.
+ *
+ * @return pdPASS if the job has completed, otherwise pdFAIL.  Once a job has
+ * completed its memory can be reused.
+ *
+ * \defgroup xTaskPoolWait xTaskPoolWait
+ * \ingroup TaskPool
+ */
+BaseType_t xTaskPoolWait( TaskPoolHandle_t xPool, TaskPoolJob_t * const pxJob, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskPoolIsDone( const TaskPoolJob_t * const pxJob ) PRIVILEGED_FUNCTION;
+
+/**
+ * task_pool.h
+ *<pre>
+ void vTaskPoolParallelFor( TaskPoolHandle_t xPool, uint32_t ulBegin, uint32_t ulEnd, uint32_t ulGrain, TaskPoolRangeFunction_t pxFunction, void *pvParameters );
+ </pre>
+ *
+ * Call pxFunction on chunks of ulGrain indexes that together cover
+ * [ ulBegin, ulEnd ), sharing the chunks out between the workers and the
+ * calling task, and return once every chunk is done.  The last chunk may be
+ * shorter.  Chunks can run in any order and at the same time as each other.
+ *
+ * @param xPool The pool to run the loop on.
+ *
+ * @param ulBegin The first index.
+ *
+ * @param ulEnd One past the last index.
+ *
+ * @param ulGrain The number of indexes in each chunk - enough that a chunk
+ * costs much more than taking it, a few microseconds of work.
+ *
+ * @param pxFunction Called once for each chunk.
+ *
+ * @param pvParameters Passed to pxFunction.
+ *
+ * Example usage:
+   <pre>
+ // y = W x for a dense layer of ROWS outputs.
+ static void vRows( uint32_t ulFirst, uint32_t ulEnd, void *pvLayer )
+ {
+    for( uint32_t ulRow = ulFirst; ulRow < ulEnd; ulRow++ )
+    {
+        vDotRow( pvLayer, ulRow );
+    }
+ }
+
+ vTaskPoolParallelFor( xPool, 0, ROWS, 8, vRows, &xLayer );
+   </pre>
+ * \defgroup vTaskPoolParallelFor vTaskPoolParallelFor
+ * \ingroup TaskPool
+ */
+void vTaskPoolParallelFor( TaskPoolHandle_t xPool, uint32_t ulBegin, uint32_t ulEnd, uint32_t ulGrain, TaskPoolRangeFunction_t pxFunction, void * const pvParameters ) PRIVILEGED_FUNCTION;
+
+/**
+ * task_pool.h
+ *<pre>
+ void vTaskPoolParallelReduce( TaskPoolHandle_t xPool, uint32_t ulBegin, uint32_t ulEnd, uint32_t ulGrain, TaskPoolReduceFunction_t pxReduce, TaskPoolCombineFunction_t pxCombine, void *pvParameters, void *pvResult, size_t xResultSize );
+ </pre>
+ *
+ * As vTaskPoolParallelFor(), but each task taking part accumulates the chunks
+ * it runs into a partial result of its own, and the partial results are then
+ * combined into *pvResult.
+ *
+ * @param pxReduce Called once for each chunk, to accumulate it into the
+ * partial result of the task running it.
+ *
+ * @param pxCombine Called to accumulate a partial result into *pvResult.  It
+ * is called with the kernel in a critical section, so must be short and must
+ * not call any API functions.
+ *
+ * @param pvResult Must hold the identity of pxCombine - 0 for a sum, for
+ * example - on entry, and holds the result on return.  Each partial result
+ * starts as a copy of it.
+ *
+ * @param xResultSize The size of *pvResult in bytes, no more than
+ * taskpoolMAX_RESULT_SIZE.
+ *
+ * Which chunks make up each partial result, and the order they are combined
+ * in, changes from call to call, so a floating point result can vary by a
+ * rounding error.
+ *
+ * \defgroup vTaskPoolParallelReduce vTaskPoolParallelReduce
+ * \ingroup TaskPool
+ */
+void vTaskPoolParallelReduce( TaskPoolHandle_t xPool, uint32_t ulBegin, uint32_t ulEnd, uint32_t ulGrain, TaskPoolReduceFunction_t pxReduce, TaskPoolCombineFunction_t pxCombine, void * const pvParameters, void * const pvResult, size_t xResultSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * task_pool.h
+ *<pre>
+ UBaseType_t uxTaskPoolGetWorkers( TaskPoolHandle_t xPool );
+ </pre>
+ *
+ * @return The number of worker tasks in the pool.
+ *
+ * \defgroup uxTaskPoolGetWorkers uxTaskPoolGetWorkers
+ * \ingroup TaskPool
+ */
+UBaseType_t uxTaskPoolGetWorkers( TaskPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * task_pool.h
+ *<pre>
+ void vTaskPoolDelete( TaskPoolHandle_t xPool );
+ </pre>
+ *
+ * Stop the workers of a pool that was created by a call to xTaskPoolCreate()
+ * and free the pool.  Every job submitted to the pool must have completed,
+ * and the calling task must not be one of the workers.  Blocks until every
+ * worker has stopped.
+ *
+ * @param xPool The pool being deleted.
+ *
+ * \defgroup vTaskPoolDelete vTaskPoolDelete
+ * \ingroup TaskPool
+ */
+void vTaskPoolDelete( TaskPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_POOL_H */
@@ -87,6 +87,24 @@ typedef void (*TimerCallbackFunction_t)( TimerHandle_t xTimer );
  */
 typedef void (*PendedFunction_t)( void *, uint32_t );
 
+#if( configUSE_TIMER_COMMAND_RING == 1 )
+
+	/*
+	 * Used with vTimerGetCommandStats() to report how the commands sent to the
+	 * timer service task have been handled.
+	 */
+	typedef struct xTIMER_COMMAND_STATS
+	{
+		UBaseType_t uxDepth;		/* The number of commands waiting for the timer service task now. */
+		UBaseType_t uxMaxDepth;		/* The most commands the timer service task has found waiting when it came to take them. */
+		uint32_t ulReceived;		/* The number of commands the timer service task has taken. */
+		uint32_t ulBatches;			/* The number of batches they were taken in. */
+		uint32_t ulCoalesced;		/* Start, reset and stop commands skipped because a later command in the same batch was for the same timer. */
+		uint32_t ulDropped;			/* Commands that could not be sent because the command ring stayed full. */
+	} TimerCommandStats_t;
+
+#endif /* configUSE_TIMER_COMMAND_RING */
+
 /**
  * TimerHandle_t xTimerCreate( 	const char * const pcTimerName,
  * 								TickType_t xTimerPeriodInTicks,
@@ -448,6 +466,12 @@ BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  *
  * Simply returns the handle of the timer service/daemon task.  It it not valid
  * to call xTimerGetTimerDaemonTaskHandle() before the scheduler has been started.
+ *
+ * When configUSE_TIMER_COMMAND_RING is 1 the timer service task is woken by a
+ * direct to task notification each time a command is sent, so its
+ * notification value belongs to the kernel.  Do not notify the timer service
+ * task, or wait on its notification value from a timer callback or pended
+ * function.
  */
 TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
 
@@ -1288,6 +1312,23 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerGetCommandStats( TimerCommandStats_t *pxStats );
+ *
+ * configUSE_TIMER_COMMAND_RING must be defined as 1 for this function to be
+ * available.
+ *
+ * Reports how many commands are waiting for the timer service task and how
+ * the commands sent so far have been handled.  The counters are read without
+ * stopping the tasks that update them, so they are a snapshot that can be a
+ * command or two out of step with each other.
+ *
+ * @param pxStats The structure the figures are written to.
+ */
+#if( configUSE_TIMER_COMMAND_RING == 1 )
+	void vTimerGetCommandStats( TimerCommandStats_t *pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
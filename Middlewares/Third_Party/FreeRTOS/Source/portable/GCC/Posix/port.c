@@ -0,0 +1,896 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the Posix/Linux
+ * simulator port.
+ *
+ * Every task is backed by its own pthread, but only the thread of the task
+ * selected by the scheduler is ever allowed to run - all the other task
+ * threads are parked on a semaphore.  The tick interrupt is simulated with
+ * SIGALRM, generated by an interval timer.  SIGALRM is only unblocked in the
+ * thread of the running task, so the tick "interrupt" always executes on top
+ * of the running task as it would on the target, and masking SIGALRM is what
+ * disables interrupts.
+ *
+ * As on the target, a yield requested from inside a critical section is held
+ * pending until the critical section is exited.
+ *
+ * Note a task can be preempted by the tick while it is inside a host library
+ * call that holds an internal lock (printf() holds the stdout lock, for
+ * example).  Tasks of different priorities that share such a library should
+ * only call it from inside a critical section.
+ *
+ * When configNUMBER_OF_CORES is greater than 1 the threads of that many tasks
+ * run at once, one per simulated core.  The core a thread is running on is
+ * held in thread local storage and passed on, with the processor, to the
+ * thread it resumes.  SIGALRM is unblocked in every running thread, so
+ * whichever core the host delivers the tick to handles it, and a core
+ * interrupts another by sending SIGUSR1 to the thread running on it.  A
+ * critical section masks both signals and takes the kernel lock, a spinlock
+ * that is recursive per core and stays with the core when it switches tasks.
+ * The simulated cores share however many processors the host has, so a core
+ * waiting for the kernel lock gives up the host processor after a few spins.
+ *----------------------------------------------------------*/
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* When set to 1 time stops being real time: whenever every task is blocked
+the tick count jumps straight to the time at which the next task unblocks,
+so delays cost no wall clock time.  Requires configUSE_TICKLESS_IDLE. */
+#ifndef configPOSIX_FAST_FORWARD
+	#define configPOSIX_FAST_FORWARD	0
+#endif
+
+#if( ( configPOSIX_FAST_FORWARD == 1 ) && ( configUSE_TICKLESS_IDLE == 0 ) )
+	#error configPOSIX_FAST_FORWARD requires configUSE_TICKLESS_IDLE to be set to 1.
+#endif
+
+/* The signal used to simulate the tick interrupt. */
+#define portTICK_SIGNAL				SIGALRM
+
+/* The signal one core sends another to make it select a task again. */
+#define portYIELD_SIGNAL			SIGUSR1
+
+/* The number of times a core tries for the kernel lock before it lets the
+host run another thread. */
+#define portKERNEL_LOCK_SPINS		64
+
+/* The host thread that backs each task.  This is stored at the top of the
+task's FreeRTOS stack, which is otherwise unused as the code of the task runs
+on the stack allocated by pthreads. */
+typedef struct THREAD
+{
+	pthread_t xThread;
+	sem_t xWakeUp;
+	TaskFunction_t pxCode;
+	void *pvParameters;
+	volatile BaseType_t xDying;
+	#if( configNUMBER_OF_CORES > 1 )
+		BaseType_t xCoreID;		/* The core the thread is resumed on. */
+	#endif
+} Thread_t;
+
+/*
+ * Setup the interval timer to generate the tick interrupts.
+ */
+static void prvSetupTimerInterrupt( void );
+
+/*
+ * The simulated tick interrupt handler.
+ */
+static void prvTickSignalHandler( int iSignal );
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	/*
+	 * The handler of the interrupt one core sends another to make it switch
+	 * tasks.
+	 */
+	static void prvYieldSignalHandler( int iSignal );
+
+	/*
+	 * Returns pdTRUE if the calling core has masked interrupts with
+	 * portSET_INTERRUPT_MASK(), in which case the signal is recorded and
+	 * raised again when the mask is cleared.
+	 */
+	static BaseType_t prvHoldOffSignal( int iSignal );
+
+#endif /* configNUMBER_OF_CORES */
+
+/*
+ * Entry point of every task thread.
+ */
+static void *prvThreadEntry( void *pvParameters );
+
+/*
+ * Select the next task to run and pass the processor to its thread.  Must be
+ * called with interrupts disabled.
+ */
+static void prvSwitchContext( void );
+
+/*
+ * Park the calling thread until it is selected to run again.
+ */
+static void prvSuspendSelf( Thread_t *pxThread );
+
+/*
+ * Mask or unmask the tick signal, and the yield signal when there is more than
+ * one core, in the calling thread.
+ */
+static void prvSetTickSignalMask( int iHow );
+
+/*
+ * Fill in the set of signals that simulate interrupts.
+ */
+static void prvGetInterruptSignals( sigset_t *pxSignals );
+
+/*-----------------------------------------------------------*/
+
+/* Each thread keeps its own critical nesting count, as every thread has its
+own signal mask.  A thread is never switched out while the count is non
+zero. */
+static __thread UBaseType_t uxCriticalNesting = 0;
+
+/* Set when a yield is requested while the count above is non zero. */
+static __thread BaseType_t xPendingYield = pdFALSE;
+
+/* Set while the calling thread is executing the tick handler. */
+static __thread BaseType_t xInsideInterrupt = pdFALSE;
+
+/* The number of times the processor has been passed from one task thread to
+another. */
+static volatile uint32_t ulContextSwitches = 0;
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	/* The core the calling thread is running on.  Only meaningful in the
+	thread of a running task. */
+	__thread BaseType_t xPortCoreID = 0;
+
+	/* Set while the calling core has masked interrupts with
+	portSET_INTERRUPT_MASK(), which only sets this flag rather than change the
+	signal mask - the signal handlers check it instead.  Signals that arrive
+	meanwhile are recorded in uxHeldOffSignals. */
+	static __thread volatile BaseType_t xInterruptsHeldOff = pdFALSE;
+	static __thread volatile UBaseType_t uxHeldOffSignals = 0;
+
+	/* The core holding the kernel lock, or -1, and how many times it has
+	taken it.  The count is only accessed by the core holding the lock. */
+	static volatile BaseType_t xKernelLockOwner = -1;
+	static UBaseType_t uxKernelLockCount = 0;
+
+#endif /* configNUMBER_OF_CORES */
+
+/* Posted when vTaskEndScheduler() is called, to release the thread that
+called vTaskStartScheduler(). */
+static sem_t xSchedulerEnd;
+
+/*-----------------------------------------------------------*/
+
+static Thread_t *prvGetThreadFromTask( TaskHandle_t xTask )
+{
+StackType_t *pxTopOfStack = *( StackType_t ** ) xTask;
+
+	/* pxTopOfStack is the first member of the TCB. */
+	return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+Thread_t *pxThread;
+int iReturn;
+
+	/* Reserve space for the thread at the top of the stack. */
+	pxThread = ( Thread_t * ) ( pxTopOfStack + 1 ) - 1;
+	pxTopOfStack = ( StackType_t * ) pxThread - 1;
+
+	pxThread->pxCode = pxCode;
+	pxThread->pvParameters = pvParameters;
+	pxThread->xDying = pdFALSE;
+	iReturn = sem_init( &( pxThread->xWakeUp ), 0, 0 );
+	configASSERT( iReturn == 0 );
+
+	#if( configNUMBER_OF_CORES == 1 )
+	{
+	sigset_t xSignals, xOldMask;
+
+		/* The new thread inherits the signal mask of its creator, so make
+		sure it starts life with the tick masked. */
+		prvGetInterruptSignals( &xSignals );
+		pthread_sigmask( SIG_BLOCK, &xSignals, &xOldMask );
+		iReturn = pthread_create( &( pxThread->xThread ), NULL, prvThreadEntry, pxThread );
+		pthread_sigmask( SIG_SETMASK, &xOldMask, NULL );
+	}
+	#else
+	{
+		/* The critical section masks the signals the new thread inherits.  It
+		also holds the kernel lock while the C library holds its own lock to
+		create the thread - as in vPortCancelThread(), a core that took an
+		interrupt while holding the library lock could otherwise spin on the
+		kernel lock held by a core waiting for the library lock. */
+		vPortEnterCritical();
+		iReturn = pthread_create( &( pxThread->xThread ), NULL, prvThreadEntry, pxThread );
+		vPortExitCritical();
+	}
+	#endif /* configNUMBER_OF_CORES */
+
+	configASSERT( iReturn == 0 );
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvThreadEntry( void *pvParameters )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParameters;
+
+	/* Wait to be scheduled for the first time. */
+	prvSuspendSelf( pxThread );
+
+	/* Tasks start with interrupts enabled. */
+	uxCriticalNesting = 0;
+
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		/* A thread resumed by a context switch inherits the kernel lock from
+		the thread it took over from.  The first threads started by
+		xPortStartScheduler() do not. */
+		if( xKernelLockOwner == xPortCoreID )
+		{
+			vPortReleaseKernelLock();
+		}
+	}
+	#endif /* configNUMBER_OF_CORES */
+
+	vPortEnableInterrupts();
+
+	pxThread->pxCode( pxThread->pvParameters );
+
+	/* A task must not return from its implementing function.  Delete it
+	rather than let the thread run off the end. */
+	vTaskDelete( NULL );
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+struct sigaction xTickAction;
+int iReturn;
+
+	iReturn = sem_init( &xSchedulerEnd, 0, 0 );
+	configASSERT( iReturn == 0 );
+
+	/* The thread that starts the scheduler never runs a task, so the tick
+	stays masked in this thread from now on. */
+	prvSetTickSignalMask( SIG_BLOCK );
+
+	/* The interrupts do not nest. */
+	memset( &xTickAction, 0, sizeof( xTickAction ) );
+	xTickAction.sa_handler = prvTickSignalHandler;
+	xTickAction.sa_flags = SA_RESTART;
+	prvGetInterruptSignals( &xTickAction.sa_mask );
+	iReturn = sigaction( portTICK_SIGNAL, &xTickAction, NULL );
+	configASSERT( iReturn == 0 );
+
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		xTickAction.sa_handler = prvYieldSignalHandler;
+		iReturn = sigaction( portYIELD_SIGNAL, &xTickAction, NULL );
+		configASSERT( iReturn == 0 );
+	}
+	#endif /* configNUMBER_OF_CORES */
+
+	/* Start the timer that generates the tick ISR. */
+	prvSetupTimerInterrupt();
+
+	/* Start the first task. */
+	#if( configNUMBER_OF_CORES == 1 )
+	{
+		sem_post( &( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() )->xWakeUp ) );
+	}
+	#else
+	{
+	BaseType_t xCoreID;
+	Thread_t *pxThread;
+
+		/* Start the first task of every core. */
+		for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+		{
+			pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+			pxThread->xCoreID = xCoreID;
+			sem_post( &( pxThread->xWakeUp ) );
+		}
+	}
+	#endif /* configNUMBER_OF_CORES */
+
+	/* Wait until the scheduler is stopped by vTaskEndScheduler(). */
+	while( sem_wait( &xSchedulerEnd ) != 0 )
+	{
+		configASSERT( errno == EINTR );
+	}
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+struct itimerval xTimer;
+
+	memset( &xTimer, 0, sizeof( xTimer ) );
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+
+	/* Release the thread that started the scheduler.  The calling task never
+	runs again. */
+	sem_post( &xSchedulerEnd );
+
+	for( ;; )
+	{
+		pause();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	if( uxCriticalNesting == 0 )
+	{
+		vPortEnterCritical();
+		prvSwitchContext();
+		vPortExitCritical();
+	}
+	else
+	{
+		/* Like a PendSV on the target, the switch is held pending until
+		interrupts are enabled again. */
+		xPendingYield = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	prvSetTickSignalMask( SIG_BLOCK );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	prvSetTickSignalMask( SIG_UNBLOCK );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	if( uxCriticalNesting == 0 )
+	{
+		vPortDisableInterrupts();
+
+		#if( configNUMBER_OF_CORES > 1 )
+		{
+			vPortGetKernelLock();
+		}
+		#endif
+	}
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	configASSERT( uxCriticalNesting );
+	uxCriticalNesting--;
+
+	if( uxCriticalNesting == 0 )
+	{
+		if( ( xPendingYield != pdFALSE ) && ( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED ) )
+		{
+			xPendingYield = pdFALSE;
+
+			/* Keep interrupts disabled across the switch. */
+			uxCriticalNesting++;
+			prvSwitchContext();
+			uxCriticalNesting--;
+		}
+
+		#if( configNUMBER_OF_CORES > 1 )
+		{
+			vPortReleaseKernelLock();
+		}
+		#endif
+
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMask( void )
+{
+	vPortEnterCritical();
+
+	/* The mask is held in the nesting count, there is nothing to return. */
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxMask )
+{
+	( void ) uxMask;
+	vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortIsInsideInterrupt( void )
+{
+	return xInsideInterrupt;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetContextSwitchCount( void )
+{
+	return ulContextSwitches;
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	void vPortYieldCore( BaseType_t xCoreID )
+	{
+		/* Called with the kernel lock held, so the task cannot leave the
+		core before the signal is sent.  If it has interrupts masked the
+		signal waits for it to unmask them. */
+		pthread_kill( prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) )->xThread, portYIELD_SIGNAL );
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxPortSetInterruptMaskLocal( void )
+	{
+	UBaseType_t uxReturn = ( UBaseType_t ) xInterruptsHeldOff;
+
+		xInterruptsHeldOff = pdTRUE;
+		portMEMORY_BARRIER();
+
+		return uxReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortClearInterruptMaskLocal( UBaseType_t uxMask )
+	{
+	UBaseType_t uxSignals;
+
+		portMEMORY_BARRIER();
+		xInterruptsHeldOff = ( BaseType_t ) uxMask;
+
+		if( ( uxMask == 0U ) && ( uxHeldOffSignals != 0U ) )
+		{
+			/* A signal that arrives from here on is handled straight away
+			rather than recorded. */
+			uxSignals = uxHeldOffSignals;
+			uxHeldOffSignals = 0U;
+
+			if( ( uxSignals & ( 1UL << portTICK_SIGNAL ) ) != 0U )
+			{
+				pthread_kill( pthread_self(), portTICK_SIGNAL );
+			}
+
+			if( ( uxSignals & ( 1UL << portYIELD_SIGNAL ) ) != 0U )
+			{
+				pthread_kill( pthread_self(), portYIELD_SIGNAL );
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortGetKernelLock( void )
+	{
+	BaseType_t xExpected;
+	uint32_t ulSpins = 0;
+
+		/* Only this core can have made itself the owner. */
+		if( xKernelLockOwner == xPortCoreID )
+		{
+			uxKernelLockCount++;
+		}
+		else
+		{
+			for( ;; )
+			{
+				xExpected = -1;
+
+				if( __atomic_compare_exchange_n( &xKernelLockOwner, &xExpected, xPortCoreID, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+				{
+					break;
+				}
+
+				/* The core holding the lock may be sharing this host
+				processor. */
+				if( ++ulSpins >= portKERNEL_LOCK_SPINS )
+				{
+					ulSpins = 0;
+					sched_yield();
+				}
+			}
+
+			uxKernelLockCount = 1;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortReleaseKernelLock( void )
+	{
+		configASSERT( xKernelLockOwner == xPortCoreID );
+		configASSERT( uxKernelLockCount );
+
+		uxKernelLockCount--;
+
+		if( uxKernelLockCount == 0 )
+		{
+			__atomic_store_n( &xKernelLockOwner, -1, __ATOMIC_RELEASE );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxPortGetCriticalNesting( void )
+	{
+		return uxCriticalNesting;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortWaitForInterrupt( void )
+	{
+	struct timespec xTickPeriod;
+
+		/* Sleep for up to a tick.  The yield signal cuts the sleep short
+		when another core readies a task for this one. */
+		xTickPeriod.tv_sec = 0;
+		xTickPeriod.tv_nsec = 1000000000L / configTICK_RATE_HZ;
+		nanosleep( &xTickPeriod, NULL );
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configNUMBER_OF_CORES */
+
+void vPortThreadDying( void *pvTaskToDelete, volatile BaseType_t *pxPendYield )
+{
+	/* The thread exits instead of parking when it yields away for the last
+	time - see prvSwitchContext(). */
+	prvGetThreadFromTask( ( TaskHandle_t ) pvTaskToDelete )->xDying = pdTRUE;
+	( void ) pxPendYield;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCancelThread( void *pxTaskToDelete )
+{
+Thread_t *pxThread = prvGetThreadFromTask( ( TaskHandle_t ) pxTaskToDelete );
+
+	/* The thread lives in the stack that is about to be freed, so wait for
+	the thread to exit before returning.  A task that deleted itself has
+	already exited, any other task is woken so it can exit. */
+	pxThread->xDying = pdTRUE;
+	sem_post( &( pxThread->xWakeUp ) );
+
+	/* pthread_join() frees the thread's stack under a lock inside the C
+	library.  Keep the tick masked so the calling task cannot be switched out
+	while it holds that lock, otherwise the next task to create a thread would
+	block on the lock forever. */
+	vPortEnterCritical();
+	pthread_join( pxThread->xThread, NULL );
+	vPortExitCritical();
+
+	sem_destroy( &( pxThread->xWakeUp ) );
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MIRRORED_STREAM_BUFFERS == 1 )
+
+	void *pvPortMallocMirrored( size_t *pxSize )
+	{
+	size_t xPageSize = ( size_t ) sysconf( _SC_PAGESIZE );
+	size_t xSize = ( ( *pxSize + xPageSize - 1 ) / xPageSize ) * xPageSize;
+	uint8_t *pucReturn = NULL;
+	void *pvReserved;
+	int iFile;
+
+		/* Reserve twice the size, then map the same memory file over both
+		halves. */
+		iFile = memfd_create( "mirrored", 0 );
+
+		if( iFile >= 0 )
+		{
+			if( ftruncate( iFile, ( off_t ) xSize ) == 0 )
+			{
+				pvReserved = mmap( NULL, 2 * xSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+
+				if( pvReserved != MAP_FAILED )
+				{
+					if( ( mmap( pvReserved, xSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, iFile, 0 ) != MAP_FAILED ) &&
+						( mmap( ( uint8_t * ) pvReserved + xSize, xSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, iFile, 0 ) != MAP_FAILED ) )
+					{
+						pucReturn = ( uint8_t * ) pvReserved;
+						*pxSize = xSize;
+					}
+					else
+					{
+						munmap( pvReserved, 2 * xSize );
+					}
+				}
+			}
+
+			/* The mappings keep the memory. */
+			close( iFile );
+		}
+
+		return pucReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortFreeMirrored( void *pv, size_t xSize )
+	{
+		munmap( pv, 2 * xSize );
+	}
+
+#endif /* configUSE_MIRRORED_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+void xPortSysTickHandler( void )
+{
+	/* Interrupts are already masked while the signal handler runs. */
+	if( xTaskIncrementTick() != pdFALSE )
+	{
+		/* A context switch is required.  Context switching is performed on
+		the way out of the handler. */
+		xPendingYield = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickSignalHandler( int iSignal )
+{
+	( void ) iSignal;
+
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		if( prvHoldOffSignal( iSignal ) != pdFALSE )
+		{
+			return;
+		}
+	}
+	#endif
+
+	uxCriticalNesting++;
+
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		vPortGetKernelLock();
+	}
+	#endif
+
+	xInsideInterrupt = pdTRUE;
+
+	xPortSysTickHandler();
+
+	xInsideInterrupt = pdFALSE;
+
+	if( xPendingYield != pdFALSE )
+	{
+		xPendingYield = pdFALSE;
+		prvSwitchContext();
+	}
+
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		vPortReleaseKernelLock();
+	}
+	#endif
+
+	uxCriticalNesting--;
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static void prvYieldSignalHandler( int iSignal )
+	{
+		if( prvHoldOffSignal( iSignal ) == pdFALSE )
+		{
+			uxCriticalNesting++;
+			vPortGetKernelLock();
+
+			/* Another core readied a task for this one, or wants the task
+			running here moved off it. */
+			xPendingYield = pdFALSE;
+			prvSwitchContext();
+
+			vPortReleaseKernelLock();
+			uxCriticalNesting--;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvHoldOffSignal( int iSignal )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		if( xInterruptsHeldOff != pdFALSE )
+		{
+			uxHeldOffSignals |= ( 1UL << iSignal );
+			xReturn = pdTRUE;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configNUMBER_OF_CORES */
+
+static void prvSwitchContext( void )
+{
+Thread_t *pxThreadToSuspend, *pxThreadToResume;
+
+	pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+	vTaskSwitchContext();
+	pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+	if( pxThreadToResume != pxThreadToSuspend )
+	{
+		( void ) __atomic_fetch_add( &ulContextSwitches, 1U, __ATOMIC_RELAXED );
+
+		#if( configNUMBER_OF_CORES > 1 )
+		{
+			/* The resumed thread takes over this core, and the kernel lock
+			this core holds. */
+			pxThreadToResume->xCoreID = xPortCoreID;
+		}
+		#endif
+
+		sem_post( &( pxThreadToResume->xWakeUp ) );
+
+		if( pxThreadToSuspend->xDying != pdFALSE )
+		{
+			/* The task deleted itself - its thread is joined by the idle task
+			when the TCB is freed. */
+			pthread_exit( NULL );
+		}
+
+		prvSuspendSelf( pxThreadToSuspend );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuspendSelf( Thread_t *pxThread )
+{
+	while( sem_wait( &( pxThread->xWakeUp ) ) != 0 )
+	{
+		configASSERT( errno == EINTR );
+	}
+
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		xPortCoreID = pxThread->xCoreID;
+	}
+	#endif
+
+	if( pxThread->xDying != pdFALSE )
+	{
+		/* The task was deleted while it was not running. */
+		pthread_exit( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetTickSignalMask( int iHow )
+{
+sigset_t xSignals;
+
+	prvGetInterruptSignals( &xSignals );
+	pthread_sigmask( iHow, &xSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvGetInterruptSignals( sigset_t *pxSignals )
+{
+	sigemptyset( pxSignals );
+	sigaddset( pxSignals, portTICK_SIGNAL );
+
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		sigaddset( pxSignals, portYIELD_SIGNAL );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE != 0 )
+
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+		#if( configPOSIX_FAST_FORWARD == 1 )
+		{
+			/* If no task is waiting on a timeout the expected idle time is
+			measured to portMAX_DELAY - in that case there is nothing to jump
+			to, so sleep on the real time tick like a normal build would. */
+			if( xExpectedIdleTime != ( portMAX_DELAY - xTaskGetTickCount() ) )
+			{
+				/* Every task is blocked, so nothing can happen until the
+				next task unblock time.  Jump straight there - step to the
+				tick before the unblock time and pend the final tick, which
+				unblocks the task(s) when the scheduler is resumed. */
+				vPortEnterCritical();
+				vTaskStepTick( xExpectedIdleTime - ( TickType_t ) 1 );
+				( void ) xTaskIncrementTick();
+				vPortExitCritical();
+				return;
+			}
+		}
+		#endif /* configPOSIX_FAST_FORWARD */
+
+		( void ) xExpectedIdleTime;
+
+		/* The tick is not actually suppressed.  Instead of spinning, the idle
+		task sleeps until the next tick signal has been handled.  The
+		scheduler is suspended, so the tick is pended and processed when the
+		idle task resumes the scheduler. */
+		pause();
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+static void prvSetupTimerInterrupt( void )
+{
+struct itimerval xTimer;
+int iReturn;
+
+	xTimer.it_interval.tv_sec = 0;
+	xTimer.it_interval.tv_usec = 1000000L / configTICK_RATE_HZ;
+	xTimer.it_value = xTimer.it_interval;
+
+	iReturn = setitimer( ITIMER_REAL, &xTimer, NULL );
+	configASSERT( iReturn == 0 );
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,233 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uintptr_t
+#define portBASE_TYPE	long
+#define portPOINTER_SIZE_TYPE	uintptr_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* 32-bit tick type on a 32 or 64-bit host, so reads of the tick count do
+	not need to be guarded with a critical section. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities. */
+extern void vPortYield( void );
+
+#define portYIELD()									vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired )	if( xSwitchRequired != pdFALSE ) portYIELD()
+#define portYIELD_FROM_ISR( x )						portEND_SWITCHING_ISR( x )
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  Interrupts are simulated with signals, so
+disabling interrupts masks the tick signal in the calling thread. */
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern UBaseType_t uxPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( UBaseType_t uxMask );
+
+#define portDISABLE_INTERRUPTS()				vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()					vPortEnableInterrupts()
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()		uxPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
+/*-----------------------------------------------------------*/
+
+/* Each task is backed by a host thread, which must be torn down when the
+task is deleted. */
+extern void vPortThreadDying( void *pvTaskToDelete, volatile BaseType_t *pxPendYield );
+extern void vPortCancelThread( void *pxTaskToDelete );
+
+#define portPRE_TASK_DELETE_HOOK( pvTaskToDelete, pxPendYield )	vPortThreadDying( ( pvTaskToDelete ), ( pxPendYield ) )
+#define portCLEAN_UP_TCB( pxTCB )									vPortCancelThread( pxTCB )
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	/* Each simulated core is the thread of the task it is running, so the core
+	ID is kept in thread local storage and handed over with the processor when
+	one task thread resumes another.  One core interrupts another by sending
+	the yield signal to the thread running on it. */
+	extern __thread BaseType_t xPortCoreID;
+	extern void vPortYieldCore( BaseType_t xCoreID );
+	extern UBaseType_t uxPortSetInterruptMaskLocal( void );
+	extern void vPortClearInterruptMaskLocal( UBaseType_t uxMask );
+	extern void vPortGetKernelLock( void );
+	extern void vPortReleaseKernelLock( void );
+	extern UBaseType_t uxPortGetCriticalNesting( void );
+	extern void vPortWaitForInterrupt( void );
+
+	#define portGET_CORE_ID()						xPortCoreID
+	#define portYIELD_CORE( xCoreID )				vPortYieldCore( xCoreID )
+	#define portSET_INTERRUPT_MASK()				uxPortSetInterruptMaskLocal()
+	#define portCLEAR_INTERRUPT_MASK( uxMask )		vPortClearInterruptMaskLocal( uxMask )
+	#define portGET_KERNEL_LOCK()					vPortGetKernelLock()
+	#define portRELEASE_KERNEL_LOCK()				vPortReleaseKernelLock()
+	#define portGET_CRITICAL_NESTING_COUNT()		uxPortGetCriticalNesting()
+
+	/* An idle core sleeps until the next tick or until another core
+	interrupts it, rather than spinning on the host processor. */
+	#define portWAIT_FOR_INTERRUPT()				vPortWaitForInterrupt()
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+/* Tickless idle functionality.  The host has no low power mode - the idle
+task simply sleeps until the next tick signal arrives. */
+#ifndef portSUPPRESS_TICKS_AND_SLEEP
+	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+/*-----------------------------------------------------------*/
+
+/* Port specific optimisations. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+#endif
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Check the configuration. */
+	#if( configMAX_PRIORITIES > 32 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#endif
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31UL - ( uint32_t ) __builtin_clz( ( uint32_t ) ( uxReadyPriorities ) ) )
+
+#endif /* taskRECORD_READY_PRIORITY */
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site.  These are
+not necessary for to use this port.  They are defined so the common demo files
+(which build with all the ports) will build. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+/* GCC keeps the compiler from reordering memory accesses around the
+scheduler suspension count. */
+#define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+
+/* portNOP() is not required by this port. */
+#define portNOP()
+
+#define portINLINE __inline
+
+#ifndef portFORCE_INLINE
+	#define portFORCE_INLINE inline __attribute__(( always_inline ))
+#endif
+
+/*-----------------------------------------------------------*/
+
+extern BaseType_t xPortIsInsideInterrupt( void );
+
+/* Number of context switches performed since the scheduler was started -
+used by the host benchmarks. */
+extern uint32_t ulPortGetContextSwitchCount( void );
+/*-----------------------------------------------------------*/
+
+/* Lock free primitives used by atomic.h in place of a critical section.  With
+one core task threads only run one at a time, but the tick signal can still
+interrupt a read-modify-write, and with more than one core the threads run in
+parallel, so the GCC builtins are used rather than plain accesses. */
+#define portHAS_ATOMIC_INSTRUCTIONS 1
+
+static portFORCE_INLINE uint32_t ulPortAtomicCompareAndSwap_u32( uint32_t volatile *pulDestination, uint32_t ulExchange, uint32_t ulComparand )
+{
+	return __atomic_compare_exchange_n( pulDestination, &ulComparand, ulExchange, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) ? 1U : 0U;
+}
+
+static portFORCE_INLINE uint32_t ulPortAtomicCompareAndSwapPointers( void * volatile *ppvDestination, void *pvExchange, void *pvComparand )
+{
+	return __atomic_compare_exchange_n( ppvDestination, &pvComparand, pvExchange, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) ? 1U : 0U;
+}
+
+static portFORCE_INLINE uint32_t ulPortAtomicFetchAndAdd_u32( uint32_t volatile *pulAddend, uint32_t ulCount )
+{
+	return __atomic_fetch_add( pulAddend, ulCount, __ATOMIC_SEQ_CST );
+}
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
+
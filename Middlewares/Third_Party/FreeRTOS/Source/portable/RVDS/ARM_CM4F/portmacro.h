@@ -242,6 +242,55 @@ BaseType_t xReturn;
 
 	return xReturn;
 }
+/*-----------------------------------------------------------*/
+
+/* Lock free primitives used by atomic.h in place of a critical section.  The
+exclusive monitor is cleared on every exception entry and return, so if an
+interrupt or another task touches the variable between the LDREX and the STREX
+the store fails and the sequence is simply retried. */
+#define portHAS_ATOMIC_INSTRUCTIONS 1
+
+static portFORCE_INLINE uint32_t ulPortAtomicCompareAndSwap_u32( uint32_t volatile *pulDestination, uint32_t ulExchange, uint32_t ulComparand )
+{
+uint32_t ulReturn = 1UL;
+
+	do
+	{
+		if( __ldrex( pulDestination ) != ulComparand )
+		{
+			/* Nothing to store, release the monitor. */
+			__clrex();
+			ulReturn = 0UL;
+			break;
+		}
+	} while( __strex( ulExchange, pulDestination ) != 0 );
+
+	__dmb( portSY_FULL_READ_WRITE );
+
+	return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE uint32_t ulPortAtomicCompareAndSwapPointers( void * volatile *ppvDestination, void *pvExchange, void *pvComparand )
+{
+	/* Pointers are 32 bits wide on this architecture. */
+	return ulPortAtomicCompareAndSwap_u32( ( uint32_t volatile * ) ppvDestination, ( uint32_t ) pvExchange, ( uint32_t ) pvComparand );
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE uint32_t ulPortAtomicFetchAndAdd_u32( uint32_t volatile *pulAddend, uint32_t ulCount )
+{
+uint32_t ulCurrent;
+
+	do
+	{
+		ulCurrent = __ldrex( pulAddend );
+	} while( __strex( ulCurrent + ulCount, pulAddend ) != 0 );
+
+	__dmb( portSY_FULL_READ_WRITE );
+
+	return ulCurrent;
+}
 
 
 #ifdef __cplusplus
@@ -37,6 +37,14 @@ task.h is included from an application file. */
 #include "task.h"
 #include "queue.h"
 
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+	#include "atomic.h"
+#endif
+
+#if ( ( configUSE_QUEUE_CONTENTION_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+	#include <stdio.h>
+#endif
+
 #if ( configUSE_CO_ROUTINES == 1 )
 	#include "croutine.h"
 #endif
@@ -72,7 +80,7 @@ typedef struct QueuePointers
 
 typedef struct SemaphoreData
 {
-	TaskHandle_t xMutexHolder;		 /*< The handle of the task that holds the mutex. */
+	TaskHandle_t xMutexHolder;		 /*< The handle of the task that holds the mutex.  Read through queueMUTEX_HOLDER(). */
 	UBaseType_t uxRecursiveCallCount;/*< Maintains a count of the number of times a recursive mutex has been recursively 'taken' when the structure is used as a mutex. */
 } SemaphoreData_t;
 
@@ -89,6 +97,36 @@ zero. */
 	#define queueYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+	/* Items are received in the order of their slots, so while a slot is
+	reserved nothing else can be sent, and while the slot at the front of the
+	queue is peeked nothing else can be received. */
+	#define queueSPACES_AVAILABLE( pxQueue )	( ( ( pxQueue )->pcReservedSlot == NULL ) ? ( ( pxQueue )->uxLength - ( pxQueue )->uxMessagesWaiting ) : ( UBaseType_t ) 0 )
+	#define queueITEMS_AVAILABLE( pxQueue )		( ( ( pxQueue )->pcPeekedSlot == NULL ) ? ( pxQueue )->uxMessagesWaiting : ( UBaseType_t ) 0 )
+#else
+	#define queueSPACES_AVAILABLE( pxQueue )	( ( pxQueue )->uxLength - ( pxQueue )->uxMessagesWaiting )
+	#define queueITEMS_AVAILABLE( pxQueue )		( ( pxQueue )->uxMessagesWaiting )
+#endif
+
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+	/* The mutex holder doubles as the owner word that uncontended takes and
+	gives swap without a critical section.  A task that blocks on the mutex
+	sets its lowest bit, which is always clear in a TCB address, so the
+	holder's next give fails to swap it and takes the slow path that unblocks
+	the waiting task.  The owner word is claimed before the semaphore count
+	is updated, so it alone says whether the mutex is taken. */
+	#define queueMUTEX_CONTENDED				( ( uintptr_t ) 1U )
+	#define queueMUTEX_HOLDER( pxQueue )		( ( TaskHandle_t ) ( ( uintptr_t ) ( pxQueue )->u.xSemaphore.xMutexHolder & ~queueMUTEX_CONTENDED ) )
+	#define queueMUTEX_IS_TAKEN( pxQueue )		( ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX ) && ( queueMUTEX_HOLDER( pxQueue ) != NULL ) )
+	#define queueCLAIM_MUTEX( pxQueue )			prvClaimMutex( pxQueue )
+	#define queueMARK_MUTEX_CONTENDED( pxQueue )	prvMarkMutexContended( pxQueue )
+#else
+	#define queueMUTEX_HOLDER( pxQueue )		( ( pxQueue )->u.xSemaphore.xMutexHolder )
+	#define queueMUTEX_IS_TAKEN( pxQueue )		( pdFALSE )
+	#define queueCLAIM_MUTEX( pxQueue )			( pdTRUE )
+	#define queueMARK_MUTEX_CONTENDED( pxQueue )	( pdTRUE )
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -115,6 +153,11 @@ typedef struct QueueDefinition 		/* The old naming convention is used to prevent
 	volatile int8_t cRxLock;		/*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 	volatile int8_t cTxLock;		/*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 
+	#if( configUSE_QUEUE_ZERO_COPY == 1 )
+		int8_t *pcReservedSlot;		/*< The slot handed out by pvQueueReserveSlot() and not yet committed, or NULL. */
+		int8_t *pcPeekedSlot;		/*< The slot handed out by pvQueuePeekSlot() and not yet released, or NULL. */
+	#endif
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
 	#endif
@@ -128,6 +171,12 @@ typedef struct QueueDefinition 		/* The old naming convention is used to prevent
 		uint8_t ucQueueType;
 	#endif
 
+	#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+		QueueContentionStats_t xContentionStats;	/*< Read by vQueueGetContentionStats(). */
+		TickType_t xTakenAt;		/*< The tick the object was last taken at, while xTaken is pdTRUE. */
+		BaseType_t xTaken;			/*< pdTRUE from the take that left no token available to the give that makes one available again. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -198,6 +247,27 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvIte
  */
 static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copy uxCount items to the back of a queue, or out of the front of a queue,
+ * with at most two calls to memcpy(), and update the number of items waiting.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const void *pvItems, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, void * const pvBuffer, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock up to uxCount of the tasks waiting to receive from, or send to, a
+ * queue - one for each item or space made available.  Returns pdTRUE if any
+ * of them has a priority above the calling task.
+ */
+static BaseType_t prvUnblockTasksWaitingToReceive( Queue_t * const pxQueue, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+static BaseType_t prvUnblockTasksWaitingToSend( Queue_t * const pxQueue, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add uxCount to a queue lock count, stopping at the largest count it can
+ * hold.
+ */
+static int8_t prvAddToQueueLock( const int8_t cLock, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 	/*
 	 * Checks to see if a queue is a member of a queue set, and if so, notifies
@@ -221,6 +291,31 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	static void prvInitialiseMutex( Queue_t *pxNewQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+	/*
+	 * Take a mutex that is free, or give one the calling task holds that no
+	 * other task is blocked on, with a compare-and-swap of the owner word.
+	 * Return pdFALSE, having changed nothing, when the caller must go through
+	 * the slow path instead - always so if the queue is not a mutex.
+	 */
+	static BaseType_t prvTakeMutexFast( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvGiveMutexFast( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The slow path's side of the owner word, called from a critical section.
+	 * prvClaimMutex() swaps a free owner word for the calling task, setting the
+	 * contended bit if tasks are still blocked on the mutex, and returns pdFALSE
+	 * if the mutex is taken.  prvMarkMutexContended() sets the contended bit
+	 * of a taken mutex before the calling task blocks on it, and returns
+	 * pdFALSE if the mutex has been given since it was found taken.  Both
+	 * compare-and-swap, as the holder can give the mutex on another core
+	 * without a critical section, and both return pdTRUE if the queue is not
+	 * a mutex.
+	 */
+	static BaseType_t prvClaimMutex( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+	static BaseType_t prvMarkMutexContended( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 #if( configUSE_MUTEXES == 1 )
 	/*
 	 * If a task waiting for a mutex causes the mutex holder to inherit a
@@ -231,6 +326,28 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	 */
 	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+	/*
+	 * Update the contention counters.  prvRecordTake() is called by a task
+	 * that has just taken a token, with uxCountBefore the count it found and
+	 * xWaited pdTRUE if it had to wait since the tick xWaitStart.  It starts a
+	 * hold if it took the last token, and prvRecordGive() ends the hold when
+	 * it is called before a give that makes a token available again.
+	 * prvRecordTimeout() counts a take, and prvRecordSend() a send, that had
+	 * to wait - the send whether or not it then succeeded.
+	 */
+	static void prvRecordTake( Queue_t * const pxQueue, const UBaseType_t uxCountBefore, const BaseType_t xWaited, const TickType_t xWaitStart ) PRIVILEGED_FUNCTION;
+	static void prvRecordTimeout( Queue_t * const pxQueue, const BaseType_t xWaited, const TickType_t xWaitStart ) PRIVILEGED_FUNCTION;
+	static void prvRecordGive( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+	static void prvRecordSend( Queue_t * const pxQueue, const BaseType_t xWaited, const TickType_t xWaitStart ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Add the time since the tick xWaitStart to the wait counters.  Called
+	 * from a critical section.
+	 */
+	static void prvRecordWait( Queue_t * const pxQueue, const TickType_t xWaitStart ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -267,6 +384,13 @@ Queue_t * const pxQueue = xQueue;
 		pxQueue->cRxLock = queueUNLOCKED;
 		pxQueue->cTxLock = queueUNLOCKED;
 
+		#if( configUSE_QUEUE_ZERO_COPY == 1 )
+		{
+			pxQueue->pcReservedSlot = NULL;
+			pxQueue->pcPeekedSlot = NULL;
+		}
+		#endif
+
 		if( xNewQueue == pdFALSE )
 		{
 			/* If there are tasks blocked waiting to read from the queue, then
@@ -457,6 +581,14 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+	{
+		( void ) memset( &( pxNewQueue->xContentionStats ), 0x00, sizeof( pxNewQueue->xContentionStats ) );
+		pxNewQueue->xTakenAt = ( TickType_t ) 0;
+		pxNewQueue->xTaken = pdFALSE;
+	}
+	#endif /* configUSE_QUEUE_CONTENTION_STATS */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -543,7 +675,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 		{
 			if( pxSemaphore->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
-				pxReturn = pxSemaphore->u.xSemaphore.xMutexHolder;
+				pxReturn = queueMUTEX_HOLDER( pxSemaphore );
 			}
 			else
 			{
@@ -571,7 +703,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 		not required here. */
 		if( ( ( Queue_t * ) xSemaphore )->uxQueueType == queueQUEUE_IS_MUTEX )
 		{
-			pxReturn = ( ( Queue_t * ) xSemaphore )->u.xSemaphore.xMutexHolder;
+			pxReturn = queueMUTEX_HOLDER( ( Queue_t * ) xSemaphore );
 		}
 		else
 		{
@@ -599,7 +731,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 		this is the only condition we are interested in it does not matter if
 		pxMutexHolder is accessed simultaneously by another task.  Therefore no
 		mutual exclusion is required to test the pxMutexHolder variable. */
-		if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+		if( queueMUTEX_HOLDER( pxMutex ) == xTaskGetCurrentTaskHandle() )
 		{
 			traceGIVE_MUTEX_RECURSIVE( pxMutex );
 
@@ -653,7 +785,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 
 		traceTAKE_MUTEX_RECURSIVE( pxMutex );
 
-		if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+		if( queueMUTEX_HOLDER( pxMutex ) == xTaskGetCurrentTaskHandle() )
 		{
 			( pxMutex->u.xSemaphore.uxRecursiveCallCount )++;
 			xReturn = pdPASS;
@@ -742,6 +874,9 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQ
 BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
 TimeOut_t xTimeOut;
 Queue_t * const pxQueue = xQueue;
+#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+	TickType_t xWaitStart = ( TickType_t ) 0;	/* When the wait began - xTaskCheckForTimeOut() moves xTimeOut on. */
+#endif
 
 	configASSERT( pxQueue );
 	configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
@@ -753,9 +888,38 @@ Queue_t * const pxQueue = xQueue;
 	#endif
 
 
+	#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+	{
+		/* A mutex is given by its holder, which ends the hold before the fast
+		path below can hand the mutex to another task. */
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			prvRecordGive( pxQueue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	/*lint -save -e904 This function relaxes the coding standard somewhat to
 	allow return statements within the function itself.  This is done in the
 	interest of execution time efficiency. */
+	#if( configUSE_MUTEX_FAST_PATH == 1 )
+	{
+		if( prvGiveMutexFast( pxQueue ) != pdFALSE )
+		{
+			traceQUEUE_SEND( pxQueue );
+			return pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	for( ;; )
 	{
 		taskENTER_CRITICAL();
@@ -764,10 +928,25 @@ Queue_t * const pxQueue = xQueue;
 			highest priority task wanting to access the queue.  If the head item
 			in the queue is to be overwritten then it does not matter if the
 			queue is full. */
-			if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+			if( ( queueSPACES_AVAILABLE( pxQueue ) > ( UBaseType_t ) 0 ) || ( xCopyPosition == queueOVERWRITE ) )
 			{
 				traceQUEUE_SEND( pxQueue );
 
+				#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+				{
+					prvRecordSend( pxQueue, xEntryTimeSet, xWaitStart );
+
+					if( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX )
+					{
+						prvRecordGive( pxQueue );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif
+
 				#if ( configUSE_QUEUE_SETS == 1 )
 				{
 				const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -871,6 +1050,12 @@ Queue_t * const pxQueue = xQueue;
 			{
 				if( xTicksToWait == ( TickType_t ) 0 )
 				{
+					#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+					{
+						prvRecordSend( pxQueue, xEntryTimeSet, xWaitStart );
+					}
+					#endif
+
 					/* The queue was full and no block time is specified (or
 					the block time has expired) so leave now. */
 					taskEXIT_CRITICAL();
@@ -886,6 +1071,11 @@ Queue_t * const pxQueue = xQueue;
 					configure the timeout structure. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+					#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+					{
+						xWaitStart = xTimeOut.xTimeOnEntering;
+					}
+					#endif
 				}
 				else
 				{
@@ -940,6 +1130,12 @@ Queue_t * const pxQueue = xQueue;
 			prvUnlockQueue( pxQueue );
 			( void ) xTaskResumeAll();
 
+			#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+			{
+				prvRecordSend( pxQueue, xEntryTimeSet, xWaitStart );
+			}
+			#endif
+
 			traceQUEUE_SEND_FAILED( pxQueue );
 			return errQUEUE_FULL;
 		}
@@ -980,7 +1176,7 @@ Queue_t * const pxQueue = xQueue;
 	post). */
 	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+		if( ( queueSPACES_AVAILABLE( pxQueue ) > ( UBaseType_t ) 0 ) || ( xCopyPosition == queueOVERWRITE ) )
 		{
 			const int8_t cTxLock = pxQueue->cTxLock;
 			const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1130,7 +1326,7 @@ Queue_t * const pxQueue = xQueue;
 	/* Normally a mutex would not be given from an interrupt, especially if
 	there is a mutex holder, as priority inheritance makes no sense for an
 	interrupts, only tasks. */
-	configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) ) );
+	configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( queueMUTEX_HOLDER( pxQueue ) != NULL ) ) );
 
 	/* RTOS ports that support interrupt nesting have the concept of a maximum
 	system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -1274,20 +1470,90 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
+BaseType_t xQueueGiveMultiple( QueueHandle_t xQueue, UBaseType_t uxCount )
+{
+BaseType_t xReturn = pdPASS, xYieldRequired = pdFALSE;
+UBaseType_t uxSpace;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+
+	/* Only semaphores hold a count rather than items. */
+	configASSERT( pxQueue->uxItemSize == 0 );
+
+	/* A mutex has a single owner, so giving it more than once makes no
+	sense. */
+	configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+	taskENTER_CRITICAL();
+	{
+		if( uxCount == queueGIVE_ALL_WAITERS )
+		{
+			uxCount = listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Give as many counts as there is room for. */
+		uxSpace = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+		if( uxCount > uxSpace )
+		{
+			uxCount = uxSpace;
+			xReturn = errQUEUE_FULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxCount > ( UBaseType_t ) 0 )
+		{
+			traceQUEUE_SEND( pxQueue );
+
+			pxQueue->uxMessagesWaiting += uxCount;
+
+			/* Unblock one waiting task per count given.  All of them are
+			moved to the ready lists before any of them runs, so the calling
+			task yields at most once however many were woken. */
+			xYieldRequired = prvUnblockTasksWaitingToReceive( pxQueue, uxCount );
+
+			if( xYieldRequired != pdFALSE )
+			{
+				/* At least one unblocked task has a priority above our own.
+				Yes it is ok to do this from within the critical section - the
+				kernel takes care of that. */
+				queueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxCount, TickType_t xTicksToWait )
 {
 BaseType_t xEntryTimeSet = pdFALSE;
 TimeOut_t xTimeOut;
+UBaseType_t uxToSend;
 Queue_t * const pxQueue = xQueue;
 
-	/* Check the pointer is not NULL. */
-	configASSERT( ( pxQueue ) );
-
-	/* The buffer into which data is received can only be NULL if the data size
-	is zero (so no data is copied into the buffer. */
-	configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvItems == NULL ) && ( uxCount != ( UBaseType_t ) 0U ) ) );
 
-	/* Cannot block if the scheduler is suspended. */
+	/* Semaphores are given more than once with xSemaphoreGiveMultiple(). */
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 	{
 		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
@@ -1295,37 +1561,38 @@ Queue_t * const pxQueue = xQueue;
 	#endif
 
 
-	/*lint -save -e904  This function relaxes the coding standard somewhat to
+	/*lint -save -e904 This function relaxes the coding standard somewhat to
 	allow return statements within the function itself.  This is done in the
 	interest of execution time efficiency. */
 	for( ;; )
 	{
 		taskENTER_CRITICAL();
 		{
-			const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+			/* Send as many of the items as there is room for now. */
+			uxToSend = queueSPACES_AVAILABLE( pxQueue );
+			if( uxToSend > uxCount )
+			{
+				uxToSend = uxCount;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-			/* Is there data in the queue now?  To be running the calling task
-			must be the highest priority task wanting to access the queue. */
-			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			if( ( uxToSend > ( UBaseType_t ) 0 ) || ( uxCount == ( UBaseType_t ) 0 ) )
 			{
-				/* Data available, remove one item. */
-				prvCopyDataFromQueue( pxQueue, pvBuffer );
-				traceQUEUE_RECEIVE( pxQueue );
-				pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+				traceQUEUE_SEND( pxQueue );
 
-				/* There is now space in the queue, were any tasks waiting to
-				post to the queue?  If so, unblock the highest priority waiting
-				task. */
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+				prvCopyItemsToQueue( pxQueue, pvItems, uxToSend );
+
+				/* Each item sent can satisfy one waiting task.  All of them
+				are moved to the ready lists before any of them runs, so the
+				calling task yields at most once however many were woken. */
+				if( prvUnblockTasksWaitingToReceive( pxQueue, uxToSend ) != pdFALSE )
 				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-					{
-						queueYIELD_IF_USING_PREEMPTION();
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+					/* Yes it is ok to do this from within the critical
+					section - the kernel takes care of that. */
+					queueYIELD_IF_USING_PREEMPTION();
 				}
 				else
 				{
@@ -1333,21 +1600,21 @@ Queue_t * const pxQueue = xQueue;
 				}
 
 				taskEXIT_CRITICAL();
-				return pdPASS;
+				return uxToSend;
 			}
 			else
 			{
 				if( xTicksToWait == ( TickType_t ) 0 )
 				{
-					/* The queue was empty and no block time is specified (or
+					/* The queue was full and no block time is specified (or
 					the block time has expired) so leave now. */
 					taskEXIT_CRITICAL();
-					traceQUEUE_RECEIVE_FAILED( pxQueue );
-					return errQUEUE_EMPTY;
+					traceQUEUE_SEND_FAILED( pxQueue );
+					return ( UBaseType_t ) 0;
 				}
 				else if( xEntryTimeSet == pdFALSE )
 				{
-					/* The queue was empty and a block time was specified so
+					/* The queue was full and a block time was specified so
 					configure the timeout structure. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
@@ -1362,7 +1629,8 @@ Queue_t * const pxQueue = xQueue;
 		taskEXIT_CRITICAL();
 
 		/* Interrupts and other tasks can send to and receive from the queue
-		now the critical section has been exited. */
+		now the critical section has been exited.  Block exactly as
+		xQueueGenericSend() does until there is room for at least one item. */
 
 		vTaskSuspendAll();
 		prvLockQueue( pxQueue );
@@ -1370,13 +1638,12 @@ Queue_t * const pxQueue = xQueue;
 		/* Update the timeout state to see if it has expired yet. */
 		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
 		{
-			/* The timeout has not expired.  If the queue is still empty place
-			the task on the list of tasks waiting to receive from the queue. */
-			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
 			{
-				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
-				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
 				prvUnlockQueue( pxQueue );
+
 				if( xTaskResumeAll() == pdFALSE )
 				{
 					portYIELD_WITHIN_API();
@@ -1388,86 +1655,328 @@ Queue_t * const pxQueue = xQueue;
 			}
 			else
 			{
-				/* The queue contains data again.  Loop back to try and read the
-				data. */
+				/* Try again. */
 				prvUnlockQueue( pxQueue );
 				( void ) xTaskResumeAll();
 			}
 		}
 		else
 		{
-			/* Timed out.  If there is no data in the queue exit, otherwise loop
-			back and attempt to read the data. */
+			/* The timeout has expired. */
 			prvUnlockQueue( pxQueue );
 			( void ) xTaskResumeAll();
 
-			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-			{
-				traceQUEUE_RECEIVE_FAILED( pxQueue );
-				return errQUEUE_EMPTY;
-			}
-			else
-			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return ( UBaseType_t ) 0;
 		}
 	} /*lint -restore */
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
+UBaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxCount, BaseType_t * const pxHigherPriorityTaskWoken )
 {
-BaseType_t xEntryTimeSet = pdFALSE;
-TimeOut_t xTimeOut;
+UBaseType_t uxToSend, uxSavedInterruptStatus;
 Queue_t * const pxQueue = xQueue;
 
-#if( configUSE_MUTEXES == 1 )
-	BaseType_t xInheritanceOccurred = pdFALSE;
-#endif
-
-	/* Check the queue pointer is not NULL. */
-	configASSERT( ( pxQueue ) );
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvItems == NULL ) && ( uxCount != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-	/* Check this really is a semaphore, in which case the item size will be
-	0. */
-	configASSERT( pxQueue->uxItemSize == 0 );
+	/* See the comment on the maximum system call interrupt priority in
+	xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	/* Cannot block if the scheduler is suspended. */
-	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
-	}
-	#endif
-
+		uxToSend = queueSPACES_AVAILABLE( pxQueue );
+		if( uxToSend > uxCount )
+		{
+			uxToSend = uxCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-	/*lint -save -e904 This function relaxes the coding standard somewhat to allow return
-	statements within the function itself.  This is done in the interest
-	of execution time efficiency. */
-	for( ;; )
-	{
-		taskENTER_CRITICAL();
+		if( uxToSend > ( UBaseType_t ) 0 )
 		{
-			/* Semaphores are queues with an item size of 0, and where the
-			number of messages in the queue is the semaphore's count value. */
-			const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+			const int8_t cTxLock = pxQueue->cTxLock;
 
-			/* Is there data in the queue now?  To be running the calling task
-			must be the highest priority task wanting to access the queue. */
-			if( uxSemaphoreCount > ( UBaseType_t ) 0 )
-			{
-				traceQUEUE_RECEIVE( pxQueue );
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
 
-				/* Semaphores are queues with a data size of zero and where the
-				messages waiting is the semaphore's count.  Reduce the count. */
-				pxQueue->uxMessagesWaiting = uxSemaphoreCount - ( UBaseType_t ) 1;
+			prvCopyItemsToQueue( pxQueue, pvItems, uxToSend );
 
-				#if ( configUSE_MUTEXES == 1 )
+			/* The event list is not altered if the queue is locked.  This will
+			be done when the queue is unlocked later. */
+			if( cTxLock == queueUNLOCKED )
+			{
+				if( prvUnblockTasksWaitingToReceive( pxQueue, uxToSend ) != pdFALSE )
 				{
-					if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+					if( pxHigherPriorityTaskWoken != NULL )
 					{
-						/* Record the information required to implement
-						priority inheritance should it become necessary. */
-						pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Add one to the lock count per item so the task that unlocks
+				the queue can unblock a task for each. */
+				pxQueue->cTxLock = prvAddToQueueLock( cTxLock, uxToSend );
+			}
+		}
+		else
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxToSend;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = xQueue;
+
+	/* Check the pointer is not NULL. */
+	configASSERT( ( pxQueue ) );
+
+	/* The buffer into which data is received can only be NULL if the data size
+	is zero (so no data is copied into the buffer. */
+	configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+
+	/*lint -save -e904  This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+			/* Is there data in the queue now?  To be running the calling task
+			must be the highest priority task wanting to access the queue. */
+			if( queueITEMS_AVAILABLE( pxQueue ) > ( UBaseType_t ) 0 )
+			{
+				/* Data available, remove one item. */
+				prvCopyDataFromQueue( pxQueue, pvBuffer );
+				traceQUEUE_RECEIVE( pxQueue );
+				pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+
+				/* There is now space in the queue, were any tasks waiting to
+				post to the queue?  If so, unblock the highest priority waiting
+				task. */
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+					{
+						queueYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return pdPASS;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue was empty and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return errQUEUE_EMPTY;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					/* The queue was empty and a block time was specified so
+					configure the timeout structure. */
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Interrupts and other tasks can send to and receive from the queue
+		now the critical section has been exited. */
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			/* The timeout has not expired.  If the queue is still empty place
+			the task on the list of tasks waiting to receive from the queue. */
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The queue contains data again.  Loop back to try and read the
+				data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* Timed out.  If there is no data in the queue exit, otherwise loop
+			back and attempt to read the data. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return errQUEUE_EMPTY;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = xQueue;
+#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+	TickType_t xWaitStart = ( TickType_t ) 0;	/* When the wait began - xTaskCheckForTimeOut() moves xTimeOut on. */
+#endif
+
+#if( configUSE_MUTEXES == 1 )
+	BaseType_t xInheritanceOccurred = pdFALSE;
+#endif
+
+	/* Check the queue pointer is not NULL. */
+	configASSERT( ( pxQueue ) );
+
+	/* Check this really is a semaphore, in which case the item size will be
+	0. */
+	configASSERT( pxQueue->uxItemSize == 0 );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+
+	/*lint -save -e904 This function relaxes the coding standard somewhat to allow return
+	statements within the function itself.  This is done in the interest
+	of execution time efficiency. */
+	#if( configUSE_MUTEX_FAST_PATH == 1 )
+	{
+		if( prvTakeMutexFast( pxQueue ) != pdFALSE )
+		{
+			traceQUEUE_RECEIVE( pxQueue );
+
+			#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+			{
+				prvRecordTake( pxQueue, ( UBaseType_t ) 1, pdFALSE, ( TickType_t ) 0 );
+			}
+			#endif
+
+			return pdPASS;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Semaphores are queues with an item size of 0, and where the
+			number of messages in the queue is the semaphore's count value. */
+			const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+
+			/* Is there data in the queue now?  To be running the calling task
+			must be the highest priority task wanting to access the queue. */
+			if( ( uxSemaphoreCount > ( UBaseType_t ) 0 ) && ( queueCLAIM_MUTEX( pxQueue ) != pdFALSE ) )
+			{
+				traceQUEUE_RECEIVE( pxQueue );
+
+				/* Semaphores are queues with a data size of zero and where the
+				messages waiting is the semaphore's count.  Reduce the count. */
+				pxQueue->uxMessagesWaiting = uxSemaphoreCount - ( UBaseType_t ) 1;
+
+				#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+				{
+					prvRecordTake( pxQueue, uxSemaphoreCount, xEntryTimeSet, xWaitStart );
+				}
+				#endif
+
+				#if ( configUSE_MUTEXES == 1 )
+				{
+					if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+					{
+						/* Record the information required to implement
+						priority inheritance should it become necessary.  With
+						the fast path the owner word was claimed above. */
+						#if( configUSE_MUTEX_FAST_PATH == 1 )
+						{
+							( void ) pvTaskIncrementMutexHeldCount();
+						}
+						#else
+						{
+							pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+						}
+						#endif
 					}
 					else
 					{
@@ -1510,6 +2019,12 @@ Queue_t * const pxQueue = xQueue;
 					}
 					#endif /* configUSE_MUTEXES */
 
+					#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+					{
+						prvRecordTimeout( pxQueue, xEntryTimeSet, xWaitStart );
+					}
+					#endif
+
 					/* The semaphore count was 0 and no block time is specified
 					(or the block time has expired) so exit now. */
 					taskEXIT_CRITICAL();
@@ -1522,6 +2037,11 @@ Queue_t * const pxQueue = xQueue;
 					so configure the timeout structure ready to block. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+					#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+					{
+						xWaitStart = xTimeOut.xTimeOnEntering;
+					}
+					#endif
 				}
 				else
 				{
@@ -1545,7 +2065,9 @@ Queue_t * const pxQueue = xQueue;
 			count is 0 then enter the Blocked state to wait for a semaphore to
 			become available.  As semaphores are implemented with queues the
 			queue being empty is equivalent to the semaphore count being 0. */
-			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			/* A mutex is marked as contended before blocking on it, so the
+			holder's give takes the slow path that unblocks this task. */
+			if( ( prvIsQueueEmpty( pxQueue ) != pdFALSE ) && ( queueMARK_MUTEX_CONTENDED( pxQueue ) != pdFALSE ) )
 			{
 				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
 
@@ -1555,7 +2077,7 @@ Queue_t * const pxQueue = xQueue;
 					{
 						taskENTER_CRITICAL();
 						{
-							xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+							xInheritanceOccurred = xTaskPriorityInherit( queueMUTEX_HOLDER( pxQueue ) );
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1614,13 +2136,19 @@ Queue_t * const pxQueue = xQueue;
 							again, but only as low as the next highest priority
 							task that is waiting for the same mutex. */
 							uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
-							vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+							vTaskPriorityDisinheritAfterTimeout( queueMUTEX_HOLDER( pxQueue ), uxHighestWaitingPriority );
 						}
 						taskEXIT_CRITICAL();
 					}
 				}
 				#endif /* configUSE_MUTEXES */
 
+				#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+				{
+					prvRecordTimeout( pxQueue, xEntryTimeSet, xWaitStart );
+				}
+				#endif
+
 				traceQUEUE_RECEIVE_FAILED( pxQueue );
 				return errQUEUE_EMPTY;
 			}
@@ -1812,7 +2340,7 @@ Queue_t * const pxQueue = xQueue;
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
 		/* Cannot block in an ISR, so check there is data available. */
-		if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+		if( queueITEMS_AVAILABLE( pxQueue ) > ( UBaseType_t ) 0 )
 		{
 			const int8_t cRxLock = pxQueue->cRxLock;
 
@@ -1873,16 +2401,591 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,  void * const pvBuffer )
+UBaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxCount, TickType_t xTicksToWait )
 {
-BaseType_t xReturn;
-UBaseType_t uxSavedInterruptStatus;
-int8_t *pcOriginalReadPosition;
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+UBaseType_t uxToReceive;
 Queue_t * const pxQueue = xQueue;
 
 	configASSERT( pxQueue );
-	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-	configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+	configASSERT( pvBuffer );
+	configASSERT( uxMaxCount > ( UBaseType_t ) 0U );
+
+	/* Semaphores and mutexes are taken one at a time. */
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+
+	/*lint -save -e904  This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			/* Receive as many of the items waiting as the buffer has room
+			for. */
+			uxToReceive = queueITEMS_AVAILABLE( pxQueue );
+			if( uxToReceive > uxMaxCount )
+			{
+				uxToReceive = uxMaxCount;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( uxToReceive > ( UBaseType_t ) 0 )
+			{
+				prvCopyItemsFromQueue( pxQueue, pvBuffer, uxToReceive );
+				traceQUEUE_RECEIVE( pxQueue );
+
+				/* There is now space for uxToReceive items, so unblock up to
+				that many tasks that were waiting to send, yielding at most
+				once. */
+				if( prvUnblockTasksWaitingToSend( pxQueue, uxToReceive ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return uxToReceive;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue was empty and no block time is specified (or
+					the block time has expired) so leave now. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return ( UBaseType_t ) 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					/* The queue was empty and a block time was specified so
+					configure the timeout structure. */
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Interrupts and other tasks can send to and receive from the queue
+		now the critical section has been exited.  Block exactly as
+		xQueueReceive() does until there is at least one item. */
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		/* Update the timeout state to see if it has expired yet. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			/* The timeout has not expired.  If the queue is still empty place
+			the task on the list of tasks waiting to receive from the queue. */
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The queue contains data again.  Loop back to try and read the
+				data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* Timed out.  If there is no data in the queue exit, otherwise loop
+			back and attempt to read the data. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return ( UBaseType_t ) 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxCount, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxToReceive, uxSavedInterruptStatus;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pvBuffer );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	/* See the comment on the maximum system call interrupt priority in
+	xQueueReceiveFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		/* Cannot block in an ISR, so take what is there now. */
+		uxToReceive = queueITEMS_AVAILABLE( pxQueue );
+		if( uxToReceive > uxMaxCount )
+		{
+			uxToReceive = uxMaxCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxToReceive > ( UBaseType_t ) 0 )
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+			prvCopyItemsFromQueue( pxQueue, pvBuffer, uxToReceive );
+
+			/* If the queue is locked the event list will not be modified.
+			Instead update the lock count so the task that unlocks the queue
+			will know that an ISR has removed data while the queue was
+			locked. */
+			if( cRxLock == queueUNLOCKED )
+			{
+				if( prvUnblockTasksWaitingToSend( pxQueue, uxToReceive ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxQueue->cRxLock = prvAddToQueueLock( cRxLock, uxToReceive );
+			}
+		}
+		else
+		{
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxToReceive;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	void *pvQueueReserveSlot( QueueHandle_t xQueue, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	void *pvSlot;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		/* Semaphores have no storage to hand out. */
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+
+		/*lint -save -e904 This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Is there room for the item, and is no other slot reserved?
+				The slot is the one the next item sent would be copied into,
+				but it is not counted as an item until it is committed. */
+				if( queueSPACES_AVAILABLE( pxQueue ) > ( UBaseType_t ) 0 )
+				{
+					pxQueue->pcReservedSlot = pxQueue->pcWriteTo;
+					pvSlot = ( void * ) pxQueue->pcWriteTo;
+
+					taskEXIT_CRITICAL();
+					return pvSlot;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was full and no block time is specified (or
+						the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_SEND_FAILED( pxQueue );
+						return NULL;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						/* The queue was full and a block time was specified so
+						configure the timeout structure. */
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* Interrupts and other tasks can send to and receive from the queue
+			now the critical section has been exited.  Block exactly as
+			xQueueGenericSend() does until there is room for the item. */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueFull( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* The timeout has expired. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return NULL;
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	void vQueueCommitSlot( QueueHandle_t xQueue )
+	{
+	BaseType_t xYieldRequired;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			/* Only the task that reserved the slot can commit it. */
+			configASSERT( pxQueue->pcReservedSlot != NULL );
+			pxQueue->pcReservedSlot = NULL;
+
+			/* The item is already in place, so move the write position past it
+			as prvCopyDataToQueue() would have done after copying it in. */
+			pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+			if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+			{
+				pxQueue->pcWriteTo = pxQueue->pcHead;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxQueue->uxMessagesWaiting++;
+			traceQUEUE_SEND( pxQueue );
+
+			/* The item can satisfy one task waiting to receive.  Tasks that
+			blocked to send while the slot was reserved may have found room,
+			so unblock as many of them as there is now room for. */
+			xYieldRequired = prvUnblockTasksWaitingToReceive( pxQueue, 1 );
+			if( prvUnblockTasksWaitingToSend( pxQueue, queueSPACES_AVAILABLE( pxQueue ) ) != pdFALSE )
+			{
+				xYieldRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xYieldRequired != pdFALSE )
+			{
+				/* Yes it is ok to do this from within the critical section -
+				the kernel takes care of that. */
+				queueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	void *pvQueuePeekSlot( QueueHandle_t xQueue, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	int8_t *pcSlot;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		/* Semaphores have no storage to hand out. */
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+		/* Cannot block if the scheduler is suspended. */
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+
+		/*lint -save -e904  This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Is there an item, and is no other slot peeked?  pcReadFrom
+				points to the last item read, so the item at the front of the
+				queue is the one after it.  It stays in the queue until it is
+				released. */
+				if( queueITEMS_AVAILABLE( pxQueue ) > ( UBaseType_t ) 0 )
+				{
+					pcSlot = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+					if( pcSlot >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+					{
+						pcSlot = pxQueue->pcHead;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					pxQueue->pcPeekedSlot = pcSlot;
+					traceQUEUE_PEEK( pxQueue );
+
+					taskEXIT_CRITICAL();
+					return ( void * ) pcSlot;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was empty and no block time is specified (or
+						the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_PEEK_FAILED( pxQueue );
+						return NULL;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						/* The queue was empty and a block time was specified so
+						configure the timeout structure. */
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* Interrupts and other tasks can send to and receive from the queue
+			now the critical section has been exited.  Block exactly as
+			xQueueReceive() does until there is an item. */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				/* The timeout has not expired.  If the queue is still empty place
+				the task on the list of tasks waiting to receive from the queue. */
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* The queue contains data again.  Loop back to try and read the
+					data. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* Timed out.  If there is no data in the queue exit, otherwise loop
+				back and attempt to read the data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceQUEUE_PEEK_FAILED( pxQueue );
+					return NULL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	void vQueueReleaseSlot( QueueHandle_t xQueue )
+	{
+	BaseType_t xYieldRequired;
+	UBaseType_t uxItems;
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			/* Only the task that peeked the slot can release it.  Nothing can
+			have been received since, so it is still the item at the front of
+			the queue, and it becomes the last item read. */
+			configASSERT( pxQueue->pcPeekedSlot != NULL );
+			pxQueue->u.xQueue.pcReadFrom = pxQueue->pcPeekedSlot;
+			pxQueue->pcPeekedSlot = NULL;
+
+			pxQueue->uxMessagesWaiting--;
+			traceQUEUE_RECEIVE( pxQueue );
+
+			/* There is now room for one more item. */
+			xYieldRequired = prvUnblockTasksWaitingToSend( pxQueue, 1 );
+
+			/* Tasks that blocked to receive while the slot was peeked may have
+			found items, so unblock as many of them as there are items left.
+			Any queue set was notified of the items as they were sent, so this
+			does not use prvUnblockTasksWaitingToReceive(). */
+			for( uxItems = pxQueue->uxMessagesWaiting; ( uxItems > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ); uxItems-- )
+			{
+				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+				{
+					xYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			if( xYieldRequired != pdFALSE )
+			{
+				queueYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,  void * const pvBuffer )
+{
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+int8_t *pcOriginalReadPosition;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
 
 	/* RTOS ports that support interrupt nesting have the concept of a maximum
 	system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -2034,41 +3137,366 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+	{
+		return ( ( Queue_t * ) xQueue )->ucQueueType;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEXES == 1 )
+
+	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+	{
+	UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+		/* If a task waiting for a mutex causes the mutex holder to inherit a
+		priority, but the waiting task times out, then the holder should
+		disinherit the priority - but only down to the highest priority of any
+		other tasks that are waiting for the same mutex.  For this purpose,
+		return the priority of the highest priority task that is waiting for the
+		mutex. */
+		if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+		{
+			uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+		}
+		else
+		{
+			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+		}
+
+		return uxHighestPriorityOfWaitingTasks;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+
+	static BaseType_t prvTakeMutexFast( Queue_t * const pxQueue )
+	{
+	BaseType_t xReturn = pdFALSE;
+	TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+
+		if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( xCurrentTask != NULL ) )
+		{
+			/* Only a free mutex has an owner word of NULL - not even the
+			contended bit is set. */
+			if( Atomic_CompareAndSwapPointers_p32( ( void * volatile * ) &( pxQueue->u.xSemaphore.xMutexHolder ), xCurrentTask, NULL ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+			{
+				/* The mutex is now this task's, so nothing else writes the
+				count until this task gives it. */
+				pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0;
+				vTaskIncrementMutexHeldCountOf( xCurrentTask );
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+
+	static BaseType_t prvGiveMutexFast( Queue_t * const pxQueue )
+	{
+	BaseType_t xReturn = pdFALSE;
+	TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+
+		/* An owner word that equals the task handle exactly means the calling
+		task holds the mutex and no task has blocked on it since it was
+		taken.  xCurrentTask is only NULL while the mutex created before any
+		task is given for the first time. */
+		if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( xCurrentTask != NULL ) && ( pxQueue->u.xSemaphore.xMutexHolder == xCurrentTask ) )
+		{
+			if( xTaskDecrementMutexHeldCount( xCurrentTask ) != pdFALSE )
+			{
+				/* The count is set before the owner word is cleared, so a
+				task that finds the mutex free also finds the count right. */
+				pxQueue->uxMessagesWaiting = ( UBaseType_t ) 1;
+
+				if( Atomic_CompareAndSwapPointers_p32( ( void * volatile * ) &( pxQueue->u.xSemaphore.xMutexHolder ), NULL, xCurrentTask ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+				{
+					xReturn = pdTRUE;
+				}
+				else
+				{
+					/* A task blocked on the mutex after the owner word was
+					read.  Undo the give for the slow path to redo. */
+					pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0;
+					vTaskIncrementMutexHeldCountOf( xCurrentTask );
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+
+	static BaseType_t prvClaimMutex( Queue_t * const pxQueue )
+	{
+	BaseType_t xReturn = pdTRUE;
+	void *pvOwner, *pvClaimed;
+
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			pvOwner = pxQueue->u.xSemaphore.xMutexHolder;
+			pvClaimed = xTaskGetCurrentTaskHandle();
+
+			/* Tasks still blocked on the mutex are unblocked by the slow path
+			of the give. */
+			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+			{
+				pvClaimed = ( void * ) ( ( uintptr_t ) pvClaimed | queueMUTEX_CONTENDED );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* A free owner word is NULL, or just the contended bit if tasks
+			were still blocked when the mutex was last given. */
+			if( ( ( ( uintptr_t ) pvOwner & ~queueMUTEX_CONTENDED ) != ( uintptr_t ) 0U ) ||
+				( Atomic_CompareAndSwapPointers_p32( ( void * volatile * ) &( pxQueue->u.xSemaphore.xMutexHolder ), pvClaimed, pvOwner ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS ) )
+			{
+				xReturn = pdFALSE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEX_FAST_PATH == 1 )
+
+	static BaseType_t prvMarkMutexContended( Queue_t * const pxQueue )
+	{
+	BaseType_t xReturn = pdTRUE;
+	void *pvOwner;
+
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			taskENTER_CRITICAL();
+			{
+				for( ;; )
+				{
+					pvOwner = pxQueue->u.xSemaphore.xMutexHolder;
+
+					if( ( ( uintptr_t ) pvOwner & ~queueMUTEX_CONTENDED ) == ( uintptr_t ) 0U )
+					{
+						/* Given since prvIsQueueEmpty() found it taken, so
+						take it again rather than block. */
+						xReturn = pdFALSE;
+						break;
+					}
+
+					if( Atomic_CompareAndSwapPointers_p32( ( void * volatile * ) &( pxQueue->u.xSemaphore.xMutexHolder ), ( void * ) ( ( uintptr_t ) pvOwner | queueMUTEX_CONTENDED ), pvOwner ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+					{
+						break;
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+
+	static void prvRecordTake( Queue_t * const pxQueue, const UBaseType_t uxCountBefore, const BaseType_t xWaited, const TickType_t xWaitStart )
+	{
+		/* Called from a critical section, or after taking a mutex on the fast
+		path - and then no other task can take or give the mutex until this
+		task gives it back. */
+		pxQueue->xContentionStats.ulTakes++;
+
+		if( xWaited != pdFALSE )
+		{
+			pxQueue->xContentionStats.ulContendedTakes++;
+			prvRecordWait( pxQueue, xWaitStart );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxCountBefore == ( UBaseType_t ) 1 )
+		{
+			/* That was the last token, so the hold starts now. */
+			pxQueue->xTakenAt = xTaskGetTickCount();
+			pxQueue->xTaken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_QUEUE_CONTENTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+
+	static void prvRecordTimeout( Queue_t * const pxQueue, const BaseType_t xWaited, const TickType_t xWaitStart )
+	{
+		/* A take with no block time fails without waiting, which is not
+		contention worth counting. */
+		if( xWaited != pdFALSE )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxQueue->xContentionStats.ulTimeouts++;
+				prvRecordWait( pxQueue, xWaitStart );
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_QUEUE_CONTENTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+
+	static void prvRecordGive( Queue_t * const pxQueue )
+	{
+	uint32_t ulHoldTicks;
+
+		/* Called from a critical section, or by the holder of a mutex before
+		it gives the mutex on the fast path. */
+		if( ( pxQueue->xTaken != pdFALSE ) && ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) )
+		{
+			ulHoldTicks = ( uint32_t ) ( xTaskGetTickCount() - pxQueue->xTakenAt );
+			pxQueue->xTaken = pdFALSE;
+			pxQueue->xContentionStats.ulTotalHoldTicks += ulHoldTicks;
+
+			if( ulHoldTicks > pxQueue->xContentionStats.ulMaxHoldTicks )
+			{
+				pxQueue->xContentionStats.ulMaxHoldTicks = ulHoldTicks;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_QUEUE_CONTENTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+
+	static void prvRecordSend( Queue_t * const pxQueue, const BaseType_t xWaited, const TickType_t xWaitStart )
+	{
+		if( xWaited != pdFALSE )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxQueue->xContentionStats.ulBlockedSends++;
+				pxQueue->xContentionStats.ulBlockedSendTicks += ( uint32_t ) ( xTaskGetTickCount() - xWaitStart );
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_QUEUE_CONTENTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
 
-	uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+	static void prvRecordWait( Queue_t * const pxQueue, const TickType_t xWaitStart )
 	{
-		return ( ( Queue_t * ) xQueue )->ucQueueType;
-	}
+	uint32_t ulWaitTicks, ulRemaining;
+	UBaseType_t uxBucket = ( UBaseType_t ) 0;
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+		/* The tick count may have wrapped since the wait started, which
+		the unsigned subtraction allows for as long as the wait was shorter
+		than a full period of the tick count. */
+		ulWaitTicks = ( uint32_t ) ( xTaskGetTickCount() - xWaitStart );
+		pxQueue->xContentionStats.ulTotalWaitTicks += ulWaitTicks;
 
-#if( configUSE_MUTEXES == 1 )
+		if( ulWaitTicks > pxQueue->xContentionStats.ulMaxWaitTicks )
+		{
+			pxQueue->xContentionStats.ulMaxWaitTicks = ulWaitTicks;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
-	{
-	UBaseType_t uxHighestPriorityOfWaitingTasks;
+		/* The bucket is the number of bits needed to hold the wait. */
+		for( ulRemaining = ulWaitTicks; ulRemaining != 0UL; ulRemaining >>= 1UL )
+		{
+			uxBucket++;
+		}
 
-		/* If a task waiting for a mutex causes the mutex holder to inherit a
-		priority, but the waiting task times out, then the holder should
-		disinherit the priority - but only down to the highest priority of any
-		other tasks that are waiting for the same mutex.  For this purpose,
-		return the priority of the highest priority task that is waiting for the
-		mutex. */
-		if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+		if( uxBucket >= ( UBaseType_t ) queueCONTENTION_HISTOGRAM_BUCKETS )
 		{
-			uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+			uxBucket = ( UBaseType_t ) queueCONTENTION_HISTOGRAM_BUCKETS - ( UBaseType_t ) 1;
 		}
 		else
 		{
-			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+			mtCOVERAGE_TEST_MARKER();
 		}
 
-		return uxHighestPriorityOfWaitingTasks;
+		pxQueue->xContentionStats.ulWaitHistogram[ uxBucket ]++;
 	}
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_QUEUE_CONTENTION_STATS */
 /*-----------------------------------------------------------*/
 
 static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
@@ -2086,9 +3514,16 @@ UBaseType_t uxMessagesWaiting;
 		{
 			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
-				/* The mutex is no longer being held. */
-				xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
-				pxQueue->u.xSemaphore.xMutexHolder = NULL;
+				/* The mutex is no longer being held.  With the fast path
+				the owner word is released below, once the count has been
+				updated. */
+				xReturn = xTaskPriorityDisinherit( queueMUTEX_HOLDER( pxQueue ) );
+
+				#if( configUSE_MUTEX_FAST_PATH == 0 )
+				{
+					pxQueue->u.xSemaphore.xMutexHolder = NULL;
+				}
+				#endif
 			}
 			else
 			{
@@ -2112,6 +3547,14 @@ UBaseType_t uxMessagesWaiting;
 	}
 	else
 	{
+		#if( configUSE_QUEUE_ZERO_COPY == 1 )
+		{
+			/* The item goes in front of the peeked slot, or over the slot
+			being filled in, so neither can be outstanding. */
+			configASSERT( ( pxQueue->pcReservedSlot == NULL ) && ( pxQueue->pcPeekedSlot == NULL ) );
+		}
+		#endif
+
 		( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
 		pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 		if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
@@ -2146,6 +3589,30 @@ UBaseType_t uxMessagesWaiting;
 
 	pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
 
+	#if( configUSE_MUTEX_FAST_PATH == 1 )
+	{
+		if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			/* A give only unblocks one task.  While tasks are blocked the
+			contended bit is left set, so a fast take cannot leave the others
+			waiting for a give that never takes the slow path.  The slow take
+			clears it once no task is left blocked. */
+			if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+			{
+				( void ) Atomic_SwapPointers_p32( ( void * volatile * ) &( pxQueue->u.xSemaphore.xMutexHolder ), ( void * ) queueMUTEX_CONTENDED );
+			}
+			else
+			{
+				( void ) Atomic_SwapPointers_p32( ( void * volatile * ) &( pxQueue->u.xSemaphore.xMutexHolder ), NULL );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
@@ -2168,6 +3635,172 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const void *pvItems, const UBaseType_t uxCount )
+{
+size_t xBytes, xBytesToEnd;
+
+	/* This function is called from a critical section, once the caller has
+	checked there is room for uxCount items. */
+	xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+	xBytesToEnd = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ); /*lint !e946 !e9033 Pointer subtraction within the queue storage area. */
+
+	if( xBytes < xBytesToEnd )
+	{
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItems, xBytes ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+		pxQueue->pcWriteTo += xBytes; /*lint !e9016 Pointer arithmetic on char types ok. */
+	}
+	else
+	{
+		/* The items reach the end of the storage area, so the rest of them go
+		at the start. */
+		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItems, xBytesToEnd ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+		( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) ( ( const uint8_t * ) pvItems + xBytesToEnd ), xBytes - xBytesToEnd ); /*lint !e961 !e418 !e9087 !e9016 MISRA exception as the casts are only redundant for some ports. */
+		pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xBytesToEnd ); /*lint !e9016 Pointer arithmetic on char types ok. */
+	}
+
+	pxQueue->uxMessagesWaiting += uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, void * const pvBuffer, const UBaseType_t uxCount )
+{
+int8_t *pcFirstItem;
+size_t xBytes, xBytesToEnd;
+
+	/* This function is called from a critical section, once the caller has
+	checked there are at least uxCount items, and uxCount is at least one.
+	pcReadFrom points to the last item read, so the first item to read now
+	is the one after it. */
+	pcFirstItem = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+	if( pcFirstItem >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+	{
+		pcFirstItem = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+	xBytesToEnd = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcFirstItem ); /*lint !e946 !e9033 Pointer subtraction within the queue storage area. */
+
+	if( xBytes <= xBytesToEnd )
+	{
+		( void ) memcpy( pvBuffer, ( void * ) pcFirstItem, xBytes ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+		pxQueue->u.xQueue.pcReadFrom = pcFirstItem + ( xBytes - pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic on char types ok. */
+	}
+	else
+	{
+		/* The items wrap past the end of the storage area. */
+		( void ) memcpy( pvBuffer, ( void * ) pcFirstItem, xBytesToEnd ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+		( void ) memcpy( ( void * ) ( ( uint8_t * ) pvBuffer + xBytesToEnd ), ( void * ) pxQueue->pcHead, xBytes - xBytesToEnd ); /*lint !e961 !e418 !e9087 !e9016 MISRA exception as the casts are only redundant for some ports. */
+		pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( ( xBytes - xBytesToEnd ) - pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic on char types ok. */
+	}
+
+	pxQueue->uxMessagesWaiting -= uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockTasksWaitingToReceive( Queue_t * const pxQueue, UBaseType_t uxCount )
+{
+BaseType_t xYieldRequired = pdFALSE;
+
+	/* This function is called from a critical section, or with interrupts
+	masked if it is called from an ISR. */
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		if( pxQueue->pxQueueSetContainer != NULL )
+		{
+			/* The queue set holds one entry per item or count. */
+			for( ; uxCount > ( UBaseType_t ) 0; uxCount-- )
+			{
+				if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+				{
+					xYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			for( ; ( uxCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ); uxCount-- )
+			{
+				if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+				{
+					xYieldRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+	#else /* configUSE_QUEUE_SETS */
+	{
+		for( ; ( uxCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ); uxCount-- )
+		{
+			if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+			{
+				xYieldRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockTasksWaitingToSend( Queue_t * const pxQueue, UBaseType_t uxCount )
+{
+BaseType_t xYieldRequired = pdFALSE;
+
+	/* This function is called from a critical section, or with interrupts
+	masked if it is called from an ISR. */
+	for( ; ( uxCount > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ); uxCount-- )
+	{
+		if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+		{
+			xYieldRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
+static int8_t prvAddToQueueLock( const int8_t cLock, const UBaseType_t uxCount )
+{
+int8_t cReturn;
+
+	/* The lock count is only eight bits wide, so stop at the top.  That can
+	only leave a task blocked that could have been unblocked if more than
+	INT8_MAX tasks are blocked on the one queue. */
+	if( uxCount < ( UBaseType_t ) ( INT8_MAX - cLock ) )
+	{
+		cReturn = ( int8_t ) ( cLock + ( int8_t ) uxCount );
+	}
+	else
+	{
+		cReturn = INT8_MAX;
+	}
+
+	return cReturn;
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2294,7 +3927,7 @@ BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == ( UBaseType_t )  0 )
+		if( ( queueITEMS_AVAILABLE( pxQueue ) == ( UBaseType_t ) 0 ) || ( queueMUTEX_IS_TAKEN( pxQueue ) != pdFALSE ) )
 		{
 			xReturn = pdTRUE;
 		}
@@ -2334,7 +3967,7 @@ BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+		if( queueSPACES_AVAILABLE( pxQueue ) == ( UBaseType_t ) 0 )
 		{
 			xReturn = pdTRUE;
 		}
@@ -2700,6 +4333,207 @@ Queue_t * const pxQueue = xQueue;
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+
+	void vQueueGetContentionStats( QueueHandle_t xQueue, QueueContentionStats_t *pxStats )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxStats );
+
+		/* Copy in a critical section so the counters are consistent with
+		each other. */
+		taskENTER_CRITICAL();
+		{
+			*pxStats = pxQueue->xContentionStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_CONTENTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_CONTENTION_STATS == 1 )
+
+	void vQueueResetContentionStats( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+
+		/* A hold that is going on carries on, and is counted when it ends. */
+		taskENTER_CRITICAL();
+		{
+			( void ) memset( &( pxQueue->xContentionStats ), 0x00, sizeof( pxQueue->xContentionStats ) );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_QUEUE_CONTENTION_STATS */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_QUEUE_CONTENTION_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) )
+
+	UBaseType_t uxQueueGetContentionReport( QueueContentionStatus_t * const pxStatusArray, const UBaseType_t uxArraySize )
+	{
+	UBaseType_t ux, uxPosition, uxCount = ( UBaseType_t ) 0U;
+	QueueContentionStatus_t xRow;
+
+		configASSERT( ( pxStatusArray != NULL ) || ( uxArraySize == ( UBaseType_t ) 0U ) );
+
+		/* As with pcQueueGetName(), nothing here protects against another task
+		adding or removing entries from the registry while it is being read. */
+		for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+		{
+			if( xQueueRegistry[ ux ].pcQueueName != NULL )
+			{
+				xRow.pcQueueName = xQueueRegistry[ ux ].pcQueueName;
+				xRow.xHandle = xQueueRegistry[ ux ].xHandle;
+				vQueueGetContentionStats( xRow.xHandle, &( xRow.xStats ) );
+
+				/* Insertion sort, longest total wait first and the most
+				contended takes first among equal waits.  When the array is
+				full the row that falls off the end is dropped. */
+				uxPosition = uxCount;
+				while( ( uxPosition > ( UBaseType_t ) 0U ) &&
+					   ( ( pxStatusArray[ uxPosition - 1U ].xStats.ulTotalWaitTicks < xRow.xStats.ulTotalWaitTicks ) ||
+						 ( ( pxStatusArray[ uxPosition - 1U ].xStats.ulTotalWaitTicks == xRow.xStats.ulTotalWaitTicks ) &&
+						   ( pxStatusArray[ uxPosition - 1U ].xStats.ulContendedTakes < xRow.xStats.ulContendedTakes ) ) ) )
+				{
+					if( uxPosition < uxArraySize )
+					{
+						pxStatusArray[ uxPosition ] = pxStatusArray[ uxPosition - 1U ];
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					uxPosition--;
+				}
+
+				if( uxPosition < uxArraySize )
+				{
+					pxStatusArray[ uxPosition ] = xRow;
+
+					if( uxCount < uxArraySize )
+					{
+						uxCount++;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return uxCount;
+	}
+
+#endif /* ( ( configUSE_QUEUE_CONTENTION_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) ) */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_QUEUE_CONTENTION_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	void vQueueListContention( char *pcWriteBuffer, size_t xBufferLength )
+	{
+	QueueContentionStatus_t *pxStatusArray;
+	const QueueContentionStats_t *pxStats;
+	UBaseType_t uxRows, ux, uxBucket, uxBuckets;
+	size_t xUsed = 0;
+	int iWritten;
+
+		configASSERT( pcWriteBuffer );
+		configASSERT( xBufferLength > ( size_t ) 0 );
+
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = ( char ) 0x00;
+
+		/* Like vTaskList(), take the rows from the heap rather than the stack
+		of the calling task. */
+		pxStatusArray = pvPortMalloc( configQUEUE_REGISTRY_SIZE * sizeof( QueueContentionStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+
+		if( pxStatusArray != NULL )
+		{
+			uxRows = uxQueueGetContentionReport( pxStatusArray, ( UBaseType_t ) configQUEUE_REGISTRY_SIZE );
+
+			iWritten = snprintf( pcWriteBuffer, xBufferLength, "%-16s %8s %8s %4s %8s %8s %6s %8s %6s  %s\n",
+								 "name", "takes", "contend", "%", "timeouts", "wait", "max", "hold", "max", "wait histogram" );
+
+			for( ux = ( UBaseType_t ) 0U; ux < uxRows; ux++ )
+			{
+				/* Stop once the buffer is full, snprintf() having written as
+				much as would fit. */
+				if( ( iWritten < 0 ) || ( ( xUsed + ( size_t ) iWritten ) >= xBufferLength ) )
+				{
+					break;
+				}
+
+				xUsed += ( size_t ) iWritten;
+				pxStats = &( pxStatusArray[ ux ].xStats );
+
+				iWritten = snprintf( &( pcWriteBuffer[ xUsed ] ), xBufferLength - xUsed, "%-16.16s %8lu %8lu %4lu %8lu %8lu %6lu %8lu %6lu ",
+									 pxStatusArray[ ux ].pcQueueName,
+									 ( unsigned long ) pxStats->ulTakes,
+									 ( unsigned long ) pxStats->ulContendedTakes,
+									 ( unsigned long ) ( ( pxStats->ulTakes > 0UL ) ? ( ( ( uint64_t ) pxStats->ulContendedTakes * 100ULL ) / pxStats->ulTakes ) : 0ULL ),
+									 ( unsigned long ) pxStats->ulTimeouts,
+									 ( unsigned long ) pxStats->ulTotalWaitTicks,
+									 ( unsigned long ) pxStats->ulMaxWaitTicks,
+									 ( unsigned long ) pxStats->ulTotalHoldTicks,
+									 ( unsigned long ) pxStats->ulMaxHoldTicks );
+
+				/* Only as many buckets as it takes to show every wait. */
+				uxBuckets = ( UBaseType_t ) 0U;
+				for( uxBucket = ( UBaseType_t ) 0U; uxBucket < ( UBaseType_t ) queueCONTENTION_HISTOGRAM_BUCKETS; uxBucket++ )
+				{
+					if( pxStats->ulWaitHistogram[ uxBucket ] != 0UL )
+					{
+						uxBuckets = uxBucket + ( UBaseType_t ) 1U;
+					}
+				}
+
+				for( uxBucket = ( UBaseType_t ) 0U; uxBucket <= uxBuckets; uxBucket++ )
+				{
+					if( ( iWritten < 0 ) || ( ( xUsed + ( size_t ) iWritten ) >= xBufferLength ) )
+					{
+						break;
+					}
+
+					xUsed += ( size_t ) iWritten;
+
+					if( uxBucket < uxBuckets )
+					{
+						iWritten = snprintf( &( pcWriteBuffer[ xUsed ] ), xBufferLength - xUsed, " %lu", ( unsigned long ) pxStats->ulWaitHistogram[ uxBucket ] );
+					}
+					else
+					{
+						iWritten = snprintf( &( pcWriteBuffer[ xUsed ] ), xBufferLength - xUsed, "\n" );
+					}
+				}
+			}
+
+			vPortFree( pxStatusArray );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* ( ( configUSE_QUEUE_CONTENTION_STATS == 1 ) && ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( configQUEUE_REGISTRY_SIZE > 0 )
 
 	void vQueueUnregisterQueue( QueueHandle_t xQueue )
@@ -0,0 +1,158 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rendezvous.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/*-----------------------------------------------------------*/
+
+void vRendezvousInitialise( Rendezvous_t * const pxRendezvous )
+{
+	configASSERT( pxRendezvous );
+
+	pxRendezvous->xWaitingTask = NULL;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRendezvousArrive( Rendezvous_t * const pxRendezvous, TickType_t xTicksToWait )
+{
+const TaskHandle_t xSelf = xTaskGetCurrentTaskHandle();
+TimeOut_t xTimeOut;
+BaseType_t xReturn = pdFAIL, xWaiting = pdFALSE;
+UBaseType_t uxOtherNotifications = 0;
+
+	configASSERT( pxRendezvous );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	taskENTER_CRITICAL();
+	{
+		if( pxRendezvous->xWaitingTask != NULL )
+		{
+			/* The other task got here first - release it.  It is taken off
+			the rendezvous before being notified so it can tell this
+			notification apart from any other. */
+			( void ) xTaskNotifyGive( pxRendezvous->xWaitingTask );
+			pxRendezvous->xWaitingTask = NULL;
+			xReturn = pdPASS;
+		}
+		else if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			pxRendezvous->xWaitingTask = xSelf;
+			xWaiting = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xWaiting != pdFALSE )
+	{
+		/* Wait for the other task.  It clears xWaitingTask then gives exactly
+		one notification, so counts are taken one at a time, and a count taken
+		while this task is still the one waiting belongs to the application and
+		is given back below. */
+		vTaskSetTimeOutState( &xTimeOut );
+
+		while( xReturn == pdFAIL )
+		{
+			if( ulTaskNotifyTake( pdFALSE, xTicksToWait ) != 0UL )
+			{
+				if( pxRendezvous->xWaitingTask != xSelf )
+				{
+					xReturn = pdPASS;
+				}
+				else
+				{
+					uxOtherNotifications++;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( ( xReturn == pdFAIL ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE ) )
+			{
+				break;
+			}
+		}
+
+		if( xReturn == pdFAIL )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( pxRendezvous->xWaitingTask == xSelf )
+				{
+					/* Timed out - stop waiting. */
+					pxRendezvous->xWaitingTask = NULL;
+				}
+				else
+				{
+					/* The other task arrived after the timeout but before
+					getting here, so its notification is still pending. */
+					( void ) ulTaskNotifyTake( pdFALSE, 0 );
+					xReturn = pdPASS;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		while( uxOtherNotifications > ( UBaseType_t ) 0 )
+		{
+			( void ) xTaskNotifyGive( xSelf );
+			uxOtherNotifications--;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
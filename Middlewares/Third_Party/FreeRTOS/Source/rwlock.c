@@ -0,0 +1,472 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rwlock.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Stored in the event list item value of a task the lock is handed to, so the
+task can tell whether it was given the lock or timed out.  It is important it
+does not clash with the taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
+#if configUSE_16_BIT_TICKS == 1
+	#define rwlockUNBLOCKED_WITH_LOCK	0x0200U
+#else
+	#define rwlockUNBLOCKED_WITH_LOCK	0x02000000UL
+#endif
+
+typedef struct RWLockDef_t
+{
+	BaseType_t xPolicy;					/*< rwlockPREFER_READERS, rwlockPREFER_WRITERS or rwlockFAIR. */
+	UBaseType_t uxReaders;				/*< The number of tasks holding the lock for reading. */
+	TaskHandle_t xWriter;				/*< The task holding the lock for writing, or NULL. */
+	List_t xTasksWaitingToRead;			/*< Readers waiting for the lock, in priority order. */
+	List_t xTasksWaitingToWrite;		/*< Writers waiting for the lock, in priority order. */
+} RWLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Take the lock for reading or writing - xRWLockTakeRead() and
+ * xRWLockTakeWrite() only differ in which.
+ */
+static BaseType_t prvTake( RWLock_t *pxRWLock, const BaseType_t xWrite, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Hand the lock to the tasks waiting for it, if the policy lets them have it
+ * now: either every waiting reader, or the highest priority waiting writer.
+ * xWriterGaveLock is pdTRUE if a writer has just given the lock, which the
+ * fair policy passes to the readers.  Must be called with the scheduler
+ * suspended.
+ */
+static void prvHandOverLock( RWLock_t *pxRWLock, const BaseType_t xWriterGaveLock ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_MUTEXES == 1 )
+
+	/*
+	 * The priority of the highest priority task waiting for the lock, which a
+	 * writer holding the lock keeps after a waiting task times out.
+	 */
+	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const RWLock_t *pxRWLock ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	RWLockHandle_t xRWLockCreate( const BaseType_t xPolicy )
+	{
+	RWLock_t *pxRWLock;
+
+		configASSERT( ( xPolicy == rwlockPREFER_READERS ) || ( xPolicy == rwlockPREFER_WRITERS ) || ( xPolicy == rwlockFAIR ) );
+
+		pxRWLock = ( RWLock_t * ) pvPortMalloc( sizeof( RWLock_t ) ); /*lint !e9087 !e9079 pvPortMalloc() meets the alignment requirements of the structure. */
+
+		if( pxRWLock != NULL )
+		{
+			pxRWLock->xPolicy = xPolicy;
+			pxRWLock->uxReaders = 0;
+			pxRWLock->xWriter = NULL;
+			vListInitialise( &( pxRWLock->xTasksWaitingToRead ) );
+			vListInitialise( &( pxRWLock->xTasksWaitingToWrite ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxRWLock;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait )
+{
+	return prvTake( xRWLock, pdFALSE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait )
+{
+	return prvTake( xRWLock, pdTRUE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTake( RWLock_t *pxRWLock, const BaseType_t xWrite, TickType_t xTicksToWait )
+{
+BaseType_t xReturn, xAlreadyYielded, xLockFree;
+
+	configASSERT( pxRWLock );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	vTaskSuspendAll();
+	{
+		if( xWrite != pdFALSE )
+		{
+			xLockFree = ( ( pxRWLock->xWriter == NULL ) && ( pxRWLock->uxReaders == ( UBaseType_t ) 0 ) ) ? pdTRUE : pdFALSE;
+		}
+		else
+		{
+			/* Unless readers are preferred, a reader queues behind the writers
+			that are already waiting. */
+			xLockFree = ( ( pxRWLock->xWriter == NULL ) &&
+						  ( ( pxRWLock->xPolicy == rwlockPREFER_READERS ) || ( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) ) != pdFALSE ) ) ) ? pdTRUE : pdFALSE;
+		}
+
+		if( xLockFree != pdFALSE )
+		{
+			if( xWrite != pdFALSE )
+			{
+				#if( configUSE_MUTEXES == 1 )
+				{
+					/* Record the writer as holding a mutex so it returns to
+					its own priority when it gives the lock. */
+					pxRWLock->xWriter = pvTaskIncrementMutexHeldCount();
+				}
+				#else
+				{
+					pxRWLock->xWriter = xTaskGetCurrentTaskHandle();
+				}
+				#endif
+			}
+			else
+			{
+				( pxRWLock->uxReaders )++;
+			}
+
+			xReturn = pdPASS;
+			xTicksToWait = 0;
+		}
+		else if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			#if( configUSE_MUTEXES == 1 )
+			{
+				if( pxRWLock->xWriter != NULL )
+				{
+					taskENTER_CRITICAL();
+					{
+						( void ) xTaskPriorityInherit( pxRWLock->xWriter );
+					}
+					taskEXIT_CRITICAL();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_MUTEXES */
+
+			/* No interrupt uses the lock, so suspending the scheduler is
+			enough to protect its lists. */
+			vTaskPlaceOnEventList( ( xWrite != pdFALSE ) ? &( pxRWLock->xTasksWaitingToWrite ) : &( pxRWLock->xTasksWaitingToRead ), xTicksToWait );
+
+			/* Set after the task unblocks. */
+			xReturn = pdFAIL;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	xAlreadyYielded = xTaskResumeAll();
+
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Either the lock was handed to the task, in which case the flag is
+		set in the task's event list item, or the block time expired. */
+		if( ( uxTaskResetEventItemValue() & rwlockUNBLOCKED_WITH_LOCK ) != ( TickType_t ) 0 )
+		{
+			xReturn = pdPASS;
+		}
+		else
+		{
+			vTaskSuspendAll();
+			{
+				/* Readers queued behind a writer that timed out might be able
+				to go now. */
+				prvHandOverLock( pxRWLock, pdFALSE );
+
+				#if( configUSE_MUTEXES == 1 )
+				{
+					/* The writer holding the lock might have taken this task's
+					priority, which it no longer needs. */
+					if( pxRWLock->xWriter != NULL )
+					{
+						taskENTER_CRITICAL();
+						{
+							vTaskPriorityDisinheritAfterTimeout( pxRWLock->xWriter, prvGetDisinheritPriorityAfterTimeout( pxRWLock ) );
+						}
+						taskEXIT_CRITICAL();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_MUTEXES */
+			}
+			( void ) xTaskResumeAll();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock )
+{
+RWLock_t *pxRWLock = xRWLock;
+BaseType_t xReturn;
+
+	configASSERT( pxRWLock );
+
+	vTaskSuspendAll();
+	{
+		if( pxRWLock->uxReaders > ( UBaseType_t ) 0 )
+		{
+			( pxRWLock->uxReaders )--;
+
+			if( pxRWLock->uxReaders == ( UBaseType_t ) 0 )
+			{
+				prvHandOverLock( pxRWLock, pdFALSE );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock )
+{
+RWLock_t *pxRWLock = xRWLock;
+BaseType_t xReturn, xYieldRequired = pdFALSE;
+
+	configASSERT( pxRWLock );
+
+	vTaskSuspendAll();
+	{
+		if( ( pxRWLock->xWriter != NULL ) && ( pxRWLock->xWriter == xTaskGetCurrentTaskHandle() ) )
+		{
+			#if( configUSE_MUTEXES == 1 )
+			{
+				/* Drop back to the priority the writer had before a waiting
+				task raised it. */
+				taskENTER_CRITICAL();
+				{
+					xYieldRequired = xTaskPriorityDisinherit( pxRWLock->xWriter );
+				}
+				taskEXIT_CRITICAL();
+			}
+			#endif /* configUSE_MUTEXES */
+
+			pxRWLock->xWriter = NULL;
+			prvHandOverLock( pxRWLock, pdTRUE );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	if( ( xTaskResumeAll() == pdFALSE ) && ( xYieldRequired != pdFALSE ) )
+	{
+		portYIELD_WITHIN_API();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRWLockGetReaders( RWLockHandle_t xRWLock )
+{
+const RWLock_t *pxRWLock = xRWLock;
+
+	configASSERT( pxRWLock );
+	return pxRWLock->uxReaders;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xRWLockGetWriter( RWLockHandle_t xRWLock )
+{
+const RWLock_t *pxRWLock = xRWLock;
+
+	configASSERT( pxRWLock );
+	return pxRWLock->xWriter;
+}
+/*-----------------------------------------------------------*/
+
+void vRWLockDelete( RWLockHandle_t xRWLock )
+{
+RWLock_t *pxRWLock = xRWLock;
+
+	configASSERT( pxRWLock );
+
+	/* A waiting task would be left blocked on freed memory. */
+	configASSERT( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToRead ) ) != pdFALSE );
+	configASSERT( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToWrite ) ) != pdFALSE );
+	configASSERT( ( pxRWLock->xWriter == NULL ) && ( pxRWLock->uxReaders == ( UBaseType_t ) 0 ) );
+
+	vPortFree( pxRWLock );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHandOverLock( RWLock_t *pxRWLock, const BaseType_t xWriterGaveLock )
+{
+List_t * const pxReaders = &( pxRWLock->xTasksWaitingToRead );
+List_t * const pxWriters = &( pxRWLock->xTasksWaitingToWrite );
+ListItem_t *pxWriterItem;
+BaseType_t xReadersFirst;
+
+	if( pxRWLock->xWriter == NULL )
+	{
+		/* Waiting readers only ever wait for a writer, so they go first unless
+		the policy puts the waiting writers before them. */
+		xReadersFirst = ( ( pxRWLock->xPolicy == rwlockPREFER_READERS ) ||
+						  ( ( pxRWLock->xPolicy == rwlockFAIR ) && ( xWriterGaveLock != pdFALSE ) ) ||
+						  ( listLIST_IS_EMPTY( pxWriters ) != pdFALSE ) ) ? pdTRUE : pdFALSE;
+
+		if( ( xReadersFirst != pdFALSE ) && ( listLIST_IS_EMPTY( pxReaders ) == pdFALSE ) )
+		{
+			/* The tasks are only moved to the ready lists here - none of them
+			can run until the scheduler is resumed. */
+			while( listLIST_IS_EMPTY( pxReaders ) == pdFALSE )
+			{
+				( pxRWLock->uxReaders )++;
+				vTaskRemoveFromUnorderedEventList( listGET_HEAD_ENTRY( pxReaders ), rwlockUNBLOCKED_WITH_LOCK );
+			}
+		}
+		else if( ( pxRWLock->uxReaders == ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( pxWriters ) == pdFALSE ) )
+		{
+			/* Record the writer straight away, so tasks that wait for it
+			before it runs raise its priority. */
+			pxWriterItem = listGET_HEAD_ENTRY( pxWriters );
+			pxRWLock->xWriter = ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxWriterItem ); /*lint !e9079 The owner of a task's event list item is the task. */
+
+			#if( configUSE_MUTEXES == 1 )
+			{
+				vTaskIncrementMutexHeldCountOf( pxRWLock->xWriter );
+			}
+			#endif
+			vTaskRemoveFromUnorderedEventList( pxWriterItem, rwlockUNBLOCKED_WITH_LOCK );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MUTEXES == 1 )
+
+	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const RWLock_t *pxRWLock )
+	{
+	UBaseType_t uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY, uxPriority;
+
+		/* Both lists are in priority order, so the highest priority task
+		waiting on each is at its head. */
+		if( listCURRENT_LIST_LENGTH( &( pxRWLock->xTasksWaitingToRead ) ) > 0U )
+		{
+			uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToRead ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( listCURRENT_LIST_LENGTH( &( pxRWLock->xTasksWaitingToWrite ) ) > 0U )
+		{
+			uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToWrite ) );
+
+			if( uxPriority > uxHighestPriorityOfWaitingTasks )
+			{
+				uxHighestPriorityOfWaitingTasks = uxPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxHighestPriorityOfWaitingTasks;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
@@ -38,6 +38,7 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "stream_buffer.h"
+#include "atomic.h"
 
 #if( configUSE_TASK_NOTIFICATIONS != 1 )
 	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
@@ -134,6 +135,41 @@ that uses task notifications. */
 /* Bits stored in the ucFlags field of the stream buffer. */
 #define sbFLAGS_IS_MESSAGE_BUFFER		( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
 #define sbFLAGS_IS_STATICALLY_ALLOCATED ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
+#define sbFLAGS_IS_MIRRORED				( ( uint8_t ) 4 ) /* Set if the storage area is mapped twice, back to back, so data that wraps is also contiguous. */
+#define sbFLAGS_IS_MULTI_PRODUCER		( ( uint8_t ) 8 ) /* Set if any number of writers can write to the buffer at once. */
+
+/* With configUSE_STREAM_BUFFER_REGIONS set to 1 a message is never split at
+the end of the storage area.  A message that would be is written at the start
+instead, and a message length of zero, which no real message has, fills the
+gap up to the end. */
+#define sbMESSAGE_PADDING				( ( configMESSAGE_BUFFER_LENGTH_TYPE ) 0 )
+
+#if( configUSE_MIRRORED_STREAM_BUFFERS == 1 )
+	#define sbIS_MIRRORED( pxStreamBuffer )	( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_IS_MIRRORED ) != ( uint8_t ) 0 )
+#else
+	#define sbIS_MIRRORED( pxStreamBuffer )	( pdFALSE )
+#endif
+
+#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	#define sbIS_MULTI_PRODUCER( pxStreamBuffer )	( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+
+	/* The writers to a multi-producer buffer share one word holding both the
+	reserve head, which is the index up to which space has been reserved, and
+	the number of writers that have reserved space but not yet committed it, so
+	the two always change together. */
+	#define sbRESERVE_HEAD_MASK			( ( uint32_t ) 0x00ffffffUL )
+	#define sbRESERVE_WRITERS_SHIFT		( 24U )
+	#define sbRESERVE_ONE_WRITER		( ( uint32_t ) 1UL << sbRESERVE_WRITERS_SHIFT )
+	#define sbRESERVE_MAX_WRITERS		( ( uint32_t ) 0xffUL )
+	#define sbRESERVE_WRITERS( ulReserve )	( ( ulReserve ) >> sbRESERVE_WRITERS_SHIFT )
+#else
+	#define sbIS_MULTI_PRODUCER( pxStreamBuffer )	( pdFALSE )
+#endif
+
+/* The number of bytes from index xIndex that are contiguous in memory - up to
+the end of the storage area, or a whole buffer's worth if the storage area is
+mirrored. */
+#define sbCONTIGUOUS_BYTES( pxStreamBuffer, xIndex )	( sbIS_MIRRORED( pxStreamBuffer ) ? ( pxStreamBuffer )->xLength : ( ( pxStreamBuffer )->xLength - ( xIndex ) ) )
 
 /*-----------------------------------------------------------*/
 
@@ -144,6 +180,17 @@ typedef struct StreamBufferDef_t /*lint !e9058 Style convention uses tag. */
 	volatile size_t xHead;				/* Index to the next item to write within the buffer. */
 	size_t xLength;						/* The length of the buffer pointed to by pucBuffer. */
 	size_t xTriggerLevelBytes;			/* The number of bytes that must be in the stream buffer before a task that is waiting for data is unblocked. */
+
+	#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+		size_t xWriteRegionBytes;		/* The size of the region last handed to the writer and not yet committed.  For a message buffer, the length of the message. */
+		size_t xReadRegionBytes;		/* The size of the region last handed to the reader and not yet consumed.  For a message buffer, the length of the message. */
+	#endif
+
+	#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		volatile uint32_t ulReserve;	/* The reserve head and the number of writers part way through a write - see sbRESERVE_HEAD_MASK.  xHead is then the index up to which writes are committed. */
+		List_t xTasksWaitingToSend;		/* The writers blocked waiting for space.  xTaskWaitingToSend is not used. */
+	#endif
+
 	volatile TaskHandle_t xTaskWaitingToReceive; /* Holds the handle of a task waiting for data, or NULL if no tasks are waiting. */
 	volatile TaskHandle_t xTaskWaitingToSend;	/* Holds the handle of a task waiting to send data to a message buffer that is full. */
 	uint8_t *pucBuffer;					/* Points to the buffer itself - that is - the RAM that stores the data passed through the buffer. */
@@ -160,12 +207,12 @@ typedef struct StreamBufferDef_t /*lint !e9058 Style convention uses tag. */
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
 
 /*
- * Add xCount bytes from pucData into the pxStreamBuffer message buffer.
- * Returns the number of bytes written, which will either equal xCount in the
- * success case, or 0 if there was not enough space in the buffer (in which case
- * no data is written into the buffer).
+ * Copy xCount bytes from pucData into the buffer's storage area starting at
+ * index xHead, and return the index that follows them.  The caller moves
+ * the head of the buffer once everything it is writing is in place, so the
+ * reader never sees part of a message.
  */
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount, size_t xHead ) PRIVILEGED_FUNCTION;
 
 /*
  * If the stream buffer is being used as a message buffer, then reads an entire
@@ -202,6 +249,97 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer,
 									  size_t xMaxCount,
 									  size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+
+	/*
+	 * The number of bytes of padding needed in front of a message of
+	 * xDataLengthBytes written at the current head, so the message is not split
+	 * at the end of the storage area.
+	 */
+	static size_t prvMessagePadding( const StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The space needed to write xDataLengthBytes at the current head - for a
+	 * message buffer including the message length and any padding.
+	 */
+	static size_t prvSpaceRequired( const StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the reader of a message buffer, with xBytesAvailable bytes in
+	 * the buffer, before it looks at the next message.  Moves the tail past any
+	 * padding in front of the message and returns the bytes left.
+	 */
+	static size_t prvSkipMessagePadding( StreamBuffer_t * const pxStreamBuffer, size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the writer with the reader locked out.  Moves the head and tail
+	 * of an empty buffer back to the start of the storage area, so a message
+	 * that fits the buffer never needs more room than the buffer has for
+	 * padding, and a region acquired for writing is as large as it can be.
+	 */
+	static void prvRewindIfEmpty( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Work out the region the writer can fill in, or the reader can use, in
+	 * place, and return its size, or 0 if there is none.  The writer calls
+	 * prvAcquireWriteRegion() with the reader locked out.  The reader passes
+	 * prvAcquireReadRegion() the number of bytes in the buffer.
+	 */
+	static size_t prvAcquireWriteRegion( StreamBuffer_t * const pxStreamBuffer, void **ppvRegion, size_t xBytesWanted ) PRIVILEGED_FUNCTION;
+	static size_t prvAcquireReadRegion( StreamBuffer_t * const pxStreamBuffer, void **ppvRegion, size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Add the first xBytesWritten bytes of the acquired write region to the
+	 * buffer, or remove the acquired read region from it.
+	 */
+	static void prvCommitWriteRegion( StreamBuffer_t * const pxStreamBuffer, size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+	static void prvConsumeReadRegion( StreamBuffer_t * const pxStreamBuffer, size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_REGIONS */
+
+#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+
+	/*
+	 * Take sbCREATE_MULTI_PRODUCER out of the xIsMessageBuffer parameter of a
+	 * create function, and return the flags it stands for.
+	 */
+	static uint8_t prvMultiProducerFlags( BaseType_t * const pxIsMessageBuffer, size_t xBufferSizeBytes ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Reserve space for xDataLengthBytes, and for a message buffer the message
+	 * length, by moving the reserve head of a multi-producer buffer.  Returns
+	 * the number of data bytes reserved, or 0 if there was no room, and sets
+	 * *pxStart to the index the reserved space starts at.
+	 */
+	static size_t prvReserveSpace( StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes, size_t * const pxStart ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Copy a write, and for a message buffer the message length, into the
+	 * space reserved for it.
+	 */
+	static void prvWriteReserved( StreamBuffer_t * const pxStreamBuffer, const void * pvTxData, size_t xDataLengthBytes, size_t xStart ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called with the reader and the other writers locked out once a write is
+	 * in place.  Returns pdTRUE if the commit made enough data visible to the
+	 * reader for it to be woken.
+	 */
+	static BaseType_t prvCommitReserved( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * xStreamBufferSend() for a multi-producer buffer.
+	 */
+	static size_t prvSendMultiProducer( StreamBuffer_t * const pxStreamBuffer, const void * pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the reader after freeing space in a multi-producer buffer to
+	 * unblock every writer waiting for space, each of which then tries again.
+	 */
+	static void prvUnblockWriters( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+	static void prvUnblockWritersFromISR( StreamBuffer_t * const pxStreamBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -220,6 +358,9 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	{
 	uint8_t *pucAllocatedMemory;
 	uint8_t ucFlags;
+	#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		uint8_t ucMultiProducerFlags = prvMultiProducerFlags( &xIsMessageBuffer, xBufferSizeBytes );
+	#endif
 
 		/* In case the stream buffer is going to be used as a message buffer
 		(that is, it will hold discrete messages with a little meta data that
@@ -239,6 +380,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 		}
 		configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
 
+		#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		{
+			ucFlags |= ucMultiProducerFlags;
+		}
+		#endif
+
 		/* A trigger level of 0 would cause a waiting task to unblock even when
 		the buffer was empty. */
 		if( xTriggerLevelBytes == ( size_t ) 0 )
@@ -278,6 +425,72 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_MIRRORED_STREAM_BUFFERS == 1 )
+
+	StreamBufferHandle_t xStreamBufferGenericCreateMirrored( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer )
+	{
+	StreamBuffer_t *pxStreamBuffer;
+	uint8_t *pucStorage;
+	uint8_t ucFlags = sbFLAGS_IS_MIRRORED;
+
+		#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		{
+			ucFlags |= prvMultiProducerFlags( &xIsMessageBuffer, xBufferSizeBytes );
+		}
+		#endif
+
+		if( xIsMessageBuffer == pdTRUE )
+		{
+			ucFlags |= sbFLAGS_IS_MESSAGE_BUFFER;
+			configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		}
+		else
+		{
+			configASSERT( xBufferSizeBytes > 0 );
+		}
+		configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
+
+		/* A trigger level of 0 would cause a waiting task to unblock even when
+		the buffer was empty. */
+		if( xTriggerLevelBytes == ( size_t ) 0 )
+		{
+			xTriggerLevelBytes = ( size_t ) 1;
+		}
+
+		/* The storage area is mapped twice, back to back, by the port, which
+		rounds its size up to whatever it can map - so the buffer can end up
+		larger than asked for, never smaller.  The size is incremented for the
+		same reason as in xStreamBufferGenericCreate(). */
+		xBufferSizeBytes++;
+		pxStreamBuffer = ( StreamBuffer_t * ) pvPortMalloc( sizeof( StreamBuffer_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pxStreamBuffer != NULL )
+		{
+			pucStorage = ( uint8_t * ) pvPortMallocMirrored( &xBufferSizeBytes );
+
+			if( pucStorage != NULL )
+			{
+				prvInitialiseNewStreamBuffer( pxStreamBuffer, pucStorage, xBufferSizeBytes, xTriggerLevelBytes, ucFlags );
+				traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer );
+			}
+			else
+			{
+				vPortFree( ( void * ) pxStreamBuffer );
+				pxStreamBuffer = NULL;
+				traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
+			}
+		}
+		else
+		{
+			traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
+		}
+
+		return ( StreamBufferHandle_t ) pxStreamBuffer;
+	}
+
+#endif /* configUSE_MIRRORED_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 	StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
@@ -289,6 +502,9 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) pxStaticStreamBuffer; /*lint !e740 !e9087 Safe cast as StaticStreamBuffer_t is opaque Streambuffer_t. */
 	StreamBufferHandle_t xReturn;
 	uint8_t ucFlags;
+	#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		uint8_t ucMultiProducerFlags = prvMultiProducerFlags( &xIsMessageBuffer, xBufferSizeBytes );
+	#endif
 
 		configASSERT( pucStreamBufferStorageArea );
 		configASSERT( pxStaticStreamBuffer );
@@ -312,6 +528,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 			ucFlags = sbFLAGS_IS_STATICALLY_ALLOCATED;
 		}
 
+		#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		{
+			ucFlags |= ucMultiProducerFlags;
+		}
+		#endif
+
 		/* In case the stream buffer is going to be used as a message buffer
 		(that is, it will hold discrete messages with a little meta data that
 		says how big the next message is) check the buffer will be large enough
@@ -366,6 +588,15 @@ StreamBuffer_t * pxStreamBuffer = xStreamBuffer;
 
 	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
 	{
+		#if( configUSE_MIRRORED_STREAM_BUFFERS == 1 )
+		if( sbIS_MIRRORED( pxStreamBuffer ) != pdFALSE )
+		{
+			/* The storage area was mapped separately. */
+			vPortFreeMirrored( ( void * ) pxStreamBuffer->pucBuffer, pxStreamBuffer->xLength );
+			vPortFree( ( void * ) pxStreamBuffer );
+		}
+		else
+		#endif /* configUSE_MIRRORED_STREAM_BUFFERS */
 		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 		{
 			/* Both the structure and the buffer were allocated using a single call
@@ -413,6 +644,17 @@ BaseType_t xReturn = pdFAIL;
 	{
 		if( pxStreamBuffer->xTaskWaitingToReceive == NULL )
 		{
+			#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+			/* Nor if a writer to a multi-producer buffer is blocked, or part
+			way through a write. */
+			if( ( sbIS_MULTI_PRODUCER( pxStreamBuffer ) != pdFALSE ) &&
+				( ( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToSend ) ) == pdFALSE ) ||
+				  ( sbRESERVE_WRITERS( pxStreamBuffer->ulReserve ) != ( uint32_t ) 0 ) ) )
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+			else
+			#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
 			if( pxStreamBuffer->xTaskWaitingToSend == NULL )
 			{
 				prvInitialiseNewStreamBuffer( pxStreamBuffer,
@@ -475,7 +717,20 @@ size_t xSpace;
 	configASSERT( pxStreamBuffer );
 
 	xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
-	xSpace -= pxStreamBuffer->xHead;
+
+	#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	if( sbIS_MULTI_PRODUCER( pxStreamBuffer ) != pdFALSE )
+	{
+		/* Space that is reserved is not free, whether or not it has been
+		committed. */
+		xSpace -= ( size_t ) ( pxStreamBuffer->ulReserve & sbRESERVE_HEAD_MASK );
+	}
+	else
+	#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+	{
+		xSpace -= pxStreamBuffer->xHead;
+	}
+
 	xSpace -= ( size_t ) 1;
 
 	if( xSpace >= pxStreamBuffer->xLength )
@@ -516,6 +771,17 @@ TimeOut_t xTimeOut;
 	configASSERT( pvTxData );
 	configASSERT( pxStreamBuffer );
 
+	#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	{
+		/* The writers to a multi-producer buffer reserve space rather than
+		owning the head. */
+		if( sbIS_MULTI_PRODUCER( pxStreamBuffer ) != pdFALSE )
+		{
+			return prvSendMultiProducer( pxStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
+		}
+	}
+	#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+
 	/* This send function is used to write to both message buffers and stream
 	buffers.  If this is a message buffer then the space needed must be
 	increased by the amount of bytes needed to store the length of the
@@ -542,6 +808,22 @@ TimeOut_t xTimeOut;
 			buffer. */
 			taskENTER_CRITICAL();
 			{
+				#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+				{
+					/* A message that would be split at the end of the storage
+					area needs padding in front of it too. */
+					if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+					{
+						prvRewindIfEmpty( pxStreamBuffer );
+						xRequiredSpace = prvSpaceRequired( pxStreamBuffer, xDataLengthBytes );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_STREAM_BUFFER_REGIONS */
+
 				xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
 
 				if( xSpace < xRequiredSpace )
@@ -572,6 +854,32 @@ TimeOut_t xTimeOut;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
+	#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+	{
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			if( pxStreamBuffer->xHead == pxStreamBuffer->xTail )
+			{
+				taskENTER_CRITICAL();
+				{
+					prvRewindIfEmpty( pxStreamBuffer );
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xRequiredSpace = prvSpaceRequired( pxStreamBuffer, xDataLengthBytes );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_STREAM_BUFFER_REGIONS */
+
 	if( xSpace == ( size_t ) 0 )
 	{
 		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
@@ -619,6 +927,48 @@ size_t xRequiredSpace = xDataLengthBytes;
 	configASSERT( pvTxData );
 	configASSERT( pxStreamBuffer );
 
+	#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	{
+		if( sbIS_MULTI_PRODUCER( pxStreamBuffer ) != pdFALSE )
+		{
+		size_t xStart = 0;
+		BaseType_t xWakeReader;
+		UBaseType_t uxSavedInterruptStatus;
+
+			/* An interrupt cannot wait for space, so reserve what it can now. */
+			xReturn = prvReserveSpace( pxStreamBuffer, xDataLengthBytes, &xStart );
+
+			if( xReturn > ( size_t ) 0 )
+			{
+				prvWriteReserved( pxStreamBuffer, pvTxData, xReturn, xStart );
+
+				uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+				{
+					xWakeReader = prvCommitReserved( pxStreamBuffer );
+				}
+				portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+				if( xWakeReader != pdFALSE )
+				{
+					sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+			return xReturn;
+		}
+	}
+	#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+
 	/* This send function is used to write to both message buffers and stream
 	buffers.  If this is a message buffer then the space needed must be
 	increased by the amount of bytes needed to store the length of the
@@ -632,6 +982,27 @@ size_t xRequiredSpace = xDataLengthBytes;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
+	#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+	{
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+		UBaseType_t uxSavedInterruptStatus;
+
+			uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				prvRewindIfEmpty( pxStreamBuffer );
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+			xRequiredSpace = prvSpaceRequired( pxStreamBuffer, xDataLengthBytes );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_STREAM_BUFFER_REGIONS */
+
 	xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
 	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
@@ -666,6 +1037,7 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 {
 	BaseType_t xShouldWrite;
 	size_t xReturn;
+	size_t xHead = pxStreamBuffer->xHead;
 
 	if( xSpace == ( size_t ) 0 )
 	{
@@ -688,7 +1060,26 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 		into the buffer.  Start by writing the length of the data, the data
 		itself will be written later in this function. */
 		xShouldWrite = pdTRUE;
-		( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH );
+
+		#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+		{
+			/* xRequiredSpace includes any padding, which goes first so the
+			message starts at the beginning of the storage area. */
+			if( prvMessagePadding( pxStreamBuffer, xDataLengthBytes ) != ( size_t ) 0 )
+			{
+				const configMESSAGE_BUFFER_LENGTH_TYPE xPadding = sbMESSAGE_PADDING;
+
+				( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &xPadding, sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead );
+				xHead = 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_STREAM_BUFFER_REGIONS */
+
+		xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead );
 	}
 	else
 	{
@@ -698,8 +1089,10 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 	if( xShouldWrite != pdFALSE )
 	{
-		/* Writes the data itself. */
-		xReturn = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+		/* Writes the data itself, then moves the head past everything written
+		in one go. */
+		pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+		xReturn = xDataLengthBytes;
 	}
 	else
 	{
@@ -798,6 +1191,12 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		{
 			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
 			sbRECEIVE_COMPLETED( pxStreamBuffer );
+
+			#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+			{
+				prvUnblockWriters( pxStreamBuffer );
+			}
+			#endif
 		}
 		else
 		{
@@ -828,6 +1227,12 @@ configMESSAGE_BUFFER_LENGTH_TYPE xTempReturn;
 		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 		if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
 		{
+			#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+			{
+				xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+			}
+			#endif
+
 			/* The number of bytes available is greater than the number of bytes
 			required to hold the length of the next message, so another message
 			is available.  Return its length without removing the length bytes
@@ -898,6 +1303,12 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		if( xReceivedLength != ( size_t ) 0 )
 		{
 			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+
+			#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+			{
+				prvUnblockWritersFromISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			#endif
 		}
 		else
 		{
@@ -926,6 +1337,12 @@ configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
 
 	if( xBytesToStoreMessageLength != ( size_t ) 0 )
 	{
+		#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+		{
+			xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+		}
+		#endif
+
 		/* A discrete message is being received.  First receive the length
 		of the message.  A copy of the tail is stored so the buffer can be
 		returned to its prior state if the length of the message is too
@@ -1085,125 +1502,1053 @@ UBaseType_t uxSavedInterruptStatus;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
-{
-size_t xNextHead, xFirstLength;
+#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
 
-	configASSERT( xCount > ( size_t ) 0 );
+	size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+									  void **ppvRegion,
+									  size_t xBytesWanted,
+									  TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+	TimeOut_t xTimeOut;
 
-	xNextHead = pxStreamBuffer->xHead;
+		configASSERT( ppvRegion );
+		configASSERT( pxStreamBuffer );
 
-	/* Calculate the number of bytes that can be added in the first write -
-	which may be less than the total number of bytes that need to be added if
-	the buffer will wrap back to the beginning. */
-	xFirstLength = configMIN( pxStreamBuffer->xLength - xNextHead, xCount );
+		/* A region belongs to the one writer, which a multi-producer buffer
+		does not have. */
+		configASSERT( sbIS_MULTI_PRODUCER( pxStreamBuffer ) == pdFALSE );
 
-	/* Write as many bytes as can be written in the first write. */
-	configASSERT( ( xNextHead + xFirstLength ) <= pxStreamBuffer->xLength );
-	( void ) memcpy( ( void* ) ( &( pxStreamBuffer->pucBuffer[ xNextHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			vTaskSetTimeOutState( &xTimeOut );
 
-	/* If the number of bytes written was less than the number that could be
-	written in the first write... */
-	if( xCount > xFirstLength )
-	{
-		/* ...then write the remaining bytes to the start of the buffer. */
-		configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
-		( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+			do
+			{
+				/* Wait for room for what is wanted, as xStreamBufferSend()
+				does, including any padding in front of a message. */
+				taskENTER_CRITICAL();
+				{
+					prvRewindIfEmpty( pxStreamBuffer );
+
+					if( xStreamBufferSpacesAvailable( pxStreamBuffer ) < prvSpaceRequired( pxStreamBuffer, xBytesWanted ) )
+					{
+						/* Clear notification state as going to wait for space. */
+						( void ) xTaskNotifyStateClear( NULL );
+
+						/* Should only be one writer. */
+						configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+						pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+					}
+					else
+					{
+						taskEXIT_CRITICAL();
+						break;
+					}
+				}
+				taskEXIT_CRITICAL();
 
-	xNextHead += xCount;
-	if( xNextHead >= pxStreamBuffer->xLength )
-	{
-		xNextHead -= pxStreamBuffer->xLength;
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
+				traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+			} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		taskENTER_CRITICAL();
+		{
+			xReturn = prvAcquireWriteRegion( pxStreamBuffer, ppvRegion, xBytesWanted );
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
 	}
+	/*-----------------------------------------------------------*/
 
-	pxStreamBuffer->xHead = xNextHead;
+	size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+											 void **ppvRegion,
+											 size_t xBytesWanted )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn;
+	UBaseType_t uxSavedInterruptStatus;
 
-	return xCount;
-}
-/*-----------------------------------------------------------*/
+		configASSERT( ppvRegion );
+		configASSERT( pxStreamBuffer );
+		configASSERT( sbIS_MULTI_PRODUCER( pxStreamBuffer ) == pdFALSE );
 
-static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer, uint8_t *pucData, size_t xMaxCount, size_t xBytesAvailable )
-{
-size_t xCount, xFirstLength, xNextTail;
+		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xReturn = prvAcquireWriteRegion( pxStreamBuffer, ppvRegion, xBytesWanted );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-	/* Use the minimum of the wanted bytes and the available bytes. */
-	xCount = configMIN( xBytesAvailable, xMaxCount );
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
 
-	if( xCount > ( size_t ) 0 )
+	void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten )
 	{
-		xNextTail = pxStreamBuffer->xTail;
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
 
-		/* Calculate the number of bytes that can be read - which may be
-		less than the number wanted if the data wraps around to the start of
-		the buffer. */
-		xFirstLength = configMIN( pxStreamBuffer->xLength - xNextTail, xCount );
+		configASSERT( pxStreamBuffer );
 
-		/* Obtain the number of bytes it is possible to obtain in the first
-		read.  Asserts check bounds of read and write. */
-		configASSERT( xFirstLength <= xMaxCount );
-		configASSERT( ( xNextTail + xFirstLength ) <= pxStreamBuffer->xLength );
-		( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xNextTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+		prvCommitWriteRegion( pxStreamBuffer, xBytesWritten );
 
-		/* If the total number of wanted bytes is greater than the number
-		that could be read in the first read... */
-		if( xCount > xFirstLength )
+		if( xBytesWritten != ( size_t ) 0 )
 		{
-			/*...then read the remaining bytes from the start of the buffer. */
-			configASSERT( xCount <= xMaxCount );
-			( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+			traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesWritten );
+
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETED( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+	}
+	/*-----------------------------------------------------------*/
 
-		/* Move the tail pointer to effectively remove the data read from
-		the buffer. */
-		xNextTail += xCount;
+	void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+										  size_t xBytesWritten,
+										  BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
 
-		if( xNextTail >= pxStreamBuffer->xLength )
-		{
-			xNextTail -= pxStreamBuffer->xLength;
-		}
+		configASSERT( pxStreamBuffer );
+
+		prvCommitWriteRegion( pxStreamBuffer, xBytesWritten );
+
+		if( xBytesWritten != ( size_t ) 0 )
+		{
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesWritten );
+	}
+	/*-----------------------------------------------------------*/
+
+	size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+									 void **ppvRegion,
+									 TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn = 0, xBytesAvailable, xBytesToStoreMessageLength;
+
+		configASSERT( ppvRegion );
+		configASSERT( pxStreamBuffer );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
+
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			/* Checking if there is data and clearing the notification state
+			must be performed atomically, as in xStreamBufferReceive(). */
+			taskENTER_CRITICAL();
+			{
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+				if( xBytesAvailable <= xBytesToStoreMessageLength )
+				{
+					/* Clear notification state as going to wait for data. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one reader. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+					pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xBytesAvailable <= xBytesToStoreMessageLength )
+			{
+				/* Wait for data to be available. */
+				traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+				/* Recheck the data available after blocking. */
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		}
+
+		if( xBytesAvailable > xBytesToStoreMessageLength )
+		{
+			xReturn = prvAcquireReadRegion( pxStreamBuffer, ppvRegion, xBytesAvailable );
+		}
+		else
+		{
+			*ppvRegion = NULL;
+			traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	size_t xStreamBufferAcquireReadFromISR( StreamBufferHandle_t xStreamBuffer, void **ppvRegion )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xReturn = 0, xBytesAvailable, xBytesToStoreMessageLength;
+
+		configASSERT( ppvRegion );
+		configASSERT( pxStreamBuffer );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+		else
+		{
+			xBytesToStoreMessageLength = 0;
+		}
+
+		xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+		if( xBytesAvailable > xBytesToStoreMessageLength )
+		{
+			xReturn = prvAcquireReadRegion( pxStreamBuffer, ppvRegion, xBytesAvailable );
+		}
+		else
+		{
+			*ppvRegion = NULL;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytesRead )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+
+		if( ( xBytesRead != ( size_t ) 0 ) || ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 ) )
+		{
+			prvConsumeReadRegion( pxStreamBuffer, xBytesRead );
+
+			/* Was a task waiting for space in the buffer? */
+			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesRead );
+			sbRECEIVE_COMPLETED( pxStreamBuffer );
+
+			#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+			{
+				prvUnblockWriters( pxStreamBuffer );
+			}
+			#endif
+		}
+		else
+		{
+			pxStreamBuffer->xReadRegionBytes = 0;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+									  size_t xBytesRead,
+									  BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+
+		if( ( xBytesRead != ( size_t ) 0 ) || ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 ) )
+		{
+			prvConsumeReadRegion( pxStreamBuffer, xBytesRead );
+
+			/* Was a task waiting for space in the buffer? */
+			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+
+			#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+			{
+				prvUnblockWritersFromISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			#endif
+		}
+		else
+		{
+			pxStreamBuffer->xReadRegionBytes = 0;
+		}
+
+		traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xBytesRead );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_REGIONS */
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount, size_t xHead )
+{
+size_t xNextHead, xFirstLength;
+
+	configASSERT( xCount > ( size_t ) 0 );
+
+	xNextHead = xHead;
+
+	/* Calculate the number of bytes that can be added in the first write -
+	which may be less than the total number of bytes that need to be added if
+	the buffer will wrap back to the beginning. */
+	xFirstLength = configMIN( sbCONTIGUOUS_BYTES( pxStreamBuffer, xNextHead ), xCount );
+
+	/* Write as many bytes as can be written in the first write. */
+	configASSERT( xFirstLength <= sbCONTIGUOUS_BYTES( pxStreamBuffer, xNextHead ) );
+	( void ) memcpy( ( void* ) ( &( pxStreamBuffer->pucBuffer[ xNextHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+	/* If the number of bytes written was less than the number that could be
+	written in the first write... */
+	if( xCount > xFirstLength )
+	{
+		/* ...then write the remaining bytes to the start of the buffer. */
+		configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
+		( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xNextHead += xCount;
+	if( xNextHead >= pxStreamBuffer->xLength )
+	{
+		xNextHead -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xNextHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytesFromBuffer( StreamBuffer_t *pxStreamBuffer, uint8_t *pucData, size_t xMaxCount, size_t xBytesAvailable )
+{
+size_t xCount, xFirstLength, xNextTail;
+
+	/* Use the minimum of the wanted bytes and the available bytes. */
+	xCount = configMIN( xBytesAvailable, xMaxCount );
+
+	if( xCount > ( size_t ) 0 )
+	{
+		xNextTail = pxStreamBuffer->xTail;
+
+		/* Calculate the number of bytes that can be read - which may be
+		less than the number wanted if the data wraps around to the start of
+		the buffer. */
+		xFirstLength = configMIN( sbCONTIGUOUS_BYTES( pxStreamBuffer, xNextTail ), xCount );
+
+		/* Obtain the number of bytes it is possible to obtain in the first
+		read.  Asserts check bounds of read and write. */
+		configASSERT( xFirstLength <= xMaxCount );
+		configASSERT( xFirstLength <= sbCONTIGUOUS_BYTES( pxStreamBuffer, xNextTail ) );
+		( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xNextTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+		/* If the total number of wanted bytes is greater than the number
+		that could be read in the first read... */
+		if( xCount > xFirstLength )
+		{
+			/*...then read the remaining bytes from the start of the buffer. */
+			configASSERT( xCount <= xMaxCount );
+			( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Move the tail pointer to effectively remove the data read from
+		the buffer. */
+		xNextTail += xCount;
+
+		if( xNextTail >= pxStreamBuffer->xLength )
+		{
+			xNextTail -= pxStreamBuffer->xLength;
+		}
 
 		pxStreamBuffer->xTail = xNextTail;
 	}
-	else
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
+{
+/* Returns the distance between xTail and xHead. */
+size_t xCount;
+
+	#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+	{
+	size_t xHead;
+
+		/* The writer moves the head and tail of an empty buffer back to the
+		start (see prvRewindIfEmpty()), so the tail read here only goes with
+		the head read here if the head did not move in between. */
+		do
+		{
+			xHead = pxStreamBuffer->xHead;
+			xCount = pxStreamBuffer->xLength + xHead;
+			xCount -= pxStreamBuffer->xTail;
+		} while( xHead != pxStreamBuffer->xHead );
+	}
+	#else
+	{
+		xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+		xCount -= pxStreamBuffer->xTail;
+	}
+	#endif
+
+	if ( xCount >= pxStreamBuffer->xLength )
+	{
+		xCount -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+
+	static size_t prvMessagePadding( const StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes )
+	{
+	size_t xBytesToEnd, xReturn;
+
+		xBytesToEnd = pxStreamBuffer->xLength - pxStreamBuffer->xHead;
+
+		if( sbIS_MIRRORED( pxStreamBuffer ) != pdFALSE )
+		{
+			/* Nothing is ever split in a mirrored storage area. */
+			xReturn = 0;
+		}
+		else if( xBytesToEnd <= sbBYTES_TO_STORE_MESSAGE_LENGTH )
+		{
+			/* The message length reaches, or is split by, the end of the
+			storage area, so the message itself starts near the beginning and
+			is not split.  There would be no room for the padding marker
+			anyway. */
+			xReturn = 0;
+		}
+		else if( ( sbBYTES_TO_STORE_MESSAGE_LENGTH + xDataLengthBytes ) <= xBytesToEnd )
+		{
+			/* The whole message fits before the end. */
+			xReturn = 0;
+		}
+		else
+		{
+			/* Pad up to the end, so the length and the message start at the
+			beginning. */
+			xReturn = xBytesToEnd;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvSpaceRequired( const StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes )
+	{
+	size_t xReturn = xDataLengthBytes;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xReturn += sbBYTES_TO_STORE_MESSAGE_LENGTH + prvMessagePadding( pxStreamBuffer, xDataLengthBytes );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvSkipMessagePadding( StreamBuffer_t * const pxStreamBuffer, size_t xBytesAvailable )
+	{
+	size_t xBytesToEnd;
+	configMESSAGE_BUFFER_LENGTH_TYPE xLength;
+
+		xBytesToEnd = pxStreamBuffer->xLength - pxStreamBuffer->xTail;
+
+		/* Padding is only written where its marker fits before the end of the
+		storage area, and a message always follows it from the start. */
+		if( ( xBytesAvailable > xBytesToEnd ) && ( xBytesToEnd > sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
+		{
+			( void ) memcpy( ( void * ) &xLength, ( const void * ) &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xTail ] ), sbBYTES_TO_STORE_MESSAGE_LENGTH ); /*lint !e9087 memcpy() requires void *. */
+
+			if( xLength == sbMESSAGE_PADDING )
+			{
+				pxStreamBuffer->xTail = 0;
+				xBytesAvailable -= xBytesToEnd;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xBytesAvailable;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRewindIfEmpty( StreamBuffer_t * const pxStreamBuffer )
+	{
+		/* The reader only reads the head and tail together when the head has
+		not moved in between - see prvBytesInBuffer(). */
+		if( pxStreamBuffer->xHead == pxStreamBuffer->xTail )
+		{
+			pxStreamBuffer->xTail = 0;
+			pxStreamBuffer->xHead = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvAcquireWriteRegion( StreamBuffer_t * const pxStreamBuffer, void **ppvRegion, size_t xBytesWanted )
+	{
+	size_t xReturn, xSpace, xHead;
+
+		prvRewindIfEmpty( pxStreamBuffer );
+
+		xHead = pxStreamBuffer->xHead;
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* A message is all or nothing, and goes after any padding and its
+			length. */
+			if( ( xBytesWanted > ( size_t ) 0 ) && ( xSpace >= prvSpaceRequired( pxStreamBuffer, xBytesWanted ) ) )
+			{
+				xHead += prvMessagePadding( pxStreamBuffer, xBytesWanted ) + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+				if( xHead >= pxStreamBuffer->xLength )
+				{
+					xHead -= pxStreamBuffer->xLength;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = xBytesWanted;
+			}
+			else
+			{
+				xReturn = 0;
+			}
+		}
+		else
+		{
+			/* As much of what is wanted as there is room for before the end of
+			the storage area. */
+			xReturn = configMIN( xBytesWanted, xSpace );
+			xReturn = configMIN( xReturn, sbCONTIGUOUS_BYTES( pxStreamBuffer, xHead ) );
+		}
+
+		pxStreamBuffer->xWriteRegionBytes = xReturn;
+
+		if( xReturn != ( size_t ) 0 )
+		{
+			*ppvRegion = ( void * ) &( pxStreamBuffer->pucBuffer[ xHead ] );
+		}
+		else
+		{
+			*ppvRegion = NULL;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvAcquireReadRegion( StreamBuffer_t * const pxStreamBuffer, void **ppvRegion, size_t xBytesAvailable )
 	{
-		mtCOVERAGE_TEST_MARKER();
+	size_t xReturn, xTail, xOriginalTail;
+	configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* Read the length of the message without removing it, as
+			xStreamBufferNextMessageLengthBytes() does.  The message itself is
+			never split. */
+			xBytesAvailable = prvSkipMessagePadding( pxStreamBuffer, xBytesAvailable );
+			xOriginalTail = pxStreamBuffer->xTail;
+			( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xBytesAvailable );
+			xTail = pxStreamBuffer->xTail;
+			pxStreamBuffer->xTail = xOriginalTail;
+
+			xReturn = ( size_t ) xTempLength;
+			configASSERT( xReturn <= sbCONTIGUOUS_BYTES( pxStreamBuffer, xTail ) );
+		}
+		else
+		{
+			xTail = pxStreamBuffer->xTail;
+			xReturn = configMIN( xBytesAvailable, sbCONTIGUOUS_BYTES( pxStreamBuffer, xTail ) );
+		}
+
+		pxStreamBuffer->xReadRegionBytes = xReturn;
+		*ppvRegion = ( void * ) &( pxStreamBuffer->pucBuffer[ xTail ] );
+
+		return xReturn;
 	}
+	/*-----------------------------------------------------------*/
 
-	return xCount;
-}
+	static void prvCommitWriteRegion( StreamBuffer_t * const pxStreamBuffer, size_t xBytesWritten )
+	{
+	size_t xHead = pxStreamBuffer->xHead;
+
+		configASSERT( xBytesWritten <= pxStreamBuffer->xWriteRegionBytes );
+
+		if( xBytesWritten != ( size_t ) 0 )
+		{
+			if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+			{
+				/* The message went where prvAcquireWriteRegion() worked out for
+				the length it was acquired with, which may be more than was
+				written, so pad for that length. */
+				if( prvMessagePadding( pxStreamBuffer, pxStreamBuffer->xWriteRegionBytes ) != ( size_t ) 0 )
+				{
+					const configMESSAGE_BUFFER_LENGTH_TYPE xPadding = sbMESSAGE_PADDING;
+
+					( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &xPadding, sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead );
+					xHead = 0;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xBytesWritten ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xHead += xBytesWritten;
+
+			if( xHead >= pxStreamBuffer->xLength )
+			{
+				xHead -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Everything is in place, so the reader can now see it. */
+			pxStreamBuffer->xHead = xHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xWriteRegionBytes = 0;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvConsumeReadRegion( StreamBuffer_t * const pxStreamBuffer, size_t xBytesRead )
+	{
+	size_t xTail;
+
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* The whole message goes, with its length. */
+			configASSERT( pxStreamBuffer->xReadRegionBytes != ( size_t ) 0 );
+			xBytesRead = sbBYTES_TO_STORE_MESSAGE_LENGTH + pxStreamBuffer->xReadRegionBytes;
+		}
+		else
+		{
+			configASSERT( xBytesRead <= pxStreamBuffer->xReadRegionBytes );
+		}
+
+		xTail = pxStreamBuffer->xTail + xBytesRead;
+
+		if( xTail >= pxStreamBuffer->xLength )
+		{
+			xTail -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xTail = xTail;
+		pxStreamBuffer->xReadRegionBytes = 0;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_REGIONS */
 /*-----------------------------------------------------------*/
 
-static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
-{
-/* Returns the distance between xTail and xHead. */
-size_t xCount;
+#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
 
-	xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
-	xCount -= pxStreamBuffer->xTail;
-	if ( xCount >= pxStreamBuffer->xLength )
+	static uint8_t prvMultiProducerFlags( BaseType_t * const pxIsMessageBuffer, size_t xBufferSizeBytes )
 	{
-		xCount -= pxStreamBuffer->xLength;
+	uint8_t ucReturn;
+
+		if( ( *pxIsMessageBuffer & sbCREATE_MULTI_PRODUCER ) != ( BaseType_t ) 0 )
+		{
+			*pxIsMessageBuffer &= ~sbCREATE_MULTI_PRODUCER;
+			ucReturn = sbFLAGS_IS_MULTI_PRODUCER;
+
+			/* Every index into the storage area, which is one byte larger than
+			asked for, must fit the reserve head. */
+			configASSERT( xBufferSizeBytes < ( size_t ) sbRESERVE_HEAD_MASK );
+		}
+		else
+		{
+			ucReturn = 0;
+		}
+
+		return ucReturn;
 	}
-	else
+	/*-----------------------------------------------------------*/
+
+	static size_t prvReserveSpace( StreamBuffer_t * const pxStreamBuffer, size_t xDataLengthBytes, size_t * const pxStart )
 	{
-		mtCOVERAGE_TEST_MARKER();
+	uint32_t ulReserve;
+	size_t xHead, xSpace, xReserved = 0, xReturn;
+
+		do
+		{
+			ulReserve = pxStreamBuffer->ulReserve;
+			xHead = ( size_t ) ( ulReserve & sbRESERVE_HEAD_MASK );
+
+			/* As xStreamBufferSpacesAvailable().  The tail can only move on
+			while this runs, so the space can only be under estimated. */
+			xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+			xSpace -= xHead;
+			xSpace -= ( size_t ) 1;
+
+			if( xSpace >= pxStreamBuffer->xLength )
+			{
+				xSpace -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( sbRESERVE_WRITERS( ulReserve ) == sbRESERVE_MAX_WRITERS )
+			{
+				/* No more writers can be counted, so treat the buffer as full
+				until one of them commits. */
+				xReturn = 0;
+			}
+			else if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+			{
+				/* A stream buffer takes as many bytes as there is room for. */
+				xReturn = configMIN( xDataLengthBytes, xSpace );
+				xReserved = xReturn;
+			}
+			else if( xSpace >= ( xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
+			{
+				/* A message is all or nothing, and goes after its length.  It
+				is not padded to keep it whole, as there is no single writer to
+				move the head and tail of an empty buffer back to the start - see
+				prvRewindIfEmpty(). */
+				xReturn = xDataLengthBytes;
+				xReserved = xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+			}
+			else
+			{
+				xReturn = 0;
+			}
+
+			if( xReturn == ( size_t ) 0 )
+			{
+				break;
+			}
+
+			/* Count this writer and move the reserve head past its space in
+			one go, unless another writer got there first. */
+			*pxStart = xHead;
+			xHead += xReserved;
+
+			if( xHead >= pxStreamBuffer->xLength )
+			{
+				xHead -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+		} while( Atomic_CompareAndSwap_u32( &( pxStreamBuffer->ulReserve ),
+											( ( ulReserve & ~sbRESERVE_HEAD_MASK ) + sbRESERVE_ONE_WRITER ) | ( uint32_t ) xHead,
+											ulReserve ) == ATOMIC_COMPARE_AND_SWAP_FAILURE );
+
+		return xReturn;
 	}
+	/*-----------------------------------------------------------*/
 
-	return xCount;
-}
+	static void prvWriteReserved( StreamBuffer_t * const pxStreamBuffer, const void * pvTxData, size_t xDataLengthBytes, size_t xStart )
+	{
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			xStart = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xStart );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xStart ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvCommitReserved( StreamBuffer_t * const pxStreamBuffer )
+	{
+	uint32_t ulReserve;
+	BaseType_t xReturn = pdFALSE;
+
+		/* Commit by no longer counting this writer.  prvReserveSpace() takes
+		no lock, so on another core it can move the reserve head at any time -
+		the count is only ever changed atomically, and the value it leaves is
+		the one the head below comes from. */
+		ulReserve = Atomic_Subtract_u32( &( pxStreamBuffer->ulReserve ), sbRESERVE_ONE_WRITER );
+		configASSERT( sbRESERVE_WRITERS( ulReserve ) != ( uint32_t ) 0 );
+		ulReserve -= sbRESERVE_ONE_WRITER;
+
+		if( sbRESERVE_WRITERS( ulReserve ) == ( uint32_t ) 0 )
+		{
+			/* This was the last writer part way through, so everything up to
+			the reserve head is in place, including writes reserved before this
+			one that committed after it and writes reserved after it that
+			committed before it.  Show it all to the reader.  Commits are made
+			inside a critical section, so another writer that reserves after
+			the count reached zero cannot commit, and move the head, until this
+			one has - the head never moves back. */
+			pxStreamBuffer->xHead = ( size_t ) ( ulReserve & sbRESERVE_HEAD_MASK );
+
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			/* Another writer is still part way through, and moves the head
+			when it commits. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvSendMultiProducer( StreamBuffer_t * const pxStreamBuffer, const void * pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait )
+	{
+	size_t xReturn, xStart = 0;
+	TimeOut_t xTimeOut;
+
+		vTaskSetTimeOutState( &xTimeOut );
+		xReturn = prvReserveSpace( pxStreamBuffer, xDataLengthBytes, &xStart );
+
+		while( ( xReturn == ( size_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+		{
+			taskENTER_CRITICAL();
+			{
+				/* Try again with the reader locked out, so it cannot free
+				space between the attempt failing and this task joining the
+				writers waiting for space. */
+				xReturn = prvReserveSpace( pxStreamBuffer, xDataLengthBytes, &xStart );
+
+				if( xReturn == ( size_t ) 0 )
+				{
+					if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+					{
+						/* There can be any number of writers waiting, so they
+						wait on an event list rather than for a notification.
+						The yield happens when the critical section is left. */
+						traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
+						vTaskPlaceOnEventList( &( pxStreamBuffer->xTasksWaitingToSend ), xTicksToWait );
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						/* Timed out, and xTicksToWait is now 0. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+
+		if( xReturn > ( size_t ) 0 )
+		{
+		BaseType_t xWakeReader;
+
+			/* The copy is made outside of any critical section, while other
+			writers reserve and fill in space of their own.  Only the commit
+			locks them out, for a few instructions. */
+			prvWriteReserved( pxStreamBuffer, pvTxData, xReturn, xStart );
+
+			taskENTER_CRITICAL();
+			{
+				xWakeReader = prvCommitReserved( pxStreamBuffer );
+			}
+			taskEXIT_CRITICAL();
+
+			if( xWakeReader != pdFALSE )
+			{
+				sbSEND_COMPLETED( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			traceSTREAM_BUFFER_SEND( pxStreamBuffer, xReturn );
+		}
+		else
+		{
+			traceSTREAM_BUFFER_SEND_FAILED( pxStreamBuffer );
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvUnblockWriters( StreamBuffer_t * const pxStreamBuffer )
+	{
+	BaseType_t xYieldRequired = pdFALSE;
+
+		/* With one core a writer only joins the list inside a critical
+		section, after the tail has moved, and then finds the space freed, so
+		there is no need for a critical section to find the list empty.  With
+		more than one, a writer on another core can have read the old tail and
+		be about to join the list, so it is only checked with the lock held. */
+		if( ( sbIS_MULTI_PRODUCER( pxStreamBuffer ) != pdFALSE ) &&
+			( ( configNUMBER_OF_CORES > 1 ) || ( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToSend ) ) == pdFALSE ) ) )
+		{
+			taskENTER_CRITICAL();
+			{
+				while( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToSend ) ) == pdFALSE )
+				{
+					if( xTaskRemoveFromEventList( &( pxStreamBuffer->xTasksWaitingToSend ) ) != pdFALSE )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				if( xYieldRequired != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvUnblockWritersFromISR( StreamBuffer_t * const pxStreamBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+
+		/* See prvUnblockWriters(). */
+		if( ( sbIS_MULTI_PRODUCER( pxStreamBuffer ) != pdFALSE ) &&
+			( ( configNUMBER_OF_CORES > 1 ) || ( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToSend ) ) == pdFALSE ) ) )
+		{
+			uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				while( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToSend ) ) == pdFALSE )
+				{
+					if( ( xTaskRemoveFromEventList( &( pxStreamBuffer->xTasksWaitingToSend ) ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
 /*-----------------------------------------------------------*/
 
 static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
@@ -1230,6 +2575,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	pxStreamBuffer->xLength = xBufferSizeBytes;
 	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
 	pxStreamBuffer->ucFlags = ucFlags;
+
+	#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	{
+		vListInitialise( &( pxStreamBuffer->xTasksWaitingToSend ) );
+	}
+	#endif
 }
 
 #if ( configUSE_TRACE_FACILITY == 1 )
@@ -0,0 +1,1033 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "atomic.h"
+#include "task_pool.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build task_pool.c
+#endif
+
+#if( configUSE_COUNTING_SEMAPHORES != 1 )
+	#error configUSE_COUNTING_SEMAPHORES must be set to 1 to build task_pool.c
+#endif
+
+/* The pvWaiter member of a job holds NULL until a task waits for the job, then
+that task's handle, and once the job has completed the address of the job
+itself, which cannot be mistaken for a task handle.  Whichever of the waiting
+task and the worker completing the job swaps the member second knows the other
+has been there, so the waiting task is notified exactly when it has blocked. */
+#define taskpoolJOB_DONE( pxJob )	( ( void * ) ( pxJob ) )
+
+/*
+ * Each worker's deque is the lock free work stealing deque of Chase and Lev,
+ * with a fixed number of slots.  The worker pushes and pops jobs at the
+ * bottom, and any task may steal the job at the top.  Only the worker writes
+ * ulBottom.  ulTop only moves on, by a compare and swap, so a thief and the
+ * worker both taking the last job cannot both succeed.  Every write of
+ * ulBottom is an atomic read-modify-write, which orders it with the read of
+ * ulTop that follows it.
+ */
+typedef struct tskpoolWorker
+{
+	volatile uint32_t ulTop;			/*< Position of the next job to steal. */
+	volatile uint32_t ulBottom;			/*< Position the worker pushes its next job at. */
+	TaskPoolJob_t **ppxSlots;			/*< The deque storage, ulDequeMask + 1 slots. */
+	TaskHandle_t xTask;					/*< The worker task, NULL if it could not be created. */
+	struct TaskPoolDef_t *pxPool;
+} TaskPoolWorker_t;
+
+/*
+ * A worker must not block while a job it could run is queued, and must not
+ * search the deques while none is.  ulJobsQueued counts the jobs queued but
+ * not yet claimed by a task that will run them.  A worker claims one by
+ * decrementing it, and if there was none the count goes below zero, to minus
+ * the number of workers blocked on xJobsSemaphore.  Queueing a job gives the
+ * semaphore if it finds the count below zero, so an idle pool costs the
+ * tasks submitting jobs two atomic adds rather than a semaphore give.
+ */
+typedef struct TaskPoolDef_t
+{
+	UBaseType_t uxWorkers;				/*< The number of workers, including any that could not be created. */
+	uint32_t ulDequeMask;				/*< The number of slots in each deque less one. */
+	volatile uint32_t ulJobsQueued;		/*< Used as signed, see above. */
+	SemaphoreHandle_t xJobsSemaphore;	/*< Blocked on by workers with no job to claim. */
+	QueueHandle_t xSharedQueue;			/*< Jobs submitted by tasks that are not workers, or that did not fit in a deque. */
+	volatile BaseType_t xStopping;		/*< Set by vTaskPoolDelete(). */
+	volatile uint32_t ulWorkersRunning;
+	TaskHandle_t xDeletingTask;
+	TaskPoolWorker_t *pxWorkers;
+} TaskPool_t;
+
+/* The state shared by the tasks running the chunks of a parallel loop. */
+typedef struct tskpoolRange
+{
+	TaskPoolJob_t xJob;					/*< Run once by the calling task and once for each helper queued. */
+	volatile uint32_t ulNext;			/*< The first index of the next chunk. */
+	uint32_t ulEnd;
+	uint32_t ulGrain;
+	TaskPoolRangeFunction_t pxFor;		/*< Set for vTaskPoolParallelFor(). */
+	TaskPoolReduceFunction_t pxReduce;	/*< Set for vTaskPoolParallelReduce(). */
+	TaskPoolCombineFunction_t pxCombine;
+	void *pvParameters;
+	void *pvResult;
+	size_t xResultSize;
+	uint64_t ullIdentity[ taskpoolMAX_RESULT_SIZE / sizeof( uint64_t ) ];	/*< The value *pvResult held on entry. */
+} TaskPoolRange_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The worker task.
+ */
+static portTASK_FUNCTION_PROTO( prvWorkerTask, pvParameters );
+
+/*
+ * Count ulCount more jobs as queued, waking as many blocked workers as there
+ * are jobs for.
+ */
+static void prvPostJobs( TaskPool_t * const pxPool, const uint32_t ulCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Claim one of the queued jobs.  With xBlock set the calling worker blocks
+ * until there is one to claim, otherwise pdFALSE is returned if there is none.
+ */
+static BaseType_t prvClaimJob( TaskPool_t * const pxPool, const BaseType_t xBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find the job a claim was made for - from the calling worker's own deque,
+ * the shared queue or another worker's deque.  pxSelf is NULL if the calling
+ * task is not a worker.
+ */
+static TaskPoolJob_t *prvFindJob( TaskPool_t * const pxPool, TaskPoolWorker_t * const pxSelf ) PRIVILEGED_FUNCTION;
+
+/*
+ * Queue a job - on the deque of pxSelf, the calling worker, if there is room,
+ * otherwise on the shared queue.  The job is not counted until prvPostJobs()
+ * is called.
+ */
+static BaseType_t prvQueueJob( TaskPool_t * const pxPool, TaskPoolWorker_t * const pxSelf, TaskPoolJob_t * const pxJob, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Run one claimed job, and complete it if that was its last run.
+ */
+static void prvRunJob( TaskPoolJob_t * const pxJob ) PRIVILEGED_FUNCTION;
+
+/*
+ * The worker of the pool the calling task is, or NULL.
+ */
+static TaskPoolWorker_t *prvGetCallingWorker( TaskPool_t * const pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * The deque operations.  prvPushBottom() returns pdFALSE if the deque is
+ * full, and prvPopBottom() and prvStealTop() return NULL if there is no job
+ * to take.
+ */
+static BaseType_t prvPushBottom( TaskPoolWorker_t * const pxWorker, TaskPoolJob_t * const pxJob ) PRIVILEGED_FUNCTION;
+static TaskPoolJob_t *prvPopBottom( TaskPoolWorker_t * const pxWorker ) PRIVILEGED_FUNCTION;
+static TaskPoolJob_t *prvStealTop( TaskPoolWorker_t * const pxWorker ) PRIVILEGED_FUNCTION;
+
+/*
+ * Run a parallel loop, and the job function of each task taking part in one.
+ */
+static void prvRunRange( TaskPool_t * const pxPool, TaskPoolRange_t * const pxRange, const uint32_t ulBegin ) PRIVILEGED_FUNCTION;
+static void prvRangeJob( void *pvRange ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	TaskPoolHandle_t xTaskPoolCreate( const char * const pcName, const UBaseType_t uxWorkers, const configSTACK_DEPTH_TYPE usStackDepth, const UBaseType_t uxPriority, const UBaseType_t uxQueueLength )
+	{
+	TaskPool_t *pxPool;
+	TaskPoolWorker_t *pxWorker;
+	TaskPoolJob_t **ppxSlots;
+	UBaseType_t x;
+	size_t xSize;
+	BaseType_t xCreated = pdTRUE;
+
+		configASSERT( uxWorkers > ( UBaseType_t ) 0 );
+		configASSERT( ( uxQueueLength > ( UBaseType_t ) 0 ) && ( ( uxQueueLength & ( uxQueueLength - ( UBaseType_t ) 1 ) ) == ( UBaseType_t ) 0 ) );
+
+		/* The pool, the workers and the deque slots in one block. */
+		xSize = sizeof( TaskPool_t ) + ( ( size_t ) uxWorkers * ( sizeof( TaskPoolWorker_t ) + ( ( size_t ) uxQueueLength * sizeof( TaskPoolJob_t * ) ) ) );
+		pxPool = ( TaskPool_t * ) pvPortMalloc( xSize ); /*lint !e9087 !e9079 pvPortMalloc() meets the alignment requirements of the structure. */
+
+		if( pxPool != NULL )
+		{
+			pxPool->uxWorkers = uxWorkers;
+			pxPool->ulDequeMask = ( uint32_t ) uxQueueLength - ( uint32_t ) 1;
+			pxPool->ulJobsQueued = 0;
+			pxPool->xStopping = pdFALSE;
+			pxPool->ulWorkersRunning = 0;
+			pxPool->xDeletingTask = NULL;
+			pxPool->pxWorkers = ( TaskPoolWorker_t * ) &( pxPool[ 1 ] ); /*lint !e9087 The workers follow the pool. */
+			ppxSlots = ( TaskPoolJob_t ** ) &( pxPool->pxWorkers[ uxWorkers ] ); /*lint !e9087 The slots follow the workers. */
+
+			for( x = ( UBaseType_t ) 0; x < uxWorkers; x++ )
+			{
+				pxWorker = &( pxPool->pxWorkers[ x ] );
+				pxWorker->ulTop = 0;
+				pxWorker->ulBottom = 0;
+				pxWorker->ppxSlots = &( ppxSlots[ x * uxQueueLength ] );
+				pxWorker->xTask = NULL;
+				pxWorker->pxPool = pxPool;
+			}
+
+			pxPool->xJobsSemaphore = xSemaphoreCreateCounting( uxWorkers, ( UBaseType_t ) 0 );
+			pxPool->xSharedQueue = xQueueCreate( uxQueueLength, sizeof( TaskPoolJob_t * ) );
+
+			if( ( pxPool->xJobsSemaphore == NULL ) || ( pxPool->xSharedQueue == NULL ) )
+			{
+				xCreated = pdFALSE;
+			}
+			else
+			{
+				for( x = ( UBaseType_t ) 0; x < uxWorkers; x++ )
+				{
+					pxWorker = &( pxPool->pxWorkers[ x ] );
+
+					/* The handle is written before the task can run, so a
+					worker can always find itself in the pool. */
+					if( xTaskCreate( prvWorkerTask, pcName, usStackDepth, pxWorker, uxPriority, &( pxWorker->xTask ) ) == pdPASS )
+					{
+						( void ) Atomic_Increment_u32( &( pxPool->ulWorkersRunning ) );
+					}
+					else
+					{
+						xCreated = pdFALSE;
+						break;
+					}
+				}
+			}
+
+			if( xCreated == pdFALSE )
+			{
+				if( pxPool->ulWorkersRunning > ( uint32_t ) 0 )
+				{
+					/* Stops the workers that were created and frees
+					everything. */
+					vTaskPoolDelete( pxPool );
+				}
+				else
+				{
+					if( pxPool->xJobsSemaphore != NULL )
+					{
+						vSemaphoreDelete( pxPool->xJobsSemaphore );
+					}
+
+					if( pxPool->xSharedQueue != NULL )
+					{
+						vQueueDelete( pxPool->xSharedQueue );
+					}
+
+					vPortFree( pxPool );
+				}
+
+				pxPool = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxPool;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskPoolSubmit( TaskPoolHandle_t xPool, TaskPoolJob_t * const pxJob, TaskPoolFunction_t pxFunction, void * const pvParameters, TickType_t xTicksToWait )
+{
+TaskPool_t * const pxPool = xPool;
+TaskPoolWorker_t *pxSelf;
+BaseType_t xReturn;
+
+	configASSERT( pxPool );
+	configASSERT( pxJob );
+	configASSERT( pxFunction );
+
+	pxJob->pxFunction = pxFunction;
+	pxJob->pvParameters = pvParameters;
+	pxJob->ulRunsLeft = 1;
+	pxJob->pvWaiter = NULL;
+
+	/* Only the workers and the tasks waiting for jobs make room in the pool,
+	so a worker must not block waiting for room. */
+	pxSelf = prvGetCallingWorker( pxPool );
+
+	if( pxSelf != NULL )
+	{
+		xTicksToWait = 0;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xReturn = prvQueueJob( pxPool, pxSelf, pxJob, xTicksToWait );
+
+	if( xReturn != pdFAIL )
+	{
+		prvPostJobs( pxPool, ( uint32_t ) 1 );
+	}
+	else if( pxSelf != NULL )
+	{
+		/* The worker runs the job itself instead. */
+		prvRunJob( pxJob );
+		xReturn = pdPASS;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskPoolWait( TaskPoolHandle_t xPool, TaskPoolJob_t * const pxJob, TickType_t xTicksToWait )
+{
+TaskPool_t * const pxPool = xPool;
+TaskPoolWorker_t * const pxSelf = prvGetCallingWorker( pxPool );
+void * const pvSelf = ( void * ) xTaskGetCurrentTaskHandle();
+TimeOut_t xTimeOut;
+BaseType_t xReturn = pdFAIL, xFinished = pdFALSE;
+uint32_t ulNotificationsTaken = 0UL;
+
+	configASSERT( pxPool );
+	configASSERT( pxJob );
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	while( xFinished == pdFALSE )
+	{
+		if( pxJob->pvWaiter == taskpoolJOB_DONE( pxJob ) )
+		{
+			xReturn = pdPASS;
+			xFinished = pdTRUE;
+		}
+		else if( prvClaimJob( pxPool, pdFALSE ) != pdFALSE )
+		{
+			/* Rather than block, run one of the queued jobs - possibly the
+			one being waited for. */
+			prvRunJob( prvFindJob( pxPool, pxSelf ) );
+		}
+		else if( Atomic_CompareAndSwapPointers_p32( &( pxJob->pvWaiter ), pvSelf, NULL ) == ATOMIC_COMPARE_AND_SWAP_FAILURE )
+		{
+			/* The job completed since it was tested. */
+			xReturn = pdPASS;
+			xFinished = pdTRUE;
+		}
+		else
+		{
+			/* Nothing left to run, so block until the job completes.  Every
+			job still queued has been claimed by a task that will run it.  A
+			notification given to this task for something else can wake it
+			first, so only the job being marked done ends the wait.  The
+			notifications are taken one at a time so the ones that were not
+			for the job can be given back. */
+			while( ( pxJob->pvWaiter != taskpoolJOB_DONE( pxJob ) ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) )
+			{
+				if( ulTaskNotifyTake( pdFALSE, xTicksToWait ) != ( uint32_t ) 0 )
+				{
+					ulNotificationsTaken++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			if( ( pxJob->pvWaiter != taskpoolJOB_DONE( pxJob ) ) &&
+				( Atomic_CompareAndSwapPointers_p32( &( pxJob->pvWaiter ), NULL, pvSelf ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS ) )
+			{
+				/* Timed out, and no longer waiting, so no worker will notify
+				this task for the job. */
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				/* The job completed, and the worker that completed it
+				notifies this task once - if that notification has not been
+				taken yet it is on its way. */
+				while( ulNotificationsTaken == 0UL )
+				{
+					if( ulTaskNotifyTake( pdFALSE, portMAX_DELAY ) != ( uint32_t ) 0 )
+					{
+						ulNotificationsTaken++;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				ulNotificationsTaken--;
+				xReturn = pdPASS;
+			}
+
+			/* Give back the rest.  Notifications only count, so it does not
+			matter which of those taken was the job's. */
+			while( ulNotificationsTaken > 0UL )
+			{
+				( void ) xTaskNotifyGive( ( TaskHandle_t ) pvSelf );
+				ulNotificationsTaken--;
+			}
+
+			xFinished = pdTRUE;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskPoolIsDone( const TaskPoolJob_t * const pxJob )
+{
+BaseType_t xReturn;
+
+	configASSERT( pxJob );
+
+	if( pxJob->pvWaiter == taskpoolJOB_DONE( pxJob ) )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPoolParallelFor( TaskPoolHandle_t xPool, uint32_t ulBegin, uint32_t ulEnd, uint32_t ulGrain, TaskPoolRangeFunction_t pxFunction, void * const pvParameters )
+{
+TaskPoolRange_t xRange;
+
+	configASSERT( xPool );
+	configASSERT( pxFunction );
+	configASSERT( ulGrain > ( uint32_t ) 0 );
+
+	xRange.ulEnd = ulEnd;
+	xRange.ulGrain = ulGrain;
+	xRange.pxFor = pxFunction;
+	xRange.pxReduce = NULL;
+	xRange.pxCombine = NULL;
+	xRange.pvParameters = pvParameters;
+	xRange.pvResult = NULL;
+	xRange.xResultSize = 0;
+
+	prvRunRange( xPool, &xRange, ulBegin );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPoolParallelReduce( TaskPoolHandle_t xPool, uint32_t ulBegin, uint32_t ulEnd, uint32_t ulGrain, TaskPoolReduceFunction_t pxReduce, TaskPoolCombineFunction_t pxCombine, void * const pvParameters, void * const pvResult, size_t xResultSize )
+{
+TaskPoolRange_t xRange;
+
+	configASSERT( xPool );
+	configASSERT( pxReduce );
+	configASSERT( pxCombine );
+	configASSERT( pvResult );
+	configASSERT( ulGrain > ( uint32_t ) 0 );
+	configASSERT( ( xResultSize > ( size_t ) 0 ) && ( xResultSize <= taskpoolMAX_RESULT_SIZE ) );
+
+	xRange.ulEnd = ulEnd;
+	xRange.ulGrain = ulGrain;
+	xRange.pxFor = NULL;
+	xRange.pxReduce = pxReduce;
+	xRange.pxCombine = pxCombine;
+	xRange.pvParameters = pvParameters;
+	xRange.pvResult = pvResult;
+	xRange.xResultSize = xResultSize;
+
+	/* Each partial result starts from a copy of the identity, which has to be
+	kept as *pvResult is combined into while other tasks are still starting. */
+	( void ) memcpy( ( void * ) xRange.ullIdentity, pvResult, xResultSize );
+
+	prvRunRange( xPool, &xRange, ulBegin );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTaskPoolGetWorkers( TaskPoolHandle_t xPool )
+{
+const TaskPool_t *pxPool = xPool;
+
+	configASSERT( pxPool );
+	return pxPool->uxWorkers;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPoolDelete( TaskPoolHandle_t xPool )
+{
+TaskPool_t *pxPool = xPool;
+uint32_t ulNotificationsTaken = 0UL;
+
+	configASSERT( pxPool );
+	configASSERT( prvGetCallingWorker( pxPool ) == NULL );
+
+	/* A job still queued would never run. */
+	configASSERT( ( int32_t ) pxPool->ulJobsQueued <= ( int32_t ) 0 );
+
+	/* Every worker claims one more job, finds the pool stopping instead, and
+	the last of them to stop notifies this task. */
+	pxPool->xDeletingTask = xTaskGetCurrentTaskHandle();
+	pxPool->xStopping = pdTRUE;
+	prvPostJobs( pxPool, pxPool->ulWorkersRunning );
+
+	/* A notification given to this task for something else can wake it
+	first, so only the count of running workers reaching zero ends the wait.
+	As in xTaskPoolWait(), the notifications are taken one at a time, the
+	last worker's is made sure of, and the rest are given back. */
+	while( pxPool->ulWorkersRunning > ( uint32_t ) 0 )
+	{
+		if( ulTaskNotifyTake( pdFALSE, portMAX_DELAY ) != ( uint32_t ) 0 )
+		{
+			ulNotificationsTaken++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	while( ulNotificationsTaken == 0UL )
+	{
+		if( ulTaskNotifyTake( pdFALSE, portMAX_DELAY ) != ( uint32_t ) 0 )
+		{
+			ulNotificationsTaken++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	ulNotificationsTaken--;
+
+	while( ulNotificationsTaken > 0UL )
+	{
+		( void ) xTaskNotifyGive( pxPool->xDeletingTask );
+		ulNotificationsTaken--;
+	}
+
+	vSemaphoreDelete( pxPool->xJobsSemaphore );
+	vQueueDelete( pxPool->xSharedQueue );
+	vPortFree( pxPool );
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvWorkerTask, pvParameters )
+{
+TaskPoolWorker_t * const pxWorker = ( TaskPoolWorker_t * ) pvParameters;
+TaskPool_t * const pxPool = pxWorker->pxPool;
+TaskHandle_t xDeletingTask;
+
+	for( ;; )
+	{
+		( void ) prvClaimJob( pxPool, pdTRUE );
+
+		if( pxPool->xStopping != pdFALSE )
+		{
+			break;
+		}
+
+		prvRunJob( prvFindJob( pxPool, pxWorker ) );
+	}
+
+	/* The pool is freed as soon as the last worker has stopped, so nothing
+	in it can be read after the count reaches zero. */
+	xDeletingTask = pxPool->xDeletingTask;
+
+	if( Atomic_Decrement_u32( &( pxPool->ulWorkersRunning ) ) == ( uint32_t ) 1 )
+	{
+		( void ) xTaskNotifyGive( xDeletingTask );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPostJobs( TaskPool_t * const pxPool, const uint32_t ulCount )
+{
+int32_t lBefore;
+uint32_t ulWake;
+
+	lBefore = ( int32_t ) Atomic_Add_u32( &( pxPool->ulJobsQueued ), ulCount );
+
+	if( lBefore < ( int32_t ) 0 )
+	{
+		/* -lBefore workers are blocked, or about to block, on the semaphore.
+		Wake one for each new job. */
+		ulWake = ( uint32_t ) -lBefore;
+
+		if( ulWake > ulCount )
+		{
+			ulWake = ulCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		while( ulWake > ( uint32_t ) 0 )
+		{
+			( void ) xSemaphoreGive( pxPool->xJobsSemaphore );
+			ulWake--;
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvClaimJob( TaskPool_t * const pxPool, const BaseType_t xBlock )
+{
+uint32_t ulQueued;
+BaseType_t xReturn = pdFALSE, xFinished = pdFALSE;
+
+	if( xBlock != pdFALSE )
+	{
+		if( ( int32_t ) Atomic_Decrement_u32( &( pxPool->ulJobsQueued ) ) <= ( int32_t ) 0 )
+		{
+			/* There was no job to claim, but the decrement stands - the
+			semaphore is given when the job this worker is now owed is
+			queued. */
+			( void ) xSemaphoreTake( pxPool->xJobsSemaphore, portMAX_DELAY );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		while( xFinished == pdFALSE )
+		{
+			ulQueued = pxPool->ulJobsQueued;
+
+			if( ( int32_t ) ulQueued <= ( int32_t ) 0 )
+			{
+				xFinished = pdTRUE;
+			}
+			else if( Atomic_CompareAndSwap_u32( &( pxPool->ulJobsQueued ), ulQueued - ( uint32_t ) 1, ulQueued ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+			{
+				xReturn = pdTRUE;
+				xFinished = pdTRUE;
+			}
+			else
+			{
+				/* Another task claimed or queued a job, try again. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static TaskPoolJob_t *prvFindJob( TaskPool_t * const pxPool, TaskPoolWorker_t * const pxSelf )
+{
+TaskPoolJob_t *pxJob = NULL;
+UBaseType_t uxFirstVictim, x;
+
+	if( pxSelf != NULL )
+	{
+		/* Start stealing from the next worker along, so the workers spread
+		out over the deques they steal from. */
+		uxFirstVictim = ( UBaseType_t ) ( pxSelf - pxPool->pxWorkers ) + ( UBaseType_t ) 1;
+	}
+	else
+	{
+		uxFirstVictim = 0;
+	}
+
+	/* A job was claimed, so there is a job queued that no other task has
+	claimed.  It may only be missed when a steal loses a race for a job to
+	another task, which then leaves a different job to find. */
+	while( pxJob == NULL )
+	{
+		if( pxSelf != NULL )
+		{
+			pxJob = prvPopBottom( pxSelf );
+		}
+
+		if( pxJob == NULL )
+		{
+			if( xQueueReceive( pxPool->xSharedQueue, &pxJob, ( TickType_t ) 0 ) == pdFAIL )
+			{
+				pxJob = NULL;
+			}
+		}
+
+		for( x = ( UBaseType_t ) 0; ( x < pxPool->uxWorkers ) && ( pxJob == NULL ); x++ )
+		{
+			pxJob = prvStealTop( &( pxPool->pxWorkers[ ( uxFirstVictim + x ) % pxPool->uxWorkers ] ) );
+		}
+
+		if( pxJob == NULL )
+		{
+			/* Let the task whose push or steal got in the way finish. */
+			taskYIELD();
+		}
+	}
+
+	return pxJob;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvQueueJob( TaskPool_t * const pxPool, TaskPoolWorker_t * const pxSelf, TaskPoolJob_t * const pxJob, const TickType_t xTicksToWait )
+{
+BaseType_t xReturn;
+
+	if( ( pxSelf != NULL ) && ( prvPushBottom( pxSelf, pxJob ) != pdFALSE ) )
+	{
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = xQueueSend( pxPool->xSharedQueue, &pxJob, xTicksToWait );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunJob( TaskPoolJob_t * const pxJob )
+{
+void *pvWaiter;
+
+	pxJob->pxFunction( pxJob->pvParameters );
+
+	if( Atomic_Decrement_u32( &( pxJob->ulRunsLeft ) ) == ( uint32_t ) 1 )
+	{
+		/* That was the last run.  Once the job is marked done the task that
+		owns it may reuse it, so it is not touched again. */
+		pvWaiter = Atomic_SwapPointers_p32( &( pxJob->pvWaiter ), taskpoolJOB_DONE( pxJob ) );
+
+		if( pvWaiter != NULL )
+		{
+			( void ) xTaskNotifyGive( ( TaskHandle_t ) pvWaiter );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TaskPoolWorker_t *prvGetCallingWorker( TaskPool_t * const pxPool )
+{
+TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+TaskPoolWorker_t *pxReturn = NULL;
+UBaseType_t x;
+
+	for( x = ( UBaseType_t ) 0; x < pxPool->uxWorkers; x++ )
+	{
+		if( pxPool->pxWorkers[ x ].xTask == xCurrentTask )
+		{
+			pxReturn = &( pxPool->pxWorkers[ x ] );
+			break;
+		}
+	}
+
+	return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPushBottom( TaskPoolWorker_t * const pxWorker, TaskPoolJob_t * const pxJob )
+{
+const uint32_t ulMask = pxWorker->pxPool->ulDequeMask;
+const uint32_t ulBottom = pxWorker->ulBottom;
+BaseType_t xReturn;
+
+	if( ( ulBottom - pxWorker->ulTop ) > ulMask )
+	{
+		xReturn = pdFALSE;
+	}
+	else
+	{
+		pxWorker->ppxSlots[ ulBottom & ulMask ] = pxJob;
+
+		/* Publish the job, after the slot is written. */
+		( void ) Atomic_Increment_u32( &( pxWorker->ulBottom ) );
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static TaskPoolJob_t *prvPopBottom( TaskPoolWorker_t * const pxWorker )
+{
+uint32_t ulBottom, ulTop;
+int32_t lJobsLeft;
+TaskPoolJob_t *pxJob;
+
+	/* Take the bottom slot before looking at the top, so a thief reading
+	ulBottom from here on will not take the same job. */
+	ulBottom = Atomic_Decrement_u32( &( pxWorker->ulBottom ) ) - ( uint32_t ) 1;
+	ulTop = pxWorker->ulTop;
+	lJobsLeft = ( int32_t ) ( ulBottom - ulTop );
+
+	if( lJobsLeft < ( int32_t ) 0 )
+	{
+		/* Empty. */
+		( void ) Atomic_Increment_u32( &( pxWorker->ulBottom ) );
+		pxJob = NULL;
+	}
+	else
+	{
+		pxJob = pxWorker->ppxSlots[ ulBottom & pxWorker->pxPool->ulDequeMask ];
+
+		if( lJobsLeft == ( int32_t ) 0 )
+		{
+			/* The last job, which a thief may be taking too.  Whoever moves
+			the top on has it, and either way the deque is left empty. */
+			if( Atomic_CompareAndSwap_u32( &( pxWorker->ulTop ), ulTop + ( uint32_t ) 1, ulTop ) == ATOMIC_COMPARE_AND_SWAP_FAILURE )
+			{
+				pxJob = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			( void ) Atomic_Increment_u32( &( pxWorker->ulBottom ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return pxJob;
+}
+/*-----------------------------------------------------------*/
+
+static TaskPoolJob_t *prvStealTop( TaskPoolWorker_t * const pxWorker )
+{
+uint32_t ulTop, ulBottom;
+TaskPoolJob_t *pxJob = NULL;
+
+	ulTop = pxWorker->ulTop;
+
+	/* An atomic read of ulBottom, which cannot be made before the read of
+	ulTop. */
+	ulBottom = Atomic_OR_u32( &( pxWorker->ulBottom ), ( uint32_t ) 0 );
+
+	if( ( int32_t ) ( ulBottom - ulTop ) > ( int32_t ) 0 )
+	{
+		pxJob = pxWorker->ppxSlots[ ulTop & pxWorker->pxPool->ulDequeMask ];
+
+		if( Atomic_CompareAndSwap_u32( &( pxWorker->ulTop ), ulTop + ( uint32_t ) 1, ulTop ) == ATOMIC_COMPARE_AND_SWAP_FAILURE )
+		{
+			/* The worker or another thief took it first. */
+			pxJob = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxJob;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunRange( TaskPool_t * const pxPool, TaskPoolRange_t * const pxRange, const uint32_t ulBegin )
+{
+uint32_t ulChunks, ulHelpers, ulQueued = 0;
+TaskPoolJob_t * const pxJob = &( pxRange->xJob );
+TaskPoolWorker_t * const pxSelf = prvGetCallingWorker( pxPool );
+
+	if( ulBegin < pxRange->ulEnd )
+	{
+		pxRange->ulNext = ulBegin;
+		ulChunks = ( ( pxRange->ulEnd - ulBegin - ( uint32_t ) 1 ) / pxRange->ulGrain ) + ( uint32_t ) 1;
+
+		/* One helper job for each worker that can have a chunk, on top of
+		the run made by the calling task. */
+		ulHelpers = ulChunks - ( uint32_t ) 1;
+
+		if( ulHelpers > ( uint32_t ) pxPool->uxWorkers )
+		{
+			ulHelpers = ( uint32_t ) pxPool->uxWorkers;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxJob->pxFunction = prvRangeJob;
+		pxJob->pvParameters = pxRange;
+		pxJob->ulRunsLeft = ulHelpers + ( uint32_t ) 1;
+		pxJob->pvWaiter = NULL;
+
+		/* The same job is queued once for each helper.  A helper that does
+		not fit is left out - the chunks are shared by whoever turns up. */
+		while( ( ulQueued < ulHelpers ) && ( prvQueueJob( pxPool, pxSelf, pxJob, ( TickType_t ) 0 ) != pdFAIL ) )
+		{
+			ulQueued++;
+		}
+
+		if( ulQueued < ulHelpers )
+		{
+			( void ) Atomic_Subtract_u32( &( pxJob->ulRunsLeft ), ulHelpers - ulQueued );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		prvPostJobs( pxPool, ulQueued );
+
+		/* Take chunks alongside the helpers, then wait for any still running
+		theirs.  A helper that only runs once the chunks have run out returns
+		straight away. */
+		prvRunJob( pxJob );
+		( void ) xTaskPoolWait( pxPool, pxJob, portMAX_DELAY );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRangeJob( void *pvRange )
+{
+TaskPoolRange_t * const pxRange = ( TaskPoolRange_t * ) pvRange;
+uint64_t ullPartial[ taskpoolMAX_RESULT_SIZE / sizeof( uint64_t ) ];
+uint32_t ulFirst, ulEnd;
+BaseType_t xRanChunk = pdFALSE;
+
+	if( pxRange->pxReduce != NULL )
+	{
+		( void ) memcpy( ( void * ) ullPartial, ( void * ) pxRange->ullIdentity, pxRange->xResultSize );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	for( ;; )
+	{
+		/* Take the next chunk. */
+		ulFirst = pxRange->ulNext;
+
+		if( ulFirst >= pxRange->ulEnd )
+		{
+			break;
+		}
+
+		ulEnd = pxRange->ulEnd;
+
+		if( ( ulEnd - ulFirst ) > pxRange->ulGrain )
+		{
+			ulEnd = ulFirst + pxRange->ulGrain;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( Atomic_CompareAndSwap_u32( &( pxRange->ulNext ), ulEnd, ulFirst ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+		{
+			if( pxRange->pxReduce != NULL )
+			{
+				pxRange->pxReduce( ulFirst, ulEnd, pxRange->pvParameters, ( void * ) ullPartial );
+			}
+			else
+			{
+				pxRange->pxFor( ulFirst, ulEnd, pxRange->pvParameters );
+			}
+
+			xRanChunk = pdTRUE;
+		}
+		else
+		{
+			/* Another task took the chunk. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	if( ( pxRange->pxReduce != NULL ) && ( xRanChunk != pdFALSE ) )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxRange->pxCombine( pxRange->pvResult, ( const void * ) ullPartial, pxRange->pvParameters );
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
@@ -193,6 +193,44 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 /*-----------------------------------------------------------*/
 
+#if( configNUMBER_OF_CORES == 1 )
+
+	/* Should the scheduler switch to pxTCB, a task that has just become ready?
+	With one core it only has to be compared with the running task.  The
+	_EQUAL form also switches to a task of the running task's priority. */
+	#define taskYIELD_REQUIRED_FOR( pxTCB )			( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+	#define taskYIELD_REQUIRED_FOR_EQUAL( pxTCB )	( ( pxTCB )->uxPriority >= pxCurrentTCB->uxPriority )
+
+	#define taskTASK_IS_RUNNING( pxTCB )			( ( pxTCB ) == pxCurrentTCB )
+
+	#define taskSCHEDULER_IS_SUSPENDED()			( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+
+#else
+
+	/* With more than one core prvYieldForTask() looks for the core running the
+	lowest priority task that pxTCB can preempt.  It interrupts that core if it
+	is not the calling one, and only returns pdTRUE if it is.  Equal priority
+	tasks share the cores through time slicing, so both forms are the same. */
+	#define taskYIELD_REQUIRED_FOR( pxTCB )			( prvYieldForTask( pxTCB ) != pdFALSE )
+	#define taskYIELD_REQUIRED_FOR_EQUAL( pxTCB )	( prvYieldForTask( pxTCB ) != pdFALSE )
+
+	/* A running task's xTaskRunState holds the number of its core. */
+	#define taskTASK_NOT_RUNNING					( ( BaseType_t ) -1 )
+	#define taskTASK_IS_RUNNING( pxTCB )			( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING )
+
+	/* Only usable where the calling task cannot move to another core. */
+	#define taskSCHEDULER_IS_SUSPENDED()			( prvSchedulerSuspendedOnThisCore() )
+
+	#if( configUSE_CORE_AFFINITY == 1 )
+		#define taskCORE_IS_ALLOWED( pxTCB, xCoreID )	( ( ( pxTCB )->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( xCoreID ) ) ) != ( UBaseType_t ) 0U )
+	#else
+		#define taskCORE_IS_ALLOWED( pxTCB, xCoreID )	( pdTRUE )
+	#endif
+
+#endif /* configNUMBER_OF_CORES */
+
+/*-----------------------------------------------------------*/
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
 count overflows. */
 #define taskSWITCH_DELAYED_LISTS()																	\
@@ -211,6 +249,34 @@ count overflows. */
 
 /*-----------------------------------------------------------*/
 
+/*
+ * Place the task represented by pxTCB, whose state list item value has been
+ * set to its wake time, into a delayed list.  pxList is the delayed list the
+ * task would be placed in without the timing wheel.
+ */
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	#define prvAddTaskToDelayedList( pxList, pxTCB )														\
+	{																										\
+		const TickType_t xWheelSlot = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) ) & taskWHEEL_MASK;	\
+																											\
+		vListInsertEnd( &( xDelayedTaskWheel[ xWheelSlot ] ), &( ( pxTCB )->xStateListItem ) );			\
+		ulDelayedTaskWheelMap[ xWheelSlot >> 5 ] |= ( 1UL << ( xWheelSlot & 31 ) );						\
+	}
+
+	/* Is pxList one of the slots of the timing wheel? */
+	#define taskIS_TIMING_WHEEL_SLOT( pxList )	( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ] ) ) && ( ( pxList ) <= &( xDelayedTaskWheel[ configTIMING_WHEEL_SLOTS - 1 ] ) ) ) /*lint !e946 Compares pointers into the same array. */
+
+#else
+
+	#define prvAddTaskToDelayedList( pxList, pxTCB )	vListInsert( ( pxList ), &( ( pxTCB )->xStateListItem ) )
+
+	#define taskIS_TIMING_WHEEL_SLOT( pxList )	( pdFALSE )
+
+#endif /* configUSE_TIMING_WHEEL */
+
+/*-----------------------------------------------------------*/
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
@@ -228,7 +294,13 @@ count overflows. */
  * task should be used in place of the parameter.  This macro simply checks to
  * see if the parameter is NULL and returns a pointer to the appropriate TCB.
  */
-#define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? pxCurrentTCB : ( pxHandle ) )
+#if( configNUMBER_OF_CORES == 1 )
+	#define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? pxCurrentTCB : ( pxHandle ) )
+#else
+	/* The calling task can be moved to another core at any time outside a
+	critical section, so its TCB is looked up with interrupts masked. */
+	#define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? ( TCB_t * ) xTaskGetCurrentTaskHandle() : ( pxHandle ) )
+#endif
 
 /* The item value of the event list item is normally used to hold the priority
 of the task to which it belongs (coded to allow it to be held in reverse
@@ -290,7 +362,10 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 	#endif
 
 	#if( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE	ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		uint32_t		ulSwitchInCount;	/*< The number of times the task has been switched in. */
+		struct tskTaskControlBlock *pxNextRunTimeTCB;		/*< Chains every task for uxTaskGetRunTimeSnapshot(). */
+		struct tskTaskControlBlock *pxPreviousRunTimeTCB;
 	#endif
 
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -326,6 +401,13 @@ typedef struct tskTaskControlBlock 			/* The old naming convention is used to pr
 		int iTaskErrno;
 	#endif
 
+	#if( configNUMBER_OF_CORES > 1 )
+		volatile BaseType_t xTaskRunState;	/*< The core the task is running on, or taskTASK_NOT_RUNNING. */
+		#if( configUSE_CORE_AFFINITY == 1 )
+			UBaseType_t	uxCoreAffinityMask;	/*< Bit n is set if the task can run on core n. */
+		#endif
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -334,7 +416,15 @@ typedef tskTCB TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
-PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if( configNUMBER_OF_CORES == 1 )
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#else
+	/* The task running on each core.  pxCurrentTCB is the calling core's, so
+	is only used where the calling task cannot move to another core - in a
+	critical section, an interrupt or with the scheduler suspended. */
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ] = { NULL };
+	#define pxCurrentTCB	pxCurrentTCBs[ portGET_CORE_ID() ]
+#endif
 
 /* Lists for ready and blocked tasks. --------------------
 xDelayedTaskList1 and xDelayedTaskList2 could be move to function scople but
@@ -360,6 +450,29 @@ PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been r
 
 #endif
 
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	/* When the timing wheel is used, delayed tasks are not kept in wake time
+	order in xDelayedTaskList1/2.  Instead each task is appended to the slot
+	selected by the low bits of its wake time, so blocking with a timeout is
+	O(1) however many tasks are already delayed, and the tick only looks at
+	the one slot that matches the new tick count.  A slot can also hold tasks
+	that wake on a later turn of the wheel - those keep their exact wake time
+	as their list item value and are left where they are until it matches.
+
+	A set bit in ulDelayedTaskWheelMap means the slot might not be empty.  Bits
+	are set when a task is added, but are only cleared when the slot is next
+	looked at and found to be empty, so tasks can leave a slot from anywhere
+	(an event, a delete, a suspend, an abort) without the bitmap being
+	touched. */
+	#define taskWHEEL_MASK			( ( TickType_t ) configTIMING_WHEEL_SLOTS - ( TickType_t ) 1 )
+	#define taskWHEEL_MAP_WORDS		( configTIMING_WHEEL_SLOTS / 32 )
+
+	PRIVILEGED_DATA static List_t xDelayedTaskWheel[ configTIMING_WHEEL_SLOTS ];	/*< Delayed tasks, hashed on their wake time. */
+	PRIVILEGED_DATA static uint32_t ulDelayedTaskWheelMap[ taskWHEEL_MAP_WORDS ];	/*< One bit per slot of xDelayedTaskWheel that may hold tasks. */
+
+#endif
+
 /* Global POSIX errno. Its value is changed upon context switching to match
 the errno of the currently running task. */
 #if ( configUSE_POSIX_ERRNO == 1 )
@@ -372,11 +485,9 @@ PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) confi
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks 			= ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
 
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
@@ -386,14 +497,39 @@ moves the task's event list item into the xPendingReadyList, ready for the
 kernel to move the task from the pending ready list into the real ready list
 when the scheduler is unsuspended.  The pending ready list itself can only be
 accessed from a critical section. */
-PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t ) pdFALSE;
+#if( configNUMBER_OF_CORES == 1 )
+	PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t ) pdFALSE;
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
+	PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#else
+	/* Each core has its own suspension count and pending yield, and its own
+	idle task.  Suspending the scheduler also takes the kernel lock, so the
+	scheduler is never suspended on more than one core at a time, and the
+	other cores wait for it to be resumed before they next enter the
+	kernel. */
+	PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspendeds[ configNUMBER_OF_CORES ] = { ( UBaseType_t ) pdFALSE };
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE };
+	PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ] = { NULL };
+	#define uxSchedulerSuspended	uxSchedulerSuspendeds[ portGET_CORE_ID() ]
+	#define xYieldPending			xYieldPendings[ portGET_CORE_ID() ]
+
+	/* The API functions that return the idle task return core 0's. */
+	#define xIdleTaskHandle			xIdleTaskHandles[ 0 ]
+#endif
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	/* Do not move these variables to function scope as doing so prevents the
 	code working with debuggers that need to remove the static qualifier. */
-	PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-	PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+	#if( configNUMBER_OF_CORES == 1 )
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	#else
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTimes[ configNUMBER_OF_CORES ] = { 0UL };
+		#define ulTaskSwitchedInTime	ulTaskSwitchedInTimes[ portGET_CORE_ID() ]
+	#endif
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+	PRIVILEGED_DATA static uint32_t ulTaskSwitchCount = 0UL;	/*< Context switches on all cores, counted by vTaskSwitchContext(), which holds the kernel lock when there is more than one core. */
+	PRIVILEGED_DATA static TCB_t *pxRunTimeTCBs = NULL;			/*< The first task in the chain walked by uxTaskGetRunTimeSnapshot(). */
 
 #endif
 
@@ -492,6 +628,17 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
 
 #endif
 
+/*
+ * Return the run time of pxTCB as at ulTimeNow - its run time counter, plus
+ * the time since it was switched in if it is running.  Called from a critical
+ * section.
+ */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static configRUN_TIME_COUNTER_TYPE prvGetRunTimeAt( const TCB_t * const pxTCB, const configRUN_TIME_COUNTER_TYPE ulTimeNow ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Searches pxList for a task with name pcNameToQuery - returning a handle to
  * the task if it is found, or NULL if the task is not found.
@@ -534,6 +681,17 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	/*
+	 * Unblock the tasks in the timing wheel slot for xConstTickCount whose
+	 * wake time is xConstTickCount.  Returns pdTRUE if one of them should
+	 * preempt the running task.
+	 */
+	static BaseType_t prvUnblockTimingWheelSlot( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -563,6 +721,43 @@ static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
+#if( configNUMBER_OF_CORES > 1 )
+
+	/*
+	 * Make xCoreID select its task again.  If it is not the calling core it is
+	 * interrupted.  Called with the kernel lock held.
+	 */
+	static void prvYieldCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * pxTCB has just become ready.  Find the core running the lowest priority
+	 * task it is allowed to preempt, preferring the calling core, and make that
+	 * core select its task again.  Returns pdTRUE if that is the calling core,
+	 * in which case the caller yields as it would with one core.  Called with
+	 * the kernel lock held.
+	 */
+	static BaseType_t prvYieldForTask( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * If pxTCB is running on a core other than the calling one, make that core
+	 * select its task again - used when pxTCB is deleted, suspended or lowered
+	 * in priority.  Called with the kernel lock held.
+	 */
+	static void prvYieldTaskCore( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Select the highest priority ready task that is not running on another
+	 * core, and that is allowed to run on xCoreID, to run on xCoreID.
+	 */
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns pdTRUE if the scheduler is suspended on the calling core.
+	 */
+	static BaseType_t prvSchedulerSuspendedOnThisCore( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -964,9 +1159,23 @@ UBaseType_t x;
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 	{
 		pxNewTCB->ulRunTimeCounter = 0UL;
+		pxNewTCB->ulSwitchInCount = 0UL;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+
+		#if ( configUSE_CORE_AFFINITY == 1 )
+		{
+			/* New tasks can run on any core. */
+			pxNewTCB->uxCoreAffinityMask = ~( UBaseType_t ) 0U;
+		}
+		#endif
+	}
+	#endif /* configNUMBER_OF_CORES */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -1081,6 +1290,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	taskENTER_CRITICAL();
 	{
 		uxCurrentNumberOfTasks++;
+
+		#if( configNUMBER_OF_CORES > 1 )
+		{
+			/* The task each core runs first is selected when the scheduler
+			starts. */
+			if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+			{
+				prvInitialiseTaskLists();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
 		if( pxCurrentTCB == NULL )
 		{
 			/* There are no other tasks, or all the other tasks are in
@@ -1120,6 +1344,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#endif /* configNUMBER_OF_CORES */
 
 		uxTaskNumber++;
 
@@ -1129,31 +1354,53 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			pxNewTCB->uxTCBNumber = uxTaskNumber;
 		}
 		#endif /* configUSE_TRACE_FACILITY */
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			/* Chain the task in whichever state list it is going to be on, so
+			uxTaskGetRunTimeSnapshot() can find it without walking them all. */
+			pxNewTCB->pxPreviousRunTimeTCB = NULL;
+			pxNewTCB->pxNextRunTimeTCB = pxRunTimeTCBs;
+
+			if( pxRunTimeTCBs != NULL )
+			{
+				pxRunTimeTCBs->pxPreviousRunTimeTCB = pxNewTCB;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxRunTimeTCBs = pxNewTCB;
+		}
+		#endif /* configGENERATE_RUN_TIME_STATS */
 		traceTASK_CREATE( pxNewTCB );
 
 		prvAddTaskToReadyList( pxNewTCB );
 
 		portSETUP_TCB( pxNewTCB );
-	}
-	taskEXIT_CRITICAL();
 
-	if( xSchedulerRunning != pdFALSE )
-	{
-		/* If the created task is of a higher priority than the current task
-		then it should run now. */
-		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		if( xSchedulerRunning != pdFALSE )
 		{
-			taskYIELD_IF_USING_PREEMPTION();
+			/* If the created task is of a higher priority than the current
+			task then it should run now.  The yield is held pending until the
+			critical section is exited.  With more than one core the check
+			must be made before another core can change which task it runs. */
+			if( taskYIELD_REQUIRED_FOR( pxNewTCB ) )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+	taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
 
@@ -1189,13 +1436,37 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			{
+				/* A deleted task drops out of the run time snapshots at once,
+				even if it is deleting itself and so is still running. */
+				if( pxTCB->pxPreviousRunTimeTCB != NULL )
+				{
+					pxTCB->pxPreviousRunTimeTCB->pxNextRunTimeTCB = pxTCB->pxNextRunTimeTCB;
+				}
+				else
+				{
+					pxRunTimeTCBs = pxTCB->pxNextRunTimeTCB;
+				}
+
+				if( pxTCB->pxNextRunTimeTCB != NULL )
+				{
+					pxTCB->pxNextRunTimeTCB->pxPreviousRunTimeTCB = pxTCB->pxPreviousRunTimeTCB;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configGENERATE_RUN_TIME_STATS */
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
 			not return. */
 			uxTaskNumber++;
 
-			if( pxTCB == pxCurrentTCB )
+			if( taskTASK_IS_RUNNING( pxTCB ) )
 			{
 				/* A task is deleting itself.  This cannot complete within the
 				task itself, as a context switch to another task is required.
@@ -1219,6 +1490,15 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				hence xYieldPending is used to latch that a context switch is
 				required. */
 				portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+
+				#if( configNUMBER_OF_CORES > 1 )
+				{
+					/* Or a task is deleting a task that is running on another
+					core, which is freed once that core has switched away from
+					it. */
+					prvYieldTaskCore( pxTCB );
+				}
+				#endif
 			}
 			else
 			{
@@ -1237,9 +1517,9 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		been deleted. */
 		if( xSchedulerRunning != pdFALSE )
 		{
-			if( pxTCB == pxCurrentTCB )
+			if( pxTCB == prvGetTCBFromHandle( NULL ) )
 			{
-				configASSERT( uxSchedulerSuspended == 0 );
+				configASSERT( taskSCHEDULER_IS_SUSPENDED() == pdFALSE );
 				portYIELD_WITHIN_API();
 			}
 			else
@@ -1261,7 +1541,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		configASSERT( pxPreviousWakeTime );
 		configASSERT( ( xTimeIncrement > 0U ) );
-		configASSERT( uxSchedulerSuspended == 0 );
+		configASSERT( taskSCHEDULER_IS_SUSPENDED() == pdFALSE );
 
 		vTaskSuspendAll();
 		{
@@ -1345,7 +1625,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		/* A delay time of zero just forces a reschedule. */
 		if( xTicksToDelay > ( TickType_t ) 0U )
 		{
-			configASSERT( uxSchedulerSuspended == 0 );
+			configASSERT( taskSCHEDULER_IS_SUSPENDED() == pdFALSE );
 			vTaskSuspendAll();
 			{
 				traceTASK_DELAY();
@@ -1391,7 +1671,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		configASSERT( pxTCB );
 
-		if( pxTCB == pxCurrentTCB )
+		if( taskTASK_IS_RUNNING( pxTCB ) )
 		{
 			/* The task calling this function is querying its own state. */
 			eReturn = eRunning;
@@ -1406,7 +1686,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+			if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) || ( taskIS_TIMING_WHEEL_SLOT( pxStateList ) ) )
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1576,7 +1856,9 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			if( uxCurrentBasePriority != uxNewPriority )
 			{
 				/* The priority change may have readied a task of higher
-				priority than the calling task. */
+				priority than the calling task.  With more than one core this
+				is decided below, once the task is in its new ready list. */
+				#if( configNUMBER_OF_CORES == 1 )
 				if( uxNewPriority > uxCurrentBasePriority )
 				{
 					if( pxTCB != pxCurrentTCB )
@@ -1613,6 +1895,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					require a yield as the running task must be above the
 					new priority of the task being modified. */
 				}
+				#endif /* configNUMBER_OF_CORES */
 
 				/* Remember the ready list the task might be referenced from
 				before its uxPriority member is changed so the
@@ -1679,6 +1962,41 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					mtCOVERAGE_TEST_MARKER();
 				}
 
+				#if( configNUMBER_OF_CORES > 1 )
+				{
+					if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
+					{
+						/* A ready task that is raised might now preempt the
+						task running on one of the cores. */
+						if( ( uxNewPriority > uxCurrentBasePriority ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+						{
+							xYieldRequired = taskYIELD_REQUIRED_FOR( pxTCB );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else if( uxNewPriority < uxCurrentBasePriority )
+					{
+						/* A running task that is lowered might no longer be
+						the task its core should run. */
+						if( pxTCB->xTaskRunState == portGET_CORE_ID() )
+						{
+							xYieldRequired = pdTRUE;
+						}
+						else
+						{
+							prvYieldTaskCore( pxTCB );
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configNUMBER_OF_CORES */
+
 				if( xYieldRequired != pdFALSE )
 				{
 					taskYIELD_IF_USING_PREEMPTION();
@@ -1746,6 +2064,13 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				}
 			}
 			#endif
+
+			#if( configNUMBER_OF_CORES > 1 )
+			{
+				/* The task might be running on another core. */
+				prvYieldTaskCore( pxTCB );
+			}
+			#endif
 		}
 		taskEXIT_CRITICAL();
 
@@ -1764,12 +2089,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		if( pxTCB == pxCurrentTCB )
+		if( pxTCB == prvGetTCBFromHandle( NULL ) )
 		{
 			if( xSchedulerRunning != pdFALSE )
 			{
 				/* The current task has just been suspended. */
-				configASSERT( uxSchedulerSuspended == 0 );
+				configASSERT( taskSCHEDULER_IS_SUSPENDED() == pdFALSE );
 				portYIELD_WITHIN_API();
 			}
 			else
@@ -1857,7 +2182,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		/* The parameter cannot be NULL as it is impossible to resume the
 		currently executing task. */
-		if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != NULL ) )
+		if( ( pxTCB != prvGetTCBFromHandle( NULL ) ) && ( pxTCB != NULL ) )
 		{
 			taskENTER_CRITICAL();
 			{
@@ -1871,7 +2196,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					prvAddTaskToReadyList( pxTCB );
 
 					/* A higher priority task may have just been resumed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskYIELD_REQUIRED_FOR_EQUAL( pxTCB ) )
 					{
 						/* This yield may not cause the task just resumed to run,
 						but will leave the lists in the correct state for the
@@ -1939,7 +2264,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskYIELD_REQUIRED_FOR_EQUAL( pxTCB ) )
 					{
 						xYieldRequired = pdTRUE;
 					}
@@ -1977,7 +2302,7 @@ void vTaskStartScheduler( void )
 BaseType_t xReturn;
 
 	/* Add the idle task at the lowest priority. */
-	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
 	{
 		StaticTask_t *pxIdleTaskTCBBuffer = NULL;
 		StackType_t *pxIdleTaskStackBuffer = NULL;
@@ -2003,7 +2328,7 @@ BaseType_t xReturn;
 			xReturn = pdFAIL;
 		}
 	}
-	#else
+	#elif( configNUMBER_OF_CORES == 1 )
 	{
 		/* The Idle task is being created using dynamically allocated RAM. */
 		xReturn = xTaskCreate(	prvIdleTask,
@@ -2013,6 +2338,25 @@ BaseType_t xReturn;
 								portPRIVILEGE_BIT, /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
 								&xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
 	}
+	#else
+	{
+	BaseType_t xCoreID;
+
+		/* Every core must always have a task it can run, so there is one idle
+		task per core.  They are not tied to their cores - the idle tasks
+		time slice with each other like any other tasks of equal priority. */
+		xReturn = pdPASS;
+
+		for( xCoreID = 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+		{
+			xReturn = xTaskCreate(	prvIdleTask,
+									configIDLE_TASK_NAME,
+									configMINIMAL_STACK_SIZE,
+									( void * ) NULL,
+									portPRIVILEGE_BIT,
+									&( xIdleTaskHandles[ xCoreID ] ) );
+		}
+	}
 	#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 	#if ( configUSE_TIMERS == 1 )
@@ -2046,6 +2390,19 @@ BaseType_t xReturn;
 		starts to run. */
 		portDISABLE_INTERRUPTS();
 
+		#if( configNUMBER_OF_CORES > 1 )
+		{
+		BaseType_t xCoreID;
+
+			/* Choose the first task for every core.  Each core takes the
+			highest priority task the cores before it have not taken. */
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				prvSelectHighestPriorityTask( xCoreID );
+			}
+		}
+		#endif /* configNUMBER_OF_CORES */
+
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		{
 			/* Switch Newlib's _impure_ptr variable to point to the _reent
@@ -2114,17 +2471,35 @@ void vTaskSuspendAll( void )
 	post in the FreeRTOS support forum before reporting this as a bug! -
 	http://goo.gl/wu4acr */
 
-	/* portSOFRWARE_BARRIER() is only implemented for emulated/simulated ports that
-	do not otherwise exhibit real time behaviour. */
-	portSOFTWARE_BARRIER();
+	#if( configNUMBER_OF_CORES == 1 )
+	{
+		/* portSOFRWARE_BARRIER() is only implemented for emulated/simulated ports that
+		do not otherwise exhibit real time behaviour. */
+		portSOFTWARE_BARRIER();
 
-	/* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
-	is used to allow calls to vTaskSuspendAll() to nest. */
-	++uxSchedulerSuspended;
+		/* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
+		is used to allow calls to vTaskSuspendAll() to nest. */
+		++uxSchedulerSuspended;
 
-	/* Enforces ordering for ports and optimised compilers that may otherwise place
-	the above increment elsewhere. */
-	portMEMORY_BARRIER();
+		/* Enforces ordering for ports and optimised compilers that may otherwise place
+		the above increment elsewhere. */
+		portMEMORY_BARRIER();
+	}
+	#else
+	{
+		/* With more than one core the count alone would not stop the other
+		cores changing the lists, so the kernel lock is held for as long as
+		the scheduler is suspended.  The critical section stops the calling
+		task moving to another core between finding its count and updating
+		it. */
+		taskENTER_CRITICAL();
+		{
+			portGET_KERNEL_LOCK();
+			++uxSchedulerSuspended;
+		}
+		taskEXIT_CRITICAL();
+	}
+	#endif /* configNUMBER_OF_CORES */
 }
 /*----------------------------------------------------------*/
 
@@ -2209,6 +2584,14 @@ BaseType_t xAlreadyYielded = pdFALSE;
 	{
 		--uxSchedulerSuspended;
 
+		#if( configNUMBER_OF_CORES > 1 )
+		{
+			/* Drop the hold vTaskSuspendAll() took - the critical section
+			still holds the lock. */
+			portRELEASE_KERNEL_LOCK();
+		}
+		#endif
+
 		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 		{
 			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
@@ -2224,7 +2607,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 					/* If the moved task has a priority higher than the current
 					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskYIELD_REQUIRED_FOR_EQUAL( pxTCB ) )
 					{
 						xYieldPending = pdTRUE;
 					}
@@ -2234,16 +2617,20 @@ BaseType_t xAlreadyYielded = pdFALSE;
 					}
 				}
 
-				if( pxTCB != NULL )
+				#if( configUSE_TIMING_WHEEL == 0 )
 				{
-					/* A task was unblocked while the scheduler was suspended,
-					which may have prevented the next unblock time from being
-					re-calculated, in which case re-calculate it now.  Mainly
-					important for low power tickless implementations, where
-					this can prevent an unnecessary exit from low power
-					state. */
-					prvResetNextTaskUnblockTime();
+					if( pxTCB != NULL )
+					{
+						/* A task was unblocked while the scheduler was suspended,
+						which may have prevented the next unblock time from being
+						re-calculated, in which case re-calculate it now.  Mainly
+						important for low power tickless implementations, where
+						this can prevent an unnecessary exit from low power
+						state. */
+						prvResetNextTaskUnblockTime();
+					}
 				}
+				#endif /* configUSE_TIMING_WHEEL */
 
 				/* If any ticks occurred while the scheduler was suspended then
 				they should be processed now.  This ensures the tick count does
@@ -2472,6 +2859,15 @@ TCB_t *pxTCB;
 				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
 			}
 
+			#if( configUSE_TIMING_WHEEL == 1 )
+			{
+				for( uxQueue = ( UBaseType_t ) 0U; ( uxQueue < ( UBaseType_t ) configTIMING_WHEEL_SLOTS ) && ( pxTCB == NULL ); uxQueue++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel[ uxQueue ] ), pcNameToQuery );
+				}
+			}
+			#endif
+
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
 				if( pxTCB == NULL )
@@ -2502,7 +2898,7 @@ TCB_t *pxTCB;
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime )
+	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
 	{
 	UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
 
@@ -2525,6 +2921,15 @@ TCB_t *pxTCB;
 				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
 				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
 
+				#if( configUSE_TIMING_WHEEL == 1 )
+				{
+					for( uxQueue = ( UBaseType_t ) 0U; uxQueue < ( UBaseType_t ) configTIMING_WHEEL_SLOTS; uxQueue++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxQueue ] ), eBlocked );
+					}
+				}
+				#endif
+
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
 					/* Fill in an TaskStatus_t structure with information on
@@ -2574,45 +2979,185 @@ TCB_t *pxTCB;
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-	TaskHandle_t xTaskGetIdleTaskHandle( void )
+	UBaseType_t uxTaskGetRunTimeSnapshot( TaskRunTime_t * const pxTaskArray, const UBaseType_t uxArraySize, RunTimeSnapshot_t * const pxSnapshot )
 	{
-		/* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-		started, then xIdleTaskHandle will be NULL. */
-		configASSERT( ( xIdleTaskHandle != NULL ) );
-		return xIdleTaskHandle;
-	}
+	UBaseType_t uxTask = 0;
+	const TCB_t *pxTCB;
+	configRUN_TIME_COUNTER_TYPE ulTimeNow, ulIdleRunTime = 0UL;
 
-#endif /* INCLUDE_xTaskGetIdleTaskHandle */
-/*----------------------------------------------------------*/
+		configASSERT( pxSnapshot );
+		configASSERT( ( pxTaskArray != NULL ) || ( uxArraySize == ( UBaseType_t ) 0U ) );
 
-/* This conditional compilation should use inequality to 0, not equality to 1.
-This is to ensure vTaskStepTick() is available when user defined low power mode
-implementations require configUSE_TICKLESS_IDLE to be set to a value other than
-1. */
-#if ( configUSE_TICKLESS_IDLE != 0 )
+		/* The counters are only written by vTaskSwitchContext(), which cannot
+		run on any core while this core is in a critical section, so they
+		are all read as at the same moment. */
+		taskENTER_CRITICAL();
+		{
+			#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+				portALT_GET_RUN_TIME_COUNTER_VALUE( ulTimeNow );
+			#else
+				ulTimeNow = portGET_RUN_TIME_COUNTER_VALUE();
+			#endif
 
-	void vTaskStepTick( const TickType_t xTicksToJump )
-	{
-		/* Correct the tick count value after a period during which the tick
-		was suppressed.  Note this does *not* call the tick hook function for
-		each stepped tick. */
-		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
-		xTickCount += xTicksToJump;
-		traceINCREASE_TICK_COUNT( xTicksToJump );
-	}
+			for( pxTCB = pxRunTimeTCBs; ( pxTCB != NULL ) && ( uxTask < uxArraySize ); pxTCB = pxTCB->pxNextRunTimeTCB )
+			{
+				pxTaskArray[ uxTask ].xHandle = ( TaskHandle_t ) pxTCB;
+				pxTaskArray[ uxTask ].ulRunTimeCounter = prvGetRunTimeAt( pxTCB, ulTimeNow );
+				pxTaskArray[ uxTask ].ulSwitchInCount = pxTCB->ulSwitchInCount;
+				( void ) memcpy( pxTaskArray[ uxTask ].pcTaskName, pxTCB->pcTaskName, sizeof( pxTaskArray[ uxTask ].pcTaskName ) );
+				uxTask++;
+			}
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
+			#if( configNUMBER_OF_CORES == 1 )
+			{
+				if( xIdleTaskHandle != NULL )
+				{
+					ulIdleRunTime = prvGetRunTimeAt( xIdleTaskHandle, ulTimeNow );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#else
+			{
+			BaseType_t xCoreID;
 
-BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
-{
+				for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+				{
+					if( xIdleTaskHandles[ xCoreID ] != NULL )
+					{
+						ulIdleRunTime += prvGetRunTimeAt( xIdleTaskHandles[ xCoreID ], ulTimeNow );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			#endif /* configNUMBER_OF_CORES */
+
+			pxSnapshot->ulTimeNow = ulTimeNow;
+			pxSnapshot->ulIdleRunTime = ulIdleRunTime;
+			pxSnapshot->ulSwitchCount = ulTaskSwitchCount;
+			pxSnapshot->uxNumberOfTasks = uxCurrentNumberOfTasks;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxTask;
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*----------------------------------------------------------*/
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+	static configRUN_TIME_COUNTER_TYPE prvGetRunTimeAt( const TCB_t * const pxTCB, const configRUN_TIME_COUNTER_TYPE ulTimeNow )
+	{
+	configRUN_TIME_COUNTER_TYPE ulRunTime = pxTCB->ulRunTimeCounter, ulSwitchedInTime;
+
+		if( taskTASK_IS_RUNNING( pxTCB ) )
+		{
+			#if( configNUMBER_OF_CORES == 1 )
+			{
+				ulSwitchedInTime = ulTaskSwitchedInTime;
+			}
+			#else
+			{
+				ulSwitchedInTime = ulTaskSwitchedInTimes[ pxTCB->xTaskRunState ];
+			}
+			#endif
+
+			/* The same guard against a suspect counter as in
+			vTaskSwitchContext(). */
+			if( ulTimeNow > ulSwitchedInTime )
+			{
+				ulRunTime += ulTimeNow - ulSwitchedInTime;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ulRunTime;
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+
+	TaskHandle_t xTaskGetIdleTaskHandle( void )
+	{
+		/* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+		started, then xIdleTaskHandle will be NULL. */
+		configASSERT( ( xIdleTaskHandle != NULL ) );
+		return xIdleTaskHandle;
+	}
+
+#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+/*----------------------------------------------------------*/
+
+/* This conditional compilation should use inequality to 0, not equality to 1.
+This is to ensure vTaskStepTick() is available when user defined low power mode
+implementations require configUSE_TICKLESS_IDLE to be set to a value other than
+1. */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	void vTaskStepTick( const TickType_t xTicksToJump )
+	{
+	TickType_t xTicksToStep = xTicksToJump;
+
+		/* Correct the tick count value after a period during which the tick
+		was suppressed.  Note this does *not* call the tick hook function for
+		each stepped tick. */
+		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+
+		#if( configUSE_TIMING_WHEEL == 1 )
+		{
+			/* Tasks in the timing wheel are only unblocked by
+			xTaskIncrementTick() arriving at their exact wake time, so rather
+			than stepping onto xNextTaskUnblockTime, step to the tick before
+			it and pend the last tick.  xTaskIncrementTick() then processes it
+			when the scheduler is resumed. */
+			if( ( xTickCount + xTicksToJump ) == xNextTaskUnblockTime )
+			{
+				configASSERT( xTicksToJump != ( TickType_t ) 0 );
+				taskENTER_CRITICAL();
+				{
+					xPendedTicks++;
+				}
+				taskEXIT_CRITICAL();
+				xTicksToStep--;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TIMING_WHEEL */
+
+		xTickCount += xTicksToStep;
+		traceINCREASE_TICK_COUNT( xTicksToStep );
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
+{
 BaseType_t xYieldRequired = pdFALSE;
 
 	/* Must not be called with the scheduler suspended as the implementation
 	relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-	configASSERT( uxSchedulerSuspended == 0 );
+	configASSERT( taskSCHEDULER_IS_SUSPENDED() == pdFALSE );
 
 	/* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
 	the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
@@ -2678,7 +3223,7 @@ BaseType_t xYieldRequired = pdFALSE;
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskYIELD_REQUIRED_FOR( pxTCB ) )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2706,8 +3251,10 @@ BaseType_t xYieldRequired = pdFALSE;
 
 BaseType_t xTaskIncrementTick( void )
 {
+#if( configUSE_TIMING_WHEEL == 0 )
 TCB_t * pxTCB;
 TickType_t xItemValue;
+#endif
 BaseType_t xSwitchRequired = pdFALSE;
 
 	/* Called by the portable layer each time a tick interrupt occurs.
@@ -2724,101 +3271,149 @@ BaseType_t xSwitchRequired = pdFALSE;
 		delayed lists if it wraps to 0. */
 		xTickCount = xConstTickCount;
 
-		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+		#if( configUSE_TIMING_WHEEL == 1 )
 		{
-			taskSWITCH_DELAYED_LISTS();
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+			/* There is no overflow list to switch to, the wheel slots hold
+			tasks that wake either side of the overflow, but the overflow
+			count is still used by xTaskCheckForTimeOut(). */
+			if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+			{
+				xNumOfOverflows++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-		/* See if this tick has made a timeout expire.  Tasks are stored in
-		the	queue in the order of their wake time - meaning once one task
-		has been found whose block time has not expired there is no need to
-		look any further down the list. */
-		if( xConstTickCount >= xNextTaskUnblockTime )
-		{
-			for( ;; )
+			/* Only the slot for this tick can hold tasks that have to be
+			unblocked now, and a clear bit means it is empty. */
+			if( ( ulDelayedTaskWheelMap[ ( xConstTickCount & taskWHEEL_MASK ) >> 5 ] & ( 1UL << ( xConstTickCount & 31 ) ) ) != 0UL )
 			{
-				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+				if( prvUnblockTimingWheelSlot( xConstTickCount ) != pdFALSE )
 				{
-					/* The delayed list is empty.  Set xNextTaskUnblockTime
-					to the maximum possible value so it is extremely
-					unlikely that the
-					if( xTickCount >= xNextTaskUnblockTime ) test will pass
-					next time through. */
-					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					break;
+					xSwitchRequired = pdTRUE;
 				}
 				else
 				{
-					/* The delayed list is not empty, get the value of the
-					item at the head of the delayed list.  This is the time
-					at which the task at the head of the delayed list must
-					be removed from the Blocked state. */
-					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-					xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-					if( xConstTickCount < xItemValue )
-					{
-						/* It is not time to unblock this item yet, but the
-						item value is the time at which the task at the head
-						of the blocked list must be removed from the Blocked
-						state -	so record the item value in
-						xNextTaskUnblockTime. */
-						xNextTaskUnblockTime = xItemValue;
-						break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-					/* It is time to remove the item from the Blocked state. */
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+			/* xNextTaskUnblockTime is only used to decide how long the tick
+			can be suppressed for, so it only needs recalculating when it has
+			been reached or the tick count has wrapped. */
+			if( ( xConstTickCount >= xNextTaskUnblockTime ) || ( xConstTickCount == ( TickType_t ) 0U ) )
+			{
+				prvResetNextTaskUnblockTime();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else /* configUSE_TIMING_WHEEL */
+		{
+			if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+			{
+				taskSWITCH_DELAYED_LISTS();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-					/* Is the task waiting on an event also?  If so remove
-					it from the event list. */
-					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+			/* See if this tick has made a timeout expire.  Tasks are stored in
+			the	queue in the order of their wake time - meaning once one task
+			has been found whose block time has not expired there is no need to
+			look any further down the list. */
+			if( xConstTickCount >= xNextTaskUnblockTime )
+			{
+				for( ;; )
+				{
+					if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
 					{
-						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						/* The delayed list is empty.  Set xNextTaskUnblockTime
+						to the maximum possible value so it is extremely
+						unlikely that the
+						if( xTickCount >= xNextTaskUnblockTime ) test will pass
+						next time through. */
+						xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+						break;
 					}
 					else
 					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+						/* The delayed list is not empty, get the value of the
+						item at the head of the delayed list.  This is the time
+						at which the task at the head of the delayed list must
+						be removed from the Blocked state. */
+						pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+						xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+						if( xConstTickCount < xItemValue )
+						{
+							/* It is not time to unblock this item yet, but the
+							item value is the time at which the task at the head
+							of the blocked list must be removed from the Blocked
+							state -	so record the item value in
+							xNextTaskUnblockTime. */
+							xNextTaskUnblockTime = xItemValue;
+							break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 
-					/* Place the unblocked task into the appropriate ready
-					list. */
-					prvAddTaskToReadyList( pxTCB );
+						/* It is time to remove the item from the Blocked state. */
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
 
-					/* A task being unblocked cannot cause an immediate
-					context switch if preemption is turned off. */
-					#if (  configUSE_PREEMPTION == 1 )
-					{
-						/* Preemption is on, but a context switch should
-						only be performed if the unblocked task has a
-						priority that is equal to or higher than the
-						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						/* Is the task waiting on an event also?  If so remove
+						it from the event list. */
+						if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
 						{
-							xSwitchRequired = pdTRUE;
+							( void ) uxListRemove( &( pxTCB->xEventListItem ) );
 						}
 						else
 						{
 							mtCOVERAGE_TEST_MARKER();
 						}
+
+						/* Place the unblocked task into the appropriate ready
+						list. */
+						prvAddTaskToReadyList( pxTCB );
+
+						/* A task being unblocked cannot cause an immediate
+						context switch if preemption is turned off. */
+						#if (  configUSE_PREEMPTION == 1 )
+						{
+							/* Preemption is on, but a context switch should
+							only be performed if the unblocked task has a
+							priority that is equal to or higher than the
+							currently executing task. */
+							if( taskYIELD_REQUIRED_FOR_EQUAL( pxTCB ) )
+							{
+								xSwitchRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_PREEMPTION */
 					}
-					#endif /* configUSE_PREEMPTION */
 				}
 			}
 		}
+		#endif /* configUSE_TIMING_WHEEL */
 
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
-		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
 		{
 			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
 			{
@@ -2829,6 +3424,44 @@ BaseType_t xSwitchRequired = pdFALSE;
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#elif ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		{
+		BaseType_t xCoreID, xOtherCoreID;
+		UBaseType_t uxPriority, uxRunning;
+
+			/* The tick is taken by one core for all of them.  A core only
+			has to give up its time slice if its priority has more ready
+			tasks than there are cores running them. */
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				uxPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+				uxRunning = 0;
+
+				for( xOtherCoreID = 0; xOtherCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xOtherCoreID++ )
+				{
+					if( pxCurrentTCBs[ xOtherCoreID ]->uxPriority == uxPriority )
+					{
+						uxRunning++;
+					}
+				}
+
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxPriority ] ) ) > uxRunning )
+				{
+					if( xCoreID == portGET_CORE_ID() )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						prvYieldCore( xCoreID );
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
 		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
 		#if ( configUSE_TICK_HOOK == 1 )
@@ -2988,6 +3621,10 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 void vTaskSwitchContext( void )
 {
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	TCB_t * const pxPreviousTCB = pxCurrentTCB;
+#endif
+
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -3038,9 +3675,33 @@ void vTaskSwitchContext( void )
 
 		/* Select a new task to run using either the generic C or port
 		optimised asm code. */
-		taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		#if( configNUMBER_OF_CORES == 1 )
+		{
+			taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		}
+		#else
+		{
+			prvSelectHighestPriorityTask( portGET_CORE_ID() );
+		}
+		#endif
 		traceTASK_SWITCHED_IN();
 
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			/* Only count a switch to another task, not the same task picked
+			again. */
+			if( pxCurrentTCB != pxPreviousTCB )
+			{
+				pxCurrentTCB->ulSwitchInCount++;
+				ulTaskSwitchCount++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configGENERATE_RUN_TIME_STATS */
+
 		/* After the new task is switched in, update the global errno. */
 		#if( configUSE_POSIX_ERRNO == 1 )
 		{
@@ -3058,7 +3719,191 @@ void vTaskSwitchContext( void )
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 	}
-}
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
+	{
+	TCB_t *pxTCB = NULL, *pxCandidate;
+	List_t *pxList;
+	UBaseType_t uxPriority, uxCandidates;
+
+		/* The task the core was running can be selected again. */
+		if( pxCurrentTCBs[ xCoreID ] != NULL )
+		{
+			pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Find the highest priority list that contains ready tasks. */
+		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+		{
+			uxPriority = uxTopReadyPriority;
+
+			while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxPriority ] ) ) )
+			{
+				configASSERT( uxPriority );
+				--uxPriority;
+			}
+
+			uxTopReadyPriority = uxPriority;
+		}
+		#else
+		{
+			portGET_HIGHEST_PRIORITY( uxPriority, uxTopReadyPriority );
+		}
+		#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+		/* The highest priority tasks might all be running on other cores, or
+		not be allowed on this one, so work down the priorities until one is
+		found.  listGET_OWNER_OF_NEXT_ENTRY moves each list's index on, so the
+		tasks of the same priority still take turns. */
+		for( ;; )
+		{
+			pxList = &( pxReadyTasksLists[ uxPriority ] );
+
+			for( uxCandidates = listCURRENT_LIST_LENGTH( pxList ); uxCandidates > ( UBaseType_t ) 0U; uxCandidates-- )
+			{
+				listGET_OWNER_OF_NEXT_ENTRY( pxCandidate, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+				if( ( pxCandidate->xTaskRunState == taskTASK_NOT_RUNNING ) && ( taskCORE_IS_ALLOWED( pxCandidate, xCoreID ) != pdFALSE ) )
+				{
+					pxTCB = pxCandidate;
+					break;
+				}
+			}
+
+			if( ( pxTCB != NULL ) || ( uxPriority == tskIDLE_PRIORITY ) )
+			{
+				break;
+			}
+
+			--uxPriority;
+		}
+
+		/* There is an idle task for every core, so there is always a task. */
+		configASSERT( pxTCB != NULL );
+		pxTCB->xTaskRunState = xCoreID;
+		pxCurrentTCBs[ xCoreID ] = pxTCB;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static void prvYieldCore( BaseType_t xCoreID )
+	{
+		configASSERT( xCoreID != portGET_CORE_ID() );
+
+		/* The core clears the flag when it next selects a task.  Until then
+		prvYieldForTask() leaves it alone, as it will pick up any task that is
+		readied in the meantime anyway. */
+		if( xYieldPendings[ xCoreID ] == pdFALSE )
+		{
+			xYieldPendings[ xCoreID ] = pdTRUE;
+			portYIELD_CORE( xCoreID );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static BaseType_t prvYieldForTask( TCB_t *pxTCB )
+	{
+	const BaseType_t xThisCoreID = portGET_CORE_ID();
+	BaseType_t xCoreID, x, xLowestCoreID = -1;
+	UBaseType_t uxLowestPriority = pxTCB->uxPriority;
+	BaseType_t xReturn = pdFALSE;
+
+		if( ( xSchedulerRunning != pdFALSE ) && ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) )
+		{
+			/* Start at the calling core so it wins a tie. */
+			for( x = 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
+			{
+				xCoreID = ( xThisCoreID + x ) % ( BaseType_t ) configNUMBER_OF_CORES;
+
+				if( ( taskCORE_IS_ALLOWED( pxTCB, xCoreID ) != pdFALSE ) &&
+					( xYieldPendings[ xCoreID ] == pdFALSE ) &&
+					( pxCurrentTCBs[ xCoreID ]->uxPriority < uxLowestPriority ) )
+				{
+					uxLowestPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+					xLowestCoreID = xCoreID;
+				}
+			}
+
+			if( xLowestCoreID == xThisCoreID )
+			{
+				xYieldPendings[ xThisCoreID ] = pdTRUE;
+				xReturn = pdTRUE;
+			}
+			else if( xLowestCoreID >= 0 )
+			{
+				prvYieldCore( xLowestCoreID );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static void prvYieldTaskCore( TCB_t *pxTCB )
+	{
+	const BaseType_t xCoreID = pxTCB->xTaskRunState;
+
+		if( ( xCoreID != taskTASK_NOT_RUNNING ) && ( xCoreID != portGET_CORE_ID() ) )
+		{
+			prvYieldCore( xCoreID );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	static BaseType_t prvSchedulerSuspendedOnThisCore( void )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xReturn;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+		{
+			xReturn = ( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE ) ? pdTRUE : pdFALSE;
+		}
+		portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
@@ -3162,7 +4007,7 @@ BaseType_t xReturn;
 		( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 		prvAddTaskToReadyList( pxUnblockedTCB );
 
-		#if( configUSE_TICKLESS_IDLE != 0 )
+		#if( ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_TIMING_WHEEL == 0 ) )
 		{
 			/* If a task is blocked on a kernel object then xNextTaskUnblockTime
 			might be set to the blocked task's time out time.  If the task is
@@ -3183,7 +4028,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskYIELD_REQUIRED_FOR( pxUnblockedTCB ) )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -3220,7 +4065,7 @@ TCB_t *pxUnblockedTCB;
 	configASSERT( pxUnblockedTCB );
 	( void ) uxListRemove( pxEventListItem );
 
-	#if( configUSE_TICKLESS_IDLE != 0 )
+	#if( ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_TIMING_WHEEL == 0 ) )
 	{
 		/* If a task is blocked on a kernel object then xNextTaskUnblockTime
 		might be set to the blocked task's time out time.  If the task is
@@ -3240,7 +4085,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskYIELD_REQUIRED_FOR( pxUnblockedTCB ) )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
 		a context switch is required.  This function is called with the
@@ -3429,7 +4274,7 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			the list, and an occasional incorrect value will not matter.  If
 			the ready list at the idle priority contains more than one task
 			then a task other than the idle task is ready to execute. */
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
 			{
 				taskYIELD();
 			}
@@ -3502,6 +4347,14 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			}
 		}
 		#endif /* configUSE_TICKLESS_IDLE */
+
+		#if( configNUMBER_OF_CORES > 1 )
+		{
+			/* Tickless idle is not available with more than one core, so
+			let the port rest the core until the next interrupt. */
+			portWAIT_FOR_INTERRUPT();
+		}
+		#endif
 	}
 }
 /*-----------------------------------------------------------*/
@@ -3617,6 +4470,17 @@ UBaseType_t uxPriority;
 	vListInitialise( &xDelayedTaskList2 );
 	vListInitialise( &xPendingReadyList );
 
+	#if( configUSE_TIMING_WHEEL == 1 )
+	{
+		for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configTIMING_WHEEL_SLOTS; uxPriority++ )
+		{
+			vListInitialise( &( xDelayedTaskWheel[ uxPriority ] ) );
+		}
+
+		( void ) memset( ( void * ) ulDelayedTaskWheelMap, 0x00, sizeof( ulDelayedTaskWheelMap ) );
+	}
+	#endif /* configUSE_TIMING_WHEEL */
+
 	#if ( INCLUDE_vTaskDelete == 1 )
 	{
 		vListInitialise( &xTasksWaitingTermination );
@@ -3651,13 +4515,44 @@ static void prvCheckTasksWaitingTermination( void )
 		{
 			taskENTER_CRITICAL();
 			{
-				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-				--uxCurrentNumberOfTasks;
-				--uxDeletedTasksWaitingCleanUp;
+				#if( configNUMBER_OF_CORES == 1 )
+				{
+					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				}
+				#else
+				{
+					/* The idle task of another core might have freed the last
+					task since the count was read, and a task that deleted
+					itself might not have been switched out of its core yet -
+					either way leave it for the next time. */
+					pxTCB = NULL;
+
+					if( listLIST_IS_EMPTY( &xTasksWaitingTermination ) == pdFALSE )
+					{
+						pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+						if( taskTASK_IS_RUNNING( pxTCB ) )
+						{
+							pxTCB = NULL;
+						}
+					}
+				}
+				#endif /* configNUMBER_OF_CORES */
+
+				if( pxTCB != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					--uxCurrentNumberOfTasks;
+					--uxDeletedTasksWaitingCleanUp;
+				}
 			}
 			taskEXIT_CRITICAL();
 
+			if( pxTCB == NULL )
+			{
+				break;
+			}
+
 			prvDeleteTCB( pxTCB );
 		}
 	}
@@ -3705,7 +4600,7 @@ static void prvCheckTasksWaitingTermination( void )
 		state is just set to whatever is passed in. */
 		if( eState != eInvalid )
 		{
-			if( pxTCB == pxCurrentTCB )
+			if( taskTASK_IS_RUNNING( pxTCB ) )
 			{
 				pxTaskStatus->eCurrentState = eRunning;
 			}
@@ -3942,43 +4837,229 @@ static void prvCheckTasksWaitingTermination( void )
 
 static void prvResetNextTaskUnblockTime( void )
 {
+#if( configUSE_TIMING_WHEEL == 1 )
+const TickType_t xConstTickCount = xTickCount;
+TickType_t xOffset = ( TickType_t ) 1, xSlot, xNextUnblockTime = portMAX_DELAY;
+uint32_t ulSlots;
+const ListItem_t *pxItem;
+#else
 TCB_t *pxTCB;
+#endif
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+	#if( configUSE_TIMING_WHEEL == 1 )
 	{
-		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-		the maximum possible value so it is	extremely unlikely that the
-		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-		there is an item in the delayed list. */
-		xNextTaskUnblockTime = portMAX_DELAY;
+		/* Look through the slots that follow the current tick for the first
+		task that wakes on this turn of the wheel.  Tasks that wake on a later
+		turn are skipped, but while there are any the next unblock time is at
+		most one turn away, so that is used if nothing sooner is found.  Slots
+		whose bit is set but which turn out to be empty have their bit cleared
+		on the way past.
+
+		A task leaving the wheel early can only make the result too soon,
+		never too late, so unlike the delayed list this is not recalculated
+		each time an event or notification unblocks a task - only when the
+		tick count reaches it. */
+		while( xOffset <= ( TickType_t ) configTIMING_WHEEL_SLOTS )
+		{
+			xSlot = ( xConstTickCount + xOffset ) & taskWHEEL_MASK;
+			ulSlots = ulDelayedTaskWheelMap[ xSlot >> 5 ] >> ( xSlot & 31 );
+
+			if( ulSlots == 0UL )
+			{
+				/* Nothing in the rest of this word of the map. */
+				xOffset += ( TickType_t ) 32 - ( xSlot & 31 );
+			}
+			else if( ( ulSlots & 1UL ) == 0UL )
+			{
+				xOffset++;
+			}
+			else if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ xSlot ] ) ) != pdFALSE )
+			{
+				ulDelayedTaskWheelMap[ xSlot >> 5 ] &= ~( 1UL << ( xSlot & 31 ) );
+				xOffset++;
+			}
+			else
+			{
+				for( pxItem = listGET_HEAD_ENTRY( &( xDelayedTaskWheel[ xSlot ] ) ); pxItem != listGET_END_MARKER( &( xDelayedTaskWheel[ xSlot ] ) ); pxItem = listGET_NEXT( pxItem ) )
+				{
+					if( listGET_LIST_ITEM_VALUE( pxItem ) == ( xConstTickCount + xOffset ) )
+					{
+						break;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				if( pxItem != listGET_END_MARKER( &( xDelayedTaskWheel[ xSlot ] ) ) )
+				{
+					xNextUnblockTime = xConstTickCount + xOffset;
+					break;
+				}
+				else
+				{
+					xNextUnblockTime = xConstTickCount + ( TickType_t ) configTIMING_WHEEL_SLOTS;
+					xOffset++;
+				}
+			}
+		}
+
+		/* As with the overflow list, a time that is only reached after the
+		tick count wraps is left at portMAX_DELAY, and is found when
+		xTaskIncrementTick() recalculates on the wrap. */
+		if( xNextUnblockTime < xConstTickCount )
+		{
+			xNextUnblockTime = portMAX_DELAY;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xNextTaskUnblockTime = xNextUnblockTime;
 	}
-	else
+	#else /* configUSE_TIMING_WHEEL */
 	{
-		/* The new current delayed list is not empty, get the value of
-		the item at the head of the delayed list.  This is the time at
-		which the task at the head of the delayed list should be removed
-		from the Blocked state. */
-		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+		if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+		{
+			/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+			the maximum possible value so it is	extremely unlikely that the
+			if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+			there is an item in the delayed list. */
+			xNextTaskUnblockTime = portMAX_DELAY;
+		}
+		else
+		{
+			/* The new current delayed list is not empty, get the value of
+			the item at the head of the delayed list.  This is the time at
+			which the task at the head of the delayed list should be removed
+			from the Blocked state. */
+			( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+		}
 	}
+	#endif /* configUSE_TIMING_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	static BaseType_t prvUnblockTimingWheelSlot( const TickType_t xConstTickCount )
+	{
+	const TickType_t xSlot = xConstTickCount & taskWHEEL_MASK;
+	List_t * const pxSlot = &( xDelayedTaskWheel[ xSlot ] );
+	ListItem_t *pxItem, *pxNext;
+	const ListItem_t * const pxEnd = listGET_END_MARKER( pxSlot );
+	TCB_t *pxTCB;
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		/* The slot is not sorted, so every task in it is looked at.  Those
+		whose wake time is a later turn of the wheel stay in the slot. */
+		for( pxItem = listGET_HEAD_ENTRY( pxSlot ); pxItem != pxEnd; pxItem = pxNext )
+		{
+			pxNext = listGET_NEXT( pxItem );
+
+			if( listGET_LIST_ITEM_VALUE( pxItem ) == xConstTickCount )
+			{
+				pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+				/* It is time to remove the item from the Blocked state. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+				/* Is the task waiting on an event also?  If so remove it from the
+				event list. */
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Place the unblocked task into the appropriate ready list. */
+				prvAddTaskToReadyList( pxTCB );
+
+				/* A task being unblocked cannot cause an immediate context switch
+				if preemption is turned off. */
+				#if (  configUSE_PREEMPTION == 1 )
+				{
+					if( taskYIELD_REQUIRED_FOR_EQUAL( pxTCB ) )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_PREEMPTION */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( listLIST_IS_EMPTY( pxSlot ) != pdFALSE )
+		{
+			ulDelayedTaskWheelMap[ xSlot >> 5 ] &= ~( 1UL << ( xSlot & 31 ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xSwitchRequired;
+	}
+
+#endif /* configUSE_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) )
 
 	TaskHandle_t xTaskGetCurrentTaskHandle( void )
 	{
 	TaskHandle_t xReturn;
 
-		/* A critical section is not required as this is not called from
-		an interrupt and the current TCB will always be the same for any
-		individual execution thread. */
-		xReturn = pxCurrentTCB;
+		#if( configNUMBER_OF_CORES == 1 )
+		{
+			/* A critical section is not required as this is not called from
+			an interrupt and the current TCB will always be the same for any
+			individual execution thread. */
+			xReturn = pxCurrentTCB;
+		}
+		#else
+		{
+		UBaseType_t uxSavedInterruptStatus;
+
+			/* The calling task could be switched to another core between
+			reading the core ID and reading that core's TCB, so interrupts
+			are masked on this core while both are read. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+			{
+				xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+			}
+			portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+		}
+		#endif /* configNUMBER_OF_CORES */
 
 		return xReturn;
 	}
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+	{
+		configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+		return pxCurrentTCBs[ xCoreID ];
+	}
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
@@ -3993,7 +5074,7 @@ TCB_t *pxTCB;
 		}
 		else
 		{
-			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+			if( taskSCHEDULER_IS_SUSPENDED() == pdFALSE )
 			{
 				xReturn = taskSCHEDULER_RUNNING;
 			}
@@ -4250,8 +5331,10 @@ TCB_t *pxTCB;
 						{
 							/* It is known that the task is in its ready list so
 							there is no need to check again and the port level
-							reset macro can be called directly. */
-							portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+							reset macro can be called directly.  The task was
+							removed from the list of the priority it had on
+							entry, uxPriority has already been changed. */
+							portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
 						}
 						else
 						{
@@ -4347,6 +5430,123 @@ TCB_t *pxTCB;
 #endif /* portCRITICAL_NESTING_IN_TCB */
 /*-----------------------------------------------------------*/
 
+#if( configNUMBER_OF_CORES > 1 )
+
+	void vTaskEnterCritical( void )
+	{
+		portENTER_CRITICAL();
+
+		/* Another core might have suspended, deleted or preempted the calling
+		task while it waited for the kernel lock, in which case the interrupt
+		asking this core to switch is held off until the critical section
+		ends.  Switch now, before the task goes on to change the lists as
+		though it were still running. */
+		if( ( xSchedulerRunning != pdFALSE ) && ( portGET_CRITICAL_NESTING_COUNT() == ( UBaseType_t ) 1U ) )
+		{
+			while( ( xYieldPending != pdFALSE ) && ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) )
+			{
+				portYIELD_WITHIN_API();
+				portEXIT_CRITICAL();
+				portENTER_CRITICAL();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_CORE_AFFINITY == 1 )
+
+	void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xCoreID;
+
+		/* The task must be allowed to run on at least one core. */
+		configASSERT( ( uxCoreAffinityMask & ( ( ( UBaseType_t ) 1U << configNUMBER_OF_CORES ) - 1U ) ) != ( UBaseType_t ) 0U );
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			configASSERT( pxTCB );
+			pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+			if( xSchedulerRunning != pdFALSE )
+			{
+				if( taskTASK_IS_RUNNING( pxTCB ) )
+				{
+					/* Move the task off a core it is no longer allowed on. */
+					xCoreID = pxTCB->xTaskRunState;
+
+					if( taskCORE_IS_ALLOWED( pxTCB, xCoreID ) == pdFALSE )
+					{
+						if( xCoreID == portGET_CORE_ID() )
+						{
+							taskYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+							prvYieldCore( xCoreID );
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+				{
+					/* A ready task might now be able to preempt a core it
+					was not allowed on before. */
+					if( taskYIELD_REQUIRED_FOR( pxTCB ) )
+					{
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_CORE_AFFINITY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_CORE_AFFINITY == 1 )
+
+	UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxCoreAffinityMask;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_CORE_AFFINITY */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	static char *prvWriteNameToBuffer( char *pcBuffer, const char *pcTaskName )
@@ -4478,7 +5678,7 @@ TCB_t *pxTCB;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	UBaseType_t uxArraySize, x;
-	uint32_t ulTotalTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
 
 		#if( configUSE_TRACE_FACILITY != 1 )
 		{
@@ -4551,7 +5751,7 @@ TCB_t *pxTCB;
 					{
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
 						}
 						#else
 						{
@@ -4567,7 +5767,7 @@ TCB_t *pxTCB;
 						consumed less than 1% of the total run time. */
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
 						}
 						#else
 						{
@@ -4602,12 +5802,13 @@ TCB_t *pxTCB;
 TickType_t uxTaskResetEventItemValue( void )
 {
 TickType_t uxReturn;
+TCB_t * const pxTCB = prvGetTCBFromHandle( NULL );
 
-	uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+	uxReturn = listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) );
 
 	/* Reset the event list item to its normal value - so it can be used with
 	queues and semaphores. */
-	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+	listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 	return uxReturn;
 }
@@ -4630,6 +5831,48 @@ TickType_t uxReturn;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
+
+	void vTaskIncrementMutexHeldCountOf( TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t * const pxTCB = pxMutexHolder;
+
+		configASSERT( pxTCB );
+		( pxTCB->uxMutexesHeld )++;
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+	BaseType_t xTaskDecrementMutexHeldCount( TaskHandle_t const pxMutexHolder )
+	{
+	TCB_t * const pxTCB = pxMutexHolder;
+	BaseType_t xReturn;
+
+		/* Only the running task changes its own mutex held count.  While a
+		task waits for the mutex its holder inherited a priority from, the
+		mutex is marked as contended and the give takes the slow path anyway -
+		this catches a priority still raised after such a task timed out. */
+		configASSERT( pxTCB->uxMutexesHeld );
+
+		if( ( pxTCB->uxMutexesHeld == ( UBaseType_t ) 1 ) && ( pxTCB->uxPriority != pxTCB->uxBasePriority ) )
+		{
+			xReturn = pdFALSE;
+		}
+		else
+		{
+			( pxTCB->uxMutexesHeld )--;
+			xReturn = pdTRUE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
 	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
@@ -4852,7 +6095,7 @@ TickType_t uxReturn;
 				/* The task should not have been on an event list. */
 				configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
-				#if( configUSE_TICKLESS_IDLE != 0 )
+				#if( ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_TIMING_WHEEL == 0 ) )
 				{
 					/* If a task is blocked waiting for a notification then
 					xNextTaskUnblockTime might be set to the blocked task's time
@@ -4868,7 +6111,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskYIELD_REQUIRED_FOR( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4993,7 +6236,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskYIELD_REQUIRED_FOR( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5081,7 +6324,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskYIELD_REQUIRED_FOR( pxTCB ) )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -5166,7 +6409,7 @@ TickType_t uxReturn;
 
 #if( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
 
-	uint32_t ulTaskGetIdleRunTimeCounter( void )
+	configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
 	{
 		return xIdleTaskHandle->ulRunTimeCounter;
 	}
@@ -5224,13 +6467,13 @@ const TickType_t xConstTickCount = xTickCount;
 			{
 				/* Wake time has overflowed.  Place this item in the overflow
 				list. */
-				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				prvAddTaskToDelayedList( pxOverflowDelayedTaskList, pxCurrentTCB );
 			}
 			else
 			{
 				/* The wake time has not overflowed, so the current block list
 				is used. */
-				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				prvAddTaskToDelayedList( pxDelayedTaskList, pxCurrentTCB );
 
 				/* If the task entering the blocked state was placed at the
 				head of the list of blocked tasks then xNextTaskUnblockTime
@@ -5259,12 +6502,12 @@ const TickType_t xConstTickCount = xTickCount;
 		if( xTimeToWake < xConstTickCount )
 		{
 			/* Wake time has overflowed.  Place this item in the overflow list. */
-			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			prvAddTaskToDelayedList( pxOverflowDelayedTaskList, pxCurrentTCB );
 		}
 		else
 		{
 			/* The wake time has not overflowed, so the current block list is used. */
-			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			prvAddTaskToDelayedList( pxDelayedTaskList, pxCurrentTCB );
 
 			/* If the task entering the blocked state was placed at the head of the
 			list of blocked tasks then xNextTaskUnblockTime needs to be updated
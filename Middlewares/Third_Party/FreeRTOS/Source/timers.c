@@ -37,6 +37,7 @@ task.h is included from an application file. */
 #include "task.h"
 #include "queue.h"
 #include "timers.h"
+#include "atomic.h"
 
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
 	#error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
@@ -137,8 +138,85 @@ PRIVILEGED_DATA static List_t xActiveTimerList2;
 PRIVILEGED_DATA static List_t *pxCurrentTimerList;
 PRIVILEGED_DATA static List_t *pxOverflowTimerList;
 
-/* A queue that is used to send commands to the timer service task. */
-PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/* When the timer wheel is used, active timers are not kept in expiry time
+	order.  Instead each timer is appended to the slot selected by the low bits
+	of its expiry time, so starting, resetting and stopping a timer is O(1)
+	however many timers are active, and there are no lists to switch when the
+	tick count overflows.  A slot can hold timers that expire on a later turn
+	of the wheel - those keep their exact expiry time as their list item value
+	and are left where they are until it comes round.
+
+	A set bit in ulActiveTimerWheelMap means the slot might not be empty.  Bits
+	are set when a timer is inserted and cleared when the slot is next looked
+	at and found to be empty, so stopping a timer only has to remove it from
+	its list.  The lists above are left empty. */
+	#define tmrWHEEL_MASK			( ( TickType_t ) configTIMER_WHEEL_SLOTS - ( TickType_t ) 1 )
+	#define tmrWHEEL_MAP_WORDS		( configTIMER_WHEEL_SLOTS / 32 )
+
+	PRIVILEGED_DATA static List_t xActiveTimerWheel[ configTIMER_WHEEL_SLOTS ];
+	PRIVILEGED_DATA static uint32_t ulActiveTimerWheelMap[ tmrWHEEL_MAP_WORDS ];
+	PRIVILEGED_DATA static TickType_t xTimerWheelTime;	/*< Timers that expire at or before this time have been processed. */
+
+#endif
+
+#if( configUSE_TIMER_COMMAND_RING == 1 )
+
+	/* When the command ring is used, commands are not sent to the timer
+	service task through a queue.  Instead they are written into a ring of
+	configTIMER_QUEUE_LENGTH slots that any number of tasks and interrupts can
+	write to, and the timer service task is woken with a direct to task
+	notification - the ring owns the task's notification value.
+
+	Each slot carries a sequence number that says whose turn it is.  A writer
+	that finds the sequence number equal to the write position claims the
+	position, fills the slot and moves the sequence number on by one to
+	publish it, all in one short critical section.  The timer service task
+	copies commands out without entering one, and moves the sequence number
+	on by the rest of a lap, which frees the slot for the writer that
+	reaches it next time round.  A task that finds the ring full blocks on
+	xTimerCommandWaitingToSend, as it would on the xTasksWaitingToSend list of
+	a full queue, and the timer service task wakes one waiting task for each
+	slot it frees.
+
+	The timer service task takes up to configTIMER_COMMAND_BATCH commands at a
+	time, so a burst of commands costs it one wake rather than one per
+	command, and a start, reset or stop that a later command in the same batch
+	would undo is skipped without being applied. */
+	#define tmrRING_MASK			( ( uint32_t ) configTIMER_QUEUE_LENGTH - ( uint32_t ) 1 )
+	#define tmrRING_HAS_COMMAND()	( xTimerCommandRing[ ulTimerCommandReadPosition & tmrRING_MASK ].ulSequence == ( ulTimerCommandReadPosition + ( uint32_t ) 1 ) )
+	#define tmrCOMMAND_CHANNEL_EXISTS()	( xTimerCommandRingReady != pdFALSE )
+
+	typedef struct tmrCommandSlot
+	{
+		volatile uint32_t	ulSequence;			/*<< The position this slot can next be written at, plus one once it has been. */
+		DaemonTaskMessage_t	xMessage;
+	} TimerCommandSlot_t;
+
+	PRIVILEGED_DATA static TimerCommandSlot_t xTimerCommandRing[ configTIMER_QUEUE_LENGTH ];
+	PRIVILEGED_DATA static volatile uint32_t ulTimerCommandWritePosition = 0U;
+	PRIVILEGED_DATA static uint32_t ulTimerCommandReadPosition = 0U;
+	PRIVILEGED_DATA static BaseType_t xTimerCommandRingReady = pdFALSE;
+	PRIVILEGED_DATA static List_t xTimerCommandWaitingToSend;	/*< Tasks blocked until there is room in the ring.  Stored in priority order. */
+
+	/* The batch being worked through by the timer service task. */
+	PRIVILEGED_DATA static DaemonTaskMessage_t xTimerCommandBatch[ configTIMER_COMMAND_BATCH ];
+	PRIVILEGED_DATA static UBaseType_t uxTimerCommandBatchLength = 0U;
+	PRIVILEGED_DATA static UBaseType_t uxTimerCommandBatchNext = 0U;
+
+	/* Only ulDropped is written by tasks other than the timer service task. */
+	PRIVILEGED_DATA static TimerCommandStats_t xTimerCommandStats;
+
+#else
+
+	#define tmrCOMMAND_CHANNEL_EXISTS()	( xTimerQueue != NULL )
+
+	/* A queue that is used to send commands to the timer service task. */
+	PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
+
+#endif /* configUSE_TIMER_COMMAND_RING */
+
 PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 
 /*lint -restore */
@@ -181,16 +259,36 @@ static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
 /*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto-reload timer, then call its callback.
+ * An auto-reload timer expired at xExpiredTime.  Insert it into the active
+ * list or wheel for its next expiry time - if that time has also passed, call
+ * the timer's callback for it and move on by another period until it has not.
  */
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+static void prvReloadTimer( Timer_t * const pxTimer, TickType_t xExpiredTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
-/*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
- */
-static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/*
+	 * Process every timer in the wheel whose expire time is after
+	 * xTimerWheelTime and not after xTimeNow.  Reload each one that is an
+	 * auto-reload timer, then call its callback.
+	 */
+	static void prvProcessExpiredTimers( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * An active timer has reached its expire time.  Reload the timer if it is an
+	 * auto-reload timer, then call its callback.
+	 */
+	static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -206,6 +304,46 @@ static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched
  */
 static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_TIMER_COMMAND_RING == 1 )
+
+	/*
+	 * Write a command into the command ring and notify the timer service task.
+	 * If the ring is full and the caller is a task that is allowed to block
+	 * then block until the timer service task frees a slot or xTicksToWait
+	 * expires.
+	 */
+	static BaseType_t prvSendCommand( const DaemonTaskMessage_t * const pxMessage, const BaseType_t xFromISR, BaseType_t * const pxHigherPriorityTaskWoken, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Claim, fill and publish the next slot of the command ring, from an
+	 * interrupt if xFromISR is pdTRUE.  Returns pdFAIL without waiting if the
+	 * ring is full.
+	 */
+	static BaseType_t prvWriteCommand( const DaemonTaskMessage_t * const pxMessage, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by the timer service task to obtain the next command to apply,
+	 * taking a new batch from the command ring when the last one has been
+	 * used up and waking a task waiting for room for each slot freed.  Returns
+	 * pdFAIL when the ring is empty.
+	 */
+	static BaseType_t prvReceiveCommand( DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns pdTRUE if the command at uxIndex in the current batch is a
+	 * start, reset or stop command that a later command in the batch, for the
+	 * same timer, would make redundant.
+	 */
+	static BaseType_t prvCommandIsSuperseded( const UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Block the timer service task until a command is written into the ring
+	 * or xTicksToWait ticks after xTimeNow, whichever is first.
+	 */
+	static void prvWaitForCommand( TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_COMMAND_RING */
+
 /*
  * If a timer has expired, process it.  Otherwise, block the timer service task
  * until either a timer does expire or a command is received.
@@ -234,7 +372,7 @@ BaseType_t xReturn = pdFAIL;
 	been created then the initialisation will already have been performed. */
 	prvCheckForValidListAndQueue();
 
-	if( xTimerQueue != NULL )
+	if( tmrCOMMAND_CHANNEL_EXISTS() )
 	{
 		#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 		{
@@ -387,28 +525,43 @@ DaemonTaskMessage_t xMessage;
 
 	/* Send a message to the timer service task to perform a particular action
 	on a particular timer definition. */
-	if( xTimerQueue != NULL )
+	if( tmrCOMMAND_CHANNEL_EXISTS() )
 	{
 		/* Send a command to the timer service task to start the xTimer timer. */
 		xMessage.xMessageID = xCommandID;
 		xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
 		xMessage.u.xTimerParameters.pxTimer = xTimer;
 
-		if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+		#if( configUSE_TIMER_COMMAND_RING == 1 )
 		{
-			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+			if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
 			{
-				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+				xReturn = prvSendCommand( &xMessage, pdFALSE, NULL, xTicksToWait );
 			}
 			else
 			{
-				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+				xReturn = prvSendCommand( &xMessage, pdTRUE, pxHigherPriorityTaskWoken, tmrNO_DELAY );
 			}
 		}
-		else
+		#else
 		{
-			xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+			if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+			{
+				if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+				}
+				else
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+				}
+			}
+			else
+			{
+				xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+			}
 		}
+		#endif /* configUSE_TIMER_COMMAND_RING */
 
 		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
 	}
@@ -504,45 +657,113 @@ Timer_t *pxTimer = xTimer;
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
-{
-BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+#if( configUSE_TIMER_WHEEL == 1 )
 
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
-	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-	traceTIMER_EXPIRED( pxTimer );
+	static void prvProcessExpiredTimers( const TickType_t xTimeNow )
+	{
+	const TickType_t xElapsed = xTimeNow - xTimerWheelTime;
+	TickType_t xOffset, xSlot, xExpireTime;
+	List_t *pxSlot;
+	ListItem_t *pxItem, *pxNext;
+	Timer_t *pxTimer;
+
+		/* Visit the slots for each tick since the wheel was last processed,
+		in expiry time order.  If the timer task fell more than a whole turn
+		behind, each slot is visited once and everything in it that is due is
+		processed, so the work is bounded by the size of the wheel. */
+		for( xOffset = ( TickType_t ) 1; ( xOffset <= xElapsed ) && ( xOffset <= ( TickType_t ) configTIMER_WHEEL_SLOTS ); xOffset++ )
+		{
+			xSlot = ( xTimerWheelTime + xOffset ) & tmrWHEEL_MASK;
 
-	/* If the timer is an auto-reload timer then calculate the next
-	expiry time and re-insert the timer in the list of active timers. */
-	if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+			if( ( ulActiveTimerWheelMap[ xSlot >> 5 ] & ( 1UL << ( xSlot & 31 ) ) ) != 0UL )
+			{
+				pxSlot = &( xActiveTimerWheel[ xSlot ] );
+
+				for( pxItem = listGET_HEAD_ENTRY( pxSlot ); pxItem != listGET_END_MARKER( pxSlot ); pxItem = pxNext )
+				{
+					pxNext = listGET_NEXT( pxItem );
+					xExpireTime = listGET_LIST_ITEM_VALUE( pxItem );
+
+					/* Only timers whose expire time falls within the ticks
+					being processed are due, the others are waiting for a later
+					turn of the wheel. */
+					if( ( TickType_t ) ( xExpireTime - xTimerWheelTime - ( TickType_t ) 1 ) < xElapsed )
+					{
+						pxTimer = ( Timer_t * ) listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+						( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+						traceTIMER_EXPIRED( pxTimer );
+
+						/* As for the list, an auto-reload timer is reloaded
+						relative to the time it should have expired. */
+						if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+						{
+							prvReloadTimer( pxTimer, xExpireTime, xTimeNow );
+						}
+						else
+						{
+							pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						/* Call the timer callback. */
+						pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				if( listLIST_IS_EMPTY( pxSlot ) != pdFALSE )
+				{
+					ulActiveTimerWheelMap[ xSlot >> 5 ] &= ~( 1UL << ( xSlot & 31 ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		xTimerWheelTime = xTimeNow;
+	}
+
+#else /* configUSE_TIMER_WHEEL */
+
+	static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
 	{
-		/* The timer is inserted into a list using a time relative to anything
-		other than the current time.  It will therefore be inserted into the
-		correct list relative to the time this task thinks it is now. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+	Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+		/* Remove the timer from the list of active timers.  A check has already
+		been performed to ensure the list is not empty. */
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		traceTIMER_EXPIRED( pxTimer );
+
+		/* If the timer is an auto-reload timer then calculate the next
+		expiry time and re-insert the timer in the list of active timers. */
+		if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
 		{
-			/* The timer expired before it was added to the active timer
-			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-			configASSERT( xResult );
-			( void ) xResult;
+			/* The timer is inserted into a list using a time relative to anything
+			other than the current time.  It will therefore be inserted into the
+			correct list relative to the time this task thinks it is now. */
+			prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
 		}
 		else
 		{
+			pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
 			mtCOVERAGE_TEST_MARKER();
 		}
-	}
-	else
-	{
-		pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
-		mtCOVERAGE_TEST_MARKER();
+
+		/* Call the timer callback. */
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
 	}
 
-	/* Call the timer callback. */
-	pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-}
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static portTASK_FUNCTION( prvTimerTask, pvParameters )
@@ -597,11 +818,21 @@ BaseType_t xTimerListsWereSwitched;
 		if( xTimerListsWereSwitched == pdFALSE )
 		{
 			/* The tick count has not overflowed, has the timer expired? */
-			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
-			{
-				( void ) xTaskResumeAll();
-				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
-			}
+			#if( configUSE_TIMER_WHEEL == 1 )
+				/* Times in the wheel are measured from xTimerWheelTime, so
+				they are compared the same way either side of an overflow. */
+				if( ( xListWasEmpty == pdFALSE ) && ( ( TickType_t ) ( xNextExpireTime - xTimerWheelTime ) <= ( TickType_t ) ( xTimeNow - xTimerWheelTime ) ) )
+				{
+					( void ) xTaskResumeAll();
+					prvProcessExpiredTimers( xTimeNow );
+				}
+			#else
+				if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+				{
+					( void ) xTaskResumeAll();
+					prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				}
+			#endif /* configUSE_TIMER_WHEEL */
 			else
 			{
 				/* The tick count has not overflowed, and the next expire
@@ -617,20 +848,32 @@ BaseType_t xTimerListsWereSwitched;
 					xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
 				}
 
-				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
-
-				if( xTaskResumeAll() == pdFALSE )
+				#if( configUSE_TIMER_COMMAND_RING == 1 )
 				{
-					/* Yield to wait for either a command to arrive, or the
-					block time to expire.  If a command arrived between the
-					critical section being exited and this yield then the yield
-					will not cause the task to block. */
-					portYIELD_WITHIN_API();
+					/* Commands are not sent through a queue, so there is no
+					event list to wait on with the scheduler suspended.  Wait
+					for the notification that comes with each command instead. */
+					( void ) xTaskResumeAll();
+					prvWaitForCommand( ( xNextExpireTime - xTimeNow ), xListWasEmpty, xTimeNow );
 				}
-				else
+				#else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						/* Yield to wait for either a command to arrive, or the
+						block time to expire.  If a command arrived between the
+						critical section being exited and this yield then the yield
+						will not cause the task to block. */
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
+				#endif /* configUSE_TIMER_COMMAND_RING */
 			}
 		}
 		else
@@ -644,24 +887,80 @@ BaseType_t xTimerListsWereSwitched;
 static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
 {
 TickType_t xNextExpireTime;
+#if( configUSE_TIMER_WHEEL == 1 )
+TickType_t xOffset = ( TickType_t ) 1, xSlot;
+uint32_t ulSlots;
+#endif
 
-	/* Timers are listed in expiry time order, with the head of the list
-	referencing the task that will expire first.  Obtain the time at which
-	the timer with the nearest expiry time will expire.  If there are no
-	active timers then just set the next expire time to 0.  That will cause
-	this task to unblock when the tick count overflows, at which point the
-	timer lists will be switched and the next expiry time can be
-	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-	if( *pxListWasEmpty == pdFALSE )
+	#if( configUSE_TIMER_WHEEL == 1 )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		/* Find the first slot after the time the wheel was last processed that
+		holds a timer.  The timers in it might not expire until a later turn of
+		the wheel, in which case the task wakes, finds nothing due, and looks
+		again - at most once per slot per turn, so the cost of a wake is
+		bounded by the slot rather than by the number of active timers. */
+		*pxListWasEmpty = pdTRUE;
+		xNextExpireTime = ( TickType_t ) 0U;
+
+		while( xOffset <= ( TickType_t ) configTIMER_WHEEL_SLOTS )
+		{
+			xSlot = ( xTimerWheelTime + xOffset ) & tmrWHEEL_MASK;
+			ulSlots = ulActiveTimerWheelMap[ xSlot >> 5 ] >> ( xSlot & 31 );
+
+			if( ulSlots == 0UL )
+			{
+				/* Nothing in the rest of this word of the map. */
+				xOffset += ( TickType_t ) 32 - ( xSlot & 31 );
+			}
+			else if( ( ulSlots & 1UL ) == 0UL )
+			{
+				xOffset++;
+			}
+			else if( listLIST_IS_EMPTY( &( xActiveTimerWheel[ xSlot ] ) ) != pdFALSE )
+			{
+				ulActiveTimerWheelMap[ xSlot >> 5 ] &= ~( 1UL << ( xSlot & 31 ) );
+				xOffset++;
+			}
+			else
+			{
+				*pxListWasEmpty = pdFALSE;
+				xNextExpireTime = xTimerWheelTime + xOffset;
+				break;
+			}
+		}
+
+		if( *pxListWasEmpty != pdFALSE )
+		{
+			/* No timers are active, so there are no ticks to catch up on when
+			the next one is started. */
+			xTimerWheelTime = xTaskGetTickCount();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 	}
-	else
+	#else /* configUSE_TIMER_WHEEL */
 	{
-		/* Ensure the task unblocks when the tick count rolls over. */
-		xNextExpireTime = ( TickType_t ) 0U;
+		/* Timers are listed in expiry time order, with the head of the list
+		referencing the task that will expire first.  Obtain the time at which
+		the timer with the nearest expiry time will expire.  If there are no
+		active timers then just set the next expire time to 0.  That will cause
+		this task to unblock when the tick count overflows, at which point the
+		timer lists will be switched and the next expiry time can be
+		re-assessed.  */
+		*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+		if( *pxListWasEmpty == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		}
+		else
+		{
+			/* Ensure the task unblocks when the tick count rolls over. */
+			xNextExpireTime = ( TickType_t ) 0U;
+		}
 	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xNextExpireTime;
 }
@@ -670,21 +969,32 @@ TickType_t xNextExpireTime;
 static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
 {
 TickType_t xTimeNow;
+#if( configUSE_TIMER_WHEEL == 0 )
 PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
+#endif
 
 	xTimeNow = xTaskGetTickCount();
 
-	if( xTimeNow < xLastTime )
-	{
-		prvSwitchTimerLists();
-		*pxTimerListsWereSwitched = pdTRUE;
-	}
-	else
+	#if( configUSE_TIMER_WHEEL == 1 )
 	{
+		/* The wheel has no lists to switch when the tick count overflows. */
 		*pxTimerListsWereSwitched = pdFALSE;
 	}
+	#else
+	{
+		if( xTimeNow < xLastTime )
+		{
+			prvSwitchTimerLists();
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
 
-	xLastTime = xTimeNow;
+		xLastTime = xTimeNow;
+	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xTimeNow;
 }
@@ -697,48 +1007,88 @@ BaseType_t xProcessTimerNow = pdFALSE;
 	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
 	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
-	if( xNextExpiryTime <= xTimeNow )
+	#if( configUSE_TIMER_WHEEL == 1 )
 	{
 		/* Has the expiry time elapsed between the command to start/reset a
-		timer was issued, and the time the command was processed? */
+		timer was issued, and the time the command was processed?  Tick counts
+		are only ever compared as differences, so this also holds when the
+		tick count has overflowed since the command was issued. */
 		if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		{
-			/* The time between a command being issued and the command being
-			processed actually exceeds the timers period.  */
 			xProcessTimerNow = pdTRUE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			const TickType_t xSlot = xNextExpiryTime & tmrWHEEL_MASK;
+
+			vListInsertEnd( &( xActiveTimerWheel[ xSlot ] ), &( pxTimer->xTimerListItem ) );
+			ulActiveTimerWheelMap[ xSlot >> 5 ] |= ( 1UL << ( xSlot & 31 ) );
 		}
 	}
-	else
+	#else /* configUSE_TIMER_WHEEL */
 	{
-		if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+		if( xNextExpiryTime <= xTimeNow )
 		{
-			/* If, since the command was issued, the tick count has overflowed
-			but the expiry time has not, then the timer must have already passed
-			its expiry time and should be processed immediately. */
-			xProcessTimerNow = pdTRUE;
+			/* Has the expiry time elapsed between the command to start/reset a
+			timer was issued, and the time the command was processed? */
+			if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+			{
+				/* The time between a command being issued and the command being
+				processed actually exceeds the timers period.  */
+				xProcessTimerNow = pdTRUE;
+			}
+			else
+			{
+				vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+			{
+				/* If, since the command was issued, the tick count has overflowed
+				but the expiry time has not, then the timer must have already passed
+				its expiry time and should be processed immediately. */
+				xProcessTimerNow = pdTRUE;
+			}
+			else
+			{
+				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			}
 		}
 	}
+	#endif /* configUSE_TIMER_WHEEL */
 
 	return xProcessTimerNow;
 }
 /*-----------------------------------------------------------*/
 
+static void prvReloadTimer( Timer_t * const pxTimer, TickType_t xExpiredTime, const TickType_t xTimeNow )
+{
+	/* The timer is reloaded here rather than by sending the timer service
+	task a command, which could fail if other tasks or cores have filled the
+	command channel in the meantime. */
+	while( prvInsertTimerInActiveList( pxTimer, ( xExpiredTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpiredTime ) != pdFALSE )
+	{
+		xExpiredTime += pxTimer->xTimerPeriodInTicks;
+		traceTIMER_EXPIRED( pxTimer );
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+	}
+}
+/*-----------------------------------------------------------*/
+
 static void	prvProcessReceivedCommands( void )
 {
 DaemonTaskMessage_t xMessage;
 Timer_t *pxTimer;
-BaseType_t xTimerListsWereSwitched, xResult;
+BaseType_t xTimerListsWereSwitched;
 TickType_t xTimeNow;
 
+	#if( configUSE_TIMER_COMMAND_RING == 1 )
+	while( prvReceiveCommand( &xMessage ) != pdFAIL )
+	#else
 	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+	#endif
 	{
 		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
 		{
@@ -808,9 +1158,7 @@ TickType_t xTimeNow;
 
 						if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
 						{
-							xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-							configASSERT( xResult );
-							( void ) xResult;
+							prvReloadTimer( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
 						}
 						else
 						{
@@ -879,63 +1227,437 @@ TickType_t xTimeNow;
 }
 /*-----------------------------------------------------------*/
 
-static void prvSwitchTimerLists( void )
-{
-TickType_t xNextExpireTime, xReloadTime;
-List_t *pxTemp;
-Timer_t *pxTimer;
-BaseType_t xResult;
+#if( configUSE_TIMER_WHEEL == 0 )
 
-	/* The tick count has overflowed.  The timer lists must be switched.
-	If there are any timers still referenced from the current timer list
-	then they must have expired and should be processed before the lists
-	are switched. */
-	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+	static void prvSwitchTimerLists( void )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+	TickType_t xNextExpireTime, xReloadTime;
+	List_t *pxTemp;
+	Timer_t *pxTimer;
+	BaseType_t xResult;
+
+		/* The tick count has overflowed.  The timer lists must be switched.
+		If there are any timers still referenced from the current timer list
+		then they must have expired and should be processed before the lists
+		are switched. */
+		while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-		/* Remove the timer from the list. */
-		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-		traceTIMER_EXPIRED( pxTimer );
+			/* Remove the timer from the list. */
+			pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+			traceTIMER_EXPIRED( pxTimer );
 
-		/* Execute its callback, then send a command to restart the timer if
-		it is an auto-reload timer.  It cannot be restarted here as the lists
-		have not yet been switched. */
-		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+			/* Execute its callback, then send a command to restart the timer if
+			it is an auto-reload timer.  It cannot be restarted here as the lists
+			have not yet been switched. */
+			pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
 
-		if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+			if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+			{
+				/* Calculate the reload value, and if the reload value results in
+				the timer going into the same timer list then it has already expired
+				and the timer should be re-inserted into the current list so it is
+				processed again within this loop.  Otherwise a command should be sent
+				to restart the timer to ensure it is only inserted into a list after
+				the lists have been swapped. */
+				xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
+				if( xReloadTime > xNextExpireTime )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
+					listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+					vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				}
+				else
+				{
+					xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+					configASSERT( xResult );
+					( void ) xResult;
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		pxTemp = pxCurrentTimerList;
+		pxCurrentTimerList = pxOverflowTimerList;
+		pxOverflowTimerList = pxTemp;
+	}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_COMMAND_RING == 1 )
+
+	static BaseType_t prvSendCommand( const DaemonTaskMessage_t * const pxMessage, const BaseType_t xFromISR, BaseType_t * const pxHigherPriorityTaskWoken, TickType_t xTicksToWait )
+	{
+	BaseType_t xReturn, xTimedOut = pdFALSE;
+	TimeOut_t xTimeOut;
+
+		xReturn = prvWriteCommand( pxMessage, xFromISR );
+
+		if( ( xReturn == pdFAIL ) && ( xFromISR == pdFALSE ) && ( xTicksToWait > tmrNO_DELAY ) && ( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ) )
 		{
-			/* Calculate the reload value, and if the reload value results in
-			the timer going into the same timer list then it has already expired
-			and the timer should be re-inserted into the current list so it is
-			processed again within this loop.  Otherwise a command should be sent
-			to restart the timer to ensure it is only inserted into a list after
-			the lists have been swapped. */
-			xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
-			if( xReloadTime > xNextExpireTime )
+			/* The ring is full, so block until the timer service task frees a
+			slot.  Another writer can take the slot first, so try again each
+			time this task is woken until there is room or the block time has
+			expired. */
+			vTaskSetTimeOutState( &xTimeOut );
+
+			while( ( xReturn == pdFAIL ) && ( xTimedOut == pdFALSE ) )
 			{
-				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
-				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				/* The timer service task frees slots before it looks for a
+				task to wake, so trying the ring and joining the waiting tasks
+				in one critical section cannot miss a slot freed in between. */
+				taskENTER_CRITICAL();
+				{
+					xReturn = prvWriteCommand( pxMessage, pdFALSE );
+
+					if( xReturn == pdFAIL )
+					{
+						if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+						{
+							vTaskPlaceOnEventList( &xTimerCommandWaitingToSend, xTicksToWait );
+
+							/* As in ulTaskNotifyTake(), all ports allow a
+							yield in a critical section. */
+							portYIELD_WITHIN_API();
+						}
+						else
+						{
+							xTimedOut = pdTRUE;
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xReturn != pdFAIL )
+		{
+			/* The timer service task does not exist until the scheduler has
+			been started.  It takes any commands written before then when it
+			first runs. */
+			if( xTimerTaskHandle != NULL )
+			{
+				if( xFromISR != pdFALSE )
+				{
+					vTaskNotifyGiveFromISR( xTimerTaskHandle, pxHigherPriorityTaskWoken );
+				}
+				else
+				{
+					( void ) xTaskNotifyGive( xTimerTaskHandle );
+				}
 			}
 			else
 			{
-				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-				configASSERT( xResult );
-				( void ) xResult;
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			( void ) Atomic_Increment_u32( &( xTimerCommandStats.ulDropped ) );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIMER_COMMAND_RING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_COMMAND_RING == 1 )
+
+	static BaseType_t prvWriteCommand( const DaemonTaskMessage_t * const pxMessage, const BaseType_t xFromISR )
+	{
+	TimerCommandSlot_t *pxSlot;
+	uint32_t ulPosition;
+	UBaseType_t uxSavedInterruptStatus = ( UBaseType_t ) 0U;
+	BaseType_t xReturn;
+
+		/* The position is claimed and the slot published in one short
+		critical section.  Were a writer able to be preempted between the two,
+		every command written after it would wait behind its slot until it ran
+		again, however low its priority. */
+		if( xFromISR != pdFALSE )
+		{
+			uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+		}
+		else
+		{
+			taskENTER_CRITICAL();
+		}
+		{
+			ulPosition = ulTimerCommandWritePosition;
+			pxSlot = &( xTimerCommandRing[ ulPosition & tmrRING_MASK ] );
+
+			if( pxSlot->ulSequence == ulPosition )
+			{
+				/* The slot is free. */
+				pxSlot->xMessage = *pxMessage;
+				ulTimerCommandWritePosition = ulPosition + ( uint32_t ) 1;
+
+				/* Publish the command - the sequence number goes from
+				ulPosition to ulPosition + 1.  The timer service task reads it
+				without a lock, so it must not see the new sequence number
+				before the command. */
+				( void ) Atomic_Increment_u32( &( pxSlot->ulSequence ) );
+				xReturn = pdPASS;
+			}
+			else
+			{
+				/* The slot still holds a command from the last lap that the
+				timer service task has not taken yet, so the ring is full. */
+				xReturn = pdFAIL;
+			}
+		}
+		if( xFromISR != pdFALSE )
+		{
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			taskEXIT_CRITICAL();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIMER_COMMAND_RING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_COMMAND_RING == 1 )
+
+	static BaseType_t prvReceiveCommand( DaemonTaskMessage_t * const pxMessage )
+	{
+	TimerCommandSlot_t *pxSlot;
+	UBaseType_t uxDepth, uxWoken;
+	BaseType_t xReturn = pdFAIL, xFinished = pdFALSE, xYieldRequired = pdFALSE;
+
+		while( xFinished == pdFALSE )
+		{
+			if( uxTimerCommandBatchNext == uxTimerCommandBatchLength )
+			{
+				/* Every command in the last batch has been used, take the
+				next batch from the ring. */
+				uxTimerCommandBatchNext = ( UBaseType_t ) 0U;
+				uxTimerCommandBatchLength = ( UBaseType_t ) 0U;
+
+				uxDepth = ( UBaseType_t ) ( ulTimerCommandWritePosition - ulTimerCommandReadPosition );
+				if( uxDepth > xTimerCommandStats.uxMaxDepth )
+				{
+					xTimerCommandStats.uxMaxDepth = uxDepth;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				while( ( uxTimerCommandBatchLength < ( UBaseType_t ) configTIMER_COMMAND_BATCH ) && tmrRING_HAS_COMMAND() )
+				{
+					pxSlot = &( xTimerCommandRing[ ulTimerCommandReadPosition & tmrRING_MASK ] );
+					xTimerCommandBatch[ uxTimerCommandBatchLength ] = pxSlot->xMessage;
+					uxTimerCommandBatchLength++;
+
+					/* Hand the slot back for the next lap - the sequence
+					number goes from position + 1 to position + the length of
+					the ring. */
+					( void ) Atomic_Add_u32( &( pxSlot->ulSequence ), ( uint32_t ) configTIMER_QUEUE_LENGTH - ( uint32_t ) 1 );
+					ulTimerCommandReadPosition++;
+				}
+
+				if( uxTimerCommandBatchLength > ( UBaseType_t ) 0U )
+				{
+					xTimerCommandStats.ulReceived += ( uint32_t ) uxTimerCommandBatchLength;
+					xTimerCommandStats.ulBatches++;
+
+					/* Wake the highest priority tasks waiting for room, one
+					for each slot freed. */
+					taskENTER_CRITICAL();
+					{
+						for( uxWoken = ( UBaseType_t ) 0U; ( uxWoken < uxTimerCommandBatchLength ) && ( listLIST_IS_EMPTY( &xTimerCommandWaitingToSend ) == pdFALSE ); uxWoken++ )
+						{
+							if( xTaskRemoveFromEventList( &xTimerCommandWaitingToSend ) != pdFALSE )
+							{
+								xYieldRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+
+						#if( configUSE_PREEMPTION == 1 )
+						{
+							if( xYieldRequired != pdFALSE )
+							{
+								portYIELD_WITHIN_API();
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif /* configUSE_PREEMPTION */
+					}
+					taskEXIT_CRITICAL();
+				}
+				else
+				{
+					/* The ring is empty. */
+					xFinished = pdTRUE;
+				}
+			}
+			else if( prvCommandIsSuperseded( uxTimerCommandBatchNext ) != pdFALSE )
+			{
+				xTimerCommandStats.ulCoalesced++;
+				uxTimerCommandBatchNext++;
+			}
+			else
+			{
+				*pxMessage = xTimerCommandBatch[ uxTimerCommandBatchNext ];
+				uxTimerCommandBatchNext++;
+				xReturn = pdPASS;
+				xFinished = pdTRUE;
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIMER_COMMAND_RING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_COMMAND_RING == 1 )
+
+	static BaseType_t prvCommandIsSuperseded( const UBaseType_t uxIndex )
+	{
+	const TimerParameter_t * const pxParameters = &( xTimerCommandBatch[ uxIndex ].u.xTimerParameters );
+	UBaseType_t uxLater;
+	BaseType_t xReturn = pdFALSE, xCoalescable;
+
+		switch( xTimerCommandBatch[ uxIndex ].xMessageID )
+		{
+			case tmrCOMMAND_START :
+			case tmrCOMMAND_START_FROM_ISR :
+			case tmrCOMMAND_RESET :
+			case tmrCOMMAND_RESET_FROM_ISR :
+				/* Every command removes the timer from the active list before
+				anything else, so a start is only worth applying if a later
+				command would not undo it - unless the timer is already due,
+				in which case applying it calls the timer's callback. */
+				xCoalescable = ( ( TickType_t ) ( xTaskGetTickCount() - pxParameters->xMessageValue ) < pxParameters->pxTimer->xTimerPeriodInTicks ) ? pdTRUE : pdFALSE;
+				break;
+
+			case tmrCOMMAND_STOP :
+			case tmrCOMMAND_STOP_FROM_ISR :
+				xCoalescable = pdTRUE;
+				break;
+
+			default :
+				/* START_DONT_TRACE reloads a timer that has expired, and
+				changing the period or deleting the timer has effects that
+				outlast the next command. */
+				xCoalescable = pdFALSE;
+				break;
+		}
+
+		if( xCoalescable != pdFALSE )
+		{
+			/* Look for a later command for the same timer.  Stop at a pended
+			function call as the function might look at the timer. */
+			for( uxLater = uxIndex + ( UBaseType_t ) 1; uxLater < uxTimerCommandBatchLength; uxLater++ )
+			{
+				if( xTimerCommandBatch[ uxLater ].xMessageID < ( BaseType_t ) 0 )
+				{
+					break;
+				}
+				else if( xTimerCommandBatch[ uxLater ].u.xTimerParameters.pxTimer == pxParameters->pxTimer )
+				{
+					xReturn = pdTRUE;
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+
+		return xReturn;
 	}
 
-	pxTemp = pxCurrentTimerList;
-	pxCurrentTimerList = pxOverflowTimerList;
-	pxOverflowTimerList = pxTemp;
-}
+#endif /* configUSE_TIMER_COMMAND_RING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_COMMAND_RING == 1 )
+
+	static void prvWaitForCommand( TickType_t xTicksToWait, const BaseType_t xWaitIndefinitely, const TickType_t xTimeNow )
+	{
+	TickType_t xElapsed;
+
+		/* A writer notifies the timer service task after publishing its
+		command, so a command written after this check is never missed - the
+		notification is pending and ulTaskNotifyTake() returns straight away.
+		The notification value is used by the timer service task alone. */
+		if( tmrRING_HAS_COMMAND() == pdFALSE )
+		{
+			if( xWaitIndefinitely != pdFALSE )
+			{
+				xTicksToWait = portMAX_DELAY;
+			}
+			else
+			{
+				/* The tick count can have moved on since xTimeNow was sampled
+				with the scheduler suspended. */
+				xElapsed = xTaskGetTickCount() - xTimeNow;
+
+				if( xElapsed < xTicksToWait )
+				{
+					xTicksToWait -= xElapsed;
+				}
+				else
+				{
+					xTicksToWait = tmrNO_DELAY;
+				}
+			}
+
+			( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TIMER_COMMAND_RING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_COMMAND_RING == 1 )
+
+	void vTimerGetCommandStats( TimerCommandStats_t *pxStats )
+	{
+		configASSERT( pxStats );
+
+		*pxStats = xTimerCommandStats;
+		pxStats->uxDepth = ( UBaseType_t ) ( ulTimerCommandWritePosition - ulTimerCommandReadPosition );
+	}
+
+#endif /* configUSE_TIMER_COMMAND_RING */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
@@ -945,40 +1667,72 @@ static void prvCheckForValidListAndQueue( void )
 	initialised. */
 	taskENTER_CRITICAL();
 	{
-		if( xTimerQueue == NULL )
+		if( tmrCOMMAND_CHANNEL_EXISTS() == pdFALSE )
 		{
 			vListInitialise( &xActiveTimerList1 );
 			vListInitialise( &xActiveTimerList2 );
 			pxCurrentTimerList = &xActiveTimerList1;
 			pxOverflowTimerList = &xActiveTimerList2;
 
-			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			#if( configUSE_TIMER_WHEEL == 1 )
 			{
-				/* The timer queue is allocated statically in case
-				configSUPPORT_DYNAMIC_ALLOCATION is 0. */
-				static StaticQueue_t xStaticTimerQueue; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
-				static uint8_t ucStaticTimerQueueStorage[ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+			UBaseType_t uxSlot;
+
+				for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) configTIMER_WHEEL_SLOTS; uxSlot++ )
+				{
+					vListInitialise( &( xActiveTimerWheel[ uxSlot ] ) );
+				}
 
-				xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ 0 ] ), &xStaticTimerQueue );
+				xTimerWheelTime = xTaskGetTickCount();
 			}
-			#else
+			#endif /* configUSE_TIMER_WHEEL */
+
+			#if( configUSE_TIMER_COMMAND_RING == 1 )
 			{
-				xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
-			}
-			#endif
+			uint32_t ulSlot;
+
+				/* Each slot is free for the writer that first reaches its
+				position. */
+				for( ulSlot = ( uint32_t ) 0U; ulSlot < ( uint32_t ) configTIMER_QUEUE_LENGTH; ulSlot++ )
+				{
+					xTimerCommandRing[ ulSlot ].ulSequence = ulSlot;
+				}
 
-			#if ( configQUEUE_REGISTRY_SIZE > 0 )
+				vListInitialise( &xTimerCommandWaitingToSend );
+
+				xTimerCommandRingReady = pdTRUE;
+			}
+			#else
 			{
-				if( xTimerQueue != NULL )
+				#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 				{
-					vQueueAddToRegistry( xTimerQueue, "TmrQ" );
+					/* The timer queue is allocated statically in case
+					configSUPPORT_DYNAMIC_ALLOCATION is 0. */
+					static StaticQueue_t xStaticTimerQueue; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+					static uint8_t ucStaticTimerQueueStorage[ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+
+					xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ 0 ] ), &xStaticTimerQueue );
 				}
-				else
+				#else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
 				}
+				#endif
+
+				#if ( configQUEUE_REGISTRY_SIZE > 0 )
+				{
+					if( xTimerQueue != NULL )
+					{
+						vQueueAddToRegistry( xTimerQueue, "TmrQ" );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configQUEUE_REGISTRY_SIZE */
 			}
-			#endif /* configQUEUE_REGISTRY_SIZE */
+			#endif /* configUSE_TIMER_COMMAND_RING */
 		}
 		else
 		{
@@ -1059,7 +1813,15 @@ Timer_t * const pxTimer = xTimer;
 		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
 		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
-		xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+		#if( configUSE_TIMER_COMMAND_RING == 1 )
+		{
+			xReturn = prvSendCommand( &xMessage, pdTRUE, pxHigherPriorityTaskWoken, tmrNO_DELAY );
+		}
+		#else
+		{
+			xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+		}
+		#endif /* configUSE_TIMER_COMMAND_RING */
 
 		tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
@@ -1079,7 +1841,7 @@ Timer_t * const pxTimer = xTimer;
 		/* This function can only be called after a timer has been created or
 		after the scheduler has been started because, until then, the timer
 		queue does not exist. */
-		configASSERT( xTimerQueue );
+		configASSERT( tmrCOMMAND_CHANNEL_EXISTS() );
 
 		/* Complete the message with the function parameters and post it to the
 		daemon task. */
@@ -1088,7 +1850,15 @@ Timer_t * const pxTimer = xTimer;
 		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
 		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
-		xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+		#if( configUSE_TIMER_COMMAND_RING == 1 )
+		{
+			xReturn = prvSendCommand( &xMessage, pdFALSE, NULL, xTicksToWait );
+		}
+		#else
+		{
+			xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+		}
+		#endif /* configUSE_TIMER_COMMAND_RING */
 
 		tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
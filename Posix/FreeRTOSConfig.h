@@ -0,0 +1,197 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Portion Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions for the Posix/Linux simulator build.
+ *
+ * These mirror Core/Inc/FreeRTOSConfig.h wherever the host allows it, so the
+ * exercises behave the same as they do on the STM32F407.  The differences are
+ * the heap size, the stack type width and the Cortex-M interrupt priority
+ * settings, which have no meaning on the host.
+ *
+ * See http://www.freertos.org/a00110.html
+ *----------------------------------------------------------*/
+
+#include <stdint.h>
+
+#define configUSE_PREEMPTION                     1
+#define configSUPPORT_STATIC_ALLOCATION          0
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configUSE_IDLE_HOOK                      0
+#define configUSE_TICK_HOOK                      0
+#define configCPU_CLOCK_HZ                       ( 168000000UL )
+#define configTICK_RATE_HZ                       ((TickType_t)1000)
+#define configMAX_PRIORITIES                     ( 7 )
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
+/* Host memory is cheap - room for the benchmarks' ten thousand timers. */
+#define configTOTAL_HEAP_SIZE                    ((size_t)(8 * 1024 * 1024))
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_16_BIT_TICKS                   0
+#define configUSE_MUTEXES                        1
+#define configQUEUE_REGISTRY_SIZE                8
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+/* Defaults to size_t for backward compatibility, but can be changed
+   if lengths will always be less than the number of bytes in a size_t. */
+#define configMESSAGE_BUFFER_LENGTH_TYPE         size_t
+
+/* The number of simulated cores, each the thread of the task it is running.
+Selected with the SIMULATOR_CORES CMake option. */
+#ifndef configNUMBER_OF_CORES
+  #define configNUMBER_OF_CORES                  1
+#endif
+/* Set to 1 to add vTaskCoreAffinitySet() when there is more than one core. */
+#define configUSE_CORE_AFFINITY                  ( configNUMBER_OF_CORES > 1 )
+
+/* The idle task sleeps between ticks rather than spinning on a host core.
+With more than one core each idle task sleeps for a tick at a time instead. */
+#define configUSE_TICKLESS_IDLE                  ( configNUMBER_OF_CORES == 1 )
+
+/* Set to 1 to run in virtual time: whenever every task is blocked the tick
+count jumps straight to the next unblock time instead of waiting for it in
+real time.  Selected with the SIMULATOR_FAST_FORWARD CMake option. */
+#ifndef configPOSIX_FAST_FORWARD
+  #define configPOSIX_FAST_FORWARD               0
+#endif
+
+/* Set to 1 to keep delayed tasks in a timing wheel of configTIMING_WHEEL_SLOTS
+slots rather than in a list sorted on wake time, so blocking with a timeout
+costs the same however many tasks are already delayed.  Selected with the
+SIMULATOR_TIMING_WHEEL CMake option. */
+#ifndef configUSE_TIMING_WHEEL
+  #define configUSE_TIMING_WHEEL                 0
+#endif
+#define configTIMING_WHEEL_SLOTS                 256
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES                    0
+#define configMAX_CO_ROUTINE_PRIORITIES          ( 2 )
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet             1
+#define INCLUDE_uxTaskPriorityGet            1
+#define INCLUDE_vTaskDelete                  1
+#define INCLUDE_vTaskCleanUpResources        0
+#define INCLUDE_vTaskSuspend                 1
+#define INCLUDE_vTaskDelayUntil              1
+#define INCLUDE_vTaskDelay                   1
+#define INCLUDE_xTaskGetSchedulerState       1
+#define INCLUDE_xTaskGetCurrentTaskHandle    1
+
+/* Normal assert() semantics without relying on the provision of an assert.h
+header file. */
+extern void vAssertFailed(char* file, uint32_t line);
+#define configASSERT( x ) if ((x) == 0) { vAssertFailed(__FILE__, __LINE__); }
+
+#define configUSE_QUEUE_SETS 1
+// 1 adds pvQueueReserveSlot() and pvQueuePeekSlot() for filling in and reading
+// queue items in place
+#define configUSE_QUEUE_ZERO_COPY 1
+// 1 adds xStreamBufferAcquireWrite() and xStreamBufferAcquireRead() for
+// writing and reading stream and message buffers in place
+#define configUSE_STREAM_BUFFER_REGIONS 1
+// 1 adds xStreamBufferCreateMirrored(), whose storage is mapped twice so
+// regions never wrap
+#define configUSE_MIRRORED_STREAM_BUFFERS 1
+// 1 adds xStreamBufferCreateMultiProducer(), which any number of writers can
+// send to without a mutex
+#define configUSE_MULTI_PRODUCER_STREAM_BUFFERS 1
+// 1 indexes the tasks blocked on an event group by the bits they wait for, so
+// setting bits only looks at the tasks those bits can unblock -
+// SIMULATOR_EVENT_GROUP_LIST turns it off to keep them all on one list
+#ifndef configUSE_EVENT_GROUP_WAITER_INDEX
+  #define configUSE_EVENT_GROUP_WAITER_INDEX 1
+#endif
+// 1 takes and gives a mutex nobody else is waiting for with one
+// compare-and-swap instead of a critical section - SIMULATOR_MUTEX_SLOW_PATH
+// turns it off
+#ifndef configUSE_MUTEX_FAST_PATH
+  #define configUSE_MUTEX_FAST_PATH 1
+#endif
+// 1 counts takes, waits, timeouts and hold times for every queue, semaphore
+// and mutex, reported by name for those in the queue registry with
+// vQueueListContention() - selected with the SIMULATOR_CONTENTION_STATS
+// CMake option
+#ifndef configUSE_QUEUE_CONTENTION_STATS
+  #define configUSE_QUEUE_CONTENTION_STATS 0
+#endif
+#define configUSE_COUNTING_SEMAPHORES 1
+#define INCLUDE_xTimerPendFunctionCall 1
+#define configUSE_RECURSIVE_MUTEXES 1
+#define configUSE_TASK_NOTIFICATIONS 1
+// Timers
+#define configUSE_TIMERS 1
+#define configTIMER_TASK_PRIORITY 2
+#define configTIMER_QUEUE_LENGTH 64
+#define configTIMER_TASK_STACK_DEPTH 0x100
+// 1 sends timer commands through a ring of slots that the timer service task
+// drains configTIMER_COMMAND_BATCH at a time - SIMULATOR_TIMER_COMMAND_QUEUE
+// turns it off to use a kernel queue
+#ifndef configUSE_TIMER_COMMAND_RING
+  #define configUSE_TIMER_COMMAND_RING 1
+#endif
+#define configTIMER_COMMAND_BATCH 16
+// 1 keeps active timers in a wheel of configTIMER_WHEEL_SLOTS slots instead of
+// a list sorted on expiry time - selected with the SIMULATOR_TIMER_WHEEL option
+#ifndef configUSE_TIMER_WHEEL
+  #define configUSE_TIMER_WHEEL 0
+#endif
+#define configTIMER_WHEEL_SLOTS 256
+// Thread local storage - slot 0 holds the task's random number generator
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 1
+// 1 records context switches, blocking and queue and semaphore operations
+// into a ring buffer for Trace/trace2chrome, see trace_recorder.h - selected
+// with the SIMULATOR_TRACE CMake option
+#ifndef configUSE_TRACE_RECORDER
+  #define configUSE_TRACE_RECORDER 0
+#endif
+#define TRACE_BUFFER_EVENTS 65536
+// the recorder names tasks and queues by the numbers the trace facility gives
+// them
+#define configUSE_TRACE_FACILITY configUSE_TRACE_RECORDER
+#if (configUSE_TRACE_RECORDER == 1)
+  #include "trace_hooks.h"
+#endif
+// 1 adds up each task's run time and counts its context switches for the
+// CPU load figures of CpuLoad/cpu_load.h, on CLOCK_MONOTONIC nanoseconds
+// (Posix/cpu_load_port.c) - SIMULATOR_RUN_TIME_STATS=OFF turns it off
+#ifndef configGENERATE_RUN_TIME_STATS
+  #define configGENERATE_RUN_TIME_STATS 1
+#endif
+// nanoseconds wrap 32 bits every 4s
+#define configRUN_TIME_COUNTER_TYPE uint64_t
+#if (configGENERATE_RUN_TIME_STATS == 1)
+  extern void cpuLoadPortInit(void);
+  extern uint64_t cpuLoadPortGetCounter(void);
+  #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() cpuLoadPortInit()
+  #define portGET_RUN_TIME_COUNTER_VALUE() cpuLoadPortGetCounter()
+#endif
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,18 @@
+/*
+  Host stand-in for the CMSIS GCC core header.
+
+  cmsis_os.c includes cmsis_gcc.h when built with GCC, but only needs
+  __get_IPSR() to tell thread mode from handler mode. On the simulator
+  "handler mode" is the simulated tick interrupt.
+*/
+#ifndef CMSIS_GCC_H
+#define CMSIS_GCC_H
+
+#include "FreeRTOS.h"
+
+__STATIC_INLINE uint32_t __get_IPSR(void)
+{
+  return (uint32_t)xPortIsInsideInterrupt();
+}
+
+#endif
@@ -0,0 +1,40 @@
+/*----------------------------------------------------------------------------
+* Name:    cpu_load_port.c
+* Purpose: Run time clock for CpuLoad/cpu_load.c on the Posix/Linux simulator
+* Note(s): CLOCK_MONOTONIC nanoseconds since the scheduler started, where the
+*          target counts cycles (MDK-ARM/cpu_load_port.c). The simulated
+*          cores are threads, so the time a task is shown to run includes
+*          the time Linux gave the thread to other processes.
+*----------------------------------------------------------------------------*/
+#include "cpu_load.h"
+#include <time.h>
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+
+static uint64_t startNs;
+
+static uint64_t monotonicNs(void);
+
+void cpuLoadPortInit(void)
+{
+  startNs = monotonicNs();
+}
+
+uint64_t cpuLoadPortGetCounter(void)
+{
+  return monotonicNs() - startNs;
+}
+
+uint32_t cpuLoadPortGetHz(void)
+{
+  return 1000000000u;
+}
+
+static uint64_t monotonicNs(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+#endif
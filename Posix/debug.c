@@ -0,0 +1,22 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "trace_recorder.h"
+
+void vAssertFailed(char* file, uint32_t line)
+{
+  taskDISABLE_INTERRUPTS();
+  printf("Assertion failed, file: %s, line %u\n", file, line);
+  fflush(stdout);
+  // keep the events that led up to it
+  traceStop();
+#if (configUSE_TRACE_RECORDER == 1)
+  if (traceSave(TRACE_FILE) == pdPASS)
+  {
+    printf("trace saved to %s\n", TRACE_FILE);
+  }
+#endif
+  // on the host, fail the run instead of spinning forever
+  abort();
+}
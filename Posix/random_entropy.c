@@ -0,0 +1,35 @@
+/*----------------------------------------------------------------------------
+* Name:    random_entropy.c
+* Purpose: Seed source for Random/task_random.c on the Posix/Linux simulator
+* Note(s): Stands in for the STM32F4 hardware RNG (MDK-ARM/random_entropy.c)
+*          by reading /dev/urandom.
+*----------------------------------------------------------------------------*/
+#include "task_random.h"
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+uint32_t randomGetEntropy(void)
+{
+  uint32_t value = 0;
+  int fd = open("/dev/urandom", O_RDONLY);
+
+  if (fd >= 0)
+  {
+    if (read(fd, &value, sizeof(value)) != sizeof(value))
+    {
+      value = 0;
+    }
+    close(fd);
+  }
+
+  if (value == 0)
+  {
+    // no /dev/urandom - fall back on the clock
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    value = (uint32_t)now.tv_nsec ^ (uint32_t)now.tv_sec ^ 0x9e3779b9UL;
+  }
+
+  return (value != 0) ? value : 1;
+}
@@ -0,0 +1,14 @@
+/*----------------------------------------------------------------------------
+* Name:    retarget.c
+* Purpose: 'Retarget' layer for the Posix/Linux simulator build
+* Note(s): On the target every character goes straight out through
+*          ITM_SendChar (see MDK-ARM/retarget.c). Make stdout unbuffered on
+*          the host too, so output is not lost or held back when it is piped.
+*----------------------------------------------------------------------------*/
+#include <stdio.h>
+
+__attribute__((constructor))
+static void retarget_init(void)
+{
+  setvbuf(stdout, NULL, _IONBF, 0);
+}
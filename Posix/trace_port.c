@@ -0,0 +1,82 @@
+/*----------------------------------------------------------------------------
+* Name:    trace_port.c
+* Purpose: Timestamps and saving for Trace/trace_recorder.c on the Posix/Linux
+*          simulator
+* Note(s): Timestamps are CLOCK_MONOTONIC nanoseconds truncated to 32 bits,
+*          where the target counts cycles (MDK-ARM/trace_port.c).
+*----------------------------------------------------------------------------*/
+#include "trace_recorder.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+
+#if (configUSE_TRACE_RECORDER == 1)
+
+static void traceInterrupted(int signalNumber);
+
+uint32_t tracePortInit(void)
+{
+  // a run that hangs is stopped with Ctrl-C, keep what led up to it
+  struct sigaction action = {0};
+  action.sa_handler = traceInterrupted;
+  sigaction(SIGINT, &action, NULL);
+
+  return 1000000000u;
+}
+
+uint32_t tracePortGetTimestamp(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t)now.tv_sec * 1000000000u + (uint32_t)now.tv_nsec;
+}
+
+BaseType_t traceSave(const char* path)
+{
+  uint32_t size;
+  const char* data = traceGetRecording(&size);
+
+  if (data == NULL)
+  {
+    return pdFAIL;
+  }
+
+  // only async signal safe calls, this also runs from the SIGINT handler
+  int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+  {
+    return pdFAIL;
+  }
+  while (size > 0)
+  {
+    ssize_t written = write(fd, data, size);
+    if (written <= 0)
+    {
+      break;
+    }
+    data += written;
+    size -= (uint32_t)written;
+  }
+  close(fd);
+
+  return (size == 0) ? pdPASS : pdFAIL;
+}
+
+static void traceInterrupted(int signalNumber)
+{
+  static const char message[] = "\ntrace saved to " TRACE_FILE "\n";
+
+  traceStop();
+  if (traceSave(TRACE_FILE) == pdPASS)
+  {
+    ssize_t ignored = write(STDOUT_FILENO, message, sizeof(message) - 1);
+    (void)ignored;
+  }
+
+  // then stop the program as Ctrl-C would have
+  signal(signalNumber, SIG_DFL);
+  raise(signalNumber);
+}
+
+#endif
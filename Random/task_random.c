@@ -0,0 +1,62 @@
+/*
+Per-task random numbers - see task_random.h.
+
+  xorshift32 (Marsaglia, "Xorshift RNGs", 2003): three shifts and three
+  xors per number, a period of 2^32 - 1 and a state of one word, which fits
+  in a thread local storage pointer on both the target and the host. A state
+  of 0 would only ever produce 0, so 0 in the slot means "not seeded yet".
+*/
+#include "task_random.h"
+
+static uint32_t getState(void)
+{
+  return (uint32_t)(uintptr_t)pvTaskGetThreadLocalStoragePointer(NULL, RANDOM_TLS_INDEX);
+}
+
+static void setState(uint32_t state)
+{
+  vTaskSetThreadLocalStoragePointer(NULL, RANDOM_TLS_INDEX, (void*)(uintptr_t)state);
+}
+
+void randomSeed(uint32_t seed)
+{
+  setState((seed != 0) ? seed : randomGetEntropy());
+}
+
+uint32_t randomNext(void)
+{
+  uint32_t state = getState();
+
+  if (state == 0)
+  {
+    state = randomGetEntropy();
+  }
+
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+
+  setState(state);
+  return state;
+}
+
+uint32_t randomRange(uint32_t bound)
+{
+  // Lemire's method: scale into [0, bound) with a multiply rather than a
+  // divide, and draw again for the 2^32 % bound values that would make some
+  // results likelier than others. They all leave a low half below bound, so
+  // the divide for the threshold is only done in that rare case.
+  uint64_t product = (uint64_t)randomNext() * bound;
+  uint32_t low = (uint32_t)product;
+
+  if (low < bound)
+  {
+    uint32_t threshold = (0u - bound) % bound;
+    while (low < threshold)
+    {
+      product = (uint64_t)randomNext() * bound;
+      low = (uint32_t)product;
+    }
+  }
+  return (uint32_t)(product >> 32);
+}
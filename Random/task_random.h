@@ -0,0 +1,48 @@
+/*
+Per-task random numbers.
+
+  rand() keeps one hidden state for the whole program, so every task that
+  calls it updates the same variable - with newlib behind the global reent
+  lock - and one task's draws depend on how many numbers every other task
+  has taken. Here each task has its own xorshift32 generator instead. Its
+  32 bits of state live in the task's thread local storage slot
+  RANDOM_TLS_INDEX, so there is nothing to allocate, nothing to lock and
+  nothing to free when the task is deleted.
+
+  A task's generator seeds itself from randomGetEntropy() the first time it
+  is used - the STM32F4 hardware RNG on the target, /dev/urandom on the
+  host. A task can call randomSeed() with a fixed value instead, which makes
+  its sequence of numbers the same on every run.
+
+  The functions use the calling task's slot, so they must not be called
+  from an interrupt or before the scheduler has started.
+*/
+#ifndef TASK_RANDOM_H
+#define TASK_RANDOM_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+
+// Thread local storage slot holding the generator state
+#define RANDOM_TLS_INDEX 0
+
+#if (configNUM_THREAD_LOCAL_STORAGE_POINTERS <= RANDOM_TLS_INDEX)
+#error task_random needs configNUM_THREAD_LOCAL_STORAGE_POINTERS > RANDOM_TLS_INDEX
+#endif
+
+// Seed the calling task's generator. A seed of 0 draws a fresh one from
+// randomGetEntropy().
+void randomSeed(uint32_t seed);
+
+// Next 32 random bits from the calling task's generator
+uint32_t randomNext(void);
+
+// Random number from 0 to bound - 1, each equally likely. 0 for a bound of 0.
+uint32_t randomRange(uint32_t bound);
+
+// Platform entropy used for seeding: Posix/random_entropy.c on the host,
+// MDK-ARM/random_entropy.c on the target. Never returns 0.
+uint32_t randomGetEntropy(void);
+
+#endif
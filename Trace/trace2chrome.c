@@ -0,0 +1,548 @@
+/*
+Trace recording to Chrome trace JSON converter, run on the host.
+
+  trace2chrome trace.bin [trace.json]
+
+  Reads a recording saved by traceSave() or dumped from the target (see
+  trace_recorder.h) and writes JSON that ui.perfetto.dev and chrome://tracing
+  open as a timeline, to stdout if no output file is given. The timeline has
+  three groups of rows:
+
+    cores     a slice for every stretch of time a task ran on the core
+    tasks     per task: when it ran, when it was blocked and on what, and a
+              marker for each send, receive, give, take and notification
+    objects   a counter per queue and semaphore - items queued, or the count
+
+  An arrow goes from the event that made a blocked task ready - a give, a
+  send, a notification, the tick - to where it next started running, so a
+  semaphore handoff shows up as an arrow from the giver to the taker.
+*/
+#include "trace_format.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_TASKS   65536
+#define MAX_CORES   256
+#define TEXT_LENGTH 64
+
+typedef struct
+{
+  int seen;
+  char blockedOn[TEXT_LENGTH];  // empty when not blocked
+  double blockedSince;
+  uint32_t flow;                // arrow waiting for the task to run, 0 if none
+} TaskState_t;
+
+typedef struct
+{
+  uint16_t task;                // 0 when not known yet
+  double since;
+} CoreState_t;
+
+static const TraceHeader_t* header;
+static const uint8_t* taskNames;
+static const uint8_t* objectNames;
+static FILE* out;
+static int eventCount;
+static TaskState_t tasks[MAX_TASKS];
+static CoreState_t cores[MAX_CORES];
+static uint32_t flowCount;
+
+static int convert(const uint8_t* data, size_t size);
+static void processEvent(const TraceEvent_t* event, double ts);
+static void processQueueEvent(const TraceEvent_t* event, double ts);
+static void switchTo(uint32_t core, uint16_t task, double ts);
+static void closeRunning(uint32_t core, double ts);
+static void blockTask(uint16_t task, double ts, const char* format, const char* name);
+static void readyTask(uint16_t task, uint32_t core, double ts);
+static void finish(double ts);
+
+static const char* taskName(uint16_t task, char* buffer);
+static const char* objectName(uint16_t object, char* buffer);
+static int objectType(uint16_t object);
+
+static void beginEvent(const char* phase, int pid, uint32_t tid, double ts);
+static void writeString(const char* text);
+static void emitSlice(const char* name, int pid, uint32_t tid, double start, double end);
+static void emitInstant(const char* name, int pid, uint32_t tid, double ts);
+static void emitCounter(const char* name, double ts, uint32_t value);
+static void emitFlow(const char* phase, uint32_t id, uint32_t core, double ts);
+static void emitMetadata(const char* what, int pid, uint32_t tid, const char* name, uint32_t sortIndex);
+
+int main(int argc, char** argv)
+{
+  if (argc < 2 || argc > 3)
+  {
+    fprintf(stderr, "usage: %s trace.bin [trace.json]\n", argv[0]);
+    return 2;
+  }
+
+  FILE* in = fopen(argv[1], "rb");
+  if (in == NULL)
+  {
+    perror(argv[1]);
+    return 1;
+  }
+  fseek(in, 0, SEEK_END);
+  long size = ftell(in);
+  fseek(in, 0, SEEK_SET);
+  uint8_t* data = malloc(size > 0 ? (size_t)size : 1);
+  if (data == NULL || fread(data, 1, (size_t)size, in) != (size_t)size)
+  {
+    fprintf(stderr, "%s: cannot read\n", argv[1]);
+    return 1;
+  }
+  fclose(in);
+
+  out = stdout;
+  if (argc == 3)
+  {
+    out = fopen(argv[2], "w");
+    if (out == NULL)
+    {
+      perror(argv[2]);
+      return 1;
+    }
+  }
+
+  int result = convert(data, (size_t)size);
+  if (out != stdout)
+  {
+    fclose(out);
+  }
+  free(data);
+  return result;
+}
+
+static int convert(const uint8_t* data, size_t size)
+{
+  header = (const TraceHeader_t*)data;
+  if (size < sizeof(TraceHeader_t) || header->magic != TRACE_MAGIC)
+  {
+    fprintf(stderr, "not a trace recording\n");
+    return 1;
+  }
+  if (header->version != TRACE_VERSION || header->eventSize != sizeof(TraceEvent_t) ||
+      header->nameSize != sizeof(TraceName_t) || header->cores > MAX_CORES || header->timestampHz == 0 ||
+      header->eventCapacity == 0 || (header->eventCapacity & (header->eventCapacity - 1)) != 0)
+  {
+    fprintf(stderr, "unsupported trace recording (version %u)\n", (unsigned)header->version);
+    return 1;
+  }
+
+  size_t namesSize = (size_t)(header->maxTasks + header->maxObjects) * sizeof(TraceName_t);
+  if (size < sizeof(TraceHeader_t) + namesSize + (size_t)header->eventCapacity * sizeof(TraceEvent_t))
+  {
+    fprintf(stderr, "trace recording is truncated\n");
+    return 1;
+  }
+  taskNames = data + sizeof(TraceHeader_t);
+  objectNames = taskNames + header->maxTasks * sizeof(TraceName_t);
+  const TraceEvent_t* events = (const TraceEvent_t*)(data + sizeof(TraceHeader_t) + namesSize);
+
+  // the ring buffer holds the last eventCapacity events
+  uint32_t written = header->eventsWritten;
+  uint32_t first = (written > header->eventCapacity) ? written - header->eventCapacity : 0;
+
+  fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+  // timestamps wrap at 32 bits - follow them by the signed difference from
+  // the previous event, which also copes with cores racing for slots
+  int64_t time = 0;
+  uint32_t lastTimestamp = 0;
+  int started = 0;
+  double ts = 0;
+
+  for (uint32_t n = first; n != written; n++)
+  {
+    const TraceEvent_t* event = &events[n & (header->eventCapacity - 1)];
+    if (event->type == TRACE_EVENT_NONE || event->type >= TRACE_EVENT_TYPES || event->core >= header->cores)
+    {
+      continue;
+    }
+
+    if (started)
+    {
+      time += (int32_t)(event->timestamp - lastTimestamp);
+    }
+    started = 1;
+    lastTimestamp = event->timestamp;
+    ts = (double)time * 1e6 / header->timestampHz;   // microseconds
+
+    processEvent(event, ts);
+  }
+  finish(ts);
+
+  fprintf(out, "\n]}\n");
+
+  fprintf(stderr, "%u events, %.3f ms", (unsigned)(written - first), ts / 1000);
+  if (first > 0)
+  {
+    fprintf(stderr, " (the %u before them were overwritten)", (unsigned)first);
+  }
+  fprintf(stderr, "\n");
+  return 0;
+}
+
+// EVENTS
+
+static void processEvent(const TraceEvent_t* event, double ts)
+{
+  char name[TEXT_LENGTH];
+  char text[TEXT_LENGTH * 2];
+  uint16_t target = (uint16_t)event->arg;
+
+  tasks[event->task].seen = 1;
+
+  switch (event->type)
+  {
+  case TRACE_EVENT_TASK_SWITCHED_IN:
+    switchTo(event->core, target, ts);
+    break;
+
+  case TRACE_EVENT_TASK_READY:
+    readyTask(target, event->core, ts);
+    break;
+
+  case TRACE_EVENT_TASK_CREATE:
+    tasks[target].seen = 1;
+    snprintf(text, sizeof(text), "create %s", taskName(target, name));
+    emitInstant(text, 2, event->task, ts);
+    break;
+
+  case TRACE_EVENT_TASK_DELETE:
+    tasks[target].blockedOn[0] = '\0';
+    tasks[target].flow = 0;
+    emitInstant("deleted", 2, target, ts);
+    break;
+
+  case TRACE_EVENT_TASK_NOTIFY:
+    snprintf(text, sizeof(text), "notify %s", taskName(target, name));
+    emitInstant(text, 2, event->task, ts);
+    break;
+
+  case TRACE_EVENT_TASK_DELAY:
+    blockTask(event->task, ts, "delayed", NULL);
+    break;
+
+  case TRACE_EVENT_TASK_NOTIFY_BLOCK:
+    blockTask(event->task, ts, "waiting for a notification", NULL);
+    break;
+
+  case TRACE_EVENT_TASK_NOTIFY_TAKE:
+    emitInstant("take notification", 2, event->task, ts);
+    break;
+
+  case TRACE_EVENT_TICK:
+    break;
+
+  case TRACE_EVENT_MARK:
+    snprintf(text, sizeof(text), "mark %u", (unsigned)event->arg);
+    emitInstant(text, 2, event->task, ts);
+    break;
+
+  default:
+    processQueueEvent(event, ts);
+    break;
+  }
+}
+
+static void processQueueEvent(const TraceEvent_t* event, double ts)
+{
+  char name[TEXT_LENGTH];
+  char text[TEXT_LENGTH * 2];
+  uint16_t object = (uint16_t)TRACE_ARG_OBJECT(event->arg);
+  uint32_t count = TRACE_ARG_COUNT(event->arg);
+  int type = objectType(object);
+  int semaphore = (type == TRACE_OBJECT_MUTEX || type == TRACE_OBJECT_RECURSIVE_MUTEX ||
+                   type == TRACE_OBJECT_COUNTING_SEMAPHORE || type == TRACE_OBJECT_BINARY_SEMAPHORE);
+  const char* send = semaphore ? "give" : "send to";
+  const char* receive = semaphore ? "take" : "receive from";
+
+  objectName(object, name);
+
+  switch (event->type)
+  {
+  case TRACE_EVENT_QUEUE_CREATE:
+  case TRACE_EVENT_QUEUE_DELETE:
+    break;
+
+  case TRACE_EVENT_QUEUE_SEND:
+    snprintf(text, sizeof(text), "%s %s", send, name);
+    emitInstant(text, 2, event->task, ts);
+    emitCounter(name, ts, count + 1);
+    break;
+
+  case TRACE_EVENT_QUEUE_SEND_FAILED:
+    snprintf(text, sizeof(text), "%s %s failed", send, name);
+    emitInstant(text, 2, event->task, ts);
+    break;
+
+  case TRACE_EVENT_QUEUE_SEND_FROM_ISR:
+    snprintf(text, sizeof(text), "%s %s from an interrupt", send, name);
+    emitInstant(text, 1, event->core, ts);
+    emitCounter(name, ts, count + 1);
+    break;
+
+  case TRACE_EVENT_QUEUE_RECEIVE:
+    snprintf(text, sizeof(text), "%s %s", receive, name);
+    emitInstant(text, 2, event->task, ts);
+    emitCounter(name, ts, count - 1);
+    break;
+
+  case TRACE_EVENT_QUEUE_RECEIVE_FAILED:
+    snprintf(text, sizeof(text), "%s %s failed", receive, name);
+    emitInstant(text, 2, event->task, ts);
+    break;
+
+  case TRACE_EVENT_QUEUE_RECEIVE_FROM_ISR:
+    snprintf(text, sizeof(text), "%s %s from an interrupt", receive, name);
+    emitInstant(text, 1, event->core, ts);
+    emitCounter(name, ts, count - 1);
+    break;
+
+  case TRACE_EVENT_QUEUE_PEEK:
+    snprintf(text, sizeof(text), "peek %s", name);
+    emitInstant(text, 2, event->task, ts);
+    break;
+
+  case TRACE_EVENT_QUEUE_BLOCK_SEND:
+    blockTask(event->task, ts, semaphore ? "blocked giving %s" : "blocked sending to %s", name);
+    break;
+
+  case TRACE_EVENT_QUEUE_BLOCK_RECEIVE:
+    blockTask(event->task, ts, semaphore ? "blocked taking %s" : "blocked receiving from %s", name);
+    break;
+
+  case TRACE_EVENT_QUEUE_BLOCK_PEEK:
+    blockTask(event->task, ts, "blocked peeking %s", name);
+    break;
+  }
+}
+
+static void switchTo(uint32_t core, uint16_t task, double ts)
+{
+  CoreState_t* state = &cores[core];
+
+  closeRunning(core, ts);
+  state->task = task;
+  state->since = ts;
+  tasks[task].seen = 1;
+
+  // a block that ended without the task being made ready again
+  if (tasks[task].blockedOn[0] != '\0')
+  {
+    emitSlice(tasks[task].blockedOn, 2, task, tasks[task].blockedSince, ts);
+    tasks[task].blockedOn[0] = '\0';
+  }
+  if (tasks[task].flow != 0)
+  {
+    emitFlow("f", tasks[task].flow, core, ts);
+    tasks[task].flow = 0;
+  }
+}
+
+static void closeRunning(uint32_t core, double ts)
+{
+  CoreState_t* state = &cores[core];
+  char name[TEXT_LENGTH];
+  char text[TEXT_LENGTH];
+
+  if (state->task == 0)
+  {
+    return;
+  }
+  emitSlice(taskName(state->task, name), 1, core, state->since, ts);
+  if (header->cores > 1)
+  {
+    snprintf(text, sizeof(text), "running on core %u", (unsigned)core);
+    emitSlice(text, 2, state->task, state->since, ts);
+  }
+  else
+  {
+    emitSlice("running", 2, state->task, state->since, ts);
+  }
+}
+
+static void blockTask(uint16_t task, double ts, const char* format, const char* name)
+{
+  snprintf(tasks[task].blockedOn, TEXT_LENGTH, format, name);
+  tasks[task].blockedSince = ts;
+}
+
+static void readyTask(uint16_t task, uint32_t core, double ts)
+{
+  TaskState_t* state = &tasks[task];
+
+  // tasks are also moved to a ready list when they are created or their
+  // priority changes - only a task that was blocked gets an arrow
+  if (state->blockedOn[0] == '\0')
+  {
+    return;
+  }
+  emitSlice(state->blockedOn, 2, task, state->blockedSince, ts);
+  state->blockedOn[0] = '\0';
+
+  // from whatever ran on the core that made it ready
+  if (cores[core].task != 0 && state->flow == 0)
+  {
+    state->flow = ++flowCount;
+    emitFlow("s", state->flow, core, ts);
+  }
+}
+
+static void finish(double ts)
+{
+  char name[TEXT_LENGTH];
+  char text[TEXT_LENGTH * 2];
+
+  // close what is still open when the recording ends
+  for (uint32_t core = 0; core < header->cores; core++)
+  {
+    closeRunning(core, ts);
+  }
+  for (uint32_t task = 0; task < MAX_TASKS; task++)
+  {
+    if (tasks[task].blockedOn[0] != '\0')
+    {
+      emitSlice(tasks[task].blockedOn, 2, task, tasks[task].blockedSince, ts);
+    }
+  }
+
+  emitMetadata("process_name", 1, 0, "cores", 1);
+  emitMetadata("process_name", 2, 0, "tasks", 2);
+  emitMetadata("process_name", 3, 0, "objects", 3);
+  for (uint32_t core = 0; core < header->cores; core++)
+  {
+    snprintf(text, sizeof(text), "core %u", (unsigned)core);
+    emitMetadata("thread_name", 1, core, text, core);
+  }
+  for (uint32_t task = 0; task < MAX_TASKS; task++)
+  {
+    if (tasks[task].seen)
+    {
+      snprintf(text, sizeof(text), "%s (%u)", taskName((uint16_t)task, name), (unsigned)task);
+      emitMetadata("thread_name", 2, task, text, task);
+    }
+  }
+}
+
+// NAMES
+
+static const char* taskName(uint16_t task, char* buffer)
+{
+  const TraceName_t* entry = (const TraceName_t*)(taskNames + (task % header->maxTasks) * sizeof(TraceName_t));
+
+  if (task == 0)
+  {
+    return "unknown";
+  }
+  if (entry->id == task && entry->name[0] != '\0')
+  {
+    memcpy(buffer, entry->name, TRACE_NAME_LENGTH);
+    buffer[TRACE_NAME_LENGTH] = '\0';
+  }
+  else
+  {
+    snprintf(buffer, TEXT_LENGTH, "task %u", (unsigned)task);
+  }
+  return buffer;
+}
+
+static const char* objectName(uint16_t object, char* buffer)
+{
+  static const char* const types[] = {"queue", "mutex", "counting semaphore", "binary semaphore", "recursive mutex", "queue set"};
+  const TraceName_t* entry = (const TraceName_t*)(objectNames + (object % header->maxObjects) * sizeof(TraceName_t));
+  int type = objectType(object);
+
+  if (entry->id == object && entry->name[0] != '\0')
+  {
+    memcpy(buffer, entry->name, TRACE_NAME_LENGTH);
+    buffer[TRACE_NAME_LENGTH] = '\0';
+  }
+  else if (type >= 0 && type <= TRACE_OBJECT_SET)
+  {
+    snprintf(buffer, TEXT_LENGTH, "%s %u", types[type], (unsigned)object);
+  }
+  else
+  {
+    snprintf(buffer, TEXT_LENGTH, "object %u", (unsigned)object);
+  }
+  return buffer;
+}
+
+static int objectType(uint16_t object)
+{
+  const TraceName_t* entry = (const TraceName_t*)(objectNames + (object % header->maxObjects) * sizeof(TraceName_t));
+  return (object != 0 && entry->id == object) ? entry->type : -1;
+}
+
+// JSON
+
+static void beginEvent(const char* phase, int pid, uint32_t tid, double ts)
+{
+  fprintf(out, "%s{\"ph\":\"%s\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f", eventCount++ ? ",\n" : "", phase, pid, (unsigned)tid, ts);
+}
+
+static void writeString(const char* text)
+{
+  fputc('"', out);
+  for (; *text != '\0'; text++)
+  {
+    if (*text == '"' || *text == '\\')
+    {
+      fprintf(out, "\\%c", *text);
+    }
+    else if ((unsigned char)*text < 0x20)
+    {
+      fprintf(out, "\\u%04x", (unsigned)*text);
+    }
+    else
+    {
+      fputc(*text, out);
+    }
+  }
+  fputc('"', out);
+}
+
+static void emitSlice(const char* name, int pid, uint32_t tid, double start, double end)
+{
+  beginEvent("X", pid, tid, start);
+  fprintf(out, ",\"dur\":%.3f,\"name\":", (end > start) ? end - start : 0);
+  writeString(name);
+  fputc('}', out);
+}
+
+static void emitInstant(const char* name, int pid, uint32_t tid, double ts)
+{
+  beginEvent("i", pid, tid, ts);
+  fprintf(out, ",\"s\":\"t\",\"name\":");
+  writeString(name);
+  fputc('}', out);
+}
+
+static void emitCounter(const char* name, double ts, uint32_t value)
+{
+  beginEvent("C", 3, 0, ts);
+  fprintf(out, ",\"name\":");
+  writeString(name);
+  fprintf(out, ",\"args\":{\"count\":%d}}", (int)(int16_t)value);
+}
+
+static void emitFlow(const char* phase, uint32_t id, uint32_t core, double ts)
+{
+  beginEvent(phase, 1, core, ts);
+  fprintf(out, ",\"id\":%u,\"cat\":\"ready\",\"name\":\"ready\"%s}", (unsigned)id, (phase[0] == 'f') ? ",\"bp\":\"e\"" : "");
+}
+
+static void emitMetadata(const char* what, int pid, uint32_t tid, const char* name, uint32_t sortIndex)
+{
+  beginEvent("M", pid, tid, 0);
+  fprintf(out, ",\"name\":\"%s\",\"args\":{\"name\":", what);
+  writeString(name);
+  fprintf(out, "}}");
+  beginEvent("M", pid, tid, 0);
+  fprintf(out, ",\"name\":\"%s\",\"args\":{\"sort_index\":%u}}", (what[0] == 'p') ? "process_sort_index" : "thread_sort_index",
+          (unsigned)sortIndex);
+}
@@ -0,0 +1,119 @@
+/*
+Binary format of a trace recording.
+
+  Shared by the recorder (trace_recorder.c), which runs on the target or in
+  the simulator, and the converter (trace2chrome.c), which runs on the host,
+  so it only depends on stdint.h. Both ends are little endian.
+
+  A recording is one block of memory, saved or dumped as it is:
+
+    TraceHeader_t                               sizes, clock rate, event count
+    TraceName_t   tasks[maxTasks]               task names
+    TraceName_t   objects[maxObjects]           queue and semaphore names
+    TraceEvent_t  events[eventCapacity]         the newest events
+
+  The events form a ring buffer that is overwritten once it is full, so it
+  always holds the last eventCapacity events before the recording stopped.
+  Event n, counting from the first one recorded, is kept in
+  events[n % eventCapacity]; eventsWritten is the number of the next one.
+
+  Tasks and objects are numbered from 1 in the order they are created. Their
+  names are kept at number % maxTasks (or maxObjects), so a program that
+  creates more than that keeps only the most recent names - an event whose
+  number does not match the entry's id has lost its name.
+
+  Timestamps count at timestampHz and wrap at 32 bits, every 25s on the
+  STM32F407 and every 4.3s in the simulator. The tick event recorded every
+  tick keeps the gap between two events shorter than that, so the converter
+  can unwrap them.
+*/
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <stdint.h>
+
+#define TRACE_MAGIC             0x52544652u   // "FRTR"
+#define TRACE_VERSION           1
+#define TRACE_NAME_LENGTH       16
+
+typedef enum
+{
+  TRACE_EVENT_NONE = 0,
+
+  // Scheduling - arg is a task number
+  TRACE_EVENT_TASK_SWITCHED_IN = 1,   // the task starts running on the core
+  TRACE_EVENT_TASK_READY,             // the task is moved to a ready list
+  TRACE_EVENT_TASK_CREATE,
+  TRACE_EVENT_TASK_DELETE,
+  TRACE_EVENT_TASK_NOTIFY,            // the running task notifies the task
+
+  // The running task blocks - arg is the tick it times out at, or 0
+  TRACE_EVENT_TASK_DELAY = 8,
+  TRACE_EVENT_TASK_NOTIFY_BLOCK,
+  TRACE_EVENT_TASK_NOTIFY_TAKE,       // the running task takes a notification, arg 0
+
+  TRACE_EVENT_TICK = 12,              // arg is the tick count
+  TRACE_EVENT_MARK,                   // arg is the application's value
+
+  // Queues and semaphores - arg is TRACE_OBJECT_ARG(object, count), where
+  // count is the number of items (or the semaphore count) before the call
+  TRACE_EVENT_QUEUE_CREATE = 16,
+  TRACE_EVENT_QUEUE_DELETE,
+  TRACE_EVENT_QUEUE_SEND,             // also a semaphore or mutex give
+  TRACE_EVENT_QUEUE_SEND_FAILED,
+  TRACE_EVENT_QUEUE_SEND_FROM_ISR,
+  TRACE_EVENT_QUEUE_RECEIVE,          // also a semaphore or mutex take
+  TRACE_EVENT_QUEUE_RECEIVE_FAILED,
+  TRACE_EVENT_QUEUE_RECEIVE_FROM_ISR,
+  TRACE_EVENT_QUEUE_PEEK,
+  TRACE_EVENT_QUEUE_BLOCK_SEND,       // the running task blocks on the object
+  TRACE_EVENT_QUEUE_BLOCK_RECEIVE,
+  TRACE_EVENT_QUEUE_BLOCK_PEEK,
+
+  TRACE_EVENT_TYPES
+} TraceEventType_t;
+
+#define TRACE_OBJECT_ARG(object, count) (((uint32_t)(object) << 16) | (uint16_t)(count))
+#define TRACE_ARG_OBJECT(arg)           ((arg) >> 16)
+#define TRACE_ARG_COUNT(arg)            ((arg) & 0xffffu)
+
+// Object types, the same numbers as queueQUEUE_TYPE_* in queue.h
+#define TRACE_OBJECT_QUEUE              0
+#define TRACE_OBJECT_MUTEX              1
+#define TRACE_OBJECT_COUNTING_SEMAPHORE 2
+#define TRACE_OBJECT_BINARY_SEMAPHORE   3
+#define TRACE_OBJECT_RECURSIVE_MUTEX    4
+#define TRACE_OBJECT_SET                5
+
+typedef struct
+{
+  uint32_t timestamp;
+  uint8_t type;                 // TraceEventType_t
+  uint8_t core;
+  uint16_t task;                // task running on the core, 0 if not known yet
+  uint32_t arg;
+} TraceEvent_t;
+
+typedef struct
+{
+  uint16_t id;                  // task or object number, 0 for an empty entry
+  uint8_t type;                 // object type, 0 for a task
+  uint8_t reserved;
+  char name[TRACE_NAME_LENGTH]; // not terminated if it fills the array
+} TraceName_t;
+
+typedef struct
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t eventSize;           // sizeof(TraceEvent_t)
+  uint32_t timestampHz;
+  uint32_t eventCapacity;       // a power of two
+  uint32_t eventsWritten;
+  uint16_t maxTasks;
+  uint16_t maxObjects;
+  uint16_t nameSize;            // sizeof(TraceName_t)
+  uint16_t cores;
+} TraceHeader_t;
+
+#endif
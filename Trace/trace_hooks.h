@@ -0,0 +1,70 @@
+/*
+Kernel trace hooks for the trace recorder - see trace_recorder.h.
+
+  FreeRTOSConfig.h includes this file when configUSE_TRACE_RECORDER is 1, so
+  the trace macros FreeRTOS.h would otherwise leave empty record an event
+  instead. They expand inside tasks.c and queue.c, which is why they can
+  read pxCurrentTCB and the task and queue structures, and the task and
+  queue numbers they use need configUSE_TRACE_FACILITY.
+
+  Only what the timeline needs is hooked: context switches, tasks becoming
+  ready, blocking, notifications, the tick, and sends, receives and peeks on
+  queues, semaphores and mutexes.
+
+  Nothing here may include FreeRTOS.h, which is still being read when this
+  file is.
+*/
+#ifndef TRACE_HOOKS_H
+#define TRACE_HOOKS_H
+
+#include "trace_format.h"
+#include <stdint.h>
+
+#if (configUSE_TRACE_FACILITY != 1)
+#error configUSE_TRACE_FACILITY must be set to 1 to use the trace recorder
+#endif
+
+void traceRecordEvent(uint32_t type, uint32_t arg);
+void traceRecordSwitch(uint32_t task);
+void traceRecordTask(uint32_t task, const char* name);
+uint32_t traceRecordObject(uint32_t type);
+void traceRecordObjectName(uint32_t object, const char* name);
+
+#define traceQUEUE_ARG(pxQueue) \
+  TRACE_OBJECT_ARG((pxQueue)->uxQueueNumber, (pxQueue)->uxMessagesWaiting)
+
+// tasks.c
+#define traceTASK_SWITCHED_IN()                 traceRecordSwitch(pxCurrentTCB->uxTCBNumber)
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB)   traceRecordEvent(TRACE_EVENT_TASK_READY, (pxTCB)->uxTCBNumber)
+#define traceTASK_CREATE(pxNewTCB)              traceRecordTask((pxNewTCB)->uxTCBNumber, (pxNewTCB)->pcTaskName)
+#define traceTASK_DELETE(pxTCB)                 traceRecordEvent(TRACE_EVENT_TASK_DELETE, (pxTCB)->uxTCBNumber)
+#define traceTASK_DELAY()                       traceRecordEvent(TRACE_EVENT_TASK_DELAY, xTickCount + xTicksToDelay)
+#define traceTASK_DELAY_UNTIL(xTimeToWake)      traceRecordEvent(TRACE_EVENT_TASK_DELAY, (xTimeToWake))
+#define traceTASK_INCREMENT_TICK(xTickCount)    traceRecordEvent(TRACE_EVENT_TICK, (xTickCount) + 1)
+#define traceTASK_NOTIFY()                      traceRecordEvent(TRACE_EVENT_TASK_NOTIFY, pxTCB->uxTCBNumber)
+#define traceTASK_NOTIFY_FROM_ISR()             traceRecordEvent(TRACE_EVENT_TASK_NOTIFY, pxTCB->uxTCBNumber)
+#define traceTASK_NOTIFY_GIVE_FROM_ISR()        traceRecordEvent(TRACE_EVENT_TASK_NOTIFY, pxTCB->uxTCBNumber)
+#define traceTASK_NOTIFY_TAKE_BLOCK()           traceRecordEvent(TRACE_EVENT_TASK_NOTIFY_BLOCK, xTickCount + xTicksToWait)
+#define traceTASK_NOTIFY_WAIT_BLOCK()           traceRecordEvent(TRACE_EVENT_TASK_NOTIFY_BLOCK, xTickCount + xTicksToWait)
+#define traceTASK_NOTIFY_TAKE()                 traceRecordEvent(TRACE_EVENT_TASK_NOTIFY_TAKE, 0)
+#define traceTASK_NOTIFY_WAIT()                 traceRecordEvent(TRACE_EVENT_TASK_NOTIFY_TAKE, 0)
+
+// queue.c - the queue number is handed out when the queue is created
+#define traceQUEUE_CREATE(pxNewQueue)           (pxNewQueue)->uxQueueNumber = traceRecordObject((pxNewQueue)->ucQueueType)
+#define traceQUEUE_REGISTRY_ADD(xQueue, pcName) traceRecordObjectName((xQueue)->uxQueueNumber, (pcName))
+#define traceQUEUE_DELETE(pxQueue)              traceRecordEvent(TRACE_EVENT_QUEUE_DELETE, traceQUEUE_ARG(pxQueue))
+#define traceQUEUE_SEND(pxQueue)                traceRecordEvent(TRACE_EVENT_QUEUE_SEND, traceQUEUE_ARG(pxQueue))
+#define traceQUEUE_SEND_FAILED(pxQueue)         traceRecordEvent(TRACE_EVENT_QUEUE_SEND_FAILED, traceQUEUE_ARG(pxQueue))
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)       traceRecordEvent(TRACE_EVENT_QUEUE_SEND_FROM_ISR, traceQUEUE_ARG(pxQueue))
+#define traceQUEUE_SEND_FROM_ISR_FAILED(pxQueue) traceRecordEvent(TRACE_EVENT_QUEUE_SEND_FAILED, traceQUEUE_ARG(pxQueue))
+#define traceQUEUE_RECEIVE(pxQueue)             traceRecordEvent(TRACE_EVENT_QUEUE_RECEIVE, traceQUEUE_ARG(pxQueue))
+#define traceQUEUE_RECEIVE_FAILED(pxQueue)      traceRecordEvent(TRACE_EVENT_QUEUE_RECEIVE_FAILED, traceQUEUE_ARG(pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)    traceRecordEvent(TRACE_EVENT_QUEUE_RECEIVE_FROM_ISR, traceQUEUE_ARG(pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED(pxQueue) traceRecordEvent(TRACE_EVENT_QUEUE_RECEIVE_FAILED, traceQUEUE_ARG(pxQueue))
+#define traceQUEUE_PEEK(pxQueue)                traceRecordEvent(TRACE_EVENT_QUEUE_PEEK, traceQUEUE_ARG(pxQueue))
+#define traceQUEUE_PEEK_FROM_ISR(pxQueue)       traceRecordEvent(TRACE_EVENT_QUEUE_PEEK, traceQUEUE_ARG(pxQueue))
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)    traceRecordEvent(TRACE_EVENT_QUEUE_BLOCK_SEND, traceQUEUE_ARG(pxQueue))
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) traceRecordEvent(TRACE_EVENT_QUEUE_BLOCK_RECEIVE, traceQUEUE_ARG(pxQueue))
+#define traceBLOCKING_ON_QUEUE_PEEK(pxQueue)    traceRecordEvent(TRACE_EVENT_QUEUE_BLOCK_PEEK, traceQUEUE_ARG(pxQueue))
+
+#endif
@@ -0,0 +1,145 @@
+/*
+Trace recorder - see trace_recorder.h, and trace_format.h for the layout.
+
+  The whole recording is one static block, so a debugger can dump it by name
+  and nothing is allocated. A hook claims the next slot with an atomic
+  increment of eventsWritten and fills it in, so hooks on different cores,
+  or an interrupt that lands in the middle of another hook, get different
+  slots without waiting for each other. A slot can be read half written
+  only while recording is still going on.
+
+  The task running on each core is kept here, updated by the context switch
+  hook, so the hooks in queue.c, which cannot see the task control block,
+  still know which task an event belongs to.
+
+  Names are stored whether or not recording has started, so tasks and queues
+  created before traceStart() are named in the timeline too.
+*/
+#include "trace_recorder.h"
+#include "atomic.h"
+#include <string.h>
+
+#if (configUSE_TRACE_RECORDER == 1)
+
+#if (TRACE_BUFFER_EVENTS & (TRACE_BUFFER_EVENTS - 1)) != 0
+#error TRACE_BUFFER_EVENTS must be a power of two
+#endif
+
+typedef struct
+{
+  TraceHeader_t header;
+  TraceName_t tasks[TRACE_MAX_TASKS];
+  TraceName_t objects[TRACE_MAX_OBJECTS];
+  TraceEvent_t events[TRACE_BUFFER_EVENTS];
+} TraceRecording_t;
+
+// Not static, so the debugger can find it
+TraceRecording_t traceRecording;
+
+static volatile uint32_t recording;
+static volatile uint32_t objectCount;
+static uint16_t runningTask[configNUMBER_OF_CORES];   // only written by the core itself
+
+static void storeName(TraceName_t* entry, uint32_t id, uint32_t type, const char* name);
+
+void traceStart(void)
+{
+  TraceHeader_t* header = &traceRecording.header;
+
+  if (header->magic != TRACE_MAGIC)
+  {
+    header->version = TRACE_VERSION;
+    header->eventSize = sizeof(TraceEvent_t);
+    header->timestampHz = tracePortInit();
+    header->eventCapacity = TRACE_BUFFER_EVENTS;
+    header->maxTasks = TRACE_MAX_TASKS;
+    header->maxObjects = TRACE_MAX_OBJECTS;
+    header->nameSize = sizeof(TraceName_t);
+    header->cores = configNUMBER_OF_CORES;
+    header->magic = TRACE_MAGIC;
+  }
+  recording = 1;
+}
+
+void traceStop(void)
+{
+  recording = 0;
+}
+
+const void* traceGetRecording(uint32_t* size)
+{
+  if (traceRecording.header.magic != TRACE_MAGIC)
+  {
+    *size = 0;
+    return NULL;    // never started
+  }
+  *size = sizeof(traceRecording);
+  return &traceRecording;
+}
+
+// HOOKS
+
+void traceRecordEvent(uint32_t type, uint32_t arg)
+{
+  if (!recording)
+  {
+    return;
+  }
+
+  uint32_t timestamp = tracePortGetTimestamp();
+  BaseType_t core = portGET_CORE_ID();
+  uint32_t n = Atomic_Increment_u32(&traceRecording.header.eventsWritten);
+  TraceEvent_t* event = &traceRecording.events[n & (TRACE_BUFFER_EVENTS - 1)];
+
+  event->timestamp = timestamp;
+  event->type = (uint8_t)type;
+  event->core = (uint8_t)core;
+  event->task = runningTask[core];
+  event->arg = arg;
+}
+
+void traceRecordSwitch(uint32_t task)
+{
+  BaseType_t core = portGET_CORE_ID();
+
+  // the scheduler picks a task on every tick and yield, most often the same one
+  if (runningTask[core] != (uint16_t)task)
+  {
+    runningTask[core] = (uint16_t)task;
+    traceRecordEvent(TRACE_EVENT_TASK_SWITCHED_IN, task);
+  }
+}
+
+void traceRecordTask(uint32_t task, const char* name)
+{
+  storeName(&traceRecording.tasks[task % TRACE_MAX_TASKS], task, 0, name);
+  traceRecordEvent(TRACE_EVENT_TASK_CREATE, task);
+}
+
+uint32_t traceRecordObject(uint32_t type)
+{
+  uint32_t object = (uint16_t)(Atomic_Increment_u32(&objectCount) + 1);
+
+  storeName(&traceRecording.objects[object % TRACE_MAX_OBJECTS], object, type, "");
+  traceRecordEvent(TRACE_EVENT_QUEUE_CREATE, TRACE_OBJECT_ARG(object, 0));
+  return object;
+}
+
+void traceRecordObjectName(uint32_t object, const char* name)
+{
+  TraceName_t* entry = &traceRecording.objects[object % TRACE_MAX_OBJECTS];
+
+  if (entry->id == object)
+  {
+    strncpy(entry->name, name, TRACE_NAME_LENGTH);
+  }
+}
+
+static void storeName(TraceName_t* entry, uint32_t id, uint32_t type, const char* name)
+{
+  entry->id = (uint16_t)id;
+  entry->type = (uint8_t)type;
+  strncpy(entry->name, name, TRACE_NAME_LENGTH);
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*
+Trace recorder.
+
+  When a barrier or dance floor run stalls, printf output only says what the
+  tasks got round to printing. With configUSE_TRACE_RECORDER set to 1 the
+  kernel's trace hooks (trace_hooks.h) record every context switch, every
+  task made ready, every block and every send, receive, give and take on a
+  queue, semaphore or mutex into a ring buffer in RAM, as 12 byte events
+  with a timestamp, the core and the running task.
+
+  Recording an event is a timestamp read, one atomic increment to claim a
+  slot and four stores - a few dozen cycles on the STM32F407 - and never
+  blocks or disables interrupts, so the hooks can run from any task, inside
+  critical sections and from interrupts, on every core. Once the buffer is
+  full the oldest events are overwritten, so it always holds what led up to
+  the moment recording stopped.
+
+  Timestamps come from the DWT cycle counter on the target and from
+  CLOCK_MONOTONIC, in nanoseconds, in the simulator.
+
+  Getting the recording out:
+    - In the simulator traceSave() writes it to a file. Once traceStart()
+      has been called it is also saved to TRACE_FILE when the program is
+      stopped with Ctrl-C and when an assertion fails.
+    - On the target stop recording (or halt) and dump the traceGetRecording()
+      block with the debugger, for example
+        dump binary memory trace.bin &traceRecording ((char*)&traceRecording)+sizeof(traceRecording)
+
+  Trace/trace2chrome converts the file to Chrome trace JSON, which Perfetto
+  (ui.perfetto.dev) and chrome://tracing open as a timeline:
+
+    trace2chrome trace.bin trace.json
+
+  Built with configUSE_TRACE_RECORDER set to 0 the calls below compile to
+  nothing, so programs can leave them in.
+*/
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include "FreeRTOS.h"
+#include <stdint.h>
+
+// Number of events the ring buffer holds, must be a power of two
+#ifndef TRACE_BUFFER_EVENTS
+#define TRACE_BUFFER_EVENTS 1024
+#endif
+
+// Number of task and queue names kept
+#ifndef TRACE_MAX_TASKS
+#define TRACE_MAX_TASKS     32
+#endif
+#ifndef TRACE_MAX_OBJECTS
+#define TRACE_MAX_OBJECTS   32
+#endif
+
+// File the simulator saves the recording to on Ctrl-C or a failed assertion
+#ifndef TRACE_FILE
+#define TRACE_FILE          "trace.bin"
+#endif
+
+#if (configUSE_TRACE_RECORDER == 1)
+
+// Start recording, or carry on after traceStop(). Tasks and queues created
+// before the first call are still named.
+void traceStart(void);
+
+// Stop recording, so the events that led up to now are kept
+void traceStop(void);
+
+// Record an application event with a value, shown as a marker on the
+// running task's row
+#define traceMark(value)    traceRecordEvent(TRACE_EVENT_MARK, (uint32_t)(value))
+
+// The recording as one block of memory (see trace_format.h) and its size
+const void* traceGetRecording(uint32_t* size);
+
+// Write the recording to a file - simulator only
+BaseType_t traceSave(const char* path);
+
+// Platform timestamp clock: Posix/trace_port.c on the host,
+// MDK-ARM/trace_port.c on the target. tracePortInit() starts the clock and
+// returns the rate it counts at.
+uint32_t tracePortInit(void);
+uint32_t tracePortGetTimestamp(void);
+
+#else
+
+#define traceStart()        ((void)0)
+#define traceStop()         ((void)0)
+#define traceMark(value)    ((void)(value))
+
+#endif
+
+#endif
@@ -24,6 +24,10 @@ Little Book of Semaphores race condition puzzle (1.5.2):
     
     The compiler switch "NOT_SAFE", when defined will yield the maximum output
     of 2000 (20 * 100) and when not defined, yield the answer 100 as expected.
+    
+    The safe build increments the counter with Atomic_Increment_u32() from
+    atomic.h, which needs neither a critical section nor a mutex on ports
+    with lock free atomics (LDREX/STREX on the Cortex-M4).
 */
 
 #include "FreeRTOS.h"
@@ -31,6 +35,7 @@ Little Book of Semaphores race condition puzzle (1.5.2):
 #include <stdio.h>
 #include "timers.h"
 #include "semphr.h"
+#include "atomic.h"
 
 #define THREAD_COUNT 20
 #define TASK_INCREMENT_AMOUNT 100
@@ -44,7 +49,7 @@ Little Book of Semaphores race condition puzzle (1.5.2):
 #define NOT_SAFE
 
 // Global shared variable
-uint32_t gCounter;
+volatile uint32_t gCounter;
 
 // Task handles
 void vTaskIncrementCounter(void* pvParam);
@@ -86,15 +91,13 @@ void vTaskIncrementCounter(void* pvParam)
 {
   for (int i = 0; i < TASK_INCREMENT_AMOUNT; i++)
   {
-    uint32_t temp = gCounter;
-    
     #ifdef NOT_SAFE
+    uint32_t temp = gCounter;
     vTaskDelay(pdMS_TO_TICKS(10));
     gCounter = temp + 1;
     #else
-    taskENTER_CRITICAL();
-    gCounter = temp + 1;
-    taskEXIT_CRITICAL();
+    // read, add and write back in one indivisible step
+    Atomic_Increment_u32(&gCounter);
     #endif
   }
   xTaskNotify(xPrintTaskHandle, (uint32_t)pvParam, eSetBits);
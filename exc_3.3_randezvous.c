@@ -16,12 +16,22 @@ Little Book of Semaphores Exc 3.3:
     b1
     b2
     
+  Code:
+      The book's solution has each thread signal a semaphore when it is
+      done with its first step and wait on the other thread's semaphore
+      before its second step - two binary semaphores, each a queue object
+      from the heap, and a give and a take per thread.
+      
+      This code uses the kernel's rendezvous object instead. Whichever
+      thread arrives first waits, and the second one wakes it with a task
+      notification. It is a single task handle held in a static variable,
+      so it needs no heap and costs one kernel call per thread.
     
 */
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "semphr.h"
+#include "rendezvous.h"
 #include <stdio.h>
 
 void vThreadA(void* pvParam);
@@ -34,16 +44,14 @@ void b2(void);
 
 void safePrint(char* str);
 
-SemaphoreHandle_t xDone_a1;
-SemaphoreHandle_t xDone_b1;
+Rendezvous_t xStepOneDone;
 
 int main(void)
 {
   xTaskCreate(vThreadA, "A", 0x100, NULL, 1, NULL);
   xTaskCreate(vThreadB, "B", 0x100, NULL, 1, NULL);
   
-  xDone_a1 = xSemaphoreCreateBinary();
-  xDone_b1 = xSemaphoreCreateBinary();
+  vRendezvousInitialise(&xStepOneDone);
   
   vTaskStartScheduler();
   
@@ -75,13 +83,12 @@ void vThreadB(void* pvParam)
 void a1(void)
 {
   safePrint("A:\t1");
-  BaseType_t err = xSemaphoreGive(xDone_a1);
-  configASSERT(err == pdTRUE);
 }
 
 void a2(void)
 {
-  BaseType_t err = xSemaphoreTake(xDone_b1, pdMS_TO_TICKS(100));
+  // wait for b1 to be done
+  BaseType_t err = xRendezvousArrive(&xStepOneDone, pdMS_TO_TICKS(100));
   configASSERT(err == pdTRUE);
   safePrint("A:\t2");
 }
@@ -89,12 +96,12 @@ void a2(void)
 void b1(void)
 {
   safePrint("B:\t1");
-  xSemaphoreGive(xDone_b1);
 }
 
 void b2(void)
 {
-  BaseType_t err = xSemaphoreTake(xDone_a1, pdMS_TO_TICKS(100));
+  // wait for a1 to be done
+  BaseType_t err = xRendezvousArrive(&xStepOneDone, pdMS_TO_TICKS(100));
   configASSERT(err == pdTRUE);
   safePrint("B:\t2");
 }
@@ -16,8 +16,9 @@ Little Book of Semaphores Exc 3.5, Multiplex:
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
+#include "deferred_log.h"
+#include "task_random.h"
 #include <stdio.h>
-#include <stdlib.h>
 
 void vThreadA(void* pvParam);
 
@@ -39,7 +40,10 @@ int main(void)
   }
   
   xCriticalSectionKeeper = xSemaphoreCreateCounting(4, 4);
+  vQueueAddToRegistry(xCriticalSectionKeeper, "critical section");  // names it in debuggers and the contention report
   
+  logInit(tskIDLE_PRIORITY);  // print from a low priority task, not from the callers
+
   vTaskStartScheduler();
   
   for (;;)
@@ -67,20 +71,20 @@ void someCriticalSection(char* taskName)
   BaseType_t err = xSemaphoreTake(xCriticalSectionKeeper, pdMS_TO_TICKS(10000));
   configASSERT(err == pdTRUE);  // a check for starving tasks
   
-  // inner critical section, 1 allowed to print!
+  // inner critical section, keeps the count and its log line in step
   portENTER_CRITICAL();
   threadsInSection += 1;
-  printf("Task [%s] entered. Threads in section = %u\n", taskName, threadsInSection);
+  logPrintf("Task [%s] entered. Threads in section = %" PRIuPTR "\n", taskName, threadsInSection);
   portEXIT_CRITICAL();
   
   // block a random amount of time- pretending to be some work
-  uint32_t msToWait = (rand() % 2000);
+  uint32_t msToWait = randomRange(2000);
   vTaskDelay(pdMS_TO_TICKS(msToWait));
   
-  // another inner critical section, 1 allowed to print
+  // another inner critical section
   portENTER_CRITICAL();
   threadsInSection -= 1;
-  printf("Task [%s] leaving. Threads in section = %u\n", taskName, threadsInSection);
+  logPrintf("Task [%s] leaving. Threads in section = %" PRIuPTR "\n", taskName, threadsInSection);
   portEXIT_CRITICAL();
   
   xSemaphoreGive(xCriticalSectionKeeper);
@@ -36,18 +36,29 @@ Little Book of Semaphores Exc 3.6, Barrier:
       either the randezvous or the critical point, and never the two
       mixed together.
       
+      The task counter is updated with Atomic_Increment_u32() and
+      Atomic_Decrement_u32() rather than under a mutex. Both return the old
+      value, so the one thread that brings the count to n (or to 0) knows it
+      is the one to open the turnstile.
+
       In a second iteration of this code, a counting semaphore will be used
       for both turnstiles to signal multiple "unlocks" which the book
       suggests will reduce the number of context switches in some situtions.
 
+      The unlocks are given with xSemaphoreGiveMultiple(), which raises the
+      count and unblocks every waiting task in one kernel call, rather than
+      calling xSemaphoreGive() once per thread.
+
 */
 
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
 #include "event_groups.h"
+#include "atomic.h"
+#include "deferred_log.h"
+#include "task_random.h"
 #include <stdio.h>
-#include <stdlib.h>
 
 // Task prototype
 void vThreadA(void* pvParam);
@@ -57,7 +68,7 @@ void someRandezvous(char* taskName);
 void somePretendAction(void);
 
 // Variables for sync event
-uint8_t threadCounter;
+volatile uint32_t threadCounter;  // updated with atomic.h, no lock needed
 
 void incrementThreadCounterSafely(void);
 void decrementThreadCounterSafely(void);
@@ -65,7 +76,6 @@ void decrementThreadCounterSafely(void);
 // FreeRTOS objects
 SemaphoreHandle_t xBarrier;
 SemaphoreHandle_t xSecondBarrier;
-SemaphoreHandle_t xThreadCounterLock;
 
 void openFirstTurnstile(void);
 void openSecondTurnstile(void);
@@ -73,8 +83,6 @@ void openSecondTurnstile(void);
 void waitAtFirstTurnstile(void);
 void waitAtSecondTurnstile(void);
 
-void giveMultipleSemaphore(SemaphoreHandle_t xSemphrHandle, UBaseType_t count);
-
 // Max threads that will be spawned
 #define MAX_THREADS 20
 #define MAX_TASK_DELAY_MS 2000
@@ -95,8 +103,9 @@ int main(void)
   
   xBarrier = xSemaphoreCreateCounting(MAX_THREADS, 0);      // xBarrier is closed to begin with
   xSecondBarrier = xSemaphoreCreateCounting(MAX_THREADS, 0); // xSecondBarrier is open to begin with
-  xThreadCounterLock =  xSemaphoreCreateMutex();  // to safely access global counter
   
+  logInit(tskIDLE_PRIORITY);  // print from a low priority task, not from the callers
+
   vTaskStartScheduler();
   
   for (;;)
@@ -133,25 +142,25 @@ void someCriticalSection(char* taskName)
   static uint8_t threadsInSection = 0;  
   // Beginning of "critical section"
   
-  // inner critical section, 1 allowed to print!
+  // inner critical section, keeps the count and its log line in step
   portENTER_CRITICAL();
   threadsInSection += 1;
-  printf("Task [%s] entered. Threads in section = %u\n", taskName, threadsInSection);
+  logPrintf("Task [%s] entered. Threads in section = %" PRIuPTR "\n", taskName, threadsInSection);
   portEXIT_CRITICAL();
   
   somePretendAction();
   
-  // another inner critical section, 1 allowed to print
+  // another inner critical section
   portENTER_CRITICAL();
   threadsInSection -= 1;
-  printf("Task [%s] leaving. Threads in section = %u\n", taskName, threadsInSection);
+  logPrintf("Task [%s] leaving. Threads in section = %" PRIuPTR "\n", taskName, threadsInSection);
   portEXIT_CRITICAL();
 }
 
 void someRandezvous(char* taskName)
 {
   portENTER_CRITICAL();
-  printf("Task [%s] performing randezvous.\n", taskName);
+  logPrintf("Task [%s] performing randezvous.\n", taskName);
   //somePretendAction();
   portEXIT_CRITICAL();
 }
@@ -159,42 +168,28 @@ void someRandezvous(char* taskName)
 void somePretendAction(void)
 {
   // block a random amount of time- pretending to be some work
-  uint32_t msToWait = (rand() % MAX_TASK_DELAY_MS);
+  uint32_t msToWait = randomRange(MAX_TASK_DELAY_MS);
   vTaskDelay(pdMS_TO_TICKS(msToWait));
 }
 
 void incrementThreadCounterSafely(void)
 {
-  if (xSemaphoreTake(xThreadCounterLock, pdMS_TO_TICKS(5000)) == pdFAIL)
-  {
-    configASSERT(0);
-  }
-  threadCounter++;
-  
-  if (threadCounter == MAX_THREADS)
+  // Atomic_Increment_u32 returns the count from before this thread arrived,
+  // so exactly one thread sees the last arrival. Everyone else is already
+  // held at the closed first turnstile, so it can be opened without a lock.
+  if (Atomic_Increment_u32(&threadCounter) + 1 == MAX_THREADS)
   {
     openFirstTurnstile();
   }
-  
-  xSemaphoreGive(xThreadCounterLock);
 }
 
 void decrementThreadCounterSafely(void)
 {
-  // take sem
-  if (xSemaphoreTake(xThreadCounterLock, pdMS_TO_TICKS(5000)) == pdFAIL)
-  {
-    configASSERT(0);
-  }
-  threadCounter--;
-  
-  if (threadCounter == 0)
+  // likewise, only the last thread out of the critical section sees 1 here
+  if (Atomic_Decrement_u32(&threadCounter) == 1)
   {
     openSecondTurnstile();
   }
-  
-  // give
-  xSemaphoreGive(xThreadCounterLock);
 }
 
 void openFirstTurnstile(void)
@@ -205,7 +200,7 @@ void openFirstTurnstile(void)
   {
     configASSERT(0);  // second barrier should be closed at this point
   }
-  giveMultipleSemaphore(xBarrier, MAX_THREADS);  // xSemaphoreGive(xBarrier);
+  xSemaphoreGiveMultiple(xBarrier, MAX_THREADS);
 }
 
 void openSecondTurnstile(void)
@@ -217,7 +212,7 @@ void openSecondTurnstile(void)
     {
       configASSERT(0);  //  First turnstile should be closed at this point
     }
-    giveMultipleSemaphore(xSecondBarrier, MAX_THREADS);  // xSemaphoreGive(xSecondBarrier);
+    xSemaphoreGiveMultiple(xSecondBarrier, MAX_THREADS);
 }
 
 void waitAtFirstTurnstile(void)
@@ -237,12 +232,3 @@ void waitAtSecondTurnstile(void)
   }
   //xSemaphoreGive(xSecondBarrier);
 }
-
-void giveMultipleSemaphore(SemaphoreHandle_t xSemphrHandle, UBaseType_t count)
-{
-  for (UBaseType_t i = 0; i < count; i++)
-  {
-    xSemaphoreGive(xSemphrHandle);
-  }
-}
-
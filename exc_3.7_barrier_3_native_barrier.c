@@ -0,0 +1,157 @@
+/*
+Little Book of Semaphores Exc 3.6, Barrier:
+
+  Puzzle:
+    The synchronization requirement is that no thread executes critical point
+    until after all threads have executed rendezvous.
+
+    You can assume that there are n threads and that this value is stored in a
+    variable, n, that is accessible from all threads.
+
+    When the first n - 1 threads arrive they should block until the nth thread
+    arrives, at which point all the threads may proceed.
+
+    Thread
+    ------
+    <<randezvous>>
+    <<critical point>>  // all tasks must have finished their randezvous task
+
+  Code:
+      The previous two iterations build a reusable barrier out of an atomic
+      counter and two turnstiles. That is two kernel objects and two trips
+      through a turnstile per thread per pass.
+
+      This iteration uses the kernel's barrier object instead. xBarrierWait()
+      counts the arrivals and releases every waiting task at once when the
+      nth one arrives. The barrier keeps a generation count that moves on
+      each time it opens, so it is ready to be reused straight away - a fast
+      thread that comes back around cannot slip through with the stragglers
+      of the previous pass, which is the job the second turnstile did.
+
+      The thread that opens the barrier is told so (barrierSERIAL_TASK), so
+      it can do any once-per-pass work, like printing the pass number below.
+
+*/
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "barrier.h"
+#include "deferred_log.h"
+#include "task_random.h"
+#include <stdio.h>
+
+// Task prototype
+void vThreadA(void* pvParam);
+
+void someCriticalSection(char* taskName);
+void someRandezvous(char* taskName);
+void somePretendAction(void);
+
+void waitAtBarrier(void);
+
+// FreeRTOS objects
+BarrierHandle_t xBarrier;
+
+// Max threads that will be spawned
+#define MAX_THREADS 20
+#define MAX_TASK_DELAY_MS 2000
+
+// For printing task info
+static const char* const numbersLookup[] =
+{
+  "0","1","2","3","4","5","6","7","8","9","10","11","12","13","14","15","16","17","18","19"
+};
+
+int main(void)
+{
+  for (int i = 0; i < MAX_THREADS; i++)
+  {
+    BaseType_t err = xTaskCreate(vThreadA, "A", 0x50, (void*)i, 1, NULL);
+    configASSERT(err == pdPASS);
+  }
+
+  xBarrier = xBarrierCreate(MAX_THREADS);
+
+  logInit(tskIDLE_PRIORITY);  // print from a low priority task, not from the callers
+
+  vTaskStartScheduler();
+
+  for (;;)
+  {
+    printf("Shouldn't come here\n");
+    while(1);
+  }
+}
+
+void vThreadA(void* pvParam)
+{
+  // Ensures that the Critical section is always performed
+  // once all threads have finished the randezvous. The barrier
+  // is reused for every pass through the loop.
+  char* taskStr = (void*)numbersLookup[(int)pvParam];
+  for (;;)
+  {
+    someRandezvous(taskStr);
+
+    waitAtBarrier();
+
+    someCriticalSection(taskStr);
+
+    waitAtBarrier();
+  }
+}
+
+void someCriticalSection(char* taskName)
+{
+  static uint8_t threadsInSection = 0;
+  // Beginning of "critical section"
+
+  // inner critical section, keeps the count and its log line in step
+  portENTER_CRITICAL();
+  threadsInSection += 1;
+  logPrintf("Task [%s] entered. Threads in section = %" PRIuPTR "\n", taskName, threadsInSection);
+  portEXIT_CRITICAL();
+
+  somePretendAction();
+
+  // another inner critical section
+  portENTER_CRITICAL();
+  threadsInSection -= 1;
+  logPrintf("Task [%s] leaving. Threads in section = %" PRIuPTR "\n", taskName, threadsInSection);
+  portEXIT_CRITICAL();
+}
+
+void someRandezvous(char* taskName)
+{
+  portENTER_CRITICAL();
+  logPrintf("Task [%s] performing randezvous.\n", taskName);
+  //somePretendAction();
+  portEXIT_CRITICAL();
+}
+
+void somePretendAction(void)
+{
+  // block a random amount of time- pretending to be some work
+  uint32_t msToWait = randomRange(MAX_TASK_DELAY_MS);
+  vTaskDelay(pdMS_TO_TICKS(msToWait));
+}
+
+void waitAtBarrier(void)
+{
+  static uint32_t passes = 0;
+
+  BaseType_t result = xBarrierWait(xBarrier, pdMS_TO_TICKS(5000));
+  if (result == pdFAIL)
+  {
+    configASSERT(0);  // expect all tasks to arrive within 5 seconds
+  }
+
+  if (result == barrierSERIAL_TASK)
+  {
+    // only the task that opened the barrier gets here, once per pass
+    portENTER_CRITICAL();
+    passes++;
+    logPrintf("Barrier opened. Pass %" PRIuPTR "\n", passes);
+    portEXIT_CRITICAL();
+  }
+}
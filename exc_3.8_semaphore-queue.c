@@ -44,7 +44,9 @@ Little Book of Semaphores Exc 3.8, Queue:
       - The queue for Leader
       - The generic semaphore (which acts like a multi-task mutex) for only 1 dancer to make
       the action.
-      - A randezvous at the end to synchronise dancers.
+      - A randezvous at the end to synchronise dancers. The book uses two more
+      semaphores for it, this code uses the kernel's rendezvous object, which
+      needs no heap and one kernel call per dancer.
       
       Scenario:
         - A Leader (doesn't matter leader or follower as it's mirrored) comes in.
@@ -64,9 +66,13 @@ Little Book of Semaphores Exc 3.8, Queue:
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semphr.h"
+#include "rendezvous.h"
+#include "deferred_log.h"
+#include "task_random.h"
+#include "trace_recorder.h"
+#include "cpu_load.h"
 #include <string.h>
 #include <stdio.h>
-#include <stdlib.h>
 
 // Constants
 #define MAX(x, y) (((x) > (y)) ? (x) : (y))
@@ -75,14 +81,15 @@ Little Book of Semaphores Exc 3.8, Queue:
 #define MAX_RANDOM_DELAY_MS  5000
 #define MAX_DANCE_DELAY_MS  (MAX_RANDOM_DELAY_MS * 2)
 #define DELAY_TOLERANCE ((MAX_DANCE_DELAY_MS) * MAX(LEADER_COUNT, FOLLOWER_COUNT))
+#define CONTENTION_REPORT_MS  30000
+#define CPU_LOAD_REPORT_MS  10000
 
 // FreeRTOS objects
 SemaphoreHandle_t xDanceFloorMutex;
-SemaphoreHandle_t xRandezvousAfterDanceFromLeader;
-SemaphoreHandle_t xRandezvousAfterDanceFromFollower;
 SemaphoreHandle_t xADancerIsAvailable;
 SemaphoreHandle_t xALeaderIsAvailable;
 SemaphoreHandle_t xDebugCounterMutex;
+Rendezvous_t xRandezvousAfterDance;  // one pair on the floor, so one is enough
 
 // Strings for printing output
 const char* const g_leaders[LEADER_COUNT]     = {"1", "2", "3", "4", "5"};
@@ -95,6 +102,7 @@ UBaseType_t g_followerCount = 0;
 // Tasks
 void vLeader(void* pvParam);
 void vFollower(void* pvParam);
+void vContentionReport(void* pvParam);
 
 // Helper functions
 void vRandomDelay(void);
@@ -106,9 +114,14 @@ int main(void)
   xDanceFloorMutex = xSemaphoreCreateCounting(1, 1);
   xADancerIsAvailable = xSemaphoreCreateBinary();
   xALeaderIsAvailable = xSemaphoreCreateBinary();
-  xRandezvousAfterDanceFromLeader = xSemaphoreCreateBinary();
-  xRandezvousAfterDanceFromFollower = xSemaphoreCreateBinary();
+  vRendezvousInitialise(&xRandezvousAfterDance);
   xDebugCounterMutex = xSemaphoreCreateMutex();
+
+  // names for the trace timeline and the contention report
+  vQueueAddToRegistry(xDanceFloorMutex, "dance floor");
+  vQueueAddToRegistry(xADancerIsAvailable, "dancer available");
+  vQueueAddToRegistry(xALeaderIsAvailable, "leader available");
+  vQueueAddToRegistry(xDebugCounterMutex, "debug counter");
   
   // create threads representing leaders
   for (UBaseType_t uLeader = 0; uLeader < LEADER_COUNT; uLeader++)
@@ -122,6 +135,15 @@ int main(void)
     xTaskCreate(vFollower, (void*)(g_followers[uFollower]), 0x50, (void*)(g_followers[uFollower]), 1, NULL);
   }
   
+  logInit(tskIDLE_PRIORITY);  // print from a low priority task, not from the callers
+  traceStart();  // only records when built with configUSE_TRACE_RECORDER
+#if (configUSE_QUEUE_CONTENTION_STATS == 1)
+  xTaskCreate(vContentionReport, "contention", 0x200, NULL, tskIDLE_PRIORITY, NULL);
+#endif
+#if (configGENERATE_RUN_TIME_STATS == 1)
+  cpuLoadInit(CPU_LOAD_REPORT_MS, tskIDLE_PRIORITY);  // who ran, and how often they were switched in
+#endif
+
   vTaskStartScheduler();
   
   while(1)
@@ -153,7 +175,7 @@ void vLeader(void* pvParam)
     else
     {
       g_leaderCount++;
-      printf("%s entering queue\n", (char*)pvParam);
+      logPrintf("%s entering queue\n", (char*)pvParam);
       xSemaphoreGive(xDanceFloorMutex);  // End of critical section
       // wait to take a follower's hand
       if (xSemaphoreTake(xADancerIsAvailable, pdMS_TO_TICKS(DELAY_TOLERANCE)) == pdFAIL)
@@ -164,8 +186,7 @@ void vLeader(void* pvParam)
         
     vDance((char*)pvParam);
     // randezvous
-    xSemaphoreGive(xRandezvousAfterDanceFromLeader);
-    if (xSemaphoreTake(xRandezvousAfterDanceFromFollower, pdMS_TO_TICKS(DELAY_TOLERANCE)) == pdFAIL)
+    if (xRendezvousArrive(&xRandezvousAfterDance, pdMS_TO_TICKS(DELAY_TOLERANCE)) == pdFAIL)
     {
       configASSERT(0);  // follower should have been done by now!
     }
@@ -195,7 +216,7 @@ void vFollower(void* pvParam)
     else
     {
       g_followerCount++;
-      printf("%s entering queue\n", (char*)pvParam);
+      logPrintf("%s entering queue\n", (char*)pvParam);
       xSemaphoreGive(xDanceFloorMutex);  // End of critical section
       // wait to take a leader's hand
       if (xSemaphoreTake(xALeaderIsAvailable, pdMS_TO_TICKS(DELAY_TOLERANCE)) == pdFAIL)
@@ -207,19 +228,35 @@ void vFollower(void* pvParam)
     // go to dance floor
     vDance((char*)pvParam);
     // randezvous
-    xSemaphoreGive(xRandezvousAfterDanceFromFollower);
-    if (xSemaphoreTake(xRandezvousAfterDanceFromLeader, pdMS_TO_TICKS(DELAY_TOLERANCE)) == pdFAIL)
+    if (xRendezvousArrive(&xRandezvousAfterDance, pdMS_TO_TICKS(DELAY_TOLERANCE)) == pdFAIL)
     {
       configASSERT(0);  // follower should have been done by now!
     }
   }
 }
 
+// CONTENTION REPORT
+
+#if (configUSE_QUEUE_CONTENTION_STATS == 1)
+// Which of the semaphores the dancers spend their time waiting on, worst first
+void vContentionReport(void* pvParam)
+{
+  static char report[1024];
+
+  while(1)
+  {
+    vTaskDelay(pdMS_TO_TICKS(CONTENTION_REPORT_MS));
+    vQueueListContention(report, sizeof(report));
+    printf("%s", report);
+  }
+}
+#endif
+
 // HELPER FUNCTIONS
 
 void vRandomDelay(void)
 {
-  vTaskDelay(pdMS_TO_TICKS(rand() % MAX_RANDOM_DELAY_MS));
+  vTaskDelay(pdMS_TO_TICKS(randomRange(MAX_RANDOM_DELAY_MS)));
 }
 
 void vDance(char* dancer)
@@ -231,7 +268,7 @@ void vDance(char* dancer)
     configASSERT(0); // couldn't grab mutex in time!
   }
   dancers++;
-  printf("%s steps onto the dance floor (people in total: %lu)!\n", dancer, dancers);
+  logPrintf("%s steps onto the dance floor (people in total: %" PRIuPTR ")!\n", dancer, dancers);
   xSemaphoreGive(xDebugCounterMutex);
   
   vRandomDelay(); // dance for a random amount of time
@@ -241,6 +278,6 @@ void vDance(char* dancer)
     configASSERT(0); // couldn't grab mutex in time!
   }
   dancers--;
-  printf("%s steps off the dance floor (people in total: %lu)!\n", dancer, dancers);
+  logPrintf("%s steps off the dance floor (people in total: %" PRIuPTR ")!\n", dancer, dancers);
   xSemaphoreGive(xDebugCounterMutex);
 }
@@ -0,0 +1,181 @@
+/*
+Little Book of Semaphores Exc 3.8, Queue:
+
+  Puzzle:
+      Semaphores can also be used to represent a queue. In this case, the initial value
+      is 0, and usually the code is written so that it is not possible to signal unless
+      there is a thread waiting, so the value of the semaphore is never positive.
+      For example, imagine that threads represent ballroom dancers and that two
+      kinds of dancers, leaders and followers, wait in two queues before entering the
+      dance floor. When a leader arrives, it checks to see if there is a follower waiting.
+      If so, they can both proceed. Otherwise it waits.
+      Similarly, when a follower arrives, it checks for a leader and either proceeds
+      or waits, accordingly.
+      Puzzle: write code for leaders and followers that enforces these constraints.
+
+  Code:
+      The first iteration (exc_3.8_semaphore-queue.c) follows the book: two queue
+      counters, a semaphore per queue, a "dance floor" semaphore that lets one pair
+      dance at a time, and two more semaphores for the randezvous after the dance.
+
+      This iteration uses the kernel's exchanger object instead. It keeps a queue of
+      leaders and a queue of followers and pairs the dancer that waited longest in
+      one queue with the one that waited longest in the other. The two dancers swap
+      their task handles as they pair up.
+
+      - The exchanger is created with room for DANCE_FLOOR_PAIRS pairs, so up to
+      that many pairs can dance at the same time. While the floor is full, dancers
+      keep queueing in arrival order even if a partner is waiting.
+      - The randezvous after the dance is a task notification straight to the
+      partner, so each pair has its own randezvous and pairs don't hold each other up.
+      - The Leader leaves the floor last (vExchangerPairDone), mirroring the first
+      iteration where the Leader always returns the dance floor semaphore.
+*/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "exchanger.h"
+#include "deferred_log.h"
+#include "task_random.h"
+#include <string.h>
+#include <stdio.h>
+
+// Constants
+#define MAX(x, y) (((x) > (y)) ? (x) : (y))
+#define LEADER_COUNT  5
+#define FOLLOWER_COUNT  5
+#define DANCE_FLOOR_PAIRS  2
+#define MAX_RANDOM_DELAY_MS  5000
+#define MAX_DANCE_DELAY_MS  (MAX_RANDOM_DELAY_MS * 2)
+#define DELAY_TOLERANCE ((MAX_DANCE_DELAY_MS) * MAX(LEADER_COUNT, FOLLOWER_COUNT))
+
+// FreeRTOS objects
+ExchangerHandle_t xDanceFloor;
+SemaphoreHandle_t xDebugCounterMutex;
+
+// Strings for printing output
+const char* const g_leaders[LEADER_COUNT]     = {"1", "2", "3", "4", "5"};
+const char* const g_followers[FOLLOWER_COUNT] = {"a", "b", "c", "d", "e"};
+
+// Tasks
+void vLeader(void* pvParam);
+void vFollower(void* pvParam);
+
+// Helper functions
+TaskHandle_t xFindPartner(BaseType_t xClass);
+void vRandezvousWith(TaskHandle_t xPartner);
+void vRandomDelay(void);
+void vDance(char* dancer);
+
+int main(void)
+{
+  xDanceFloor = xExchangerCreate(DANCE_FLOOR_PAIRS);
+  xDebugCounterMutex = xSemaphoreCreateMutex();
+
+  // create threads representing leaders
+  for (UBaseType_t uLeader = 0; uLeader < LEADER_COUNT; uLeader++)
+  {
+    xTaskCreate(vLeader, (void*)(g_leaders[uLeader]), 0x50, (void*)(g_leaders[uLeader]), 1, NULL);
+  }
+
+  // create threads representing followers
+  for (UBaseType_t uFollower = 0; uFollower < FOLLOWER_COUNT; uFollower++)
+  {
+    xTaskCreate(vFollower, (void*)(g_followers[uFollower]), 0x50, (void*)(g_followers[uFollower]), 1, NULL);
+  }
+
+  logInit(tskIDLE_PRIORITY);  // print from a low priority task, not from the callers
+
+  vTaskStartScheduler();
+
+  while(1)
+  {
+    printf("Shouldn't come here!\n");
+    while(1);
+  }
+}
+
+// LEADERS
+void vLeader(void* pvParam)
+{
+  while(1)
+  {
+    // do preperation to start dancing
+    vRandomDelay();
+
+    TaskHandle_t xPartner = xFindPartner(exchangerLEADER);
+
+    vDance((char*)pvParam);
+    vRandezvousWith(xPartner);
+    vExchangerPairDone(xDanceFloor);  // allow another pair to begin
+  }
+}
+
+// FOLLOWERS
+void vFollower(void* pvParam)
+{
+  while(1)
+  {
+    // do preperation to start dancing
+    vRandomDelay();
+
+    TaskHandle_t xPartner = xFindPartner(exchangerFOLLOWER);
+
+    // go to dance floor
+    vDance((char*)pvParam);
+    vRandezvousWith(xPartner);
+  }
+}
+
+// HELPER FUNCTIONS
+
+TaskHandle_t xFindPartner(BaseType_t xClass)
+{
+  void* partner;
+
+  // join the queue and swap hands (task handles) with the partner
+  if (xExchangerPair(xDanceFloor, xClass, xTaskGetCurrentTaskHandle(), &partner,
+                     pdMS_TO_TICKS(DELAY_TOLERANCE)) == pdFAIL)
+  {
+    configASSERT(0);  // should have found a partner by now!
+  }
+  return (TaskHandle_t)partner;
+}
+
+void vRandezvousWith(TaskHandle_t xPartner)
+{
+  // tell the partner this dancer is done, then wait for the partner
+  xTaskNotifyGive(xPartner);
+  if (ulTaskNotifyTake(pdFALSE, pdMS_TO_TICKS(DELAY_TOLERANCE)) == 0)
+  {
+    configASSERT(0);  // partner should have been done by now!
+  }
+}
+
+void vRandomDelay(void)
+{
+  vTaskDelay(pdMS_TO_TICKS(randomRange(MAX_RANDOM_DELAY_MS)));
+}
+
+void vDance(char* dancer)
+{
+  static UBaseType_t dancers = 0;
+
+  if (xSemaphoreTake(xDebugCounterMutex, pdMS_TO_TICKS(10000)) == pdFAIL)
+  {
+    configASSERT(0); // couldn't grab mutex in time!
+  }
+  dancers++;
+  logPrintf("%s steps onto the dance floor (people in total: %" PRIuPTR ")!\n", dancer, dancers);
+  xSemaphoreGive(xDebugCounterMutex);
+
+  vRandomDelay(); // dance for a random amount of time
+
+  if (xSemaphoreTake(xDebugCounterMutex, pdMS_TO_TICKS(10000)) == pdFAIL)
+  {
+    configASSERT(0); // couldn't grab mutex in time!
+  }
+  dancers--;
+  logPrintf("%s steps off the dance floor (people in total: %" PRIuPTR ")!\n", dancer, dancers);
+  xSemaphoreGive(xDebugCounterMutex);
+}